@@ -28,8 +28,8 @@ class PlanetTerrain : public IPrivateComponent
     std::vector<std::shared_ptr<TerrainChunk>> m_chunks;
     PlanetInfo m_info;
     // Used for fast mesh generation;
-    std::vector<Vertex> m_sharedVertices;
-    std::vector<unsigned> m_sharedTriangles;
+    VertexStreams m_sharedVertexStreams;
+    std::vector<glm::uvec3> m_sharedTriangles;
     bool m_initialized = false;
   public:
     void SetPlanetInfo(const PlanetInfo &planetInfo);
@@ -44,6 +44,10 @@ class TerrainChunk
         glm::ivec2 chunkCoordinate,
         ChunkDirection direction,
         glm::dvec3 localUp);
+    /**
+     * Expand and GenerateTerrain must be called from the main thread. Elevation is evaluated on the workers and the
+     * resulting mesh is uploaded right away.
+     */
     void Expand(std::mutex &mutex);
     void GenerateTerrain(std::mutex &mutex, std::shared_ptr<TerrainChunk> &targetChunk) const;
     void Collapse();
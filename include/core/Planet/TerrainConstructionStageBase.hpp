@@ -7,6 +7,10 @@ class TerrainConstructionStageBase
 {
   public:
     virtual ~TerrainConstructionStageBase() = default;
+    /**
+     * Called for many points at once from the job workers. Implementations must not modify shared state, the stage
+     * object itself included.
+     */
     virtual void Process(glm::dvec3 point, double previousResult, double &elevation) = 0;
 };
 } // namespace Planet
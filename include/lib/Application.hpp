@@ -39,6 +39,15 @@ struct UNIENGINE_API ApplicationConfigs{
     bool m_enableDocking = true;
     bool m_enableViewport = false;
     bool m_fullScreen = false;
+    /**
+     * Run without a GPU: GL calls are recorded instead of executed (see OpenGLUtils::GetStatistics) and the editor UI
+     * is laid out but not drawn. Meant for benchmarking the CPU side of a frame.
+     */
+    bool m_headless = false;
+    /**
+     * Start returns after this many frames, 0 runs until the window is closed.
+     */
+    size_t m_frameLimit = 0;
 };
 enum class UNIENGINE_API ApplicationStatus{
     Uninitialized,
@@ -23,6 +23,7 @@ class UNIENGINE_API Editor : public ISingleton<Editor>
     friend class Scene;
     std::map<std::string, std::shared_ptr<Texture2D>> m_assetsIcons;
     bool m_enabled = false;
+    bool m_headless = false;
     std::map<size_t, std::function<bool(Entity entity, IDataComponent *data, bool isRoot)>> m_componentDataInspectorMap;
     std::vector<std::pair<size_t, std::function<void(Entity owner)>>> m_privateComponentMenuList;
     std::vector<std::pair<size_t, std::function<void(float rank)>>> m_systemMenuList;
@@ -30,7 +31,10 @@ class UNIENGINE_API Editor : public ISingleton<Editor>
     template <typename T1 = IPrivateComponent> static void RegisterPrivateComponent();
     template <typename T1 = ISystem> static void RegisterSystem();
     template <typename T1 = IDataComponent> static void RegisterDataComponent();
-    static void Init(bool docking, bool viewport);
+    /**
+     * @param headless Skip the platform and renderer backends, frames are laid out by ImGui but never drawn.
+     */
+    static void Init(bool docking, bool viewport, bool headless = false);
     static void ImGuiPreUpdate();
     static void ImGuiLateUpdate();
 
@@ -93,6 +93,7 @@ namespace UniEngine
 		friend class AssetRecord;
 		friend class Folder;
 		friend class PhysicsLayer;
+		friend class MemoryStats;
 		std::shared_ptr<Folder> m_projectFolder;
 		std::filesystem::path m_projectPath;
 		std::optional<std::function<void()>> m_newSceneCustomizer;
@@ -12,6 +12,11 @@ class UNIENGINE_API Jobs final : ISingleton<Jobs>
     static void ResizeWorkers(unsigned size);
     static ThreadPool &Workers();
     static void Init();
+    /**
+     * Whether the calling thread is a worker. A worker that waits on jobs it pushed can deadlock the pool, since the
+     * jobs may be queued behind it.
+     */
+    static bool IsWorkerThread();
     static void ParallelFor(unsigned size, const std::function<void(unsigned i)> &func, std::vector<std::shared_future<void>>& results);
     static void ParallelFor(unsigned size, const std::function<void(unsigned i, unsigned threadIndex)>& func, std::vector<std::shared_future<void>>& results);
 };
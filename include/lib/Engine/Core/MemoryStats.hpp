@@ -0,0 +1,76 @@
+#pragma once
+#include "ISingleton.hpp"
+#include "uniengine_export.h"
+
+namespace UniEngine
+{
+enum class UNIENGINE_API MemoryTag
+{
+    ArchetypeChunks,
+    EntityMetadata,
+    MeshVertices,
+    PointClouds,
+    AnimationKeyFrames,
+    PrivateComponentPool,
+    YamlBuffers,
+    Count
+};
+
+struct UNIENGINE_API MemoryTagStats
+{
+    size_t m_bytes = 0;
+    size_t m_peakBytes = 0;
+    // Chunks, entities, vertices, points, key frames, pooled components or documents, depending on the tag.
+    size_t m_amount = 0;
+    // 0 means the tag has no budget.
+    size_t m_budget = 0;
+};
+
+/**
+ * CPU memory of the engine broken down by subsystem. Memory owned by scenes and assets is measured by Collect, which
+ * walks every live scene and asset. Transient buffers such as the YAML text of a file being loaded are reported while
+ * they live with ScopedAllocation, from any thread.
+ *
+ * Collect warns once whenever a tag grows over its budget.
+ */
+class UNIENGINE_API MemoryStats final : ISingleton<MemoryStats>
+{
+    friend class ISingleton<MemoryStats>;
+    static constexpr size_t TagAmount = static_cast<size_t>(MemoryTag::Count);
+    std::array<MemoryTagStats, TagAmount> m_collected;
+    std::array<size_t, TagAmount> m_budgets{};
+    std::array<bool, TagAmount> m_overBudget{};
+    std::array<std::atomic<size_t>, TagAmount> m_allocatedBytes{};
+    std::array<std::atomic<size_t>, TagAmount> m_allocatedAmount{};
+    std::array<std::atomic<size_t>, TagAmount> m_allocatedPeakBytes{};
+
+  public:
+    /**
+     * Reports an allocation under a tag from construction to destruction.
+     */
+    class UNIENGINE_API ScopedAllocation
+    {
+        MemoryTag m_tag;
+        size_t m_bytes;
+
+      public:
+        ScopedAllocation(const MemoryTag &tag, const size_t &bytes);
+        ~ScopedAllocation();
+        ScopedAllocation(const ScopedAllocation &) = delete;
+        ScopedAllocation &operator=(const ScopedAllocation &) = delete;
+    };
+    static void Allocate(const MemoryTag &tag, const size_t &bytes);
+    static void Free(const MemoryTag &tag, const size_t &bytes);
+    /**
+     * Measure the memory held by live scenes and assets and check the budgets. Main thread only.
+     */
+    static void Collect();
+    [[nodiscard]] static MemoryTagStats Get(const MemoryTag &tag);
+    [[nodiscard]] static size_t GetTotalBytes();
+    [[nodiscard]] static const char *GetTagName(const MemoryTag &tag);
+    /**
+     * Bytes a tag may hold before Collect warns, 0 removes the budget.
+     */
+    static void SetBudget(const MemoryTag &tag, const size_t &bytes);
+};
+} // namespace UniEngine
@@ -46,10 +46,25 @@ namespace UniEngine
 		Src1Alpha = GL_SRC1_ALPHA,
 		OneMinusSrc1Alpha = GL_ONE_MINUS_SRC1_ALPHA
 	};
+	/**
+	 * GL calls recorded by the headless backend. Draws include compute dispatches, state changes are capability,
+	 * blending, depth, viewport and binding calls, and bytes uploaded count buffer and texture data sent from memory.
+	 */
+	struct UNIENGINE_API GLStatistics
+	{
+		size_t m_calls = 0;
+		size_t m_drawCalls = 0;
+		size_t m_stateChanges = 0;
+		size_t m_uniformUpdates = 0;
+		size_t m_bytesUploaded = 0;
+	};
+
 	class UNIENGINE_API OpenGLUtils : ISingleton<OpenGLUtils>
 	{
 		friend class DefaultResources;
 		// friend class Graphics;
+		bool m_headless = false;
+		static void* HeadlessProcAddress(const char* name);
 		float m_lineWidth = 1.0f;
 		float m_pointSize = 1.0f;
 		bool m_depthTest = true;
@@ -65,7 +80,17 @@ namespace UniEngine
 	public:
 		static void InsertMemoryBarrier(GLbitfield barriers);
 		static void InsertMemoryBarrierByRegion(GLbitfield barriers);
-		static void Init();
+		/**
+		 * @param headless Load the GL entry points from a recording backend instead of the current context. Every call
+		 * then returns without reaching a driver, so the engine runs on machines without a GPU.
+		 */
+		static void Init(bool headless = false);
+		[[nodiscard]] static bool IsHeadless();
+		/**
+		 * Calls recorded since the last ResetStatistics, all zero unless headless.
+		 */
+		[[nodiscard]] static const GLStatistics& GetStatistics();
+		static void ResetStatistics();
 		static void PreUpdate();
 		static void SetEnable(OpenGLCapability capability, bool enable);
 		static void SetPolygonMode(OpenGLPolygonMode mode);
@@ -132,6 +157,10 @@ namespace UniEngine
 			static void BindDefault(GLBufferTarget target);
 			void SetData(const GLsizei& length, const GLvoid* data, const GLenum& usage) const;
 			void SubData(const GLintptr& offset, const GLsizeiptr& size, const GLvoid* data) const;
+			/**
+			 * Bind part of the buffer to the indexed slot. The cached bindings of the slot are dropped, so the next Bind
+			 * of any buffer to it is not skipped.
+			 */
 			void SetRange(const GLuint& index, const GLintptr& offset, const GLsizeiptr& size) const;
 			~GLBuffer() override;
 		};
@@ -172,6 +201,11 @@ namespace UniEngine
 				const void* pointer);
 
 			void SetAttributeDivisor(const GLuint& index, const GLuint& divisor);
+			/**
+			 * Let every vertex read the value stored at offset in the vertex buffer through a zero stride binding.
+			 * Unlike glVertexAttrib* this is VAO state and doesn't leak into other draws.
+			 */
+			void SetAttributeConstant(const GLuint& index, const GLint& size, const GLenum& type, const GLintptr& offset);
 		};
 
 		class UNIENGINE_API GLRenderBuffer : public GLObject
@@ -1,4 +1,5 @@
 #pragma once
+#include "TraceRecorder.hpp"
 namespace UniEngine
 {
 namespace detail
@@ -70,6 +71,18 @@ class ThreadPool
         return *this->m_threads[i];
     }
 
+    // whether the calling thread is one of the threads of this pool
+    bool IsWorkerThread() const
+    {
+        const auto id = std::this_thread::get_id();
+        for (const auto &thread : this->m_threads)
+        {
+            if (thread && thread->get_id() == id)
+                return true;
+        }
+        return false;
+    }
+
     // change the number of threads in the pool
     // should be called from one thread, otherwise be careful to not interleave, also with this->stop()
     // nThreads must be >= 0
@@ -205,6 +218,7 @@ class ThreadPool
     {
         std::shared_ptr<std::atomic<bool>> flag(this->m_flags[i]); // a copy of the shared ptr to the flag
         auto f = [this, i, flag /* a copy of the shared ptr to the flag */]() {
+            TraceRecorder::SetThreadName("Worker " + std::to_string(i));
             std::atomic<bool> &_flag = *flag;
             std::function<void(int id)> *_f;
             bool isPop = this->m_threadPool.pop(_f);
@@ -214,7 +228,10 @@ class ThreadPool
                 { // if there is anything in the queue
                     std::unique_ptr<std::function<void(int id)>> func(
                         _f); // at return, delete the function even if an exception occurred
-                    (*_f)(i);
+                    {
+                        UNIENGINE_PROFILE_SCOPE("Job");
+                        (*_f)(i);
+                    }
                     if (_flag)
                         return; // the thread is wanted to stop, return even if the queue is not empty yet
                     else
@@ -0,0 +1,115 @@
+#pragma once
+#include "ISingleton.hpp"
+#include "uniengine_export.h"
+
+namespace UniEngine
+{
+struct UNIENGINE_API TraceEvent
+{
+    // Nanoseconds on the steady clock.
+    uint64_t m_time;
+    uint32_t m_scope;
+    uint16_t m_thread;
+    // 'B' or 'E', as in the Chrome trace format.
+    char m_phase;
+};
+
+struct UNIENGINE_API TraceFrame
+{
+    uint64_t m_start = 0;
+    uint64_t m_end = 0;
+    std::vector<TraceEvent> m_events;
+};
+
+/**
+ * Records begin and end events of named scopes from any thread. Every thread writes into its own fixed size ring, so
+ * recording takes no lock and never allocates. The main thread drains the rings once per frame with NewFrame and keeps
+ * the last frames, which can be exported in the Chrome trace format read by chrome://tracing and Perfetto.
+ *
+ * Scope names are interned once per call site by UNIENGINE_PROFILE_SCOPE. A ring keeps room for the ends of the scopes
+ * it holds the beginnings of, so a scope is recorded whole or dropped whole with the scopes nested in it. Dropped events
+ * are counted.
+ */
+class UNIENGINE_API TraceRecorder final : ISingleton<TraceRecorder>
+{
+    friend class ISingleton<TraceRecorder>;
+    struct ThreadBuffer;
+    std::atomic<bool> m_recording{false};
+    // Incremented whenever recording starts, so the threads forget the scopes left open by the previous recording.
+    std::atomic<uint32_t> m_recordingEpoch{0};
+    size_t m_maxFrames = 120;
+    std::mutex m_mutex;
+    // A deque keeps the names in place while scopes are registered from other threads.
+    std::deque<std::string> m_scopeNames;
+    std::unordered_map<std::string, uint32_t> m_scopeIndices;
+    std::vector<std::shared_ptr<ThreadBuffer>> m_threadBuffers;
+    std::deque<TraceFrame> m_frames;
+    TraceFrame m_currentFrame;
+    size_t m_droppedEvents = 0;
+    static ThreadBuffer &GetThreadBuffer();
+    static void Record(const uint32_t &scope, const char &phase);
+
+  public:
+    /**
+     * Amount of events every thread can hold between two frames.
+     */
+    static constexpr uint32_t ThreadBufferCapacity = 1 << 16;
+
+    [[nodiscard]] static uint32_t RegisterScope(const std::string &name);
+    [[nodiscard]] static const std::string &GetScopeName(const uint32_t &scope);
+    /**
+     * Name of the calling thread in exported traces.
+     */
+    static void SetThreadName(const std::string &name);
+    static void SetRecording(const bool &value);
+    [[nodiscard]] static bool IsRecording();
+    static void Begin(const uint32_t &scope);
+    static void End(const uint32_t &scope);
+    /**
+     * Close the current frame with every event recorded so far and start the next one. Main thread only.
+     */
+    static void NewFrame();
+    /**
+     * Amount of frames kept by NewFrame, older frames are discarded.
+     */
+    static void SetMaxFrames(const size_t &value);
+    static void Clear();
+    [[nodiscard]] static const std::deque<TraceFrame> &GetFrames();
+    [[nodiscard]] static size_t GetDroppedEventAmount();
+    /**
+     * Write the kept frames as Chrome trace JSON.
+     */
+    static bool ExportChromeTrace(const std::filesystem::path &path);
+};
+
+/**
+ * Records a scope from construction to destruction.
+ */
+class UNIENGINE_API TraceScope
+{
+    uint32_t m_scope;
+
+  public:
+    explicit TraceScope(const uint32_t &scope) : m_scope(scope)
+    {
+        TraceRecorder::Begin(m_scope);
+    }
+    ~TraceScope()
+    {
+        TraceRecorder::End(m_scope);
+    }
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+};
+} // namespace UniEngine
+
+#define UNIENGINE_TRACE_CONCAT_INNER(a, b) a##b
+#define UNIENGINE_TRACE_CONCAT(a, b) UNIENGINE_TRACE_CONCAT_INNER(a, b)
+/**
+ * Record the enclosing scope under a name. The name is interned the first time the line runs.
+ */
+#define UNIENGINE_PROFILE_SCOPE(name)                                                                                  \
+    static const uint32_t UNIENGINE_TRACE_CONCAT(traceScopeId, __LINE__) =                                             \
+        UniEngine::TraceRecorder::RegisterScope(name);                                                                 \
+    const UniEngine::TraceScope UNIENGINE_TRACE_CONCAT(traceScope, __LINE__)(                                          \
+        UNIENGINE_TRACE_CONCAT(traceScopeId, __LINE__))
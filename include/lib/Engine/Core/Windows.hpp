@@ -8,7 +8,15 @@ class UNIENGINE_API Windows : public ISingleton<Windows>
 {
   public:
     static void LateUpdate();
-    static void Init(std::string name, bool fullScreen = false);
+    /**
+     * @param headless Create a hidden window without a GL context. When no display is available either, the
+     * application runs without a window.
+     */
+    static void Init(std::string name, bool fullScreen = false, bool headless = false);
+    /**
+     * Seconds since Init, from GLFW when it could be initialized.
+     */
+    static double GetTime();
     static GLFWwindow *GetWindow();
     static GLFWmonitor *PrimaryMonitor();
     static void PreUpdate();
@@ -23,6 +31,9 @@ class UNIENGINE_API Windows : public ISingleton<Windows>
     GLFWwindow *m_window = nullptr;
     unsigned m_windowWidth = 1;
     unsigned m_windowHeight = 1;
+    bool m_headless = false;
+    bool m_initialized = false;
+    std::chrono::steady_clock::time_point m_startTime;
 };
 
 } // namespace UniEngine
@@ -34,6 +34,7 @@ class UNIENGINE_API DefaultResources : ISingleton<DefaultResources>
     friend class EditorLayer;
     friend class RenderLayer;
     friend class Gizmos;
+    friend class PointCloudOctree;
     static std::shared_ptr<OpenGLUtils::GLProgram> m_2DToCubemapProgram;
 
     static std::unique_ptr<Texture2D> m_brdfLut;
@@ -15,6 +15,9 @@ class UNIENGINE_API ISystem : public ISerializable
     float m_rank = 0.0f;
     bool m_started = false;
     std::weak_ptr<Scene> m_scene;
+    // Registered with TraceRecorder the first time the scene profiles the system.
+    std::optional<uint32_t> m_profilerScope;
+    [[nodiscard]] uint32_t GetProfilerScope();
   protected:
     virtual void OnEnable(){};
     virtual void OnDisable(){};
@@ -43,6 +43,21 @@ struct UNIENGINE_API PrivateComponentHolder
     void Deserialize(const YAML::Node &in);
 };
 
+/**
+ * Options of a single model import through Prefab::LoadModel. Everything that changes the imported data is off by
+ * default.
+ */
+struct UNIENGINE_API ModelImportSettings
+{
+    // Let assimp merge the node graph and the meshes.
+    bool m_optimizeScene = false;
+    // Run Mesh optimization (welding, cache, overdraw and fetch ordering) on the imported meshes.
+    bool m_optimizeMeshes = false;
+    // Compress the animations of the model when m_animationCompression.m_enabled is set.
+    AnimationCompressionSettings m_animationCompression;
+    unsigned m_flags = aiProcess_Triangulate | aiProcess_CalcTangentSpace | aiProcess_GenSmoothNormals;
+};
+
 class UNIENGINE_API Prefab : public IAsset
 {
     std::string m_name;
@@ -60,7 +75,8 @@ class UNIENGINE_API Prefab : public IAsset
     void ReadAnimations(
         const aiScene *importerScene,
         std::shared_ptr<Animation> &animator,
-        std::map<std::string, std::shared_ptr<Bone>> &bonesMap);
+        std::map<std::string, std::shared_ptr<Bone>> &bonesMap,
+        const ModelImportSettings &settings);
     void ReadKeyFrame(BoneKeyFrames &boneAnimation, const aiNodeAnim *channel);
     std::shared_ptr<Material> ReadMaterial(
         const std::string &directory,
@@ -76,8 +92,9 @@ class UNIENGINE_API Prefab : public IAsset
         aiNode *importerNode,
         std::shared_ptr<AssimpNode> assimpNode,
         const aiScene *importerScene,
-        const std::shared_ptr<Animation> &animation);
-    std::shared_ptr<Mesh> ReadMesh(aiMesh *importerMesh);
+        const std::shared_ptr<Animation> &animation,
+        const ModelImportSettings &settings);
+    std::shared_ptr<Mesh> ReadMesh(aiMesh *importerMesh, const ModelImportSettings &settings);
     std::shared_ptr<SkinnedMesh> ReadSkinnedMesh(
         std::map<std::string, std::shared_ptr<Bone>> &bonesMap, aiMesh *importerMesh);
     void AttachChildren(const std::shared_ptr<Scene>& scene,
@@ -96,7 +113,7 @@ class UNIENGINE_API Prefab : public IAsset
   protected:
     bool LoadInternal(const std::filesystem::path &path) override;
     bool SaveInternal(const std::filesystem::path &path) override;
-    void LoadModelInternal(const std::filesystem::path &path, bool optimize = false, unsigned flags = aiProcess_Triangulate | aiProcess_CalcTangentSpace | aiProcess_GenSmoothNormals);
+    void LoadModelInternal(const std::filesystem::path &path, const ModelImportSettings &settings = ModelImportSettings());
     void SaveModelInternal(const std::filesystem::path &path);
   public:
     Handle m_entityHandle = Handle();
@@ -109,6 +126,7 @@ class UNIENGINE_API Prefab : public IAsset
     [[nodiscard]] Entity ToEntity(const std::shared_ptr<Scene>& scene) const;
 
     void LoadModel(const std::filesystem::path &path, bool optimize = false, unsigned flags = aiProcess_Triangulate | aiProcess_CalcTangentSpace | aiProcess_GenSmoothNormals);
+    void LoadModel(const std::filesystem::path &path, const ModelImportSettings &settings);
 
     void FromEntity(const Entity &entity);
     void CollectAssets(std::unordered_map<Handle, std::shared_ptr<IAsset>> &map);
@@ -17,6 +17,7 @@ struct UNIENGINE_API POwnersCollection
 class Scene;
 class UNIENGINE_API PrivateComponentStorage
 {
+    friend class MemoryStats;
     std::unordered_map<size_t, size_t> m_pOwnersCollectionsMap;
     std::vector<std::pair<size_t, POwnersCollection>> m_pOwnersCollectionsList;
     std::unordered_map<size_t, std::vector<std::shared_ptr<IPrivateComponent>>> m_privateComponentPool;
@@ -62,11 +62,13 @@ class UNIENGINE_API Scene : public IAsset
     friend class Prefab;
     friend class TransformLayer;
     friend class PrivateComponentStorage;
+    friend class MemoryStats;
     SceneDataStorage m_sceneDataStorage;
     std::multimap<float, std::shared_ptr<ISystem>> m_systems;
     std::map<size_t, std::shared_ptr<ISystem>> m_indexedSystems;
     std::map<Handle, std::shared_ptr<ISystem>> m_mappedSystems;
     Bound m_worldBound;
+    size_t m_staticVersion = 0;
     void SerializeDataComponentStorage(const DataComponentStorage &storage, YAML::Emitter &out);
     void SerializeSystem(const std::shared_ptr<ISystem> &system, YAML::Emitter &out);
 
@@ -234,6 +236,17 @@ class UNIENGINE_API Scene : public IAsset
     static void Clone(const std::shared_ptr<Scene> &source, const std::shared_ptr<Scene> &newScene);
     [[nodiscard]] Bound GetBound() const;
     void SetBound(const Bound &value);
+    /**
+     * Changes whenever something that static renderers depend on may have changed: entities are deleted, enabled,
+     * disabled, reparented or made static, private components are added or removed, or the transform of a static
+     * entity is set. Renderers cache their static draws until it changes.
+     */
+    [[nodiscard]] size_t GetStaticVersion() const;
+    /**
+     * Invalidate everything cached for static entities. Call it after editing a component of a static entity in
+     * place, e.g. swapping the mesh or material of its mesh renderer.
+     */
+    void MarkStaticChanged();
     template <typename T = ISystem> void DestroySystem();
     ~Scene();
     void FixedUpdate();
@@ -275,6 +288,11 @@ class UNIENGINE_API Scene : public IAsset
     template <typename T = IDataComponent> void SetDataComponent(const Entity &entity, const T &value);
     template <typename T = IDataComponent> T GetDataComponent(const Entity &entity);
     template <typename T = IDataComponent> bool HasDataComponent(const Entity &entity);
+    /**
+     * Read the global transforms of many entities at once. Every archetype stores them at the same place in its
+     * chunks, so no component type lookup is needed. Invalid entities get the identity.
+     */
+    void GetGlobalTransforms(const std::vector<Entity> &entities, std::vector<GlobalTransform> &results);
 
     template <typename T = IPrivateComponent> std::weak_ptr<T> GetOrSetPrivateComponent(const Entity &entity);
     std::weak_ptr<IPrivateComponent> GetPrivateComponent(const Entity &entity, const std::string &typeName);
@@ -936,6 +954,7 @@ template <typename T> std::weak_ptr<T> Scene::GetOrSetPrivateComponent(const Ent
     auto ptr = m_sceneDataStorage.m_entityPrivateComponentStorage.GetOrSetPrivateComponent<T>(entity);
     elements.emplace_back(typeid(T).hash_code(), ptr, entity, std::dynamic_pointer_cast<Scene>(m_self.lock()));
     m_saved = false;
+    m_staticVersion++;
     return std::move(ptr);
 }
 template <typename T> void Scene::RemovePrivateComponent(const Entity &entity)
@@ -951,6 +970,7 @@ template <typename T> void Scene::RemovePrivateComponent(const Entity &entity)
                 entity, elements[i].m_privateComponentData);
             elements.erase(elements.begin() + i);
             m_saved = false;
+            m_staticVersion++;
             return;
         }
     }
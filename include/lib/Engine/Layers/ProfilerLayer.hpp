@@ -3,6 +3,8 @@
 #include "ISingleton.hpp"
 #include <uniengine_export.h>
 #include "ILayer.hpp"
+#include "MemoryStats.hpp"
+#include "TraceRecorder.hpp"
 namespace UniEngine
 {
 class UNIENGINE_API IProfiler
@@ -12,31 +14,146 @@ class UNIENGINE_API IProfiler
     std::string m_name;
     virtual void PreUpdate() = 0;
     virtual void LateUpdate() = 0;
-    virtual void StartEvent(const std::string &name) = 0;
-    virtual void EndEvent(const std::string &name) = 0;
+    // Scopes registered with TraceRecorder.
+    virtual void StartEvent(const uint32_t &scope) = 0;
+    virtual void EndEvent(const uint32_t &scope) = 0;
     virtual void OnInspect() = 0;
 };
 struct CPUUsageEvent
 {
-    std::string m_name = "";
+    // Scope registered with TraceRecorder, the name is only looked up for display.
+    uint32_t m_scope = 0;
     double m_timeStart = 0;
     double m_timeEnd = 0;
     std::vector<CPUUsageEvent> m_children;
     CPUUsageEvent *m_parent;
-    CPUUsageEvent(CPUUsageEvent *parent, const std::string &name);
+    CPUUsageEvent(CPUUsageEvent *parent, const uint32_t &scope);
     void OnInspect(const float &parentTotalTime) const;
 };
 
+/**
+ * Durations of an event over the frame history, in milliseconds.
+ */
+struct UNIENGINE_API CPUEventStatistics
+{
+    // Path of the event in the frame tree, such as "Main Loop/Update".
+    std::string m_name;
+    size_t m_samples = 0;
+    float m_min = 0;
+    float m_average = 0;
+    float m_p50 = 0;
+    float m_p95 = 0;
+    float m_p99 = 0;
+    float m_max = 0;
+};
+
+/**
+ * History of one path of events in the frame tree, such as "Main Loop/Update".
+ */
+struct UNIENGINE_API CPUEventHistory
+{
+    uint32_t m_scope = 0;
+    // Index of the parent path in CPUTimeProfiler, SIZE_MAX for the root.
+    size_t m_parent = SIZE_MAX;
+    // Milliseconds per frame, an event that runs several times in a frame is summed.
+    std::deque<float> m_frameTimes;
+    float m_currentFrameTime = 0;
+    // Frame the path last ran in.
+    size_t m_lastFrame = 0;
+};
+
 class UNIENGINE_API CPUTimeProfiler : public IProfiler
 {
-    CPUUsageEvent m_rootEvent = CPUUsageEvent(nullptr, "Main Loop");
+    CPUUsageEvent m_rootEvent = CPUUsageEvent(nullptr, TraceRecorder::RegisterScope("Main Loop"));
     CPUUsageEvent *m_currentEventPointer = &m_rootEvent;
+    // Paths are found by their parent path and scope, the root is the first. Paths are kept once seen, only their
+    // frame times are released when they stop running.
+    std::vector<CPUEventHistory> m_history;
+    std::unordered_map<uint64_t, size_t> m_historyIndices;
+    // Path of every open event.
+    std::vector<size_t> m_historyStack;
+    size_t m_frameAmount = 0;
+    CPUUsageEvent m_spikeEvent = CPUUsageEvent(nullptr, m_rootEvent.m_scope);
+    bool m_hasSpike = false;
+    size_t m_spikeFrame = 0;
     friend class ProfilerLayer;
+    size_t GetHistoryIndex(const size_t &parent, const uint32_t &scope);
+    [[nodiscard]] std::string GetHistoryPath(const size_t &index) const;
 
   protected:
     void PreUpdate() override;
-    void StartEvent(const std::string &name) override;
-    void EndEvent(const std::string &name) override;
+    void StartEvent(const uint32_t &scope) override;
+    void EndEvent(const uint32_t &scope) override;
+    void LateUpdate() override;
+    void OnInspect() override;
+
+  public:
+    /**
+     * Amount of frames every event keeps in its history. The history of an event that has not run for as many frames
+     * is released.
+     */
+    size_t m_historySize = 600;
+    /**
+     * Frames longer than this, in milliseconds, are captured as a spike and their event tree is kept until a longer
+     * spike is recorded or the history is cleared. 0 disables the capture.
+     */
+    float m_spikeThreshold = 33.3f;
+    [[nodiscard]] std::vector<CPUEventStatistics> GetStatistics() const;
+    void ClearHistory();
+    /**
+     * Write the statistics of every event as CSV, one event per line.
+     */
+    bool ExportCsv(const std::filesystem::path &path) const;
+    /**
+     * Write the statistics of every event and the frame times of the history as JSON.
+     */
+    bool ExportJson(const std::filesystem::path &path) const;
+};
+
+/**
+ * Per frame counters, shown as "value / total". Values are cleared at the start of every recorded frame.
+ */
+class UNIENGINE_API CounterProfiler : public IProfiler
+{
+    std::map<std::string, std::pair<size_t, size_t>> m_counters;
+    friend class ProfilerLayer;
+
+  protected:
+    void PreUpdate() override;
+    void StartEvent(const uint32_t &scope) override;
+    void EndEvent(const uint32_t &scope) override;
+    void LateUpdate() override;
+    void OnInspect() override;
+
+  public:
+    void SetCounter(const std::string &name, const size_t &value, const size_t &total);
+};
+/**
+ * Feeds the events into TraceRecorder, which also receives the scopes of worker threads, and exports the recorded
+ * frames as a Chrome trace.
+ */
+class UNIENGINE_API TraceProfiler : public IProfiler
+{
+    friend class ProfilerLayer;
+
+  protected:
+    void PreUpdate() override;
+    void StartEvent(const uint32_t &scope) override;
+    void EndEvent(const uint32_t &scope) override;
+    void LateUpdate() override;
+    void OnInspect() override;
+};
+/**
+ * Memory of every subsystem as measured by MemoryStats, with editable budgets.
+ */
+class UNIENGINE_API MemoryProfiler : public IProfiler
+{
+    friend class ProfilerLayer;
+
+  protected:
+    void PreUpdate() override;
+    void StartEvent(const uint32_t &scope) override;
+    void EndEvent(const uint32_t &scope) override;
     void LateUpdate() override;
     void OnInspect() override;
 };
@@ -44,16 +161,36 @@ class UNIENGINE_API ProfilerLayer : public ILayer
 {
     std::map<size_t, std::shared_ptr<IProfiler>> m_profilers;
     bool m_record = false;
+    std::thread::id m_mainThread;
+    size_t m_frameCount = 0;
     void PreUpdate() override;
     void LateUpdate() override;
     void OnInspect() override;
     void OnCreate() override;
   public:
     bool m_gui = false;
+    /**
+     * MemoryStats::Collect runs every this many frames, whether or not the profiler records. 0 only collects on demand
+     * from the memory profiler.
+     */
+    size_t m_memoryCollectInterval = 0;
     template <class T = IProfiler> std::shared_ptr<T> GetOrCreateProfiler(const std::string &name);
     template <class T = IProfiler> std::shared_ptr<T> GetProfiler();
+    /**
+     * Events from other threads than the main thread are only recorded by the TraceProfiler. The scope is registered
+     * with TraceRecorder, call sites with a fixed name cache it with UNIENGINE_PROFILE_EVENT.
+     */
+    static void StartEvent(const uint32_t &scope);
+    static void EndEvent(const uint32_t &scope);
+    /**
+     * Register the name with TraceRecorder on every call, for names that are not known ahead.
+     */
     static void StartEvent(const std::string &name);
     static void EndEvent(const std::string &name);
+    /**
+     * Main thread only.
+     */
+    static void SetCounter(const std::string &name, const size_t &value, const size_t &total);
 
 };
 template <class T> std::shared_ptr<T> UniEngine::ProfilerLayer::GetProfiler()
@@ -75,4 +212,14 @@ template <class T> std::shared_ptr<T> UniEngine::ProfilerLayer::GetOrCreateProfi
 }
 
 
-} // namespace UniEngine
\ No newline at end of file
+} // namespace UniEngine
+
+/**
+ * Scope of the event named name for ProfilerLayer::StartEvent and EndEvent, registered the first time the call site
+ * runs.
+ */
+#define UNIENGINE_PROFILE_EVENT(name)                                                                                  \
+    ([]() {                                                                                                            \
+        static const uint32_t scope = UniEngine::TraceRecorder::RegisterScope(name);                                   \
+        return scope;                                                                                                  \
+    }())
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <Camera.hpp>
+#include <BoundingVolumeHierarchy.hpp>
+#include <Culling.hpp>
+#include <RenderSort.hpp>
 #include <DefaultResources.hpp>
 #include <Lights.hpp>
 #include <MeshRenderer.hpp>
@@ -68,26 +71,75 @@ namespace UniEngine {
 		SkinnedMesh,
 		Strands
 	};
+	/**
+	 * Passes in submission order, stored in the top bits of RenderCommand::m_sortKey.
+	 */
+	enum class RenderCommandPass : unsigned {
+		Deferred,
+		DeferredInstanced,
+		Forward,
+		ForwardInstanced,
+		Transparent,
+		InstancedTransparent,
+		Count
+	};
+
+	/**
+	 * Trivially copyable draw of one geometry. Geometry, material and matrices are indices into the RenderResources of
+	 * the frame, so copying, sorting and discarding commands never touches a reference count.
+	 */
 	struct RenderCommand {
+		static constexpr unsigned NoResource = UINT_MAX;
 		RenderCommandType m_commandType = RenderCommandType::None;
 		RenderGeometryType m_geometryType = RenderGeometryType::None;
-		Entity m_owner = Entity();
-		std::shared_ptr<RenderGeometry> m_renderGeometry;
 		bool m_castShadow = true;
 		bool m_receiveShadow = true;
-		std::shared_ptr<ParticleMatrices> m_matrices;
-		std::shared_ptr<BoneMatrices> m_boneMatrices; // We require the skinned mesh renderer to provide bones.
+		Entity m_owner = Entity();
+		unsigned m_geometryIndex = NoResource;
+		unsigned m_materialIndex = NoResource;
+		// Particle matrices for instanced commands, bone matrices for skinned meshes.
+		unsigned m_matricesIndex = NoResource;
+		// See RenderSort. The pass is in the top bits.
+		uint64_t m_sortKey = 0;
+		// Bit i is set when the camera in slot i draws the command.
+		uint64_t m_cameraMask = 0;
+		// World space center of the bound, used to sort transparent commands by depth.
+		glm::vec3 m_center = glm::vec3(0.0f);
 		GlobalTransform m_globalTransform;
+		[[nodiscard]] RenderCommandPass GetPass() const;
 	};
 
-	struct RenderCommandGroup {
-		std::shared_ptr<Material> m_material;
-		std::unordered_map<Handle, std::vector<RenderCommand>> m_renderCommands;
+	/**
+	 * Run of non-instanced mesh commands in the sorted command list that share mesh and material and are drawn as one
+	 * instanced draw. Commands in the range that are not drawn by the pass the batch was built for are not members.
+	 * The world matrices of the members are at m_firstInstance in the instance buffer of the frame.
+	 */
+	struct RenderInstanceBatch {
+		unsigned m_begin = 0;
+		unsigned m_end = 0;
+		unsigned m_firstInstance = 0;
+		unsigned m_instanceCount = 0;
 	};
 
-	struct RenderInstances {
-		std::shared_ptr<Camera> m_camera;
-		std::unordered_map<Handle, RenderCommandGroup> m_renderCommandsGroups;
+	/**
+	 * Frame-local tables of everything RenderCommand refers to. Each resource is added once per frame no matter how many
+	 * commands use it, and the tables are cleared when the frame starts.
+	 */
+	struct RenderResources {
+		std::vector<std::shared_ptr<RenderGeometry>> m_geometries;
+		std::vector<std::shared_ptr<Material>> m_materials;
+		std::vector<std::shared_ptr<ParticleMatrices>> m_particleMatrices;
+		std::vector<std::shared_ptr<BoneMatrices>> m_boneMatrices;
+		// Table index of every resource, one map per table so two resources of different types can never collide.
+		std::unordered_map<const RenderGeometry*, unsigned> m_geometryIndices;
+		std::unordered_map<const Material*, unsigned> m_materialIndices;
+		std::unordered_map<const ParticleMatrices*, unsigned> m_particleMatricesIndices;
+		std::unordered_map<const BoneMatrices*, unsigned> m_boneMatricesIndices;
+		void Clear();
+		unsigned Add(const std::shared_ptr<RenderGeometry>& geometry);
+		unsigned Add(const std::shared_ptr<Material>& material);
+		unsigned Add(const std::shared_ptr<ParticleMatrices>& matrices);
+		unsigned Add(const std::shared_ptr<BoneMatrices>& matrices);
 	};
 
 	class UNIENGINE_API RenderLayer : public ILayer {
@@ -101,6 +153,11 @@ namespace UniEngine {
 		int m_mainCameraResolutionY = 1;
 		bool m_allowAutoResize = true;
 		float m_mainCameraResolutionMultiplier = 1.0f;
+		/**
+		 * Bounds of every renderer with a reliable world bound in the active scene, refreshed each frame during
+		 * render command collection. Particles and ragdolls are not included.
+		 */
+		[[nodiscard]] const BoundingVolumeHierarchy& GetSceneBvh() const;
 	private:
 		unsigned m_frameIndex = 0;
 #pragma region GUI
@@ -114,17 +171,182 @@ namespace UniEngine {
 		std::unique_ptr<OpenGLUtils::GLBuffer> m_instancedMatricesBuffer;
 
 
-		std::unordered_map<Handle, RenderInstances> m_deferredRenderInstances;
-		std::unordered_map<Handle, RenderInstances> m_deferredInstancedRenderInstances;
-		std::unordered_map<Handle, RenderInstances> m_forwardRenderInstances;
-		std::unordered_map<Handle, RenderInstances> m_forwardInstancedRenderInstances;
-		std::unordered_map<Handle, RenderInstances> m_transparentRenderInstances;
-		std::unordered_map<Handle, RenderInstances> m_instancedTransparentRenderInstances;
+		/**
+		 * Cameras registered for the current frame, a camera's slot is its bit in RenderCommand::m_cameraMask.
+		 */
+		static constexpr unsigned MaxCameraSlots = 64;
+		static constexpr unsigned NoCameraSlot = UINT_MAX;
+		std::vector<std::shared_ptr<Camera>> m_cameraSlots;
+		std::unordered_map<Handle, unsigned> m_cameraSlotIndices;
+		unsigned RegisterCamera(const std::shared_ptr<Camera>& camera);
+		[[nodiscard]] unsigned GetCameraSlot(const std::shared_ptr<Camera>& camera) const;
+		/**
+		 * Add a command from the Graphics API for the camera, and for the scene camera of the editor when there is one.
+		 */
+		void PushApiRenderCommand(RenderCommand renderCommand, const std::shared_ptr<Camera>& camera);
+
+		RenderResources m_renderResources;
+		/**
+		 * Every command of the frame, from renderers and from the Graphics API, once each. After collection the list is
+		 * sorted by pass, and m_passRanges holds where each pass starts and ends. Within a pass the commands of cached
+		 * static renderers come first, each part sorted by material and geometry. Commands no camera sees are kept when
+		 * they cast shadows.
+		 */
+		std::vector<RenderCommand> m_renderCommands;
+		std::pair<size_t, size_t> m_passRanges[static_cast<size_t>(RenderCommandPass::Count)];
+		// Transparent commands in back to front order for every camera slot, as indices into m_renderCommands.
+		std::vector<std::vector<unsigned>> m_transparentCommandOrders;
+		// Commands emitted by every Jobs slice, merged into m_renderCommands.
+		std::vector<std::vector<RenderCommand>> m_renderCommandBuffers;
+		std::vector<RenderCommand> m_sortedRenderCommands;
+		std::vector<RenderSortItem> m_renderSortItems;
+		std::vector<RenderSortItem> m_renderSortScratch;
+		/**
+		 * Instance batches of the deferred pass for every camera slot and of the shadow passes, built after sorting.
+		 * The matrices of every batch of the frame are uploaded to m_instanceBatchBuffer at once.
+		 */
+		std::vector<std::vector<RenderInstanceBatch>> m_cameraInstanceBatches;
+		std::vector<RenderInstanceBatch> m_shadowInstanceBatches;
+		std::vector<glm::mat4> m_instanceBatchMatrices;
+		std::unique_ptr<OpenGLUtils::GLBuffer> m_instanceBatchBuffer;
+		void BuildInstanceBatches();
+		/**
+		 * Renderer gathered by CollectRenderInstances, its world bound is at the same index in m_cullingBounds.
+		 */
+		struct RenderCandidate
+		{
+			RenderCommand m_command;
+			std::shared_ptr<Material> m_material;
+			std::shared_ptr<RenderGeometry> m_geometry;
+			bool m_forwardRendering = false;
+			bool m_instanced = false;
+			// Set for renderers whose bound can not be trusted, they are drawn for every camera.
+			bool m_alwaysVisible = false;
+			// Cached static renderers index m_staticRenderResources instead of the resources of the frame.
+			bool m_static = false;
+			RenderCommandPass m_pass = RenderCommandPass::Deferred;
+			float m_radius = 0.0f;
+			std::shared_ptr<MeshRenderer> m_meshRenderer;
+			std::shared_ptr<MeshLodChain> m_lodChain;
+			// Cameras that see the candidate. With a LOD chain, one geometry and one mask per level instead.
+			uint64_t m_cameraMask = 0;
+			std::vector<unsigned> m_lodGeometryIndices;
+			std::vector<uint64_t> m_lodCameraMasks;
+		};
+		/**
+		 * Everything a cached static mesh renderer was built from, the entry is rebuilt when any of it changes.
+		 */
+		struct StaticRenderState
+		{
+			uint64_t m_mesh = 0;
+			uint64_t m_material = 0;
+			uint64_t m_lodChain = 0;
+			// Kept so a chain without levels, which the candidate does not hold, is still watched for new levels.
+			std::shared_ptr<MeshLodChain> m_lodChainAsset;
+			size_t m_meshVersion = 0;
+			unsigned m_materialVersion = 0;
+			size_t m_lodChainVersion = 0;
+			bool m_castShadow = true;
+			bool m_receiveShadow = true;
+			bool m_forwardRendering = false;
+			bool m_blending = false;
+			glm::mat4 m_globalTransform = glm::mat4(1.0f);
+		};
+		/**
+		 * Every candidate of the frame. The first m_staticCandidateCount are mesh renderers of static entities, kept
+		 * with their bounds in m_cullingBounds between frames and only rebuilt when they change.
+		 */
+		std::vector<RenderCandidate> m_renderCandidates;
+		size_t m_staticCandidateCount = 0;
+		// Enabled static owners of mesh renderers the cache was built for, including the ones that could not be drawn.
+		std::vector<Entity> m_staticRendererOwners;
+		// Owner and state of every cached candidate.
+		std::vector<Entity> m_staticCandidateOwners;
+		std::vector<StaticRenderState> m_staticRenderStates;
+		// Static owners left out of the cache because their renderer has nothing to draw yet.
+		std::vector<Entity> m_pendingStaticOwners;
+		RenderResources m_staticRenderResources;
+		std::vector<unsigned> m_staticGeometryIndices;
+		std::vector<unsigned> m_staticMaterialIndices;
+		Bound m_staticWorldBound;
+		// Enabled owners of mesh renderers split into static and dynamic ones, split again when the static version of the
+		// scene differs from m_ownersVersion.
+		std::vector<Entity> m_staticOwners;
+		std::vector<Entity> m_dynamicOwners;
+		size_t m_ownersVersion = 0;
+		bool m_ownersValid = false;
+		// Versions of the meshes, materials and LOD chains in the static cache, compared each frame instead of the entries.
+		std::vector<size_t> m_staticAssetVersions;
+		std::vector<std::shared_ptr<MeshLodChain>> m_staticLodChains;
+		/**
+		 * Every draw a cached static candidate can produce, sorted by pass, material and geometry when the cache changes.
+		 * Each frame only the draws seen by a camera or casting shadows are copied out, in this order, so static commands
+		 * are never sorted again. A LOD candidate has one draw per level and one of its base mesh.
+		 */
+		struct StaticDraw
+		{
+			static constexpr unsigned BaseLevel = UINT_MAX;
+			unsigned m_candidate = 0;
+			unsigned m_level = BaseLevel;
+		};
+		std::vector<StaticDraw> m_staticDraws;
+		std::vector<RenderCommand> m_staticRenderCommands;
+		// Level of the shadow casting draw for every static candidate with a LOD chain, for the current frame.
+		std::vector<unsigned> m_staticCasterLevels;
+		void CaptureStaticAssetVersions(std::vector<size_t>& versions) const;
+		void SortStaticDraws();
+		bool GatherMeshRenderer(
+			const std::shared_ptr<Scene>& scene, const Entity& owner, RenderCandidate& candidate, Bound& bound);
+		void PrepareRenderCandidate(RenderCandidate& candidate, const Bound& bound, RenderResources& resources);
+		[[nodiscard]] static StaticRenderState CaptureStaticRenderState(const RenderCandidate& candidate);
+		[[nodiscard]] static bool IsStaticRenderStateValid(
+			const StaticRenderState& state, const RenderCandidate& candidate, const GlobalTransform& globalTransform);
+		void ClearStaticRenderCache();
+		void RebuildStaticRenderCache(const std::shared_ptr<Scene>& scene);
+		/**
+		 * Bring the cache up to date with the scene, returns true when any entry was rebuilt. Entries are only compared
+		 * with the scene when sceneChanged is set or the version of a cached asset changed.
+		 */
+		bool UpdateStaticRenderCache(
+			const std::shared_ptr<Scene>& scene, const std::vector<Entity>& staticOwners, const bool& sceneChanged);
+		PackedBounds m_cullingBounds;
+		std::vector<unsigned char> m_cullingVisibility;
+		BoundingVolumeHierarchy m_sceneBvh;
+		uint64_t m_sceneBvhHandle = 0;
+		// Entity index -> the last point or spot light shadow pass the entity was found in by m_sceneBvh.
+		std::vector<unsigned> m_lightCasterStamps;
+		unsigned m_lightCasterStamp = 0;
+		bool m_filterLightCasters = false;
+		void SetLightCasters(const std::vector<Entity>& casters);
+		[[nodiscard]] bool IsLightCaster(const RenderCommand& renderCommand) const;
+		OcclusionBuffer m_occlusionBuffer;
+		// Entries of m_cullingBounds used as occluders by the current camera.
+		std::vector<size_t> m_occluderIndices;
 #pragma region Settings
 		RenderingSettingsBlock m_renderSettings;
 		bool m_stableFit = true;
 		float m_maxShadowDistance = 300;
 		float m_shadowCascadeSplit[DefaultResources::ShaderIncludes::ShadowCascadeAmount] = { 0.075f, 0.15f, 0.3f, 1.0f };
+		/**
+		 * Hide renderers that are in view but behind large opaque meshes, tested on the CPU against a small depth buffer.
+		 */
+		bool m_occlusionCulling = true;
+		// Mesh renderers covering at least this fraction of the screen height are picked as occluders.
+		float m_occluderScreenSize = 0.25f;
+		// Meshes with more triangles are only used as occluders when MeshRenderer::m_occluder is set.
+		int m_occluderMaxTriangles = 2048;
+		int m_maxOccluders = 32;
+		int m_occlusionBufferWidth = 256;
+		/**
+		 * Merge mesh renderers with the same mesh, material and shadow flags into instanced draws.
+		 */
+		bool m_dynamicInstancing = true;
+		// Shorter runs are drawn one by one.
+		int m_minInstanceBatchSize = 4;
+		/**
+		 * Keep the mesh renderers of static entities between frames instead of gathering them every frame.
+		 */
+		bool m_staticRenderCache = true;
 
 		void SetSplitRatio(const float& r1, const float& r2, const float& r3, const float& r4);
 
@@ -147,11 +369,31 @@ namespace UniEngine {
 		size_t Triangles();
 
 		size_t DrawCall();
-
+		/**
+		 * Draw calls saved by dynamic instancing since the frame started, DrawCall() plus this is the amount without it.
+		 */
+		size_t MergedDrawCall();
+
+		/**
+		 * Call func for every command of the pass the camera in the slot draws, in submission order. When batchFunc is
+		 * set, instance batches of the camera are passed to it with their first command instead.
+		 */
 		void DispatchRenderCommands(
-			const RenderInstances& renderCommands,
+			const RenderCommandPass& pass,
+			const unsigned& cameraSlot,
 			const std::function<void(const std::shared_ptr<Material>&, const RenderCommand& renderCommand)>& func,
-			const bool& setMaterial);
+			const bool& setMaterial,
+			const std::function<void(
+				const std::shared_ptr<Material>&, const RenderCommand& renderCommand, const RenderInstanceBatch& batch)>&
+				batchFunc = nullptr);
+		/**
+		 * Geometry of the command as T. T must match RenderCommand::m_geometryType, the cast is not checked in release
+		 * builds.
+		 */
+		template <typename T>
+		[[nodiscard]] std::shared_ptr<T> GetGeometry(const RenderCommand& renderCommand) const;
+		[[nodiscard]] const std::shared_ptr<ParticleMatrices>& GetParticleMatrices(const RenderCommand& renderCommand) const;
+		[[nodiscard]] const std::shared_ptr<BoneMatrices>& GetBoneMatrices(const RenderCommand& renderCommand) const;
 
 		void OnCreate() override;
 
@@ -180,6 +422,7 @@ namespace UniEngine {
 		size_t m_triangles = 0;
 		size_t m_strandsSegments = 0;
 		size_t m_drawCall = 0;
+		size_t m_mergedDrawCall = 0;
 		std::unique_ptr<OpenGLUtils::GLBuffer> m_materialSettingsBuffer;
 		std::unique_ptr<OpenGLUtils::GLBuffer> m_environmentalMapSettingsBuffer;
 #pragma endregion
@@ -240,6 +483,7 @@ namespace UniEngine {
 
 		void DeferredPrepassInstancedInternal(
 			const std::shared_ptr<Mesh>& mesh, const std::shared_ptr<ParticleMatrices>& matrices);
+		void DeferredPrepassInstancedInternal(const std::shared_ptr<Mesh>& mesh, const RenderInstanceBatch& batch);
 
 		void DeferredPrepassInternal(const std::shared_ptr<SkinnedMesh>& skinnedMesh);
 		void DeferredPrepassInternal(const std::shared_ptr<Strands>& strands);
@@ -274,5 +518,13 @@ namespace UniEngine {
 		float Lerp(const float& a, const float& b, const float& f);
 	};
 
+	template <typename T>
+	std::shared_ptr<T> RenderLayer::GetGeometry(const RenderCommand& renderCommand) const
+	{
+		const auto& geometry = m_renderResources.m_geometries[renderCommand.m_geometryIndex];
+		assert(std::dynamic_pointer_cast<T>(geometry));
+		return std::static_pointer_cast<T>(geometry);
+	}
+
 
 }
\ No newline at end of file
@@ -82,20 +82,190 @@ struct UNIENGINE_API Bone
     void Deserialize(const YAML::Node &in);
 };
 
+#pragma endregion
+#pragma region Baked
+/**
+ * Key frames of one clip for every bone. The keys of the bone at order position i are [m_positionBegin[i],
+ * m_positionBegin[i + 1]) in the position arrays, and likewise for rotations and scales.
+ */
+struct UNIENGINE_API BakedAnimationClip
+{
+    std::string m_name;
+    float m_length = 0.0f;
+    std::vector<uint32_t> m_positionBegin;
+    std::vector<float> m_positionTimes;
+    std::vector<glm::vec3> m_positions;
+    std::vector<uint32_t> m_rotationBegin;
+    std::vector<float> m_rotationTimes;
+    std::vector<glm::quat> m_rotations;
+    std::vector<uint32_t> m_scaleBegin;
+    std::vector<float> m_scaleTimes;
+    std::vector<glm::vec3> m_scales;
+    /**
+     * Set when the animation is quantized. The value arrays above are then empty and the keys are read from the
+     * quantized arrays instead: positions and scales as 16 bits per component relative to the range of their track,
+     * given per order position, and rotations as the smallest three components of the quaternion.
+     */
+    bool m_quantized = false;
+    std::vector<glm::vec3> m_positionMin;
+    std::vector<glm::vec3> m_positionExtent;
+    std::vector<glm::u16vec3> m_quantizedPositions;
+    std::vector<glm::u16vec3> m_quantizedRotations;
+    std::vector<glm::vec3> m_scaleMin;
+    std::vector<glm::vec3> m_scaleExtent;
+    std::vector<glm::u16vec3> m_quantizedScales;
+};
+
+/**
+ * The bone tree of an Animation flattened in topological order, parents always come before their children.
+ */
+struct UNIENGINE_API BakedAnimation
+{
+    // Bone::m_index of the bone at every order position.
+    std::vector<uint32_t> m_boneIndices;
+    // Bone::m_index of the parent of the bone at every order position, -1 for the root.
+    std::vector<int> m_parentIndices;
+    std::vector<BakedAnimationClip> m_clips;
+    [[nodiscard]] size_t GetMemoryUsage() const;
+};
+
+/**
+ * Last key used by every bone of an animator. Playback mostly stays on or moves to the next key, so the search starts
+ * there and only falls back to a binary search on jumps.
+ */
+struct UNIENGINE_API AnimationCursor
+{
+    int m_clipIndex = -1;
+    std::vector<uint32_t> m_positionKeys;
+    std::vector<uint32_t> m_rotationKeys;
+    std::vector<uint32_t> m_scaleKeys;
+};
+
+/**
+ * Local transforms of every bone in the order of BakedAnimation, as separate streams.
+ */
+struct UNIENGINE_API AnimationPose
+{
+    std::vector<glm::vec3> m_positions;
+    std::vector<glm::quat> m_rotations;
+    std::vector<glm::vec3> m_scales;
+    void Resize(const size_t &boneAmount);
+    /**
+     * Set every bone to the identity transform.
+     */
+    void SetIdentity();
+};
+#pragma endregion
+#pragma region Compression
+struct UNIENGINE_API AnimationCompressionSettings
+{
+    // Whether models compress their animations on import, Animation::Compress ignores it.
+    bool m_enabled = false;
+    /**
+     * Largest distance between a removed position key and the interpolation of the kept keys, in model units.
+     */
+    float m_positionError = 0.001f;
+    /**
+     * Largest angle between a removed rotation key and the interpolation of the kept keys, in degrees.
+     */
+    float m_angularError = 0.05f;
+    float m_scaleError = 0.001f;
+    /**
+     * Bake the keys quantized. The quantization error is taken from the tolerances above.
+     */
+    bool m_quantize = false;
+};
+
+struct UNIENGINE_API AnimationClipCompressionReport
+{
+    std::string m_name;
+    size_t m_keysBefore = 0;
+    size_t m_keysAfter = 0;
+    size_t m_bytesBefore = 0;
+    // Size of the keys as they are kept, the quantized clip for quantized animations.
+    size_t m_bytesAfter = 0;
+    // Largest error measured at the time of every original key, in the local space of its bone.
+    float m_maxPositionError = 0.0f;
+    float m_maxAngularError = 0.0f;
+    float m_maxScaleError = 0.0f;
+    [[nodiscard]] float GetRatio() const;
+};
 #pragma endregion
 class UNIENGINE_API Animation : public IAsset
 {
+    /**
+     * The keys of a quantized animation only exist in the quantized baked clips, in memory and when saved. The bones
+     * keep the hierarchy without keys.
+     */
+    bool m_quantized = false;
+    std::vector<AnimationClipCompressionReport> m_compressionReports;
+    BakedAnimation m_baked;
+    std::atomic<bool> m_bakeDirty{true};
+    std::mutex m_bakeMutex;
+    void BakeInternal();
+    // Decode the baked keys back into the bones and drop the quantization.
+    void UnpackBakedKeys();
+
   public:
     std::map<std::string, float> m_animationNameAndLength;
     std::shared_ptr<Bone> m_rootBone;
     size_t m_boneSize = 0;
     [[nodiscard]] std::shared_ptr<Bone> &UnsafeGetRootBone();
     void OnInspect() override;
+    /**
+     * Evaluates the clip through the baked representation.
+     */
     void Animate(
         const std::string &name,
         const float &animationTime,
         const glm::mat4 &rootTransform,
         std::vector<glm::mat4> &results);
+    /**
+     * Flatten the bone tree and the clips into the baked representation. Baking happens on first use, call this
+     * again after editing the bones or the clips. Does nothing for a quantized animation, whose bones hold no keys.
+     */
+    void Bake();
+    /**
+     * The baked representation, baked first if needed. Safe to call from several threads.
+     */
+    [[nodiscard]] const BakedAnimation &GetBaked();
+    /**
+     * @return Index of the clip in the baked representation, -1 if there is no such clip.
+     */
+    [[nodiscard]] int GetClipIndex(const std::string &name);
+    /**
+     * Evaluate the pose of a baked clip iteratively, writing the global transform of every bone to results at its
+     * Bone::m_index. The cursor carries the key positions of an animator between frames, without one every key is
+     * found by binary search.
+     */
+    void Animate(
+        const int &clipIndex,
+        const float &animationTime,
+        const glm::mat4 &rootTransform,
+        std::vector<glm::mat4> &results,
+        AnimationCursor *cursor = nullptr);
+    /**
+     * Sample the local transform of every bone of a baked clip into pose, which is resized to the amount of bones.
+     */
+    void SamplePose(
+        const int &clipIndex, const float &animationTime, AnimationPose &pose, AnimationCursor *cursor = nullptr);
+    /**
+     * Concatenate the local transforms of pose down the hierarchy, writing the global transform of every bone to
+     * results at its Bone::m_index.
+     */
+    void ComposePose(const AnimationPose &pose, const glm::mat4 &rootTransform, std::vector<glm::mat4> &results);
+    /**
+     * Remove the keys that the interpolation of their neighbours recovers within the tolerances of the settings, and
+     * quantize the baked keys if requested. The reduced keys replace the keys of the bones, or with quantization the
+     * quantized clips replace them. A quantized animation is decoded first, so it can be compressed again.
+     * @return Sizes and measured errors of every clip.
+     */
+    std::vector<AnimationClipCompressionReport> Compress(const AnimationCompressionSettings &settings);
+    [[nodiscard]] bool IsQuantized() const;
+    /**
+     * Reports of the last Compress call.
+     */
+    [[nodiscard]] const std::vector<AnimationClipCompressionReport> &PeekCompressionReports() const;
 
     void Serialize(YAML::Emitter &out) override;
     void Deserialize(const YAML::Node &in) override;
@@ -0,0 +1,119 @@
+#pragma once
+#include <Animation.hpp>
+#include <uniengine_export.h>
+namespace UniEngine
+{
+enum class UNIENGINE_API AnimationGraphNodeType
+{
+    Clip,
+    Blend
+};
+
+struct UNIENGINE_API AnimationGraphNode
+{
+    AnimationGraphNodeType m_type = AnimationGraphNodeType::Clip;
+    std::string m_clipName;
+    float m_speed = 1.0f;
+    bool m_loop = true;
+    // Inputs of a blend node, always earlier nodes. The weights are normalized during evaluation.
+    std::vector<int> m_inputs;
+    std::vector<float> m_weights;
+};
+
+struct UNIENGINE_API AnimationGraphState
+{
+    std::string m_name;
+    int m_node = -1;
+};
+
+struct UNIENGINE_API AnimationGraphLayer
+{
+    std::string m_name;
+    float m_weight = 1.0f;
+    // Additive layers add the difference of their pose to the first frame of its clips on top of the layers below.
+    bool m_additive = false;
+    // Weight per Bone::m_index, empty applies the layer to every bone.
+    std::vector<float> m_boneMask;
+    std::vector<AnimationGraphState> m_states;
+    int m_currentState = -1;
+    float m_currentTime = 0.0f;
+    // State faded out by the running transition, -1 when there is none.
+    int m_previousState = -1;
+    float m_previousTime = 0.0f;
+    float m_transitionTime = 0.0f;
+    float m_transitionDuration = 0.0f;
+};
+
+/**
+ * Clip and blend nodes played by layered state machines. Every layer plays one state, the layers are applied from the
+ * first to the last: override layers blend the pose toward their own by their weight and bone mask, additive layers add
+ * to it. CrossFade blends the previous state of a layer out over the transition duration.
+ *
+ * Times are in the units of the clip lengths in Animation::m_animationNameAndLength. Poses are evaluated into buffers
+ * pooled per thread, so graphs of different animators can be evaluated in parallel.
+ */
+class UNIENGINE_API AnimationGraph
+{
+    std::vector<AnimationGraphNode> m_nodes;
+    std::vector<AnimationGraphLayer> m_layers;
+    // One per node, nodes are evaluated at most once per pose in the common case.
+    std::vector<AnimationCursor> m_cursors;
+    // One per node for the reference poses of additive layers, which are always sampled at the start of the clips.
+    std::vector<AnimationCursor> m_referenceCursors;
+    void EvaluateNode(
+        Animation &animation,
+        const int &node,
+        const float &time,
+        AnimationPose &pose,
+        std::vector<AnimationCursor> &cursors);
+    void EvaluateState(
+        Animation &animation,
+        const AnimationGraphLayer &layer,
+        const int &state,
+        const float &time,
+        AnimationPose &pose,
+        std::vector<AnimationCursor> &cursors);
+
+  public:
+    int AddClipNode(const std::string &clipName, const float &speed = 1.0f, const bool &loop = true);
+    int AddBlendNode(const std::vector<int> &inputs, const std::vector<float> &weights);
+    void SetBlendWeights(const int &node, const std::vector<float> &weights);
+    int AddLayer(const std::string &name, const float &weight = 1.0f, const bool &additive = false);
+    void SetLayerWeight(const int &layer, const float &weight);
+    void SetBoneMask(const int &layer, const std::vector<float> &boneMask);
+    /**
+     * Mask with a weight of 1 for the named bone and its descendants and 0 for every other bone.
+     */
+    [[nodiscard]] static std::vector<float> CreateBoneMask(
+        const std::shared_ptr<Animation> &animation, const std::string &boneName);
+    int AddState(const int &layer, const std::string &name, const int &node);
+    /**
+     * Switch the layer to a state immediately.
+     */
+    bool Play(const int &layer, const std::string &state);
+    /**
+     * Switch the layer to a state, blending the current state out over duration.
+     */
+    bool CrossFade(const int &layer, const std::string &state, const float &duration);
+    [[nodiscard]] bool Empty() const;
+    [[nodiscard]] const std::vector<AnimationGraphNode> &PeekNodes() const;
+    [[nodiscard]] const std::vector<AnimationGraphLayer> &PeekLayers() const;
+    /**
+     * Advance the states and the transitions of every layer.
+     */
+    void Update(const float &deltaTime);
+    /**
+     * Evaluate the layers into the local transform of every baked bone.
+     */
+    void EvaluatePose(Animation &animation, AnimationPose &pose);
+    /**
+     * Evaluate the layers into the global transform of every bone, written to results at its Bone::m_index.
+     */
+    void Evaluate(Animation &animation, const glm::mat4 &rootTransform, std::vector<glm::mat4> &results);
+    /**
+     * Blend every bone of target toward source by weight, rotations along the shorter arc. Both poses have the same
+     * size.
+     */
+    static void Blend(AnimationPose &target, const AnimationPose &source, const float &weight);
+};
+} // namespace UniEngine
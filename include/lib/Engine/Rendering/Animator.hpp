@@ -1,5 +1,6 @@
 #pragma once
 #include <Animation.hpp>
+#include <AnimationGraph.hpp>
 #include <Core/OpenGLUtils.hpp>
 #include <Scene.hpp>
 #include <Transform.hpp>
@@ -11,6 +12,7 @@ class UNIENGINE_API Animator : public IPrivateComponent
     std::vector<std::shared_ptr<Bone>> m_bones;
     friend class SkinnedMeshRenderer;
     friend class AnimationLayer;
+    friend class BonePalette;
 
     std::vector<glm::mat4> m_transformChain;
     std::vector<glm::mat4> m_offsetMatrices;
@@ -23,11 +25,44 @@ class UNIENGINE_API Animator : public IPrivateComponent
     void Setup();
     std::string m_currentActivatedAnimation;
     float m_currentAnimationTime;
+    AnimationCursor m_cursor;
+    /**
+     * Set the animation up and fall back to its first clip when the current one is missing.
+     * @return The animation, or nullptr when there is nothing to evaluate.
+     */
+    std::shared_ptr<Animation> PrepareApply();
     void Apply();
     void AutoPlay();
+
+#pragma region Update rate LOD
+    // Chosen by AnimationLayer every frame.
+    unsigned m_lodInterval = 1;
+    bool m_lodVisible = true;
+    // World space bound of the renderers skinned by the animator this frame.
+    Bound m_lodBound;
+    bool m_lodHasBound = false;
+    unsigned m_lodFrame = 0;
+    // Local poses, the pose shown is blended from the previous to the target evaluation over the interval.
+    AnimationPose m_lodPose;
+    AnimationPose m_lodPreviousPose;
+    AnimationPose m_lodTargetPose;
+    bool m_lodHasPose = false;
+    bool m_lodBlending = false;
+    void ComposeLodPose(const std::shared_ptr<Animation> &animation);
+    /**
+     * Evaluate the animation at the rate selected for this frame.
+     * @return True when the animation was evaluated, not only interpolated.
+     */
+    bool ApplyAtRate();
+#pragma endregion
   public:
     [[nodiscard]] bool AnimatedCurrentFrame() const;
     bool m_needAnimate = true;
+    /**
+     * When the graph has layers it drives the animator instead of the current animation. AnimationLayer advances it
+     * every frame while playing, or in the editor with auto play. The graph is built at runtime and not serialized.
+     */
+    AnimationGraph m_graph;
     /**
      * Only set offset matrices, so the animator can be used as ragDoll.
      * @param name Name of the bones
@@ -38,6 +73,24 @@ class UNIENGINE_API Animator : public IPrivateComponent
     void SetAutoPlay(bool value);
     glm::mat4 GetReverseTransform(const int &index, const Entity &entity);
     bool m_autoPlay = false;
+    /**
+     * Evaluate the animator less often far from the cameras, and not at all while no camera sees its renderers.
+     */
+    bool m_updateRateLod = false;
+    /**
+     * Within this distance of a camera the animator is evaluated every frame.
+     */
+    float m_fullRateDistance = 30.0f;
+    /**
+     * Farther away the animator is evaluated every m_reducedRateInterval frames.
+     */
+    unsigned m_reducedRateInterval = 4;
+    /**
+     * Blend the local transforms of the bones from one reduced rate evaluation to the next instead of holding the pose.
+     * The pose trails the animation by one interval.
+     */
+    bool m_interpolateReducedRate = true;
+    bool m_pauseWhenInvisible = false;
     [[nodiscard]] float CurrentAnimationTime();
     [[nodiscard]] std::string CurrentAnimationName();
     void Animate(const std::string& animationName, float time);
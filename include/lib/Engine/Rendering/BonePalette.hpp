@@ -0,0 +1,56 @@
+#pragma once
+#include <Core/OpenGLUtils.hpp>
+#include <ISingleton.hpp>
+#include <Scene.hpp>
+#include <uniengine_export.h>
+namespace UniEngine
+{
+class BoneMatrices;
+/**
+ * Bone matrices of every skinned mesh renderer of the scene in one array. AnimationLayer rebuilds it every frame and
+ * uploads the changed part to a single shader storage buffer. The matrices of a renderer start at an offset aligned
+ * for binding their range to the bone block, so drawing a renderer only rebinds its range.
+ */
+class UNIENGINE_API BonePalette final : ISingleton<BonePalette>
+{
+    friend class ISingleton<BonePalette>;
+    std::vector<glm::mat4> m_matrices;
+    // Range of m_matrices written since the last upload.
+    size_t m_dirtyBegin = 0;
+    size_t m_dirtyEnd = 0;
+    std::unique_ptr<OpenGLUtils::GLBuffer> m_buffer;
+    size_t m_bufferCapacity = 0;
+    size_t m_version = 0;
+    size_t m_updatedAmount = 0;
+
+  public:
+    /**
+     * Offsets are multiples of this many matrices. 256 bytes is the largest shader storage buffer offset alignment an
+     * OpenGL implementation may require.
+     */
+    static constexpr size_t Alignment = 256 / sizeof(glm::mat4);
+    /**
+     * results[i] = a[i] * b[i] where every b[i] is affine, its last row being (0, 0, 0, 1). results may alias a.
+     */
+    static void MultiplyAffine(const glm::mat4 *a, const glm::mat4 *b, glm::mat4 *results, const size_t &amount);
+    /**
+     * Lay out the renderers owned by owners and write the matrices of those whose animator moved, whose layout
+     * changed, and of every ragdoll. Ragdolls read the global transforms of their bound entities in one pass.
+     */
+    static void Build(const std::shared_ptr<Scene> &scene, const std::vector<Entity> &owners);
+    /**
+     * Upload the matrices written since the last upload. Main thread only.
+     */
+    static void Upload();
+    /**
+     * Bind the range of the renderer to the bone block.
+     * @return False when the palette does not hold the matrices of the renderer, they have to be uploaded on their own.
+     */
+    static bool Bind(const BoneMatrices &boneMatrices);
+    [[nodiscard]] static size_t GetMatrixAmount();
+    /**
+     * Amount of renderers whose matrices were written by the last Build.
+     */
+    [[nodiscard]] static size_t GetUpdatedAmount();
+};
+} // namespace UniEngine
@@ -0,0 +1,89 @@
+#pragma once
+#include <Culling.hpp>
+
+namespace UniEngine
+{
+/**
+ * Dynamic AABB tree over entity bounds. Leaves store a fat copy of the bound, so an entity that moves inside its fat
+ * bound costs a single lookup and only entities that leave it are re-inserted. The tree is kept balanced by AVL
+ * rotations on the way up from every insertion and removal. Leaves are found through a table indexed by entity index,
+ * a leaf keeps the entity it was last updated with. Queries append to the result containers and never clear them.
+ */
+class UNIENGINE_API BoundingVolumeHierarchy
+{
+    static constexpr int NullNode = -1;
+    struct Node
+    {
+        // Fat bound for leaves, union of the children for internal nodes.
+        Bound m_bound;
+        Bound m_tightBound;
+        Entity m_entity;
+        // Next free node while the node is in the free list.
+        int m_parent = NullNode;
+        int m_children[2] = {NullNode, NullNode};
+        // 0 for leaves, -1 for free nodes.
+        int m_height = -1;
+        unsigned m_stamp = 0;
+        bool m_pinned = false;
+        [[nodiscard]] bool IsLeaf() const;
+    };
+    std::vector<Node> m_nodes;
+    // Leaf node of every entity index, NullNode when the entity is not in the tree.
+    std::vector<int> m_leaves;
+    size_t m_leafCount = 0;
+    int m_root = NullNode;
+    int m_freeList = NullNode;
+    unsigned m_stamp = 0;
+
+    int AllocateNode();
+    void FreeNode(const int &index);
+    void InsertLeaf(const int &leaf);
+    void RemoveLeaf(const int &leaf);
+    int Balance(const int &index);
+    void UpdateNode(const int &leaf, const Bound &bound);
+    [[nodiscard]] int FindLeaf(const Entity &entity) const;
+
+  public:
+    /**
+     * Absolute padding added to every fat bound, on top of 10% of the half extents.
+     */
+    float m_margin = 0.05f;
+    void Clear();
+    /**
+     * Insert the entity or move it to a new bound.
+     */
+    void Update(const Entity &entity, const Bound &bound);
+    /**
+     * Same as Update, except that an entity already updated since the last RemoveStale keeps the union of both bounds.
+     * Used when an entity is fed by several renderers.
+     */
+    void Merge(const Entity &entity, const Bound &bound);
+    void Remove(const Entity &entity);
+    /**
+     * A pinned entity is kept by RemoveStale without being updated every frame, and Merge adds to its bound instead of
+     * replacing it. Used for bounds that are cached between frames.
+     */
+    void Pin(const Entity &entity, const bool &value);
+    /**
+     * Remove every entity that was not updated since the previous call and is not pinned.
+     * @return Amount of removed entities.
+     */
+    size_t RemoveStale();
+    [[nodiscard]] bool Contains(const Entity &entity) const;
+    [[nodiscard]] bool GetBound(const Entity &entity, Bound &bound) const;
+    [[nodiscard]] size_t Size() const;
+    [[nodiscard]] int GetHeight() const;
+
+    void QueryFrustum(const Frustum &frustum, std::vector<Entity> &results) const;
+    void QueryBound(const Bound &bound, std::vector<Entity> &results) const;
+    void QuerySphere(const glm::vec3 &center, const float &radius, std::vector<Entity> &results) const;
+    /**
+     * Every entity whose bound is hit by the ray, with the distance to the entry point, sorted from near to far.
+     */
+    void QueryRay(const Ray &ray, std::vector<std::pair<float, Entity>> &results) const;
+    /**
+     * Closest entity whose bound is hit by the ray.
+     */
+    [[nodiscard]] bool RayCast(const Ray &ray, Entity &entity, float &distance) const;
+};
+} // namespace UniEngine
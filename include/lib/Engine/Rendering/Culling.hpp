@@ -0,0 +1,109 @@
+#pragma once
+#include <Utilities.hpp>
+
+namespace UniEngine
+{
+/**
+ * Six clip planes of a camera in world space, (normal, distance) with normals pointing inwards.
+ */
+struct UNIENGINE_API Frustum
+{
+    glm::vec4 m_planes[6];
+    Frustum() = default;
+    explicit Frustum(const glm::mat4 &projectionView);
+    /**
+     * Extract the planes from a projection * view matrix (Gribb and Hartmann).
+     */
+    void Set(const glm::mat4 &projectionView);
+    [[nodiscard]] bool Intersect(const Bound &bound) const;
+    [[nodiscard]] bool Intersect(const glm::vec3 &center, const float &radius) const;
+};
+
+/**
+ * World space bounds stored as center and half extent streams, so four of them can be tested against a plane with
+ * one set of SIMD instructions.
+ */
+class UNIENGINE_API PackedBounds
+{
+    std::vector<float> m_centerX;
+    std::vector<float> m_centerY;
+    std::vector<float> m_centerZ;
+    std::vector<float> m_extentX;
+    std::vector<float> m_extentY;
+    std::vector<float> m_extentZ;
+
+  public:
+    void Clear();
+    void Reserve(const size_t &size);
+    /**
+     * @return The index of the bound.
+     */
+    size_t Push(const Bound &bound);
+    void Set(const size_t &index, const Bound &bound);
+    /**
+     * Keep the first size bounds, or pad with empty bounds at the origin.
+     */
+    void Resize(const size_t &size);
+    [[nodiscard]] size_t Size() const;
+    [[nodiscard]] Bound Get(const size_t &index) const;
+    /**
+     * Test all bounds against the frustum on the Jobs workers. visibility[i] is set to 1 when bound i intersects the
+     * frustum, 0 otherwise.
+     * @return Amount of visible bounds.
+     */
+    size_t Cull(const Frustum &frustum, std::vector<unsigned char> &visibility) const;
+};
+
+/**
+ * Low resolution software depth buffer for occlusion culling. Occluder triangles are rasterized on the Jobs workers,
+ * each worker owning a band of rows, into a buffer that keeps the closest depth. A mip chain that keeps the farthest
+ * depth of every 2x2 block is then built, so a bound is tested against at most 2x2 texels of the level that matches
+ * its size on screen. Depth is the OpenGL window depth, 0 at the near plane and 1 at the far plane.
+ */
+class UNIENGINE_API OcclusionBuffer
+{
+    struct ScreenTriangle
+    {
+        // x and y in pixels, z is the depth.
+        glm::vec3 m_vertices[3];
+        glm::ivec4 m_rect;
+    };
+    unsigned m_width = 0;
+    unsigned m_height = 0;
+    glm::mat4 m_projectionView = glm::mat4(1.0f);
+    std::vector<ScreenTriangle> m_triangles;
+    std::vector<std::vector<float>> m_levels;
+    std::vector<glm::uvec2> m_levelSizes;
+    void RasterizeBand(const unsigned &rowStart, const unsigned &rowEnd);
+    void AddTriangle(const glm::vec4 &a, const glm::vec4 &b, const glm::vec4 &c);
+
+  public:
+    /**
+     * Start a new frame. The width is rounded up to a multiple of 4 for the SIMD rasterizer.
+     */
+    void Begin(const glm::mat4 &projectionView, const unsigned &width, const unsigned &height);
+    /**
+     * Clip and project the triangles of an occluder. Triangles are not culled by facing, so the winding of the
+     * occluder does not matter.
+     */
+    void AddOccluder(
+        const std::vector<glm::vec3> &positions, const std::vector<glm::uvec3> &triangles, const glm::mat4 &model);
+    /**
+     * Rasterize every added triangle and build the mip chain.
+     */
+    void Rasterize();
+    [[nodiscard]] size_t GetTriangleAmount() const;
+    [[nodiscard]] unsigned GetWidth() const;
+    [[nodiscard]] unsigned GetHeight() const;
+    [[nodiscard]] const std::vector<float> &PeekDepth() const;
+    /**
+     * False when the bound is certainly hidden behind the occluders. Bounds that cross the near plane are visible.
+     */
+    [[nodiscard]] bool IsVisible(const Bound &bound) const;
+    /**
+     * Test bound i for every visibility[i] != 0 on the Jobs workers and clear the entries of the occluded ones.
+     * @return Amount of bounds found occluded.
+     */
+    size_t Test(const PackedBounds &bounds, std::vector<unsigned char> &visibility) const;
+};
+} // namespace UniEngine
@@ -4,6 +4,7 @@
 #include "Scene.hpp"
 #include "Transform.hpp"
 #include "Vertex.hpp"
+#include "MeshUtilities.hpp"
 #include "RenderGeometry.hpp"
 namespace UniEngine
 {
@@ -17,13 +18,25 @@ namespace UniEngine
 	class UNIENGINE_API MeshStorage {
 		std::unique_ptr<OpenGLUtils::GLVAO> m_persistentMeshesVAO;
 	};
+	/**
+	 * Values read by attribute locations without a stream. One copy is stored after the streams and the reserved space
+	 * in the vertex buffer and bound with zero stride.
+	 */
+	struct UNIENGINE_API VertexAttributeDefaults
+	{
+		glm::vec3 m_normal = glm::vec3(0.0f, 1.0f, 0.0f);
+		glm::vec3 m_tangent = glm::vec3(1.0f, 0.0f, 0.0f);
+		glm::vec4 m_color = glm::vec4(1.0f);
+		glm::vec2 m_texCoord = glm::vec2(0.0f);
+		glm::ivec4 m_boneIds = glm::ivec4(0);
+		glm::vec4 m_weights = glm::vec4(0.0f);
+	};
 	class ParticleMatrices;
 	class UNIENGINE_API Mesh : public IAsset, public RenderGeometry
 	{
 		std::shared_ptr<OpenGLUtils::GLVAO> m_vao;
 		size_t m_offset = 0;
 
-		unsigned m_mask = 0;
 		Bound m_bound;
 		friend class Graphics;
 		friend class RenderLayer;
@@ -32,7 +45,7 @@ namespace UniEngine
 		friend class Editor;
 		size_t m_version = 0;
 
-		std::vector<Vertex> m_vertices;
+		VertexStreams m_vertexStreams;
 		std::vector<glm::uvec3> m_triangles;
 		unsigned m_verticesSize = 0;
 		unsigned m_triangleSize = 0;
@@ -47,6 +60,10 @@ namespace UniEngine
 		void DrawInstanced(const std::vector<glm::mat4>& matrices) const override;
 		void DrawInstanced(const std::shared_ptr<ParticleMatrices>& particleMatrices) const override;
 		void DrawInstanced(const std::vector<GlobalTransform>& matrices) const override;
+		/**
+		 * Draw count instances with the matrices starting at instance first in the buffer.
+		 */
+		void DrawInstanced(const OpenGLUtils::GLBuffer& matricesBuffer, const size_t& first, const size_t& count) const;
 
 		void OnInspect() override;
 		[[nodiscard]] glm::vec3 GetCenter() const;
@@ -55,20 +72,48 @@ namespace UniEngine
 		void Upload();
 		void SetVertices(const unsigned& mask, std::vector<Vertex>& vertices, const std::vector<unsigned>& indices);
 		void SetVertices(const unsigned& mask, const std::vector<Vertex>& vertices, const std::vector<glm::uvec3>& triangles);
+		void SetVertices(VertexStreams&& vertexStreams, const std::vector<glm::uvec3>& triangles);
 		[[nodiscard]] size_t GetVerticesAmount() const;
 		[[nodiscard]] size_t GetTriangleAmount() const;
 
 		void UnsafeSetVerticesAmount(unsigned size);
 		void UnsafeSetTrianglesAmount(unsigned size);
-		void RecalculateNormal();
+		void RecalculateNormal(const NormalWeighting& weighting = NormalWeighting::Uniform);
 		void RecalculateTangent();
+		/**
+		 * Weld duplicated vertices and reorder triangles and vertices for the post-transform cache, overdraw and vertex
+		 * fetch locality, then upload the result. Requires the CPU copy of the vertices.
+		 */
+		MeshOptimizationReport Optimize();
 		[[nodiscard]] std::shared_ptr<OpenGLUtils::GLVAO> Vao() const;
 		void Enable() const;
 		[[nodiscard]] size_t& GetVersion();
-		[[nodiscard]] std::vector<Vertex>& UnsafeGetVertices();
+		/**
+		 * Compatibility view of the vertex streams as interleaved vertices. This is a copy, edits won't affect the mesh.
+		 */
+		[[nodiscard]] std::vector<Vertex> GetVertices() const;
+		[[nodiscard]] unsigned GetMask() const;
+		[[nodiscard]] const VertexStreams& PeekVertexStreams() const;
+		[[nodiscard]] VertexStreams& UnsafeGetVertexStreams();
+		/**
+		 * Bytes of CPU memory held by the vertex streams and the triangles of this mesh.
+		 */
+		[[nodiscard]] size_t GetMemoryUsage() const;
+		[[nodiscard]] const std::vector<glm::uvec3>& PeekTriangles() const;
 		[[nodiscard]] std::vector<glm::uvec3>& UnsafeGetTriangles();
 
 		void Serialize(YAML::Emitter& out) override;
 		void Deserialize(const YAML::Node& in) override;
+
+		/**
+		 * Upload the streams into the VAO as consecutive blocks bound to locations 0 to 4, followed by reservedBytes of
+		 * space and one VertexAttributeDefaults. Returns the offset of the reserved space.
+		 */
+		static size_t UploadVertexStreams(
+			OpenGLUtils::GLVAO& vao, const VertexStreams& vertexStreams, const size_t& reservedBytes);
+		static void SerializeVertexStreams(const VertexStreams& vertexStreams, YAML::Emitter& out);
+		static void DeserializeVertexStreams(const unsigned& mask, VertexStreams& vertexStreams, const YAML::Node& in);
+		static void SerializeBoneWeightStreams(const BoneWeightStreams& boneWeightStreams, YAML::Emitter& out);
+		static void DeserializeBoneWeightStreams(BoneWeightStreams& boneWeightStreams, const YAML::Node& in);
 	};
 } // namespace UniEngine
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+#include <Mesh.hpp>
+
+namespace UniEngine
+{
+struct UNIENGINE_API MeshLodLevel
+{
+    AssetRef m_mesh;
+    /**
+     * The level is used while the projected bound of the object covers at least this fraction of the screen height.
+     */
+    float m_screenSize = 0.0f;
+};
+/**
+ * A chain of progressively simplified versions of a mesh. Level 0 is the source mesh, the simplified levels are
+ * generated with MeshUtilities::Simplify and stored inside the chain.
+ */
+class UNIENGINE_API MeshLodChain : public IAsset
+{
+    size_t m_version = 0;
+
+  public:
+    std::vector<MeshLodLevel> m_levels;
+    /**
+     * Relative margin around the screen size thresholds. The level only changes after the screen size moved past the
+     * threshold by this margin, to avoid popping back and forth at the boundary.
+     */
+    float m_hysteresis = 0.1f;
+
+    /**
+     * Rebuild the chain from the source mesh.
+     * @param levelCount Amount of levels including the source mesh.
+     * @param reduction Fraction of triangles kept from one level to the next.
+     */
+    void Generate(const std::shared_ptr<Mesh> &mesh, const unsigned &levelCount = 4, const float &reduction = 0.5f);
+    [[nodiscard]] unsigned SelectLevel(const float &screenSize, const unsigned &currentLevel) const;
+    [[nodiscard]] std::shared_ptr<Mesh> GetMesh(const unsigned &level);
+    /**
+     * Changes whenever the levels are replaced.
+     */
+    [[nodiscard]] size_t GetVersion() const;
+    void OnInspect() override;
+    void CollectAssetRef(std::vector<AssetRef> &list) override;
+    void Serialize(YAML::Emitter &out) override;
+    void Deserialize(const YAML::Node &in) override;
+};
+} // namespace UniEngine
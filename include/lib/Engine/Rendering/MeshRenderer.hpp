@@ -1,21 +1,41 @@
 #pragma once
 #include <Material.hpp>
 #include <Mesh.hpp>
+#include <MeshLodChain.hpp>
 
 namespace UniEngine
 {
+/**
+ * Renderers of static entities are cached by the render layer. After changing the members of one from code, call
+ * Scene::MarkStaticChanged so the change is picked up.
+ */
 class UNIENGINE_API MeshRenderer : public IPrivateComponent
 {
     friend class Editor;
+    friend class RenderLayer;
     void RenderBound(glm::vec4 &color);
+    // Current LOD level for every camera, kept between frames for the hysteresis. Cameras that stop rendering are
+    // dropped, and all levels are dropped when the chain changes.
+    std::unordered_map<Handle, unsigned> m_lodLevels;
+    uint64_t m_lodLevelsChain = 0;
   public:
     bool m_forwardRendering = false;
     bool m_castShadow = true;
     bool m_receiveShadow = true;
+    /**
+     * Always rasterize this renderer into the occlusion buffer when it is in view, regardless of its size on screen.
+     */
+    bool m_occluder = false;
     AssetRef m_mesh;
     AssetRef m_material;
+    /**
+     * Optional LOD chain. When set, the level picked per camera replaces m_mesh for rendering.
+     */
+    AssetRef m_lodChain;
     void OnInspect() override;
     void OnCreate() override;
+    void OnEnable() override;
+    void OnDisable() override;
     void Serialize(YAML::Emitter &out) override;
     void Deserialize(const YAML::Node &in) override;
     void OnDestroy() override;
@@ -0,0 +1,109 @@
+#pragma once
+#include <uniengine_export.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <cfloat>
+#include "Vertex.hpp"
+
+namespace UniEngine
+{
+    enum class UNIENGINE_API NormalWeighting
+    {
+        // Every adjacent face contributes equally.
+        Uniform,
+        // Faces contribute proportionally to their area.
+        Area,
+        // Faces contribute proportionally to the angle they form at the vertex.
+        Angle
+    };
+
+    /**
+     * Vertex count and average cache miss ratio (ACMR, post-transform cache misses per triangle) of a mesh before and
+     * after MeshUtilities::Optimize. ACMR is measured on a simulated FIFO cache so the numbers do not depend on the GPU.
+     */
+    struct UNIENGINE_API MeshOptimizationReport
+    {
+        size_t m_verticesBefore = 0;
+        size_t m_verticesAfter = 0;
+        size_t m_triangles = 0;
+        float m_acmrBefore = 0.0f;
+        float m_acmrAfter = 0.0f;
+    };
+
+    /**
+     * CPU-side geometry kernels shared by Mesh, SkinnedMesh and the procedural mesh builders.
+     * Normals and tangents are gathered per vertex through a vertex-to-triangle adjacency instead of being scattered, so the work is
+     * split across Jobs workers without locks and the output is deterministic. The adjacency and per-face scratch
+     * buffers are kept per calling thread and reused, repeated calls on meshes of similar size do not allocate.
+     */
+    class UNIENGINE_API MeshUtilities
+    {
+      public:
+        static void RecalculateNormal(
+            const std::vector<glm::vec3> &positions,
+            const std::vector<glm::uvec3> &triangles,
+            std::vector<glm::vec3> &normals,
+            const NormalWeighting &weighting = NormalWeighting::Uniform);
+        static void RecalculateTangent(
+            const std::vector<glm::vec3> &positions,
+            const std::vector<glm::vec2> &texCoords,
+            const std::vector<glm::uvec3> &triangles,
+            std::vector<glm::vec3> &tangents);
+
+#pragma region Optimization
+        // Vertex cache size used by the optimizer and the ACMR metric.
+        static constexpr unsigned DefaultCacheSize = 16;
+        /**
+         * Merge vertices whose enabled attributes are bitwise identical and drop degenerate triangles, including the
+         * ones collapsed by the merge.
+         * @return Vertex count after welding.
+         */
+        static size_t WeldVertices(VertexStreams &vertexStreams, std::vector<glm::uvec3> &triangles);
+        /**
+         * Reorder triangles for the post-transform vertex cache (Tipsify). The start of every triangle cluster, where
+         * the order jumps to a vertex outside of the cache, is written to clusterOffsets for OptimizeOverdraw.
+         */
+        static void OptimizeVertexCache(
+            std::vector<glm::uvec3> &triangles,
+            const size_t &vertexCount,
+            std::vector<unsigned> &clusterOffsets,
+            const unsigned &cacheSize = DefaultCacheSize);
+        /**
+         * Sort the clusters produced by OptimizeVertexCache so the outward facing ones, the likely occluders, are
+         * drawn first. Triangles inside a cluster keep their order, so the cache efficiency is mostly preserved.
+         */
+        static void OptimizeOverdraw(
+            const std::vector<glm::vec3> &positions,
+            std::vector<glm::uvec3> &triangles,
+            const std::vector<unsigned> &clusterOffsets);
+        /**
+         * Reorder vertices by first use in the index buffer and drop unreferenced vertices.
+         */
+        static void OptimizeVertexFetch(VertexStreams &vertexStreams, std::vector<glm::uvec3> &triangles);
+        [[nodiscard]] static float CalculateAcmr(
+            const std::vector<glm::uvec3> &triangles,
+            const size_t &vertexCount,
+            const unsigned &cacheSize = DefaultCacheSize);
+        /**
+         * Weld, vertex cache, overdraw and vertex fetch optimization in sequence.
+         */
+        static MeshOptimizationReport Optimize(VertexStreams &vertexStreams, std::vector<glm::uvec3> &triangles);
+#pragma endregion
+#pragma region Simplification
+        /**
+         * Reduce the triangle count with quadric error metric edge collapses (Garland and Heckbert). Vertices collapse
+         * onto one of their neighbours so the attributes of the remaining vertices stay valid. Vertices on attribute
+         * seams collapse along the seam together with their twin on the other side. Vertices on open borders and
+         * where seams meet are kept in place.
+         * @param targetTriangleCount Stop once the mesh has at most this many triangles.
+         * @param maxError Stop before a collapse would move the surface further than this, in mesh units.
+         * @return The largest error introduced, in mesh units.
+         */
+        static float Simplify(
+            VertexStreams &vertexStreams,
+            std::vector<glm::uvec3> &triangles,
+            const size_t &targetTriangleCount,
+            const float &maxError = FLT_MAX);
+#pragma endregion
+    };
+} // namespace UniEngine
@@ -0,0 +1,53 @@
+#pragma once
+#include <uniengine_export.h>
+#include <cstdint>
+#include <vector>
+
+namespace UniEngine
+{
+/**
+ * Sort key and the index of the render command it was built for.
+ */
+struct UNIENGINE_API RenderSortItem
+{
+    uint64_t m_key;
+    unsigned m_index;
+};
+
+/**
+ * 64-bit keys that order render commands for submission, and the radix sort that orders them. The pass always takes
+ * the top bits. Opaque keys then group by material and geometry, and the low bits can order a group front to back for
+ * callers that sort for a single view. RenderLayer shares one opaque order between all cameras and passes 0, a group
+ * is mostly drawn as one instance batch anyway. Transparent keys order back to front first and only group by material
+ * and geometry between commands at the same quantized depth.
+ *
+ * Material and geometry are frame-local indices, not handles. Indices that do not fit in their field wrap around, which
+ * only costs state changes.
+ */
+class UNIENGINE_API RenderSort
+{
+  public:
+    static constexpr unsigned PassBits = 3;
+    static constexpr unsigned OpaqueMaterialBits = 20;
+    static constexpr unsigned OpaqueGeometryBits = 20;
+    static constexpr unsigned OpaqueDepthBits = 21;
+    static constexpr unsigned TransparentDepthBits = 24;
+    static constexpr unsigned TransparentMaterialBits = 18;
+    static constexpr unsigned TransparentGeometryBits = 19;
+    /**
+     * @param depth View distance normalized to [0, 1], values outside are clamped and NaN counts as 0.
+     */
+    [[nodiscard]] static uint64_t OpaqueKey(
+        const unsigned &pass, const unsigned &material, const unsigned &geometry, const float &depth);
+    [[nodiscard]] static uint64_t TransparentKey(
+        const unsigned &pass, const unsigned &material, const unsigned &geometry, const float &depth);
+    [[nodiscard]] static unsigned GetPass(const uint64_t &key);
+    /**
+     * Stable least significant digit radix sort on the keys, 8 bits per round, split across the Jobs workers for large
+     * inputs. Rounds whose digit is the same for every item are skipped, so keys that only use a few passes, materials
+     * or meshes sort in fewer rounds.
+     * @param scratch Reused between calls to avoid the allocation.
+     */
+    static void RadixSort(std::vector<RenderSortItem> &items, std::vector<RenderSortItem> &scratch);
+};
+} // namespace UniEngine
@@ -6,6 +6,7 @@
 #include "Transform.hpp"
 #include "Particles.hpp"
 #include "Vertex.hpp"
+#include "MeshUtilities.hpp"
 #include "RenderGeometry.hpp"
 namespace UniEngine
 {
@@ -16,7 +17,6 @@ class UNIENGINE_API SkinnedMesh : public IAsset, public RenderGeometry
     std::shared_ptr<OpenGLUtils::GLVAO> m_vao;
     size_t m_offset = 0;
 
-    unsigned m_mask = 0;
     Bound m_bound;
     friend class SkinnedMeshRenderer;
     friend class Particles;
@@ -24,7 +24,8 @@ class UNIENGINE_API SkinnedMesh : public IAsset, public RenderGeometry
     friend class RenderLayer;
     friend class Editor;
     size_t m_version = 0;
-    std::vector<SkinnedVertex> m_skinnedVertices;
+    VertexStreams m_vertexStreams;
+    BoneWeightStreams m_boneWeightStreams;
     std::vector<glm::uvec3> m_triangles;
     friend struct SkinnedMeshBonesBlock;
     static std::unique_ptr<OpenGLUtils::GLBuffer> m_skinnedMeshBonesUniformBufferBlock;
@@ -52,14 +53,26 @@ class UNIENGINE_API SkinnedMesh : public IAsset, public RenderGeometry
     void Upload();
     void SetVertices(const unsigned &mask, std::vector<SkinnedVertex> &skinnedVertices, std::vector<unsigned> &indices);
     void SetVertices(const unsigned &mask, std::vector<SkinnedVertex> &skinnedVertices, std::vector<glm::uvec3> &triangles);
+    void SetVertices(
+        VertexStreams &&vertexStreams, BoneWeightStreams &&boneWeightStreams, const std::vector<glm::uvec3> &triangles);
     [[nodiscard]] size_t GetSkinnedVerticesAmount() const;
     [[nodiscard]] size_t GetTriangleAmount() const;
-    void RecalculateNormal();
+    void RecalculateNormal(const NormalWeighting &weighting = NormalWeighting::Uniform);
     void RecalculateTangent();
     [[nodiscard]] std::shared_ptr<OpenGLUtils::GLVAO> Vao() const;
     void Enable() const;
     [[nodiscard]] size_t &GetVersion();
-    [[nodiscard]] std::vector<SkinnedVertex> &UnsafeGetSkinnedVertices();
+    /**
+     * Compatibility view of the vertex streams as interleaved vertices. This is a copy, edits won't affect the mesh.
+     */
+    [[nodiscard]] std::vector<SkinnedVertex> GetSkinnedVertices() const;
+    [[nodiscard]] unsigned GetMask() const;
+    [[nodiscard]] const VertexStreams &PeekVertexStreams() const;
+    [[nodiscard]] const BoneWeightStreams &PeekBoneWeightStreams() const;
+    /**
+     * Bytes of CPU memory held by the vertex streams, the bone weights and the triangles of this mesh.
+     */
+    [[nodiscard]] size_t GetMemoryUsage() const;
     [[nodiscard]] std::vector<glm::uvec3> &UnsafeGetTriangles();
 
     void Serialize(YAML::Emitter &out) override;
@@ -8,9 +8,16 @@ namespace UniEngine
 	class UNIENGINE_API BoneMatrices
 	{
 		size_t m_version = 0;
+		friend class BonePalette;
+		friend class SkinnedMeshRenderer;
+		// Range of the matrices in the BonePalette, only used while m_paletteVersion matches the palette.
+		size_t m_paletteOffset = 0;
+		size_t m_paletteSize = 0;
+		size_t m_paletteVersion = 0;
 	public:
 		[[nodiscard]] size_t& GetVersion();
 		void Update();
+		// Matrices of renderers kept out of the BonePalette, written by SkinnedMeshRenderer::GetBoneMatrices.
 		std::vector<glm::mat4> m_value;
 		void UploadBones(const std::shared_ptr<SkinnedMesh>& skinnedMesh);
 	};
@@ -20,6 +27,7 @@ namespace UniEngine
 		friend class Editor;
 		friend class Animator;
 		friend class AnimationLayer;
+		friend class BonePalette;
 		friend class Prefab;
 		friend class RenderLayer;
 		void RenderBound(glm::vec4& color);
@@ -27,6 +35,9 @@ namespace UniEngine
 		bool m_ragDoll = false;
 		std::vector<glm::mat4> m_ragDollTransformChain;
 		std::vector<EntityRef> m_boundEntities;
+		// Kept between calls of GetBoneMatrices so moving a ragdoll allocates nothing.
+		std::vector<Entity> m_ragDollEntities;
+		std::vector<GlobalTransform> m_ragDollGlobalTransforms;
 		void DebugBoneRender(const glm::vec4& color, const float& size);
 	public:
 		void GetBoneMatrices();
@@ -1,6 +1,7 @@
 #pragma once
 #include <uniengine_export.h>
 #include <glm/glm.hpp>
+#include <vector>
 
 namespace UniEngine
 {
@@ -41,6 +42,197 @@ namespace UniEngine
         glm::ivec4 m_bondId2;
         glm::vec4 m_weight2;
     };
+    /**
+     * CPU side vertex data stored as one array per attribute. Only attributes present in the mask own a stream, so a
+     * mesh with position and normal only costs 24 bytes per vertex instead of sizeof(Vertex). The position stream is
+     * always present and is what depth and shadow passes read.
+     */
+    struct UNIENGINE_API VertexStreams
+    {
+        unsigned m_mask = 0;
+        std::vector<glm::vec3> m_positions;
+        std::vector<glm::vec3> m_normals;
+        std::vector<glm::vec3> m_tangents;
+        std::vector<glm::vec4> m_colors;
+        std::vector<glm::vec2> m_texCoords;
+
+        [[nodiscard]] bool Has(VertexAttribute attribute) const
+        {
+            return m_mask & static_cast<unsigned>(attribute);
+        }
+        [[nodiscard]] size_t Size() const
+        {
+            return m_positions.size();
+        }
+        [[nodiscard]] bool Empty() const
+        {
+            return m_positions.empty();
+        }
+        void Clear()
+        {
+            m_mask = 0;
+            m_positions.clear();
+            m_normals.clear();
+            m_tangents.clear();
+            m_colors.clear();
+            m_texCoords.clear();
+        }
+        /**
+         * Allocate or release the stream of an attribute and update the mask accordingly.
+         */
+        void SetAttribute(VertexAttribute attribute, bool enabled)
+        {
+            const size_t size = enabled ? m_positions.size() : 0;
+            switch (attribute)
+            {
+            case VertexAttribute::Position:
+                return;
+            case VertexAttribute::Normal:
+                m_normals.resize(size);
+                break;
+            case VertexAttribute::Tangent:
+                m_tangents.resize(size);
+                break;
+            case VertexAttribute::Color:
+                m_colors.resize(size, glm::vec4(1.0f));
+                break;
+            case VertexAttribute::TexCoord:
+                m_texCoords.resize(size);
+                break;
+            }
+            if (enabled)
+                m_mask |= static_cast<unsigned>(attribute);
+            else
+                m_mask &= ~static_cast<unsigned>(attribute);
+        }
+        /**
+         * Split interleaved vertices into streams. Attributes not present in the mask are dropped.
+         */
+        template <typename T> void Import(unsigned mask, const std::vector<T> &vertices)
+        {
+            Clear();
+            m_mask = mask | static_cast<unsigned>(VertexAttribute::Position);
+            const auto size = vertices.size();
+            m_positions.resize(size);
+            for (size_t i = 0; i < size; i++)
+                m_positions[i] = vertices[i].m_position;
+            if (Has(VertexAttribute::Normal))
+            {
+                m_normals.resize(size);
+                for (size_t i = 0; i < size; i++)
+                    m_normals[i] = vertices[i].m_normal;
+            }
+            if (Has(VertexAttribute::Tangent))
+            {
+                m_tangents.resize(size);
+                for (size_t i = 0; i < size; i++)
+                    m_tangents[i] = vertices[i].m_tangent;
+            }
+            if (Has(VertexAttribute::Color))
+            {
+                m_colors.resize(size);
+                for (size_t i = 0; i < size; i++)
+                    m_colors[i] = vertices[i].m_color;
+            }
+            if (Has(VertexAttribute::TexCoord))
+            {
+                m_texCoords.resize(size);
+                for (size_t i = 0; i < size; i++)
+                    m_texCoords[i] = vertices[i].m_texCoord;
+            }
+        }
+        /**
+         * Write the streams into interleaved vertices. Missing attributes keep the default value of T.
+         */
+        template <typename T> void Export(std::vector<T> &vertices) const
+        {
+            const auto size = m_positions.size();
+            vertices.resize(size);
+            for (size_t i = 0; i < size; i++)
+            {
+                auto &vertex = vertices[i];
+                vertex.m_position = m_positions[i];
+                if (!m_normals.empty())
+                    vertex.m_normal = m_normals[i];
+                if (!m_tangents.empty())
+                    vertex.m_tangent = m_tangents[i];
+                if (!m_colors.empty())
+                    vertex.m_color = m_colors[i];
+                if (!m_texCoords.empty())
+                    vertex.m_texCoord = m_texCoords[i];
+            }
+        }
+        /**
+         * Bytes taken by the attribute data, excluding vector bookkeeping.
+         */
+        [[nodiscard]] size_t GetMemoryUsage() const
+        {
+            return m_positions.capacity() * sizeof(glm::vec3) + m_normals.capacity() * sizeof(glm::vec3) +
+                   m_tangents.capacity() * sizeof(glm::vec3) + m_colors.capacity() * sizeof(glm::vec4) +
+                   m_texCoords.capacity() * sizeof(glm::vec2);
+        }
+    };
+    /**
+     * Bone indices and weights of skinned vertices, one array per attribute. The second set of four influences is
+     * only kept when at least one vertex uses it.
+     */
+    struct UNIENGINE_API BoneWeightStreams
+    {
+        std::vector<glm::ivec4> m_boneIds;
+        std::vector<glm::vec4> m_weights;
+        std::vector<glm::ivec4> m_boneIds2;
+        std::vector<glm::vec4> m_weights2;
+
+        void Clear()
+        {
+            m_boneIds.clear();
+            m_weights.clear();
+            m_boneIds2.clear();
+            m_weights2.clear();
+        }
+        void Import(const std::vector<SkinnedVertex> &skinnedVertices)
+        {
+            Clear();
+            const auto size = skinnedVertices.size();
+            m_boneIds.resize(size);
+            m_weights.resize(size);
+            bool secondSet = false;
+            for (size_t i = 0; i < size; i++)
+            {
+                m_boneIds[i] = skinnedVertices[i].m_bondId;
+                m_weights[i] = skinnedVertices[i].m_weight;
+                if (skinnedVertices[i].m_weight2 != glm::vec4(0.0f))
+                    secondSet = true;
+            }
+            if (!secondSet)
+                return;
+            m_boneIds2.resize(size);
+            m_weights2.resize(size);
+            for (size_t i = 0; i < size; i++)
+            {
+                m_boneIds2[i] = skinnedVertices[i].m_bondId2;
+                m_weights2[i] = skinnedVertices[i].m_weight2;
+            }
+        }
+        void Export(std::vector<SkinnedVertex> &skinnedVertices) const
+        {
+            const auto size = m_boneIds.size();
+            skinnedVertices.resize(size);
+            for (size_t i = 0; i < size; i++)
+            {
+                auto &vertex = skinnedVertices[i];
+                vertex.m_bondId = m_boneIds[i];
+                vertex.m_weight = m_weights[i];
+                vertex.m_bondId2 = m_boneIds2.empty() ? glm::ivec4(0) : m_boneIds2[i];
+                vertex.m_weight2 = m_weights2.empty() ? glm::vec4(0.0f) : m_weights2[i];
+            }
+        }
+        [[nodiscard]] size_t GetMemoryUsage() const
+        {
+            return m_boneIds.capacity() * sizeof(glm::ivec4) + m_weights.capacity() * sizeof(glm::vec4) +
+                   m_boneIds2.capacity() * sizeof(glm::ivec4) + m_weights2.capacity() * sizeof(glm::vec4);
+        }
+    };
     enum class UNIENGINE_API StrandPointAttribute
     {
         Position = 1,
@@ -0,0 +1,114 @@
+#pragma once
+#include <uniengine_export.h>
+namespace UniEngine
+{
+enum class UNIENGINE_API PlyFormat
+{
+    Ascii,
+    BinaryLittleEndian,
+    BinaryBigEndian
+};
+
+enum class UNIENGINE_API PlyType
+{
+    Int8,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Float32,
+    Float64
+};
+
+struct UNIENGINE_API PlyProperty
+{
+    std::string m_name;
+    PlyType m_type = PlyType::Float32;
+    // Bytes from the start of the vertex in binary files.
+    size_t m_offset = 0;
+    // Index among the properties of the vertex, and of the value on the line in ascii files.
+    size_t m_index = 0;
+};
+
+/**
+ * The attributes and the vertices to read. Vertex m_first + i * m_stride is written at i, for at most m_amount
+ * vertices.
+ */
+struct UNIENGINE_API PlyReadSettings
+{
+    bool m_positions = true;
+    bool m_normals = true;
+    bool m_colors = true;
+    size_t m_first = 0;
+    size_t m_amount = SIZE_MAX;
+    size_t m_stride = 1;
+};
+
+/**
+ * Reads the vertices of a PLY file straight into the arrays of the caller. Binary files are memory mapped and every
+ * requested property is converted as a column, in parallel chunks on the Jobs workers, so reading costs no more memory
+ * than the arrays filled. Ascii files are parsed a line at a time.
+ *
+ * Positions are x, y, z, normals nx, ny, nz and colors red, green, blue, alpha or r, g, b, a. Integer colors are
+ * scaled by the largest value of their type, alpha is 1 when missing. Elements before the vertices are skipped as long
+ * as they have no list properties.
+ */
+class UNIENGINE_API PlyReader
+{
+    struct MappedFile;
+    std::filesystem::path m_path;
+    std::unique_ptr<MappedFile> m_mappedFile;
+    // Fallback for binary files that can not be mapped, and the stream of ascii files.
+    std::ifstream m_stream;
+    std::vector<char> m_buffer;
+    PlyFormat m_format = PlyFormat::Ascii;
+    size_t m_dataBegin = 0;
+    // Lines of the elements before the vertices in ascii files.
+    size_t m_skippedLines = 0;
+    // Index of the vertex on the next line of m_stream in ascii files.
+    size_t m_nextLine = 0;
+    size_t m_vertexAmount = 0;
+    size_t m_vertexSize = 0;
+    std::vector<PlyProperty> m_properties;
+    int m_position[3] = {-1, -1, -1};
+    int m_normal[3] = {-1, -1, -1};
+    int m_color[4] = {-1, -1, -1, -1};
+
+    template <typename Color>
+    size_t ReadVertices(
+        const PlyReadSettings &settings,
+        std::vector<glm::dvec3> &positions,
+        std::vector<glm::dvec3> *normals,
+        std::vector<Color> &colors);
+    [[nodiscard]] const char *GetBinaryData(const size_t &first, const size_t &amount);
+    void SeekLine(const size_t &vertex);
+
+  public:
+    PlyReader();
+    ~PlyReader();
+    bool Open(const std::filesystem::path &path, std::string &error);
+    void Close();
+    [[nodiscard]] PlyFormat GetFormat() const;
+    [[nodiscard]] size_t GetVertexAmount() const;
+    [[nodiscard]] const std::vector<PlyProperty> &GetProperties() const;
+    [[nodiscard]] bool IsMapped() const;
+    [[nodiscard]] bool HasPositions() const;
+    [[nodiscard]] bool HasNormals() const;
+    [[nodiscard]] bool HasColors() const;
+    /**
+     * Resize the arrays to the amount of vertices read and fill them. Arrays of attributes that are not requested or
+     * not in the file are cleared.
+     * @return The amount of vertices read, 0 when the file ended early.
+     */
+    size_t Read(
+        const PlyReadSettings &settings,
+        std::vector<glm::dvec3> &positions,
+        std::vector<glm::dvec3> &normals,
+        std::vector<glm::vec4> &colors);
+    /**
+     * Positions and 8 bit colors only.
+     */
+    size_t Read(const PlyReadSettings &settings, std::vector<glm::dvec3> &positions, std::vector<glm::u8vec4> &colors);
+};
+} // namespace UniEngine
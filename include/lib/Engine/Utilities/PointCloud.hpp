@@ -3,6 +3,9 @@
 #include "Entity.hpp"
 #include "Camera.hpp"
 #include "Mesh.hpp"
+#include "PointCloudKdTree.hpp"
+#include "PointCloudOctree.hpp"
+#include "PlyReader.hpp"
 namespace UniEngine
 {
 
@@ -20,14 +23,41 @@ class UNIENGINE_API PointCloud : public IAsset
     std::vector<glm::vec4> m_colors;
     float m_pointSize = 0.01f;
     float m_compressFactor = 0.01f;
+    // Streamed from disk instead of held in m_points, see PointCloudOctree.
+    std::shared_ptr<PointCloudOctree> m_octree;
     void OnCreate() override;
     void Load(const std::filesystem::path &path);
+    /**
+     * Load the attributes and the vertices of a PLY file picked by settings, see PlyReader.
+     */
+    void Load(const std::filesystem::path &path, const PlyReadSettings &settings);
     void Save(const std::filesystem::path &path);
     void OnInspect() override;
     void Compress(std::vector<glm::dvec3>& points);
+    /**
+     * Downsample to one point per cell of a grid with cells of m_compressFactor, averaging the positions, and the
+     * normals and colors when the cloud has them. Only occupied cells are stored, hashed into one map per partition
+     * that a single job fills, so memory grows with the output rather than with the bounding box.
+     */
+    void Compress(std::vector<glm::dvec3>& points, std::vector<glm::dvec3>& normals, std::vector<glm::vec4>& colors);
     void ApplyCompressed();
     void ApplyOriginal();
     void RecalculateBoundingBox();
+    /**
+     * Bytes of CPU memory held by the points, normals and colors.
+     */
+    [[nodiscard]] size_t GetMemoryUsage() const;
+    /**
+     * Set m_normals to the normal of the plane fitted to the k nearest neighbours of every point. Normals are flipped
+     * to agree with the previous normals when the cloud has them, otherwise to face away from the center of the cloud.
+     */
+    void EstimateNormals(const size_t &k = 16);
+    /**
+     * Remove the points whose mean distance to their k nearest neighbours is more than stdRatio standard deviations
+     * above the mean over the cloud, along with their normals and colors.
+     * @return The amount of points removed.
+     */
+    size_t RemoveStatisticalOutliers(const size_t &k = 16, const double &stdRatio = 2.0);
     void Crop(std::vector<glm::dvec3>& points, const glm::dvec3& min, const glm::dvec3& max);
     void Serialize(YAML::Emitter &out) override;
     void Deserialize(const YAML::Node &in) override;
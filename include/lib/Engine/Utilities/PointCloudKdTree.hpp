@@ -0,0 +1,78 @@
+#pragma once
+#include <uniengine_export.h>
+namespace UniEngine
+{
+/**
+ * Balanced KD-tree over a set of points for nearest neighbour and radius queries. Every node splits its range of points
+ * at the median along the axis of largest extent, so the ranges follow from the amount of points alone and a node only
+ * stores its split. The points are copied in leaf order next to their original index, so a query reads the leaves it
+ * visits as contiguous memory instead of gathering from the source array.
+ *
+ * The levels near the root are split one level at a time across the Jobs workers, the subtrees below them are built
+ * one per job. Queries are const and can run from any amount of threads at once.
+ */
+class UNIENGINE_API PointCloudKdTree
+{
+    struct Node
+    {
+        double m_split = 0;
+        int m_axis = 0;
+    };
+    struct Entry
+    {
+        glm::dvec3 m_position;
+        unsigned m_index;
+    };
+    // Inner nodes in breadth first order, the children of node i are 2i + 1 and 2i + 2. Leaves are not stored.
+    std::vector<Node> m_nodes;
+    std::vector<Entry> m_entries;
+    // Depth of the leaves, every leaf is at this depth.
+    int m_leafDepth = 0;
+    // Split the range at its median along its widest axis, returns the first point of the right child.
+    size_t SplitNode(size_t node, size_t begin, size_t end);
+    void BuildSubtree(size_t node, int depth, size_t begin, size_t end);
+    void SearchNearest(
+        size_t node,
+        int depth,
+        size_t begin,
+        size_t end,
+        const glm::dvec3 &point,
+        size_t k,
+        std::vector<std::pair<double, unsigned>> &heap) const;
+    void SearchRadius(
+        size_t node,
+        int depth,
+        size_t begin,
+        size_t end,
+        const glm::dvec3 &point,
+        double squaredRadius,
+        std::vector<unsigned> &indices,
+        std::vector<double> &squaredDistances) const;
+
+  public:
+    PointCloudKdTree() = default;
+    explicit PointCloudKdTree(const std::vector<glm::dvec3> &points, const size_t &leafSize = 16);
+    /**
+     * Rebuild over points. Results index into points, the tree does not keep a reference to it.
+     */
+    void Build(const std::vector<glm::dvec3> &points, const size_t &leafSize = 16);
+    void Clear();
+    [[nodiscard]] size_t GetPointAmount() const;
+    /**
+     * The k points closest to point, nearest first. Fewer when the tree has less than k points.
+     */
+    void FindNearest(
+        const glm::dvec3 &point,
+        const size_t &k,
+        std::vector<unsigned> &indices,
+        std::vector<double> &squaredDistances) const;
+    /**
+     * Every point within radius of point, in no particular order.
+     */
+    void FindInRadius(
+        const glm::dvec3 &point,
+        const double &radius,
+        std::vector<unsigned> &indices,
+        std::vector<double> &squaredDistances) const;
+};
+} // namespace UniEngine
@@ -0,0 +1,120 @@
+#pragma once
+#include "Camera.hpp"
+#include "Core/OpenGLUtils.hpp"
+namespace UniEngine
+{
+/**
+ * A point as stored in the node files and in the vertex buffers, position relative to the minimum of the octree.
+ */
+struct UNIENGINE_API PointCloudOctreePoint
+{
+    glm::vec3 m_position;
+    glm::u8vec4 m_color;
+};
+
+struct UNIENGINE_API PointCloudOctreeBuildSettings
+{
+    // Nodes with more points keep one point per cell of a grid of this resolution and pass the rest to their children.
+    int m_gridResolution = 64;
+    size_t m_nodeCapacity = 20000;
+    // Largest amount of points of a chunk, the subtrees below the chunks are built one chunk at a time.
+    size_t m_chunkCapacity = 5000000;
+    // Points read from the PLY file and held before being appended to the chunk files.
+    size_t m_bufferedPoints = 4000000;
+};
+
+struct UNIENGINE_API PointCloudOctreeNode
+{
+    // "r" followed by the index of the child taken at each level.
+    std::string m_name;
+    int m_parent = -1;
+    std::array<int, 8> m_children;
+    glm::dvec3 m_min;
+    double m_size = 0;
+    size_t m_pointAmount = 0;
+
+    enum class State
+    {
+        Unloaded,
+        Loading,
+        Loaded
+    } m_state = State::Unloaded;
+    // Read by a worker while loading, released once uploaded.
+    std::vector<PointCloudOctreePoint> m_points;
+    std::shared_future<void> m_loading;
+    std::unique_ptr<OpenGLUtils::GLVAO> m_vao;
+    size_t m_lastVisibleFrame = 0;
+};
+
+/**
+ * Out-of-core point cloud in the spirit of Potree. Build turns a PLY file into a directory of node files in bounded
+ * memory: the points are streamed into chunks small enough to fit in memory, the subtree of every chunk is built on its
+ * own, then the levels above the chunks are sampled from their children. Every node keeps one point per cell of a
+ * grid over its cube, so loading a node refines the nodes above it without duplicating their points.
+ *
+ * At runtime Update picks the nodes to draw by their size on screen within the point budget, loads the missing ones
+ * on the Jobs workers and unloads the least recently visible ones over the cache budget. Every loaded node is drawn as
+ * a 16 bytes per point position and color buffer. The editor streams every open octree into its scene camera each
+ * frame, see StreamOpenOctrees.
+ */
+class UNIENGINE_API PointCloudOctree
+{
+    std::filesystem::path m_directory;
+    glm::dvec3 m_min = glm::dvec3(0.0);
+    double m_size = 0;
+    size_t m_pointAmount = 0;
+    std::vector<PointCloudOctreeNode> m_nodes;
+    std::vector<int> m_visibleNodes;
+    size_t m_visiblePointAmount = 0;
+    size_t m_loadedPointAmount = 0;
+    size_t m_frame = 0;
+    void Load(PointCloudOctreeNode &node);
+    void Unload(PointCloudOctreeNode &node);
+
+  public:
+    // Whether StreamOpenOctrees updates and draws this octree.
+    bool m_streaming = true;
+    // Added to the positions when drawing, like PointCloud::m_offset.
+    glm::dvec3 m_offset = glm::dvec3(0.0);
+    size_t m_pointBudget = 5000000;
+    // Points kept loaded, visible or not.
+    size_t m_cacheBudget = 10000000;
+    // Nodes smaller than this many pixels on screen are not drawn.
+    float m_minNodeSize = 100.0f;
+    int m_maxConcurrentLoads = 4;
+    float m_pointSize = 2.0f;
+
+    /**
+     * Convert a PLY file with x, y, z and optionally red, green, blue (or r, g, b) vertex properties into an octree in
+     * directory, replacing the octree there.
+     */
+    static bool Build(
+        const std::filesystem::path &plyPath,
+        const std::filesystem::path &directory,
+        const PointCloudOctreeBuildSettings &settings = PointCloudOctreeBuildSettings());
+    bool Open(const std::filesystem::path &directory);
+    void Close();
+    ~PointCloudOctree();
+    [[nodiscard]] const std::filesystem::path &GetDirectory() const;
+    [[nodiscard]] bool IsOpen() const;
+    [[nodiscard]] size_t GetPointAmount() const;
+    [[nodiscard]] size_t GetNodeAmount() const;
+    [[nodiscard]] size_t GetVisiblePointAmount() const;
+    [[nodiscard]] size_t GetLoadedPointAmount() const;
+    /**
+     * Select the nodes to draw from the camera, start loading the missing ones and unload over the cache budget. Main
+     * thread only.
+     */
+    void Update(const std::shared_ptr<Camera> &camera, const glm::vec3 &cameraPosition, const glm::quat &cameraRotation);
+    /**
+     * Draw the visible loaded nodes into the camera.
+     */
+    void Render(const std::shared_ptr<Camera> &camera, const glm::vec3 &cameraPosition, const glm::quat &cameraRotation);
+    /**
+     * Update and render every open octree that is streaming into the camera. Main thread only.
+     */
+    static void StreamOpenOctrees(
+        const std::shared_ptr<Camera> &camera, const glm::vec3 &cameraPosition, const glm::quat &cameraRotation);
+    void OnInspect();
+};
+} // namespace UniEngine
@@ -7,7 +7,7 @@
 #include <PostProcessing.hpp>
 using namespace UniEngine;
 void LoadScene();
-int main()
+int main(int argc, char **argv)
 {
     /*
      * Please change this to the root folder.
@@ -27,11 +27,31 @@ int main()
     ProjectManager::SetScenePostLoadActions([]() { LoadScene(); });
     ApplicationConfigs applicationConfigs;
     applicationConfigs.m_projectPath = resourceFolderPath / "Example Projects/Rendering/Rendering.ueproj";
+    // "--headless [frames]" runs the scene without a GPU for a fixed amount of frames, 600 by default.
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::string(argv[i]) != "--headless")
+            continue;
+        applicationConfigs.m_headless = true;
+        applicationConfigs.m_frameLimit = i + 1 < argc ? std::stoul(argv[i + 1]) : 600;
+    }
     Application::Create(applicationConfigs);
 
     // Start engine. Here since we need to inject procedures to the main engine loop we need to manually loop by our
     // self. Another way to run engine is to simply execute:
     Application::Start();
+    if (applicationConfigs.m_headless)
+    {
+        const auto &statistics = OpenGLUtils::GetStatistics();
+        printf(
+            "%zu frames: %zu GL calls, %zu draw calls, %zu state changes, %zu uniform updates, %zu bytes uploaded\n",
+            applicationConfigs.m_frameLimit,
+            statistics.m_calls,
+            statistics.m_drawCalls,
+            statistics.m_stateChanges,
+            statistics.m_uniformUpdates,
+            statistics.m_bytesUploaded);
+    }
     Application::End();
 
 #pragma endregion
@@ -0,0 +1,307 @@
+#include "Benchmark.hpp"
+#include <Animation.hpp>
+#include <BonePalette.hpp>
+#include <PointCloud.hpp>
+#include <PointCloudOctree.hpp>
+#include <ProjectManager.hpp>
+#include <Vertex.hpp>
+#include <random>
+using namespace UniEngine;
+
+namespace
+{
+constexpr size_t BoneAmount = 64;
+constexpr size_t KeyFrameAmount = 30;
+constexpr size_t InstanceAmount = 1000;
+constexpr size_t RigBoneAmount = 100;
+const std::string AnimationName = "Bench";
+
+// Binary tree of bones, every bone has its own keys over a one second clip.
+std::shared_ptr<Animation> CreateAnimation(const size_t &boneAmount = BoneAmount)
+{
+    const auto animation = ProjectManager::CreateTemporaryAsset<Animation>();
+    animation->m_animationNameAndLength[AnimationName] = 1.0f;
+    animation->m_boneSize = boneAmount;
+    std::mt19937 random(boneAmount);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<std::shared_ptr<Bone>> bones(boneAmount);
+    for (size_t i = 0; i < boneAmount; i++)
+    {
+        bones[i] = std::make_shared<Bone>();
+        bones[i]->m_index = i;
+        bones[i]->m_name = "Bone " + std::to_string(i);
+        auto &keyFrames = bones[i]->m_animations[AnimationName];
+        for (size_t key = 0; key < KeyFrameAmount; key++)
+        {
+            const float timeStamp = static_cast<float>(key) / (KeyFrameAmount - 1);
+            const glm::vec3 euler(distribution(random), distribution(random), distribution(random));
+            keyFrames.m_positions.push_back({glm::vec3(distribution(random), 1.0f, 0.0f), timeStamp});
+            keyFrames.m_rotations.push_back({glm::quat(euler), timeStamp});
+            keyFrames.m_scales.push_back({glm::vec3(1.0f), timeStamp});
+        }
+        keyFrames.m_maxTimeStamp = 1.0f;
+        if (i != 0)
+            bones[(i - 1) / 2]->m_children.push_back(bones[i]);
+    }
+    animation->m_rootBone = bones[0];
+    return animation;
+}
+
+void BenchmarkAnimation(std::vector<Bench::BenchmarkResult> &results)
+{
+    const auto animation = CreateAnimation();
+    std::vector<glm::mat4> boneMatrices(BoneAmount);
+    const auto name = "Animation::Animate, " + std::to_string(BoneAmount) + " bones x " +
+                      std::to_string(InstanceAmount) + " instances";
+    results.push_back(Bench::Measure(name, 10, [&]() {
+        for (size_t i = 0; i < InstanceAmount; i++)
+            animation->Animate(
+                AnimationName, static_cast<float>(i) / InstanceAmount, glm::mat4(1.0f), boneMatrices);
+    }));
+}
+
+// Every animator plays the clip at its own phase and advances by a 60 Hz frame per iteration.
+void BenchmarkAnimators(std::vector<Bench::BenchmarkResult> &results)
+{
+    const auto animation = CreateAnimation(RigBoneAmount);
+    std::vector<std::vector<glm::mat4>> boneMatrices(InstanceAmount, std::vector<glm::mat4>(RigBoneAmount));
+    const auto suffix =
+        ", " + std::to_string(RigBoneAmount) + " bones x " + std::to_string(InstanceAmount) + " animators";
+    const auto time = [](const size_t &frame, const size_t &instance) {
+        return glm::mod(static_cast<float>(instance) / InstanceAmount + frame / 60.0f, 1.0f);
+    };
+    size_t frame = 0;
+    results.push_back(Bench::Measure("Bone::Animate tree walk" + suffix, 10, [&]() {
+        for (size_t i = 0; i < InstanceAmount; i++)
+            animation->m_rootBone->Animate(
+                AnimationName, time(frame, i), glm::mat4(1.0f), glm::mat4(1.0f), boneMatrices[i]);
+        frame++;
+    }));
+    const int clipIndex = animation->GetClipIndex(AnimationName);
+    std::vector<AnimationCursor> cursors(InstanceAmount);
+    frame = 0;
+    results.push_back(Bench::Measure("Baked clip with cursors" + suffix, 10, [&]() {
+        for (size_t i = 0; i < InstanceAmount; i++)
+            animation->Animate(clipIndex, time(frame, i), glm::mat4(1.0f), boneMatrices[i], &cursors[i]);
+        frame++;
+    }));
+    // Compressing removes keys from the animation, so it goes last.
+    AnimationCompressionSettings settings;
+    settings.m_quantize = true;
+    results.push_back(Bench::Measure("Animation::Compress, " + std::to_string(RigBoneAmount) + " bones", 1, [&]() {
+        animation->Compress(settings);
+    }));
+    frame = 0;
+    results.push_back(Bench::Measure("Compressed baked clip with cursors" + suffix, 10, [&]() {
+        for (size_t i = 0; i < InstanceAmount; i++)
+            animation->Animate(clipIndex, time(frame, i), glm::mat4(1.0f), boneMatrices[i], &cursors[i]);
+        frame++;
+    }));
+}
+
+// The offset matrices applied to every bone of every animator each frame.
+void BenchmarkOffsetMatrices(std::vector<Bench::BenchmarkResult> &results)
+{
+    const size_t amount = RigBoneAmount * InstanceAmount;
+    std::mt19937 random(amount);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<glm::mat4> transformChain(amount);
+    std::vector<glm::mat4> offsetMatrices(amount);
+    for (size_t i = 0; i < amount; i++)
+    {
+        const glm::vec3 position(distribution(random), distribution(random), distribution(random));
+        const glm::vec3 euler(distribution(random), distribution(random), distribution(random));
+        transformChain[i] = glm::translate(position) * glm::mat4_cast(glm::quat(euler));
+        offsetMatrices[i] = glm::translate(-position) * glm::mat4_cast(glm::quat(-euler));
+    }
+    std::vector<glm::mat4> products(amount);
+    const auto suffix = " (" + std::to_string(amount) + " bones)";
+    results.push_back(Bench::Measure("glm::mat4 products" + suffix, 10, [&]() {
+        for (size_t i = 0; i < amount; i++)
+            products[i] = transformChain[i] * offsetMatrices[i];
+    }));
+    results.push_back(Bench::Measure("BonePalette::MultiplyAffine" + suffix, 10, [&]() {
+        BonePalette::MultiplyAffine(transformChain.data(), offsetMatrices.data(), products.data(), amount);
+    }));
+}
+
+// The default primitives as shipped in the old interleaved format, split into vertex streams and back.
+void BenchmarkVertexStreams(std::vector<Bench::BenchmarkResult> &results)
+{
+    const std::filesystem::path directory = std::filesystem::path("./DefaultResources") / "Primitives";
+    if (!std::filesystem::exists(directory))
+    {
+        printf("Skipping vertex stream benchmarks, %s not found.\n", directory.string().c_str());
+        return;
+    }
+    std::vector<std::pair<unsigned, std::vector<Vertex>>> meshes;
+    for (const auto &entry : std::filesystem::directory_iterator(directory))
+    {
+        if (entry.path().extension() != ".uemesh")
+            continue;
+        const auto in = YAML::LoadFile(entry.path().string());
+        if (!in["m_vertices"])
+            continue;
+        const auto vertexData = in["m_vertices"].as<YAML::Binary>();
+        auto &mesh = meshes.emplace_back(in["m_mask"].as<unsigned>(), std::vector<Vertex>());
+        mesh.second.resize(vertexData.size() / sizeof(Vertex));
+        std::memcpy(mesh.second.data(), vertexData.data(), vertexData.size());
+    }
+    std::vector<VertexStreams> streams(meshes.size());
+    const auto suffix = " (" + std::to_string(meshes.size()) + " default primitives)";
+    auto import = Bench::Measure("VertexStreams::Import" + suffix, 10, [&]() {
+        for (size_t i = 0; i < meshes.size(); i++)
+            streams[i].Import(meshes[i].first, meshes[i].second);
+    });
+    std::vector<std::vector<Vertex>> vertices(meshes.size());
+    auto exported = Bench::Measure("VertexStreams::Export" + suffix, 10, [&]() {
+        for (size_t i = 0; i < meshes.size(); i++)
+            streams[i].Export(vertices[i]);
+    });
+    for (size_t i = 0; i < meshes.size(); i++)
+    {
+        import.m_bytes += streams[i].GetMemoryUsage();
+        exported.m_bytes += vertices[i].size() * sizeof(Vertex);
+    }
+    results.push_back(import);
+    results.push_back(exported);
+}
+
+// Points scattered in a cube of the given extent, downsampled at the given resolution.
+void BenchmarkPointCloud(
+    const size_t &amount, const double &extent, const float &resolution, std::vector<Bench::BenchmarkResult> &results)
+{
+    const auto pointCloud = ProjectManager::CreateTemporaryAsset<PointCloud>();
+    std::mt19937 random(amount);
+    std::uniform_real_distribution<double> distribution(-extent / 2.0, extent / 2.0);
+    pointCloud->m_points.resize(amount);
+    for (auto &point : pointCloud->m_points)
+        point = glm::dvec3(distribution(random), distribution(random), distribution(random));
+    pointCloud->m_hasPositions = true;
+    pointCloud->m_compressFactor = resolution;
+    std::vector<glm::dvec3> compressed;
+    const auto name = "PointCloud::Compress (" + std::to_string(amount) + ", " + Bench::FormatNumber(extent) +
+                      "m at " + Bench::FormatNumber(resolution) + "m)";
+    results.push_back(Bench::Measure(name, 3, [&]() { pointCloud->Compress(compressed); }));
+}
+// Points on a rippled 100m plane, as a terrain scan without normals.
+void BenchmarkPointCloudKdTree(const size_t &amount, std::vector<Bench::BenchmarkResult> &results)
+{
+    const auto pointCloud = ProjectManager::CreateTemporaryAsset<PointCloud>();
+    std::mt19937 random(amount);
+    std::uniform_real_distribution<double> distribution(0.0, 100.0);
+    pointCloud->m_points.resize(amount);
+    for (auto &point : pointCloud->m_points)
+    {
+        const double x = distribution(random);
+        const double z = distribution(random);
+        point = glm::dvec3(x, std::sin(x * 0.1) * std::cos(z * 0.1), z);
+    }
+    pointCloud->m_hasPositions = true;
+    const auto suffix = " (" + std::to_string(amount) + ")";
+    PointCloudKdTree tree;
+    results.push_back(
+        Bench::Measure("PointCloudKdTree::Build" + suffix, 3, [&]() { tree.Build(pointCloud->m_points); }));
+    std::vector<unsigned> indices;
+    std::vector<double> squaredDistances;
+    results.push_back(Bench::Measure("PointCloudKdTree::FindNearest, 16 of 100000 points" + suffix, 3, [&]() {
+        for (size_t i = 0; i < 100000; i++)
+            tree.FindNearest(pointCloud->m_points[i * amount / 100000], 16, indices, squaredDistances);
+    }));
+    results.push_back(
+        Bench::Measure("PointCloud::EstimateNormals" + suffix, 1, [&]() { pointCloud->EstimateNormals(16); }));
+}
+// Layout of the vertices written by WriteBenchmarkPly.
+struct BenchmarkPlyProperties
+{
+    bool m_doublePositions = false;
+    bool m_normals = false;
+};
+// Binary PLY of points scattered in a 100m cube with 8 bit colors, and upward normals if requested.
+void WriteBenchmarkPly(const std::filesystem::path &path, const size_t &amount, const BenchmarkPlyProperties &properties)
+{
+    std::ofstream stream(path, std::ios::binary);
+    const std::string positionType = properties.m_doublePositions ? "double" : "float";
+    stream << "ply\nformat binary_little_endian 1.0\nelement vertex " << amount << "\n";
+    for (const auto &i : {"x", "y", "z"})
+        stream << "property " << positionType << " " << i << "\n";
+    if (properties.m_normals)
+        stream << "property float nx\nproperty float ny\nproperty float nz\n";
+    stream << "property uchar red\nproperty uchar green\nproperty uchar blue\nend_header\n";
+    std::mt19937 random(amount);
+    std::uniform_real_distribution<double> distribution(0.0, 100.0);
+    for (size_t i = 0; i < amount; i++)
+    {
+        const glm::dvec3 position(distribution(random), distribution(random), distribution(random));
+        if (properties.m_doublePositions)
+        {
+            stream.write(reinterpret_cast<const char *>(&position), sizeof(glm::dvec3));
+        }
+        else
+        {
+            const glm::vec3 floatPosition(position);
+            stream.write(reinterpret_cast<const char *>(&floatPosition), sizeof(glm::vec3));
+        }
+        if (properties.m_normals)
+        {
+            const glm::vec3 normal(0.0f, 1.0f, 0.0f);
+            stream.write(reinterpret_cast<const char *>(&normal), sizeof(glm::vec3));
+        }
+        const glm::u8vec3 color(i % 256);
+        stream.write(reinterpret_cast<const char *>(&color), sizeof(glm::u8vec3));
+    }
+}
+// Binary PLY with float positions and normals and 8 bit colors, loaded whole and every 10th point.
+void BenchmarkPointCloudLoad(const size_t &amount, std::vector<Bench::BenchmarkResult> &results)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "uniengine-bench-ply";
+    std::filesystem::create_directories(directory);
+    const auto plyPath = directory / "points.ply";
+    BenchmarkPlyProperties properties;
+    properties.m_normals = true;
+    WriteBenchmarkPly(plyPath, amount, properties);
+    const auto pointCloud = ProjectManager::CreateTemporaryAsset<PointCloud>();
+    const auto suffix = " (" + std::to_string(amount) + ")";
+    results.push_back(Bench::Measure("PointCloud::Load" + suffix, 3, [&]() { pointCloud->Load(plyPath); }));
+    PlyReadSettings settings;
+    settings.m_normals = false;
+    settings.m_stride = 10;
+    results.push_back(Bench::Measure("PointCloud::Load, positions and colors of every 10th point" + suffix, 3, [&]() {
+        pointCloud->Load(plyPath, settings);
+    }));
+    std::filesystem::remove_all(directory);
+}
+// Binary PLY with double positions and 8 bit colors, converted into an octree next to it.
+void BenchmarkPointCloudOctree(const size_t &amount, std::vector<Bench::BenchmarkResult> &results)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "uniengine-bench-octree";
+    std::filesystem::create_directories(directory);
+    const auto plyPath = directory / "points.ply";
+    BenchmarkPlyProperties properties;
+    properties.m_doublePositions = true;
+    WriteBenchmarkPly(plyPath, amount, properties);
+    // Small chunks and buffers, so the build goes through the out-of-core path.
+    PointCloudOctreeBuildSettings settings;
+    settings.m_chunkCapacity = amount / 8;
+    settings.m_bufferedPoints = amount / 16;
+    results.push_back(Bench::Measure("PointCloudOctree::Build (" + std::to_string(amount) + ")", 1, [&]() {
+        PointCloudOctree::Build(plyPath, directory / "octree", settings);
+    }));
+    std::filesystem::remove_all(directory);
+}
+} // namespace
+
+void Bench::RunAssetBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    BenchmarkVertexStreams(results);
+    BenchmarkAnimation(results);
+    BenchmarkAnimators(results);
+    BenchmarkOffsetMatrices(results);
+    // A 10m cube at a 5cm resolution, 8 million voxels.
+    BenchmarkPointCloud(1000000, 10.0, 0.05f, results);
+    // A city block at 1cm, far more cells than a dense grid could hold. Memory follows the occupied cells.
+    BenchmarkPointCloud(10000000, 1000.0, 0.01f, results);
+    BenchmarkPointCloudKdTree(1000000, results);
+    BenchmarkPointCloudLoad(10000000, results);
+    BenchmarkPointCloudOctree(4000000, results);
+}
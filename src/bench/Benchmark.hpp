@@ -0,0 +1,73 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace UniEngine::Bench
+{
+struct BenchmarkResult
+{
+    std::string m_name;
+    size_t m_iterations = 0;
+    double m_minMilliseconds = 0;
+    double m_meanMilliseconds = 0;
+    /**
+     * Size of the data the benchmark produces, for benchmarks that compare memory layouts. 0 when not measured.
+     */
+    size_t m_bytes = 0;
+};
+
+/**
+ * Run func iterations times and record the fastest and the mean wall time of a single run.
+ */
+inline BenchmarkResult Measure(const std::string &name, const size_t &iterations, const std::function<void()> &func)
+{
+    BenchmarkResult result;
+    result.m_name = name;
+    result.m_iterations = iterations;
+    result.m_minMilliseconds = std::numeric_limits<double>::max();
+    double total = 0;
+    for (size_t i = 0; i < iterations; i++)
+    {
+        const auto start = std::chrono::high_resolution_clock::now();
+        func();
+        const double time =
+            std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        total += time;
+        result.m_minMilliseconds = (std::min)(result.m_minMilliseconds, time);
+    }
+    result.m_meanMilliseconds = iterations == 0 ? 0 : total / iterations;
+    return result;
+}
+
+/**
+ * Shortest decimal form of value for benchmark names, "10" and "0.05" rather than "10.000000" and "0.050000".
+ */
+inline std::string FormatNumber(const double &value)
+{
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%g", value);
+    return buffer;
+}
+
+/**
+ * Create the application headless with every frame the macro suite runs. Replaces Jobs::Init and Entities::Init, the
+ * application initializes both.
+ */
+void CreateHeadlessApplication();
+
+void RunSpatialBenchmarks(std::vector<BenchmarkResult> &results);
+void RunEcsBenchmarks(std::vector<BenchmarkResult> &results);
+void RunSceneBenchmarks(std::vector<BenchmarkResult> &results);
+void RunAssetBenchmarks(std::vector<BenchmarkResult> &results);
+void RunProfilerBenchmarks(std::vector<BenchmarkResult> &results);
+/**
+ * Whole frames of the headless application for a few representative scenes. Needs CreateHeadlessApplication and the
+ * internal resources next to the executable.
+ */
+void RunMacroBenchmarks(std::vector<BenchmarkResult> &results);
+} // namespace UniEngine::Bench
@@ -0,0 +1,93 @@
+#include "Benchmark.hpp"
+#include <ClassRegistry.hpp>
+#include <Entities.hpp>
+#include <Jobs.hpp>
+#include <ProjectManager.hpp>
+#include <Scene.hpp>
+using namespace UniEngine;
+
+namespace
+{
+// Distinct component types, so ForEach can be measured at every arity over the same archetype.
+template <int Index> struct BenchData : IDataComponent
+{
+    glm::vec4 m_value = glm::vec4(0.0f);
+};
+DataComponentRegistration<BenchData<0>> BenchData0Registry("BenchData0");
+DataComponentRegistration<BenchData<1>> BenchData1Registry("BenchData1");
+DataComponentRegistration<BenchData<2>> BenchData2Registry("BenchData2");
+DataComponentRegistration<BenchData<3>> BenchData3Registry("BenchData3");
+DataComponentRegistration<BenchData<4>> BenchData4Registry("BenchData4");
+DataComponentRegistration<BenchData<5>> BenchData5Registry("BenchData5");
+DataComponentRegistration<BenchData<6>> BenchData6Registry("BenchData6");
+DataComponentRegistration<BenchData<7>> BenchData7Registry("BenchData7");
+
+template <int... Indices>
+void MeasureForEach(
+    const std::shared_ptr<Scene> &scene,
+    const EntityQuery &query,
+    const std::string &suffix,
+    std::vector<Bench::BenchmarkResult> &results,
+    std::integer_sequence<int, Indices...>)
+{
+    const auto name = "ForEach, " + std::to_string(sizeof...(Indices)) + " components" + suffix;
+    results.push_back(Bench::Measure(name, 10, [&]() {
+        scene->ForEach<BenchData<Indices>...>(
+            Jobs::Workers(), query, [](int i, Entity entity, BenchData<Indices> &...data) {
+                ((data.m_value += 1.0f), ...);
+            });
+    }));
+}
+
+template <int... Arities>
+void MeasureForEachArities(
+    const std::shared_ptr<Scene> &scene,
+    const EntityQuery &query,
+    const std::string &suffix,
+    std::vector<Bench::BenchmarkResult> &results,
+    std::integer_sequence<int, Arities...>)
+{
+    (MeasureForEach(scene, query, suffix, results, std::make_integer_sequence<int, Arities + 1>()), ...);
+}
+
+void BenchmarkAmount(const size_t &amount, std::vector<Bench::BenchmarkResult> &results)
+{
+    const auto archetype = Entities::CreateEntityArchetype(
+        "Bench",
+        BenchData<0>(),
+        BenchData<1>(),
+        BenchData<2>(),
+        BenchData<3>(),
+        BenchData<4>(),
+        BenchData<5>(),
+        BenchData<6>(),
+        BenchData<7>());
+    const std::string suffix = " (" + std::to_string(amount) + ")";
+
+    // Scenes outlive the measurement so their destruction is not timed.
+    std::vector<std::shared_ptr<Scene>> scenes;
+    results.push_back(Bench::Measure("CreateEntities" + suffix, 5, [&]() {
+        scenes.push_back(ProjectManager::CreateTemporaryAsset<Scene>());
+        scenes.back()->CreateEntities(archetype, amount);
+    }));
+    const auto scene = scenes.back();
+    scenes.clear();
+
+    auto query = Entities::CreateEntityQuery();
+    query.SetAllFilters(BenchData<0>());
+    MeasureForEachArities(scene, query, suffix, results, std::make_integer_sequence<int, 8>());
+
+    std::vector<BenchData<0>> container;
+    container.reserve(amount);
+    results.push_back(Bench::Measure("GetComponentDataArray" + suffix, 10, [&]() {
+        container.clear();
+        scene->GetComponentDataArray(query, container);
+    }));
+}
+} // namespace
+
+void Bench::RunEcsBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    BenchmarkAmount(100000, results);
+    BenchmarkAmount(1000000, results);
+}
@@ -0,0 +1,163 @@
+#include "Benchmark.hpp"
+#include <Application.hpp>
+#include <Camera.hpp>
+#include <DefaultResources.hpp>
+#include <Lights.hpp>
+#include <MeshRenderer.hpp>
+#include <ProjectManager.hpp>
+#include <Scene.hpp>
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+using namespace UniEngine;
+
+namespace
+{
+// Frames at the start of every scenario that are not measured, the first ones upload meshes and build caches.
+constexpr size_t WarmupFrames = 5;
+
+struct Scenario
+{
+    std::string m_name;
+    size_t m_frames;
+    std::function<void(const std::shared_ptr<Scene> &)> m_build;
+};
+
+/**
+ * Main camera looking down at the origin from distance, and a directional light that casts shadows.
+ */
+void AddCameraAndLight(const std::shared_ptr<Scene> &scene, const float &distance)
+{
+    const auto cameraEntity = scene->CreateEntity("Main Camera");
+    Transform cameraTransform;
+    cameraTransform.SetPosition(glm::vec3(0.0f, distance * 0.5f, distance));
+    cameraTransform.SetEulerRotation(glm::radians(glm::vec3(-25.0f, 0.0f, 0.0f)));
+    scene->SetDataComponent(cameraEntity, cameraTransform);
+    const auto camera = scene->GetOrSetPrivateComponent<Camera>(cameraEntity).lock();
+    camera->m_farDistance = distance * 4.0f;
+    scene->m_mainCamera = camera;
+
+    const auto lightEntity = scene->CreateEntity("Sun");
+    Transform lightTransform;
+    lightTransform.SetEulerRotation(glm::radians(glm::vec3(-60.0f, 30.0f, 0.0f)));
+    scene->SetDataComponent(lightEntity, lightTransform);
+    scene->GetOrSetPrivateComponent<DirectionalLight>(lightEntity);
+}
+
+/**
+ * Square grid of mesh renderers on the XZ plane, cycling through three default primitives and the materials.
+ */
+void AddRendererGrid(
+    const std::shared_ptr<Scene> &scene, const size_t &amount, const size_t &materialAmount, const bool &isStatic)
+{
+    std::vector<std::shared_ptr<Material>> materials(materialAmount);
+    for (size_t i = 0; i < materialAmount; i++)
+    {
+        materials[i] = ProjectManager::CreateTemporaryAsset<Material>();
+        materials[i]->SetProgram(DefaultResources::GLPrograms::StandardProgram);
+        materials[i]->m_materialProperties.m_roughness = static_cast<float>(i) / materialAmount;
+    }
+    const std::shared_ptr<Mesh> meshes[] = {
+        DefaultResources::Primitives::Cube, DefaultResources::Primitives::Sphere, DefaultResources::Primitives::Cylinder};
+    const auto side = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(amount))));
+    const auto entities = scene->CreateEntities(amount, "Renderer");
+    for (size_t i = 0; i < amount; i++)
+    {
+        Transform transform;
+        transform.SetPosition(
+            glm::vec3(static_cast<float>(i % side) - side * 0.5f, 0.0f, static_cast<float>(i / side) - side * 0.5f) *
+            2.0f);
+        scene->SetDataComponent(entities[i], transform);
+        // The transform layer skips static roots, their global transform is only written here.
+        GlobalTransform globalTransform;
+        globalTransform.m_value = transform.m_value;
+        scene->SetDataComponent(entities[i], globalTransform);
+        const auto meshRenderer = scene->GetOrSetPrivateComponent<MeshRenderer>(entities[i]).lock();
+        meshRenderer->m_mesh.Set<Mesh>(meshes[i % 3]);
+        meshRenderer->m_material.Set<Material>(materials[i % materialAmount]);
+        if (isStatic)
+            scene->SetEntityStatic(entities[i], true);
+    }
+}
+
+std::vector<Scenario> Scenarios()
+{
+    return {
+        {"4096 mesh renderers, 16 materials, 1 directional light", 120, [](const std::shared_ptr<Scene> &scene) {
+             AddCameraAndLight(scene, 80.0f);
+             AddRendererGrid(scene, 4096, 16, false);
+         }},
+        {"200000 static mesh renderers, 16 materials, 1 directional light", 60, [](const std::shared_ptr<Scene> &scene) {
+             AddCameraAndLight(scene, 600.0f);
+             AddRendererGrid(scene, 200000, 16, true);
+         }}};
+}
+} // namespace
+
+void Bench::CreateHeadlessApplication()
+{
+    ApplicationConfigs applicationConfigs;
+    applicationConfigs.m_applicationName = "uniengine-bench";
+    applicationConfigs.m_headless = true;
+    // A new project every run, an existing one would load its saved start scene.
+    const auto projectFolder = std::filesystem::temp_directory_path() / "uniengine-bench";
+    std::filesystem::remove_all(projectFolder);
+    applicationConfigs.m_projectPath = projectFolder / "Bench.ueproj";
+    // One more frame than the scenarios need, the time of a frame is taken when the next one starts.
+    size_t frameLimit = 1;
+    for (const auto &scenario : Scenarios())
+        frameLimit += scenario.m_frames;
+    applicationConfigs.m_frameLimit = frameLimit;
+    Application::Create(applicationConfigs);
+}
+
+void Bench::RunMacroBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    const auto scenarios = Scenarios();
+    std::vector<std::vector<double>> frameTimes(scenarios.size());
+    size_t frame = 0;
+    auto frameStart = std::chrono::high_resolution_clock::now();
+    Application::RegisterPreUpdateFunction([&]() {
+        const auto now = std::chrono::high_resolution_clock::now();
+        // Scenario and frame within the scenario of the frame that starts now.
+        size_t scenarioIndex = 0;
+        size_t scenarioFrame = frame;
+        while (scenarioIndex < scenarios.size() && scenarioFrame >= scenarios[scenarioIndex].m_frames)
+            scenarioFrame -= scenarios[scenarioIndex++].m_frames;
+        if (frame != 0)
+        {
+            size_t previousIndex = scenarioIndex;
+            size_t previousFrame = scenarioFrame;
+            if (previousFrame == 0)
+                previousFrame = scenarios[--previousIndex].m_frames;
+            if (previousFrame - 1 >= WarmupFrames)
+                frameTimes[previousIndex].push_back(
+                    std::chrono::duration<double, std::milli>(now - frameStart).count());
+        }
+        if (scenarioIndex < scenarios.size() && scenarioFrame == 0)
+        {
+            const auto scene = ProjectManager::CreateTemporaryAsset<Scene>();
+            Application::Attach(scene);
+            scenarios[scenarioIndex].m_build(scene);
+        }
+        const auto scene = Application::GetActiveScene();
+        if (const auto camera = scene ? scene->m_mainCamera.Get<Camera>() : nullptr)
+            camera->SetRequireRendering(true);
+        frame++;
+        frameStart = std::chrono::high_resolution_clock::now();
+    });
+    Application::Start();
+    for (size_t i = 0; i < scenarios.size(); i++)
+    {
+        const auto &times = frameTimes[i];
+        BenchmarkResult result;
+        result.m_name = "Headless frame, " + scenarios[i].m_name;
+        result.m_iterations = times.size();
+        result.m_minMilliseconds = times.empty() ? 0 : *std::min_element(times.begin(), times.end());
+        double total = 0;
+        for (const auto &time : times)
+            total += time;
+        result.m_meanMilliseconds = times.empty() ? 0 : total / times.size();
+        results.push_back(result);
+    }
+}
@@ -0,0 +1,192 @@
+#include "Benchmark.hpp"
+#include <Application.hpp>
+#include <Entities.hpp>
+#include <Jobs.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+using namespace UniEngine;
+
+namespace
+{
+struct Suite
+{
+    const char *m_name;
+    void (*m_run)(std::vector<Bench::BenchmarkResult> &);
+};
+const Suite Suites[] = {
+    {"spatial", Bench::RunSpatialBenchmarks},
+    {"ecs", Bench::RunEcsBenchmarks},
+    {"scene", Bench::RunSceneBenchmarks},
+    {"asset", Bench::RunAssetBenchmarks},
+    {"profiler", Bench::RunProfilerBenchmarks},
+    {"macro", Bench::RunMacroBenchmarks}};
+
+void PrintUsage()
+{
+    printf("Usage: uniengine-bench [suite...] [--json <file>] [--compare <baseline>] [--threshold <percent>]\n");
+    printf("Suites: spatial, ecs, scene, asset, profiler, macro. All of them run when none is given.\n");
+    printf("             macro runs whole frames of the headless application and needs the internal resources in\n");
+    printf("             the working directory.\n");
+    printf("--json       Write the results as JSON.\n");
+    printf("--compare    Compare the fastest run of every benchmark with a JSON file written by --json. The exit code\n");
+    printf("             is 1 when any benchmark is slower than the baseline by more than the threshold.\n");
+    printf("--threshold  Allowed slowdown in percent, 10 by default.\n");
+}
+
+std::string Escape(const std::string &value)
+{
+    std::string escaped;
+    for (const auto &c : value)
+    {
+        if (c == '"' || c == '\\')
+            escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+bool WriteJson(const std::string &path, const std::vector<Bench::BenchmarkResult> &results)
+{
+    std::ofstream file(path);
+    if (!file)
+        return false;
+    file.precision(9);
+    file << "{\n  \"workers\": " << Jobs::Workers().Size() << ",\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const auto &result = results[i];
+        file << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << Escape(result.m_name)
+             << "\", \"iterations\": " << result.m_iterations << ", \"min_ms\": " << result.m_minMilliseconds
+             << ", \"mean_ms\": " << result.m_meanMilliseconds;
+        if (result.m_bytes != 0)
+            file << ", \"bytes\": " << result.m_bytes;
+        file << "}";
+    }
+    file << "\n  ]\n}\n";
+    return true;
+}
+
+/**
+ * @return Amount of regressions, or -1 when the baseline can not be read.
+ */
+int Compare(const std::string &path, const std::vector<Bench::BenchmarkResult> &results, const double &threshold)
+{
+    // JSON is a subset of YAML, so the baseline is read with yaml-cpp.
+    std::map<std::string, double> baseline;
+    try
+    {
+        const auto in = YAML::LoadFile(path);
+        for (const auto &i : in["results"])
+            baseline[i["name"].as<std::string>()] = i["min_ms"].as<double>();
+    }
+    catch (const std::exception &e)
+    {
+        printf("Failed to read baseline %s: %s\n", path.c_str(), e.what());
+        return -1;
+    }
+    int regressions = 0;
+    printf("\n%-48s %12s %12s %10s\n", "Benchmark", "Base (ms)", "Min (ms)", "Change");
+    for (const auto &result : results)
+    {
+        const auto search = baseline.find(result.m_name);
+        if (search == baseline.end())
+        {
+            printf("%-48s %12s %12.3f %10s\n", result.m_name.c_str(), "-", result.m_minMilliseconds, "new");
+            continue;
+        }
+        const double change =
+            search->second > 0 ? (result.m_minMilliseconds / search->second - 1.0) * 100.0 : 0.0;
+        const bool regressed = change > threshold;
+        if (regressed)
+            regressions++;
+        printf(
+            "%-48s %12.3f %12.3f %+9.1f%%%s\n",
+            result.m_name.c_str(),
+            search->second,
+            result.m_minMilliseconds,
+            change,
+            regressed ? " REGRESSION" : "");
+    }
+    return regressions;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::vector<std::string> suiteNames;
+    std::string jsonPath;
+    std::string baselinePath;
+    double threshold = 10.0;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string argument = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (argument == "--json" && hasValue)
+            jsonPath = argv[++i];
+        else if (argument == "--compare" && hasValue)
+            baselinePath = argv[++i];
+        else if (argument == "--threshold" && hasValue)
+            threshold = std::atof(argv[++i]);
+        else if (!argument.empty() && argument[0] != '-')
+            suiteNames.push_back(argument);
+        else
+        {
+            PrintUsage();
+            return argument == "--help" ? 0 : 2;
+        }
+    }
+    for (const auto &name : suiteNames)
+    {
+        if (std::none_of(std::begin(Suites), std::end(Suites), [&](const Suite &suite) { return name == suite.m_name; }))
+        {
+            printf("Unknown suite: %s\n", name.c_str());
+            PrintUsage();
+            return 2;
+        }
+    }
+
+    const auto isSelected = [&](const std::string &name) {
+        return suiteNames.empty() || std::find(suiteNames.begin(), suiteNames.end(), name) != suiteNames.end();
+    };
+    const bool headless = isSelected("macro");
+    if (headless)
+    {
+        Bench::CreateHeadlessApplication();
+    }
+    else
+    {
+        Jobs::Init();
+        Entities::Init();
+    }
+    std::vector<Bench::BenchmarkResult> results;
+    for (const auto &suite : Suites)
+    {
+        if (isSelected(suite.m_name))
+            suite.m_run(results);
+    }
+    if (headless)
+        Application::End();
+    printf("%-48s %10s %12s %12s %12s\n", "Benchmark", "Iterations", "Min (ms)", "Mean (ms)", "Memory (KB)");
+    for (const auto &i : results)
+    {
+        printf("%-48s %10zu %12.3f %12.3f", i.m_name.c_str(), i.m_iterations, i.m_minMilliseconds, i.m_meanMilliseconds);
+        if (i.m_bytes != 0)
+            printf(" %12.1f", i.m_bytes / 1024.0);
+        printf("\n");
+    }
+
+    if (!jsonPath.empty() && !WriteJson(jsonPath, results))
+    {
+        printf("Failed to write %s\n", jsonPath.c_str());
+        return 1;
+    }
+    if (!baselinePath.empty())
+    {
+        const int regressions = Compare(baselinePath, results, threshold);
+        if (regressions != 0)
+            return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include "Benchmark.hpp"
+#include <Jobs.hpp>
+#include <TraceRecorder.hpp>
+#include <cstdio>
+using namespace UniEngine;
+
+namespace
+{
+// Scope pairs per thread and frame, below the ring capacity so that no event is dropped.
+constexpr size_t ScopeAmount = 30000;
+
+void RecordScopes()
+{
+    for (size_t i = 0; i < ScopeAmount; i++)
+    {
+        UNIENGINE_PROFILE_SCOPE("Bench");
+    }
+}
+} // namespace
+
+void Bench::RunProfilerBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    TraceRecorder::Clear();
+    TraceRecorder::SetRecording(false);
+    results.push_back(Measure("Trace scope, not recording (" + std::to_string(ScopeAmount) + ")", 10, RecordScopes));
+
+    TraceRecorder::SetRecording(true);
+    results.push_back(Measure("Trace scope, recording (" + std::to_string(ScopeAmount) + ")", 10, [&]() {
+        RecordScopes();
+        TraceRecorder::NewFrame();
+    }));
+
+    const size_t threadAmount = Jobs::Workers().Size();
+    results.push_back(Measure(
+        "Trace scope, recording on " + std::to_string(threadAmount) + " workers (" + std::to_string(ScopeAmount) +
+            " each)",
+        10,
+        [&]() {
+            std::vector<std::shared_future<void>> futures;
+            for (size_t i = 0; i < threadAmount; i++)
+                futures.push_back(Jobs::Workers().Push([](int) { RecordScopes(); }).share());
+            for (const auto &i : futures)
+                i.wait();
+            TraceRecorder::NewFrame();
+        }));
+    const auto droppedEvents = TraceRecorder::GetDroppedEventAmount();
+    if (droppedEvents != 0)
+        printf("Trace recorder dropped %zu events\n", droppedEvents);
+    TraceRecorder::SetRecording(false);
+    TraceRecorder::NewFrame();
+    TraceRecorder::Clear();
+}
@@ -0,0 +1,86 @@
+#include "Benchmark.hpp"
+#include <Application.hpp>
+#include <ProjectManager.hpp>
+#include <Scene.hpp>
+#include <TransformLayer.hpp>
+#include <random>
+using namespace UniEngine;
+
+namespace
+{
+// Entities of the deep hierarchy form chains of this length.
+constexpr size_t ChainLength = 100;
+
+std::shared_ptr<Scene> CreateHierarchy(const size_t &amount, const size_t &chainLength)
+{
+    const auto scene = ProjectManager::CreateTemporaryAsset<Scene>();
+    const auto entities = scene->CreateEntities(amount);
+    std::mt19937 random(amount);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    for (size_t i = 0; i < amount; i++)
+    {
+        Transform transform;
+        transform.SetPosition(glm::vec3(distribution(random), distribution(random), distribution(random)));
+        transform.SetEulerRotation(glm::vec3(distribution(random), distribution(random), distribution(random)));
+        scene->SetDataComponent(entities[i], transform);
+        if (i % chainLength != 0)
+            scene->SetParent(entities[i], entities[i - 1]);
+    }
+    return scene;
+}
+
+void BenchmarkTransforms(const size_t &amount, std::vector<Bench::BenchmarkResult> &results)
+{
+    TransformLayer transformLayer;
+    const std::string suffix = " (" + std::to_string(amount) + ")";
+    const auto flatScene = CreateHierarchy(amount, 1);
+    results.push_back(Bench::Measure("Transform propagation, flat" + suffix, 10, [&]() {
+        transformLayer.CalculateTransformGraphs(flatScene, false);
+    }));
+    const auto deepScene = CreateHierarchy(amount, ChainLength);
+    results.push_back(
+        Bench::Measure("Transform propagation, chains of " + std::to_string(ChainLength) + suffix, 10, [&]() {
+            transformLayer.CalculateTransformGraphs(deepScene, false);
+        }));
+}
+
+void BenchmarkSerialization(const size_t &amount, std::vector<Bench::BenchmarkResult> &results)
+{
+    const std::string suffix = " (" + std::to_string(amount) + ")";
+    const auto scene = CreateHierarchy(amount, 10);
+    std::string serialized;
+    results.push_back(Bench::Measure("Scene serialize" + suffix, 3, [&]() {
+        YAML::Emitter out;
+        out << YAML::BeginMap;
+        scene->Serialize(out);
+        out << YAML::EndMap;
+        serialized = out.c_str();
+    }));
+    YAML::Node in;
+    results.push_back(Bench::Measure("Scene YAML parse" + suffix, 3, [&]() { in = YAML::Load(serialized); }));
+
+    // Scenes outlive the measurement so their destruction is not timed. Deserialization resolves references through
+    // the active scene, like Scene::LoadInternal.
+    std::vector<std::shared_ptr<Scene>> scenes;
+    const auto previousScene = Application::GetActiveScene();
+    results.push_back(Bench::Measure("Scene deserialize" + suffix, 3, [&]() {
+        scenes.push_back(ProjectManager::CreateTemporaryAsset<Scene>());
+        Application::Attach(scenes.back());
+        scenes.back()->Deserialize(in);
+    }));
+    Application::Attach(previousScene);
+    scenes.clear();
+
+    results.push_back(Bench::Measure("Scene::Clone" + suffix, 3, [&]() {
+        scenes.push_back(ProjectManager::CreateTemporaryAsset<Scene>());
+        Scene::Clone(scene, scenes.back());
+    }));
+}
+} // namespace
+
+void Bench::RunSceneBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    BenchmarkTransforms(100000, results);
+    BenchmarkTransforms(1000000, results);
+    BenchmarkSerialization(10000, results);
+}
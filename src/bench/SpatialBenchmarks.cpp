@@ -0,0 +1,101 @@
+#include "Benchmark.hpp"
+#include <BoundingVolumeHierarchy.hpp>
+#include <ProjectManager.hpp>
+#include <Scene.hpp>
+#include <random>
+using namespace UniEngine;
+
+namespace
+{
+// Objects are scattered in a cube of this half size with half extents between 0.2 and 3.
+constexpr float WorldHalfSize = 500.0f;
+
+void BenchmarkAmount(const size_t &amount, std::vector<Bench::BenchmarkResult> &results)
+{
+    const auto scene = ProjectManager::CreateTemporaryAsset<Scene>();
+    const auto entities = scene->CreateEntities(amount);
+    std::mt19937 random(amount);
+    std::uniform_real_distribution<float> positionDistribution(-WorldHalfSize, WorldHalfSize);
+    std::uniform_real_distribution<float> extentDistribution(0.2f, 3.0f);
+    std::uniform_real_distribution<float> offsetDistribution(-1.0f, 1.0f);
+    std::vector<Bound> bounds(amount);
+    for (auto &bound : bounds)
+    {
+        const glm::vec3 center(positionDistribution(random), positionDistribution(random), positionDistribution(random));
+        const glm::vec3 extent(extentDistribution(random), extentDistribution(random), extentDistribution(random));
+        bound.m_min = center - extent;
+        bound.m_max = center + extent;
+    }
+    const std::string suffix = " (" + std::to_string(amount) + ")";
+
+    BoundingVolumeHierarchy bvh;
+    results.push_back(Bench::Measure("BVH build" + suffix, 3, [&]() {
+        bvh.Clear();
+        for (size_t i = 0; i < amount; i++)
+            bvh.Update(entities[i], bounds[i]);
+        bvh.RemoveStale();
+    }));
+    results.push_back(Bench::Measure("BVH update, static" + suffix, 10, [&]() {
+        for (size_t i = 0; i < amount; i++)
+            bvh.Update(entities[i], bounds[i]);
+        bvh.RemoveStale();
+    }));
+    results.push_back(Bench::Measure("BVH update, 10% moving" + suffix, 10, [&]() {
+        for (size_t i = 0; i < amount; i += 10)
+        {
+            const glm::vec3 offset(offsetDistribution(random), offsetDistribution(random), offsetDistribution(random));
+            bounds[i].m_min += offset;
+            bounds[i].m_max += offset;
+        }
+        for (size_t i = 0; i < amount; i++)
+            bvh.Update(entities[i], bounds[i]);
+        bvh.RemoveStale();
+    }));
+
+    // A 60 degree camera at the center of the world looking along a diagonal, like RenderLayer builds it.
+    const Frustum frustum(
+        glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, WorldHalfSize) *
+        glm::lookAt(glm::vec3(0.0f), glm::vec3(1.0f, 0.2f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+    std::vector<Entity> queryResults;
+    queryResults.reserve(amount);
+    results.push_back(Bench::Measure("BVH frustum query" + suffix, 20, [&]() {
+        queryResults.clear();
+        bvh.QueryFrustum(frustum, queryResults);
+    }));
+    PackedBounds packedBounds;
+    packedBounds.Reserve(amount);
+    for (const auto &bound : bounds)
+        packedBounds.Push(bound);
+    std::vector<unsigned char> visibility;
+    results.push_back(Bench::Measure("PackedBounds frustum cull" + suffix, 20, [&]() {
+        packedBounds.Cull(frustum, visibility);
+    }));
+
+    constexpr size_t QueryAmount = 1000;
+    std::vector<glm::vec3> queryPoints(QueryAmount);
+    for (auto &point : queryPoints)
+        point = glm::vec3(positionDistribution(random), positionDistribution(random), positionDistribution(random));
+    results.push_back(Bench::Measure("BVH 1000 sphere queries, r = 20" + suffix, 10, [&]() {
+        for (const auto &point : queryPoints)
+        {
+            queryResults.clear();
+            bvh.QuerySphere(point, 20.0f, queryResults);
+        }
+    }));
+    results.push_back(Bench::Measure("BVH 1000 ray casts" + suffix, 10, [&]() {
+        Entity entity;
+        float distance;
+        for (const auto &point : queryPoints)
+        {
+            const Ray ray(point, glm::normalize(-point), 2.0f * WorldHalfSize);
+            (void)bvh.RayCast(ray, entity, distance);
+        }
+    }));
+}
+} // namespace
+
+void Bench::RunSpatialBenchmarks(std::vector<BenchmarkResult> &results)
+{
+    BenchmarkAmount(100000, results);
+    BenchmarkAmount(1000000, results);
+}
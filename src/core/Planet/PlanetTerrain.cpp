@@ -32,30 +32,24 @@ void Planet::PlanetTerrain::Deserialize(const YAML::Node &out)
 void Planet::PlanetTerrain::Init()
 {
     if(m_initialized) return;
-    m_sharedVertices = std::vector<Vertex>();
     size_t resolution = m_info.m_resolution;
-    m_sharedVertices.resize(resolution * resolution);
-    m_sharedTriangles = std::vector<unsigned>();
-    m_sharedTriangles.resize((resolution - 1) * (resolution - 1) * 6);
+    m_sharedVertexStreams.Clear();
+    m_sharedVertexStreams.m_positions.resize(resolution * resolution);
+    m_sharedVertexStreams.SetAttribute(VertexAttribute::TexCoord, true);
+    m_sharedTriangles = std::vector<glm::uvec3>();
+    m_sharedTriangles.reserve((resolution - 1) * (resolution - 1) * 2);
 
-    size_t triIndex = 0;
     for (size_t y = 0; y < resolution; y++)
     {
         for (size_t x = 0; x < resolution; x++)
         {
             size_t i = x + y * resolution;
-            m_sharedVertices[i].m_texCoord =
+            m_sharedVertexStreams.m_texCoords[i] =
                 glm::vec2(static_cast<float>(x) / (resolution - 1), static_cast<float>(y) / (resolution - 1));
             if (x != resolution - 1 && y != resolution - 1)
             {
-                m_sharedTriangles[triIndex] = i;
-                m_sharedTriangles[triIndex + 1] = i + resolution + 1;
-                m_sharedTriangles[triIndex + 2] = i + resolution;
-
-                m_sharedTriangles[triIndex + 3] = i;
-                m_sharedTriangles[triIndex + 4] = i + 1;
-                m_sharedTriangles[triIndex + 5] = i + resolution + 1;
-                triIndex += 6;
+                m_sharedTriangles.emplace_back(i, i + resolution + 1, i + resolution);
+                m_sharedTriangles.emplace_back(i, i + 1, i + resolution + 1);
             }
         }
     }
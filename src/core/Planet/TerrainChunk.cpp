@@ -117,40 +117,49 @@ void Planet::TerrainChunk::GenerateTerrain(std::mutex &mutex, std::shared_ptr<Te
     {
         Console::Error("Mesh Exist!");
     }
-    std::vector<Vertex> &vertices = m_planetTerrain->m_sharedVertices;
-    auto size = vertices.size();
-    auto resolution = m_planetTerrain->m_info.m_resolution;
-    for (auto index = 0; index < size; index++)
+    // The elevation loop waits on the workers and the mesh is uploaded to the GL context, neither works on a worker.
+    if (Jobs::IsWorkerThread())
     {
-        int actualDetailLevel = (int)glm::pow(2, targetChunk->m_detailLevel);
-        int x = index % resolution;
-        int y = index / resolution;
-        glm::dvec2 percent = glm::dvec2(x, y) / (double)(resolution - 1) / (double)actualDetailLevel;
-        glm::dvec2 globalPercent =
-            45.0 * glm::dvec2(
-                       (percent.x + (double)targetChunk->m_chunkCoordinate.x / actualDetailLevel - 0.5) * 2.0,
-                       (percent.y + (double)targetChunk->m_chunkCoordinate.y / actualDetailLevel - 0.5) * 2.0);
-        glm::dvec2 actualPercent =
-            glm::dvec2(glm::tan(glm::radians(globalPercent.x)), glm::tan(glm::radians(globalPercent.y)));
-        glm::dvec3 pointOnUnitCube =
-            targetChunk->m_localUp + actualPercent.x * targetChunk->m_axisA + actualPercent.y * targetChunk->m_axisB;
-        pointOnUnitCube = glm::normalize(pointOnUnitCube);
-        double elevation = 1.0;
-
-        double previousResult = 1.0;
-        for (auto &stage : m_planetTerrain->m_terrainConstructionStages)
-        {
-            stage->Process(pointOnUnitCube, previousResult, elevation);
-            previousResult = elevation;
-        }
-        vertices.at(index).m_position = glm::vec3(pointOnUnitCube * m_planetTerrain->m_info.m_radius * elevation);
+        Console::Error("Terrain chunks can only be generated on the main thread!");
+        return;
     }
+    auto vertexStreams = m_planetTerrain->m_sharedVertexStreams;
+    auto &positions = vertexStreams.m_positions;
+    auto resolution = m_planetTerrain->m_info.m_resolution;
+    int actualDetailLevel = (int)glm::pow(2, targetChunk->m_detailLevel);
+    std::vector<std::shared_future<void>> results;
+    Jobs::ParallelFor(
+        positions.size(),
+        [&](unsigned index) {
+            int x = index % resolution;
+            int y = index / resolution;
+            glm::dvec2 percent = glm::dvec2(x, y) / (double)(resolution - 1) / (double)actualDetailLevel;
+            glm::dvec2 globalPercent =
+                45.0 * glm::dvec2(
+                           (percent.x + (double)targetChunk->m_chunkCoordinate.x / actualDetailLevel - 0.5) * 2.0,
+                           (percent.y + (double)targetChunk->m_chunkCoordinate.y / actualDetailLevel - 0.5) * 2.0);
+            glm::dvec2 actualPercent =
+                glm::dvec2(glm::tan(glm::radians(globalPercent.x)), glm::tan(glm::radians(globalPercent.y)));
+            glm::dvec3 pointOnUnitCube = targetChunk->m_localUp + actualPercent.x * targetChunk->m_axisA +
+                                         actualPercent.y * targetChunk->m_axisB;
+            pointOnUnitCube = glm::normalize(pointOnUnitCube);
+            double elevation = 1.0;
+
+            double previousResult = 1.0;
+            for (auto &stage : m_planetTerrain->m_terrainConstructionStages)
+            {
+                stage->Process(pointOnUnitCube, previousResult, elevation);
+                previousResult = elevation;
+            }
+            positions[index] = glm::vec3(pointOnUnitCube * m_planetTerrain->m_info.m_radius * elevation);
+        },
+        results);
+    for (auto &result : results)
+        result.wait();
     std::lock_guard<std::mutex> lock(mutex);
     auto mesh = ProjectManager::CreateTemporaryAsset<Mesh>();
-    mesh->SetVertices(
-        1 | static_cast<unsigned>(VertexAttribute::TexCoord),
-        m_planetTerrain->m_sharedVertices,
-        m_planetTerrain->m_sharedTriangles);
+    // Normals and tangents are filled in by the shared mesh kernels.
+    mesh->SetVertices(std::move(vertexStreams), m_planetTerrain->m_sharedTriangles);
     targetChunk->m_mesh = std::move(mesh);
 }
 
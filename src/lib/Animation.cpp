@@ -237,6 +237,31 @@ void Animation::OnInspect()
     if (!m_rootBone)
         return;
     ImGui::Text(("Bone size: " + std::to_string(m_boneSize)).c_str());
+    if (ImGui::TreeNode("Compression##Animation"))
+    {
+        static AnimationCompressionSettings settings;
+        ImGui::DragFloat("Position error##Animation", &settings.m_positionError, 0.0001f, 0.0f, 1.0f, "%.4f");
+        ImGui::DragFloat("Angular error (degrees)##Animation", &settings.m_angularError, 0.01f, 0.0f, 10.0f);
+        ImGui::DragFloat("Scale error##Animation", &settings.m_scaleError, 0.0001f, 0.0f, 1.0f, "%.4f");
+        ImGui::Checkbox("Quantize##Animation", &settings.m_quantize);
+        // Removed keys are gone for good, compressing again with tighter tolerances does not bring them back.
+        if (ImGui::Button("Compress##Animation"))
+            Compress(settings);
+        ImGui::Text("Quantized: %s", m_quantized ? "Yes" : "No");
+        for (const auto &report : m_compressionReports)
+        {
+            ImGui::Text(
+                "%s: %zu -> %zu keys, %.1fx, max error %.4f / %.3f deg / %.4f",
+                report.m_name.c_str(),
+                report.m_keysBefore,
+                report.m_keysAfter,
+                report.GetRatio(),
+                report.m_maxPositionError,
+                report.m_maxAngularError,
+                report.m_maxScaleError);
+        }
+        ImGui::TreePop();
+    }
     m_rootBone->OnInspect();
 }
 
@@ -250,11 +275,780 @@ void Animation::Animate(
     {
         return;
     }
-    m_rootBone->Animate(name, animationTime, rootTransform, rootTransform, results);
+    Animate(GetClipIndex(name), animationTime, rootTransform, results);
+}
+
+#pragma region Baked
+namespace
+{
+/**
+ * Same key as the linear search of BoneKeyFrames: the first key whose successor is later than the time, or the second
+ * last key.
+ */
+uint32_t FindKey(const float *times, const uint32_t &size, const float &time, uint32_t &cursor)
+{
+    const uint32_t last = size - 2;
+    const auto isKey = [&](const uint32_t &key) {
+        return key <= last && (key == 0 || time >= times[key]) && (key == last || time < times[key + 1]);
+    };
+    if (isKey(cursor))
+        return cursor;
+    if (isKey(cursor + 1))
+        return ++cursor;
+    const auto key = static_cast<uint32_t>(std::upper_bound(times + 1, times + size, time) - (times + 1));
+    cursor = (std::min)(key, last);
+    return cursor;
+}
+
+// Translation * rotation * scale without the matrix products.
+glm::mat4 ComposeLocal(const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &scale)
+{
+    glm::mat4 local = glm::mat4_cast(rotation);
+    local[0] *= scale.x;
+    local[1] *= scale.y;
+    local[2] *= scale.z;
+    local[3] = glm::vec4(position, 1.0f);
+    return local;
+}
+
+template <typename T> T Interpolate(const T &a, const T &b, const float &factor)
+{
+    if constexpr (std::is_same_v<T, glm::quat>)
+        return glm::slerp(a, b, factor);
+    else
+        return glm::mix(a, b, factor);
+}
+
+// fetch(i) returns the value of key i of the clip.
+template <typename T, typename Fetch>
+bool SampleKeys(
+    const std::vector<uint32_t> &begin,
+    const std::vector<float> &times,
+    const Fetch &fetch,
+    const size_t &bone,
+    const float &time,
+    uint32_t &cursor,
+    T &result)
+{
+    const uint32_t first = begin[bone];
+    const uint32_t size = begin[bone + 1] - first;
+    if (size == 0)
+        return false;
+    if (size == 1)
+    {
+        result = fetch(first);
+        return true;
+    }
+    const uint32_t key = FindKey(times.data() + first, size, time, cursor);
+    const float factor = BoneKeyFrames::GetScaleFactor(times[first + key], times[first + key + 1], time);
+    result = Interpolate<T>(fetch(first + key), fetch(first + key + 1), factor);
+    return true;
+}
+
+#pragma region Quantization
+constexpr float QuantizedVectorMax = 65535.0f;
+// The three smallest components of a unit quaternion lie within +-1/sqrt(2), stored with 15 bits each.
+constexpr float SmallestThreeRange = 0.70710678f;
+constexpr float SmallestThreeMax = 32767.0f;
+// Largest angle between a quaternion and its smallest three decoding, in degrees, with some margin.
+constexpr float SmallestThreeAngularError = 0.01f;
+
+void GetRange(const std::vector<glm::vec3> &values, glm::vec3 &min, glm::vec3 &extent)
+{
+    min = glm::vec3(FLT_MAX);
+    glm::vec3 max = glm::vec3(-FLT_MAX);
+    for (const auto &i : values)
+    {
+        min = (glm::min)(min, i);
+        max = (glm::max)(max, i);
+    }
+    if (values.empty())
+        min = max = glm::vec3(0.0f);
+    extent = max - min;
+}
+
+// Largest distance between a vector of the range and its quantized value.
+float GetQuantizationError(const glm::vec3 &extent)
+{
+    return glm::length(extent) / QuantizedVectorMax * 0.5f;
+}
+
+glm::u16vec3 QuantizeVector(const glm::vec3 &value, const glm::vec3 &min, const glm::vec3 &extent)
+{
+    glm::u16vec3 result;
+    for (int i = 0; i < 3; i++)
+    {
+        const float normalized = extent[i] > 0.0f ? (value[i] - min[i]) / extent[i] : 0.0f;
+        result[i] = static_cast<uint16_t>(glm::round(glm::clamp(normalized, 0.0f, 1.0f) * QuantizedVectorMax));
+    }
+    return result;
+}
+
+glm::vec3 DequantizeVector(const glm::u16vec3 &value, const glm::vec3 &min, const glm::vec3 &extent)
+{
+    return min + glm::vec3(value) * (extent / QuantizedVectorMax);
+}
+
+// The index of the dropped largest component goes into the top bits of the first two components.
+glm::u16vec3 QuantizeRotation(const glm::quat &rotation)
+{
+    const glm::quat normalized = glm::normalize(rotation);
+    float components[4] = {normalized.x, normalized.y, normalized.z, normalized.w};
+    int largest = 0;
+    for (int i = 1; i < 4; i++)
+    {
+        if (glm::abs(components[i]) > glm::abs(components[largest]))
+            largest = i;
+    }
+    // q and -q are the same rotation, keep the largest component positive so its sign need not be stored.
+    const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+    glm::u16vec3 result;
+    for (int i = 0, j = 0; i < 4; i++)
+    {
+        if (i == largest)
+            continue;
+        const float normalizedComponent = glm::clamp(sign * components[i] / SmallestThreeRange * 0.5f + 0.5f, 0.0f, 1.0f);
+        result[j++] = static_cast<uint16_t>(glm::round(normalizedComponent * SmallestThreeMax));
+    }
+    result[0] |= static_cast<uint16_t>((largest & 1) << 15);
+    result[1] |= static_cast<uint16_t>((largest >> 1) << 15);
+    return result;
+}
+
+glm::quat DequantizeRotation(const glm::u16vec3 &value)
+{
+    const int largest = (value[0] >> 15) | ((value[1] >> 15) << 1);
+    float components[4];
+    float sum = 0.0f;
+    for (int i = 0, j = 0; i < 4; i++)
+    {
+        if (i == largest)
+            continue;
+        components[i] = ((value[j++] & 0x7FFF) / SmallestThreeMax * 2.0f - 1.0f) * SmallestThreeRange;
+        sum += components[i] * components[i];
+    }
+    components[largest] = glm::sqrt((glm::max)(1.0f - sum, 0.0f));
+    return glm::quat(components[3], components[0], components[1], components[2]);
+}
+#pragma endregion
+
+// Breadth first, so every parent precedes its children. parentIndices gets the Bone::m_index of every parent.
+void CollectBones(
+    const std::shared_ptr<Bone> &root, std::vector<std::shared_ptr<Bone>> &bones, std::vector<int> &parentIndices)
+{
+    bones.clear();
+    parentIndices.clear();
+    if (!root)
+        return;
+    bones.push_back(root);
+    parentIndices.push_back(-1);
+    for (size_t i = 0; i < bones.size(); i++)
+    {
+        for (const auto &child : bones[i]->m_children)
+        {
+            bones.push_back(child);
+            parentIndices.push_back(static_cast<int>(bones[i]->m_index));
+        }
+    }
+}
+
+// Bytes of the keys of a clip as they are stored.
+size_t GetClipBytes(const BakedAnimationClip &clip)
+{
+    return (clip.m_positionBegin.size() + clip.m_rotationBegin.size() + clip.m_scaleBegin.size()) * sizeof(uint32_t) +
+           (clip.m_positionTimes.size() + clip.m_rotationTimes.size() + clip.m_scaleTimes.size()) * sizeof(float) +
+           (clip.m_positions.size() + clip.m_scales.size()) * sizeof(glm::vec3) +
+           clip.m_rotations.size() * sizeof(glm::quat) +
+           (clip.m_positionMin.size() + clip.m_positionExtent.size() + clip.m_scaleMin.size() +
+            clip.m_scaleExtent.size()) *
+               sizeof(glm::vec3) +
+           (clip.m_quantizedPositions.size() + clip.m_quantizedRotations.size() + clip.m_quantizedScales.size()) *
+               sizeof(glm::u16vec3);
+}
+
+template <typename T> void SaveArray(const std::string &name, const std::vector<T> &values, YAML::Emitter &out)
+{
+    if (values.empty())
+        return;
+    out << YAML::Key << name << YAML::Value
+        << YAML::Binary(reinterpret_cast<const unsigned char *>(values.data()), values.size() * sizeof(T));
+}
+
+template <typename T> void LoadArray(const std::string &name, std::vector<T> &values, const YAML::Node &in)
+{
+    values.clear();
+    if (!in[name])
+        return;
+    const auto binary = in[name].as<YAML::Binary>();
+    values.resize(binary.size() / sizeof(T));
+    std::memcpy(values.data(), binary.data(), values.size() * sizeof(T));
+}
+
+// Sample the local transform of the bone at order position i of a clip, channels without keys are left as they are.
+void SampleBone(
+    const BakedAnimationClip &clip,
+    const size_t &i,
+    const float &time,
+    uint32_t &positionKey,
+    uint32_t &rotationKey,
+    uint32_t &scaleKey,
+    glm::vec3 &position,
+    glm::quat &rotation,
+    glm::vec3 &scale)
+{
+    if (clip.m_quantized)
+    {
+        SampleKeys(
+            clip.m_positionBegin,
+            clip.m_positionTimes,
+            [&](const uint32_t &key) {
+                return DequantizeVector(clip.m_quantizedPositions[key], clip.m_positionMin[i], clip.m_positionExtent[i]);
+            },
+            i,
+            time,
+            positionKey,
+            position);
+        SampleKeys(
+            clip.m_rotationBegin,
+            clip.m_rotationTimes,
+            [&](const uint32_t &key) { return DequantizeRotation(clip.m_quantizedRotations[key]); },
+            i,
+            time,
+            rotationKey,
+            rotation);
+        SampleKeys(
+            clip.m_scaleBegin,
+            clip.m_scaleTimes,
+            [&](const uint32_t &key) {
+                return DequantizeVector(clip.m_quantizedScales[key], clip.m_scaleMin[i], clip.m_scaleExtent[i]);
+            },
+            i,
+            time,
+            scaleKey,
+            scale);
+        return;
+    }
+    SampleKeys(
+        clip.m_positionBegin,
+        clip.m_positionTimes,
+        [&](const uint32_t &key) { return clip.m_positions[key]; },
+        i,
+        time,
+        positionKey,
+        position);
+    SampleKeys(
+        clip.m_rotationBegin,
+        clip.m_rotationTimes,
+        [&](const uint32_t &key) { return clip.m_rotations[key]; },
+        i,
+        time,
+        rotationKey,
+        rotation);
+    SampleKeys(
+        clip.m_scaleBegin,
+        clip.m_scaleTimes,
+        [&](const uint32_t &key) { return clip.m_scales[key]; },
+        i,
+        time,
+        scaleKey,
+        scale);
+}
+} // namespace
+
+size_t BakedAnimation::GetMemoryUsage() const
+{
+    size_t bytes = m_boneIndices.capacity() * sizeof(uint32_t) + m_parentIndices.capacity() * sizeof(int);
+    for (const auto &clip : m_clips)
+    {
+        bytes += (clip.m_positionBegin.capacity() + clip.m_rotationBegin.capacity() + clip.m_scaleBegin.capacity()) *
+                     sizeof(uint32_t) +
+                 (clip.m_positionTimes.capacity() + clip.m_rotationTimes.capacity() + clip.m_scaleTimes.capacity()) *
+                     sizeof(float) +
+                 (clip.m_positions.capacity() + clip.m_scales.capacity()) * sizeof(glm::vec3) +
+                 clip.m_rotations.capacity() * sizeof(glm::quat) +
+                 (clip.m_positionMin.capacity() + clip.m_positionExtent.capacity() + clip.m_scaleMin.capacity() +
+                  clip.m_scaleExtent.capacity()) *
+                     sizeof(glm::vec3) +
+                 (clip.m_quantizedPositions.capacity() + clip.m_quantizedRotations.capacity() +
+                  clip.m_quantizedScales.capacity()) *
+                     sizeof(glm::u16vec3);
+    }
+    return bytes;
+}
+
+void Animation::Bake()
+{
+    std::lock_guard<std::mutex> lock(m_bakeMutex);
+    // The baked clips are the only copy of the keys of a quantized animation.
+    if (!m_quantized)
+        BakeInternal();
+}
+
+void Animation::BakeInternal()
+{
+    m_baked = BakedAnimation();
+    std::vector<std::shared_ptr<Bone>> bones;
+    CollectBones(m_rootBone, bones, m_baked.m_parentIndices);
+    for (const auto &bone : bones)
+        m_baked.m_boneIndices.push_back(static_cast<uint32_t>(bone->m_index));
+
+    for (const auto &i : m_animationNameAndLength)
+    {
+        BakedAnimationClip clip;
+        clip.m_name = i.first;
+        clip.m_length = i.second;
+        clip.m_quantized = m_quantized;
+        std::vector<glm::vec3> trackValues;
+        glm::vec3 min, extent;
+        for (const auto &bone : bones)
+        {
+            clip.m_positionBegin.push_back(static_cast<uint32_t>(clip.m_positionTimes.size()));
+            clip.m_rotationBegin.push_back(static_cast<uint32_t>(clip.m_rotationTimes.size()));
+            clip.m_scaleBegin.push_back(static_cast<uint32_t>(clip.m_scaleTimes.size()));
+            const auto search = bone->m_animations.find(i.first);
+            if (search == bone->m_animations.end())
+            {
+                if (m_quantized)
+                {
+                    clip.m_positionMin.emplace_back(0.0f);
+                    clip.m_positionExtent.emplace_back(0.0f);
+                    clip.m_scaleMin.emplace_back(0.0f);
+                    clip.m_scaleExtent.emplace_back(0.0f);
+                }
+                continue;
+            }
+            const auto &keyFrames = search->second;
+            for (const auto &key : keyFrames.m_positions)
+                clip.m_positionTimes.push_back(key.m_timeStamp);
+            for (const auto &key : keyFrames.m_rotations)
+                clip.m_rotationTimes.push_back(key.m_timeStamp);
+            for (const auto &key : keyFrames.m_scales)
+                clip.m_scaleTimes.push_back(key.m_timeStamp);
+            if (!m_quantized)
+            {
+                for (const auto &key : keyFrames.m_positions)
+                    clip.m_positions.push_back(key.m_value);
+                for (const auto &key : keyFrames.m_rotations)
+                    clip.m_rotations.push_back(key.m_value);
+                for (const auto &key : keyFrames.m_scales)
+                    clip.m_scales.push_back(key.m_value);
+                continue;
+            }
+            trackValues.clear();
+            for (const auto &key : keyFrames.m_positions)
+                trackValues.push_back(key.m_value);
+            GetRange(trackValues, min, extent);
+            clip.m_positionMin.push_back(min);
+            clip.m_positionExtent.push_back(extent);
+            for (const auto &value : trackValues)
+                clip.m_quantizedPositions.push_back(QuantizeVector(value, min, extent));
+            for (const auto &key : keyFrames.m_rotations)
+                clip.m_quantizedRotations.push_back(QuantizeRotation(key.m_value));
+            trackValues.clear();
+            for (const auto &key : keyFrames.m_scales)
+                trackValues.push_back(key.m_value);
+            GetRange(trackValues, min, extent);
+            clip.m_scaleMin.push_back(min);
+            clip.m_scaleExtent.push_back(extent);
+            for (const auto &value : trackValues)
+                clip.m_quantizedScales.push_back(QuantizeVector(value, min, extent));
+        }
+        clip.m_positionBegin.push_back(static_cast<uint32_t>(clip.m_positionTimes.size()));
+        clip.m_rotationBegin.push_back(static_cast<uint32_t>(clip.m_rotationTimes.size()));
+        clip.m_scaleBegin.push_back(static_cast<uint32_t>(clip.m_scaleTimes.size()));
+        m_baked.m_clips.push_back(std::move(clip));
+    }
+    m_bakeDirty = false;
+}
+
+void Animation::UnpackBakedKeys()
+{
+    std::vector<std::shared_ptr<Bone>> bones;
+    std::vector<int> parentIndices;
+    CollectBones(m_rootBone, bones, parentIndices);
+    for (const auto &clip : m_baked.m_clips)
+    {
+        for (size_t i = 0; i < bones.size() && i + 1 < clip.m_positionBegin.size(); i++)
+        {
+            BoneKeyFrames keyFrames;
+            for (uint32_t key = clip.m_positionBegin[i]; key < clip.m_positionBegin[i + 1]; key++)
+            {
+                keyFrames.m_positions.push_back(
+                    {clip.m_quantized ? DequantizeVector(
+                                            clip.m_quantizedPositions[key], clip.m_positionMin[i], clip.m_positionExtent[i])
+                                      : clip.m_positions[key],
+                     clip.m_positionTimes[key]});
+            }
+            for (uint32_t key = clip.m_rotationBegin[i]; key < clip.m_rotationBegin[i + 1]; key++)
+            {
+                keyFrames.m_rotations.push_back(
+                    {clip.m_quantized ? DequantizeRotation(clip.m_quantizedRotations[key]) : clip.m_rotations[key],
+                     clip.m_rotationTimes[key]});
+            }
+            for (uint32_t key = clip.m_scaleBegin[i]; key < clip.m_scaleBegin[i + 1]; key++)
+            {
+                keyFrames.m_scales.push_back(
+                    {clip.m_quantized
+                         ? DequantizeVector(clip.m_quantizedScales[key], clip.m_scaleMin[i], clip.m_scaleExtent[i])
+                         : clip.m_scales[key],
+                     clip.m_scaleTimes[key]});
+            }
+            if (keyFrames.m_positions.empty() && keyFrames.m_rotations.empty() && keyFrames.m_scales.empty())
+                continue;
+            for (const auto &key : keyFrames.m_positions)
+                keyFrames.m_maxTimeStamp = (glm::max)(keyFrames.m_maxTimeStamp, key.m_timeStamp);
+            for (const auto &key : keyFrames.m_rotations)
+                keyFrames.m_maxTimeStamp = (glm::max)(keyFrames.m_maxTimeStamp, key.m_timeStamp);
+            for (const auto &key : keyFrames.m_scales)
+                keyFrames.m_maxTimeStamp = (glm::max)(keyFrames.m_maxTimeStamp, key.m_timeStamp);
+            bones[i]->m_animations[clip.m_name] = std::move(keyFrames);
+        }
+    }
+    m_quantized = false;
+    m_bakeDirty = true;
+}
+
+const BakedAnimation &Animation::GetBaked()
+{
+    if (m_bakeDirty)
+    {
+        std::lock_guard<std::mutex> lock(m_bakeMutex);
+        if (m_bakeDirty)
+            BakeInternal();
+    }
+    return m_baked;
+}
+
+int Animation::GetClipIndex(const std::string &name)
+{
+    const auto &clips = GetBaked().m_clips;
+    // Clips are baked in the order of m_animationNameAndLength, which is sorted by name.
+    const auto search = std::lower_bound(
+        clips.begin(), clips.end(), name, [](const BakedAnimationClip &clip, const std::string &value) {
+            return clip.m_name < value;
+        });
+    if (search == clips.end() || search->m_name != name)
+        return -1;
+    return static_cast<int>(search - clips.begin());
+}
+
+void Animation::Animate(
+    const int &clipIndex,
+    const float &animationTime,
+    const glm::mat4 &rootTransform,
+    std::vector<glm::mat4> &results,
+    AnimationCursor *cursor)
+{
+    const auto &baked = GetBaked();
+    if (clipIndex < 0 || static_cast<size_t>(clipIndex) >= baked.m_clips.size())
+        return;
+    const auto &clip = baked.m_clips[clipIndex];
+    const auto boneAmount = baked.m_boneIndices.size();
+    if (cursor && (cursor->m_clipIndex != clipIndex || cursor->m_positionKeys.size() != boneAmount))
+    {
+        cursor->m_clipIndex = clipIndex;
+        cursor->m_positionKeys.assign(boneAmount, 0);
+        cursor->m_rotationKeys.assign(boneAmount, 0);
+        cursor->m_scaleKeys.assign(boneAmount, 0);
+    }
+    for (size_t i = 0; i < boneAmount; i++)
+    {
+        uint32_t positionKey = cursor ? cursor->m_positionKeys[i] : 0;
+        uint32_t rotationKey = cursor ? cursor->m_rotationKeys[i] : 0;
+        uint32_t scaleKey = cursor ? cursor->m_scaleKeys[i] : 0;
+        glm::vec3 position = glm::vec3(0.0f);
+        glm::quat rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+        glm::vec3 scale = glm::vec3(1.0f);
+        SampleBone(clip, i, animationTime, positionKey, rotationKey, scaleKey, position, rotation, scale);
+        if (cursor)
+        {
+            cursor->m_positionKeys[i] = positionKey;
+            cursor->m_rotationKeys[i] = rotationKey;
+            cursor->m_scaleKeys[i] = scaleKey;
+        }
+        const int parent = baked.m_parentIndices[i];
+        results[baked.m_boneIndices[i]] =
+            (parent < 0 ? rootTransform : results[parent]) * ComposeLocal(position, glm::normalize(rotation), scale);
+    }
+}
+
+void Animation::SamplePose(
+    const int &clipIndex, const float &animationTime, AnimationPose &pose, AnimationCursor *cursor)
+{
+    const auto &baked = GetBaked();
+    const auto boneAmount = baked.m_boneIndices.size();
+    pose.Resize(boneAmount);
+    pose.SetIdentity();
+    if (clipIndex < 0 || static_cast<size_t>(clipIndex) >= baked.m_clips.size())
+        return;
+    const auto &clip = baked.m_clips[clipIndex];
+    if (cursor && (cursor->m_clipIndex != clipIndex || cursor->m_positionKeys.size() != boneAmount))
+    {
+        cursor->m_clipIndex = clipIndex;
+        cursor->m_positionKeys.assign(boneAmount, 0);
+        cursor->m_rotationKeys.assign(boneAmount, 0);
+        cursor->m_scaleKeys.assign(boneAmount, 0);
+    }
+    for (size_t i = 0; i < boneAmount; i++)
+    {
+        uint32_t positionKey = cursor ? cursor->m_positionKeys[i] : 0;
+        uint32_t rotationKey = cursor ? cursor->m_rotationKeys[i] : 0;
+        uint32_t scaleKey = cursor ? cursor->m_scaleKeys[i] : 0;
+        SampleBone(
+            clip,
+            i,
+            animationTime,
+            positionKey,
+            rotationKey,
+            scaleKey,
+            pose.m_positions[i],
+            pose.m_rotations[i],
+            pose.m_scales[i]);
+        pose.m_rotations[i] = glm::normalize(pose.m_rotations[i]);
+        if (cursor)
+        {
+            cursor->m_positionKeys[i] = positionKey;
+            cursor->m_rotationKeys[i] = rotationKey;
+            cursor->m_scaleKeys[i] = scaleKey;
+        }
+    }
+}
+
+void Animation::ComposePose(const AnimationPose &pose, const glm::mat4 &rootTransform, std::vector<glm::mat4> &results)
+{
+    const auto &baked = GetBaked();
+    const auto boneAmount = (std::min)(baked.m_boneIndices.size(), pose.m_positions.size());
+    for (size_t i = 0; i < boneAmount; i++)
+    {
+        const int parent = baked.m_parentIndices[i];
+        results[baked.m_boneIndices[i]] = (parent < 0 ? rootTransform : results[parent]) *
+                                          ComposeLocal(pose.m_positions[i], pose.m_rotations[i], pose.m_scales[i]);
+    }
+}
+
+void AnimationPose::Resize(const size_t &boneAmount)
+{
+    m_positions.resize(boneAmount);
+    m_rotations.resize(boneAmount);
+    m_scales.resize(boneAmount);
+}
+
+void AnimationPose::SetIdentity()
+{
+    std::fill(m_positions.begin(), m_positions.end(), glm::vec3(0.0f));
+    std::fill(m_rotations.begin(), m_rotations.end(), glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+    std::fill(m_scales.begin(), m_scales.end(), glm::vec3(1.0f));
+}
+#pragma endregion
+#pragma region Compression
+namespace
+{
+float PositionError(const glm::vec3 &a, const glm::vec3 &b)
+{
+    return glm::distance(a, b);
+}
+
+// Angle between two rotations in degrees, from their difference rotation since acos is too coarse near 1.
+float AngularError(const glm::quat &a, const glm::quat &b)
+{
+    const glm::quat difference = glm::conjugate(glm::normalize(a)) * glm::normalize(b);
+    return glm::degrees(
+        2.0f * glm::atan(glm::length(glm::vec3(difference.x, difference.y, difference.z)), glm::abs(difference.w)));
+}
+
+/**
+ * Greedily extend the segment from the last kept key as long as interpolating across it recovers every skipped key
+ * within the tolerance.
+ */
+template <typename Key, typename Error> void ReduceKeys(std::vector<Key> &keys, const float &tolerance, const Error &error)
+{
+    if (keys.size() <= 1)
+        return;
+    bool constant = true;
+    for (size_t i = 1; i < keys.size() && constant; i++)
+        constant = error(keys.front().m_value, keys[i].m_value) <= tolerance;
+    if (constant)
+    {
+        keys.resize(1);
+        return;
+    }
+    const auto recovers = [&](const size_t &from, const size_t &to) {
+        for (size_t i = from + 1; i < to; i++)
+        {
+            const float factor =
+                BoneKeyFrames::GetScaleFactor(keys[from].m_timeStamp, keys[to].m_timeStamp, keys[i].m_timeStamp);
+            if (error(Interpolate(keys[from].m_value, keys[to].m_value, factor), keys[i].m_value) > tolerance)
+                return false;
+        }
+        return true;
+    };
+    std::vector<Key> kept;
+    kept.push_back(keys.front());
+    size_t anchor = 0;
+    for (size_t i = 2; i < keys.size(); i++)
+    {
+        if (!recovers(anchor, i))
+        {
+            anchor = i - 1;
+            kept.push_back(keys[anchor]);
+        }
+    }
+    kept.push_back(keys.back());
+    keys = std::move(kept);
+}
+
+/**
+ * Largest error between the original keys and the reduced track sampled at their times the way the baked evaluator
+ * does, with every reduced value passed through decode.
+ */
+template <typename Key, typename Decode, typename Error>
+float MeasureError(
+    const std::vector<Key> &original, const std::vector<Key> &reduced, const Decode &decode, const Error &error)
+{
+    using Value = decltype(Key::m_value);
+    if (reduced.empty())
+        return 0.0f;
+    std::vector<float> times;
+    std::vector<Value> values;
+    for (const auto &key : reduced)
+    {
+        times.push_back(key.m_timeStamp);
+        values.push_back(decode(key.m_value));
+    }
+    const std::vector<uint32_t> begin = {0, static_cast<uint32_t>(times.size())};
+    uint32_t cursor = 0;
+    float maxError = 0.0f;
+    for (const auto &key : original)
+    {
+        Value sampled;
+        SampleKeys(begin, times, [&](const uint32_t &i) { return values[i]; }, 0, key.m_timeStamp, cursor, sampled);
+        maxError = (glm::max)(maxError, error(sampled, key.m_value));
+    }
+    return maxError;
+}
+
+template <typename Key> std::vector<glm::vec3> GetValues(const std::vector<Key> &keys)
+{
+    std::vector<glm::vec3> values;
+    values.reserve(keys.size());
+    for (const auto &key : keys)
+        values.push_back(key.m_value);
+    return values;
+}
+} // namespace
+
+float AnimationClipCompressionReport::GetRatio() const
+{
+    return m_bytesAfter == 0 ? 1.0f : static_cast<float>(m_bytesBefore) / static_cast<float>(m_bytesAfter);
+}
+
+std::vector<AnimationClipCompressionReport> Animation::Compress(const AnimationCompressionSettings &settings)
+{
+    // The keys of a quantized animation go back to the bones first, so they can be reduced and baked again.
+    if (m_quantized)
+        UnpackBakedKeys();
+    std::vector<std::shared_ptr<Bone>> bones;
+    std::vector<int> parentIndices;
+    CollectBones(m_rootBone, bones, parentIndices);
+    const bool quantize = settings.m_quantize;
+    std::vector<AnimationClipCompressionReport> reports;
+    for (const auto &i : m_animationNameAndLength)
+    {
+        AnimationClipCompressionReport report;
+        report.m_name = i.first;
+        for (const auto &bone : bones)
+        {
+            const auto search = bone->m_animations.find(i.first);
+            if (search == bone->m_animations.end())
+                continue;
+            auto &keyFrames = search->second;
+            const auto positions = keyFrames.m_positions;
+            const auto rotations = keyFrames.m_rotations;
+            const auto scales = keyFrames.m_scales;
+            report.m_keysBefore += positions.size() + rotations.size() + scales.size();
+            report.m_bytesBefore += positions.size() * sizeof(BonePosition) +
+                                    rotations.size() * sizeof(BoneRotation) + scales.size() * sizeof(BoneScale);
+
+            // The quantization error is taken from the tolerances, so the reduced and quantized track stays within.
+            glm::vec3 min, extent;
+            GetRange(GetValues(positions), min, extent);
+            const float positionTolerance =
+                (glm::max)(settings.m_positionError - (quantize ? GetQuantizationError(extent) : 0.0f), 0.0f);
+            GetRange(GetValues(scales), min, extent);
+            const float scaleTolerance =
+                (glm::max)(settings.m_scaleError - (quantize ? GetQuantizationError(extent) : 0.0f), 0.0f);
+            const float angularTolerance =
+                (glm::max)(settings.m_angularError - (quantize ? SmallestThreeAngularError : 0.0f), 0.0f);
+            ReduceKeys(keyFrames.m_positions, positionTolerance, PositionError);
+            ReduceKeys(keyFrames.m_rotations, angularTolerance, AngularError);
+            ReduceKeys(keyFrames.m_scales, scaleTolerance, PositionError);
+
+            const auto decodeVector = [&](const std::vector<glm::vec3> &values) {
+                glm::vec3 trackMin, trackExtent;
+                GetRange(values, trackMin, trackExtent);
+                return [=](const glm::vec3 &value) {
+                    return quantize ? DequantizeVector(QuantizeVector(value, trackMin, trackExtent), trackMin, trackExtent)
+                                    : value;
+                };
+            };
+            report.m_maxPositionError = (glm::max)(
+                report.m_maxPositionError,
+                MeasureError(positions, keyFrames.m_positions, decodeVector(GetValues(keyFrames.m_positions)), PositionError));
+            report.m_maxAngularError = (glm::max)(
+                report.m_maxAngularError,
+                MeasureError(
+                    rotations,
+                    keyFrames.m_rotations,
+                    [&](const glm::quat &value) { return quantize ? DequantizeRotation(QuantizeRotation(value)) : value; },
+                    AngularError));
+            report.m_maxScaleError = (glm::max)(
+                report.m_maxScaleError,
+                MeasureError(scales, keyFrames.m_scales, decodeVector(GetValues(keyFrames.m_scales)), PositionError));
+
+            report.m_keysAfter +=
+                keyFrames.m_positions.size() + keyFrames.m_rotations.size() + keyFrames.m_scales.size();
+            // Quantized clips are measured once they are baked below.
+            if (!quantize)
+                report.m_bytesAfter += keyFrames.m_positions.size() * sizeof(BonePosition) +
+                                       keyFrames.m_rotations.size() * sizeof(BoneRotation) +
+                                       keyFrames.m_scales.size() * sizeof(BoneScale);
+            keyFrames.m_positions.shrink_to_fit();
+            keyFrames.m_rotations.shrink_to_fit();
+            keyFrames.m_scales.shrink_to_fit();
+        }
+        reports.push_back(std::move(report));
+    }
+    m_quantized = quantize;
+    {
+        std::lock_guard<std::mutex> lock(m_bakeMutex);
+        BakeInternal();
+    }
+    if (quantize)
+    {
+        // The quantized clips replace the keys of the bones, which keep only the hierarchy.
+        for (const auto &bone : bones)
+            bone->m_animations.clear();
+        for (size_t i = 0; i < reports.size() && i < m_baked.m_clips.size(); i++)
+            reports[i].m_bytesAfter = GetClipBytes(m_baked.m_clips[i]);
+    }
+    m_compressionReports = reports;
+    return reports;
+}
+
+bool Animation::IsQuantized() const
+{
+    return m_quantized;
+}
+
+const std::vector<AnimationClipCompressionReport> &Animation::PeekCompressionReports() const
+{
+    return m_compressionReports;
 }
+#pragma endregion
 void Animation::Serialize(YAML::Emitter &out)
 {
     out << YAML::Key << "m_boneSize" << YAML::Value << m_boneSize;
+    out << YAML::Key << "m_quantized" << YAML::Value << m_quantized;
 
     if (!m_animationNameAndLength.empty())
     {
@@ -274,10 +1068,38 @@ void Animation::Serialize(YAML::Emitter &out)
         m_rootBone->Serialize(out);
         out << YAML::EndMap;
     }
+    // The bones of a quantized animation hold no keys, the quantized clips are saved as they are.
+    if (m_quantized)
+    {
+        const auto &baked = GetBaked();
+        out << YAML::Key << "m_quantizedClips" << YAML::Value << YAML::BeginSeq;
+        for (const auto &clip : baked.m_clips)
+        {
+            out << YAML::BeginMap;
+            out << YAML::Key << "m_name" << YAML::Value << clip.m_name;
+            out << YAML::Key << "m_length" << YAML::Value << clip.m_length;
+            SaveArray("m_positionBegin", clip.m_positionBegin, out);
+            SaveArray("m_positionTimes", clip.m_positionTimes, out);
+            SaveArray("m_positionMin", clip.m_positionMin, out);
+            SaveArray("m_positionExtent", clip.m_positionExtent, out);
+            SaveArray("m_quantizedPositions", clip.m_quantizedPositions, out);
+            SaveArray("m_rotationBegin", clip.m_rotationBegin, out);
+            SaveArray("m_rotationTimes", clip.m_rotationTimes, out);
+            SaveArray("m_quantizedRotations", clip.m_quantizedRotations, out);
+            SaveArray("m_scaleBegin", clip.m_scaleBegin, out);
+            SaveArray("m_scaleTimes", clip.m_scaleTimes, out);
+            SaveArray("m_scaleMin", clip.m_scaleMin, out);
+            SaveArray("m_scaleExtent", clip.m_scaleExtent, out);
+            SaveArray("m_quantizedScales", clip.m_quantizedScales, out);
+            out << YAML::EndMap;
+        }
+        out << YAML::EndSeq;
+    }
 }
 void Animation::Deserialize(const YAML::Node &in)
 {
     m_boneSize = in["m_boneSize"].as<size_t>();
+    m_quantized = in["m_quantized"] && in["m_quantized"].as<bool>();
     auto inAnimationNameAndLength = in["m_animationNameAndLength"];
     m_animationNameAndLength.clear();
     if (inAnimationNameAndLength)
@@ -292,4 +1114,47 @@ void Animation::Deserialize(const YAML::Node &in)
         m_rootBone = std::make_shared<Bone>();
         m_rootBone->Deserialize(in["m_rootBone"]);
     }
+    std::lock_guard<std::mutex> lock(m_bakeMutex);
+    m_bakeDirty = true;
+    if (!m_quantized)
+        return;
+    const auto inQuantizedClips = in["m_quantizedClips"];
+    if (!inQuantizedClips)
+    {
+        // Saved before the quantized clips replaced the keys, the bones still hold the reduced keys.
+        BakeInternal();
+        std::vector<std::shared_ptr<Bone>> bones;
+        std::vector<int> parentIndices;
+        CollectBones(m_rootBone, bones, parentIndices);
+        for (const auto &bone : bones)
+            bone->m_animations.clear();
+        return;
+    }
+    m_baked = BakedAnimation();
+    std::vector<std::shared_ptr<Bone>> bones;
+    CollectBones(m_rootBone, bones, m_baked.m_parentIndices);
+    for (const auto &bone : bones)
+        m_baked.m_boneIndices.push_back(static_cast<uint32_t>(bone->m_index));
+    for (const auto &inClip : inQuantizedClips)
+    {
+        BakedAnimationClip clip;
+        clip.m_name = inClip["m_name"].as<std::string>();
+        clip.m_length = inClip["m_length"].as<float>();
+        clip.m_quantized = true;
+        LoadArray("m_positionBegin", clip.m_positionBegin, inClip);
+        LoadArray("m_positionTimes", clip.m_positionTimes, inClip);
+        LoadArray("m_positionMin", clip.m_positionMin, inClip);
+        LoadArray("m_positionExtent", clip.m_positionExtent, inClip);
+        LoadArray("m_quantizedPositions", clip.m_quantizedPositions, inClip);
+        LoadArray("m_rotationBegin", clip.m_rotationBegin, inClip);
+        LoadArray("m_rotationTimes", clip.m_rotationTimes, inClip);
+        LoadArray("m_quantizedRotations", clip.m_quantizedRotations, inClip);
+        LoadArray("m_scaleBegin", clip.m_scaleBegin, inClip);
+        LoadArray("m_scaleTimes", clip.m_scaleTimes, inClip);
+        LoadArray("m_scaleMin", clip.m_scaleMin, inClip);
+        LoadArray("m_scaleExtent", clip.m_scaleExtent, inClip);
+        LoadArray("m_quantizedScales", clip.m_quantizedScales, inClip);
+        m_baked.m_clips.push_back(std::move(clip));
+    }
+    m_bakeDirty = false;
 }
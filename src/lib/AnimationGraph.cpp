@@ -0,0 +1,417 @@
+#include <AnimationGraph.hpp>
+#include <Console.hpp>
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define UNIENGINE_ANIMATION_SSE
+#include <xmmintrin.h>
+#endif
+using namespace UniEngine;
+
+namespace
+{
+/**
+ * Poses and weights used by the evaluation on one thread. Buffers are handed out as a stack and keep their storage, so
+ * evaluating a graph does not allocate once the pool has grown to the depth of the graph.
+ */
+class PosePool
+{
+    std::vector<std::unique_ptr<AnimationPose>> m_poses;
+    size_t m_used = 0;
+
+  public:
+    // Weights of a single blend, filled right before it.
+    std::vector<float> m_blendWeights;
+    // Weights of the layer being applied.
+    std::vector<float> m_layerWeights;
+    AnimationPose &Acquire(const size_t &boneAmount)
+    {
+        if (m_used == m_poses.size())
+            m_poses.push_back(std::make_unique<AnimationPose>());
+        auto &pose = *m_poses[m_used++];
+        pose.Resize(boneAmount);
+        return pose;
+    }
+    void Release()
+    {
+        m_used--;
+    }
+};
+
+thread_local PosePool t_posePool;
+
+class PooledPose
+{
+    AnimationPose &m_pose;
+
+  public:
+    explicit PooledPose(const size_t &boneAmount) : m_pose(t_posePool.Acquire(boneAmount))
+    {
+    }
+    ~PooledPose()
+    {
+        t_posePool.Release();
+    }
+    PooledPose(const PooledPose &) = delete;
+    PooledPose &operator=(const PooledPose &) = delete;
+    AnimationPose &operator*()
+    {
+        return m_pose;
+    }
+};
+
+#ifdef UNIENGINE_ANIMATION_SSE
+// Dot product of two quaternions in every lane.
+inline __m128 Dot4(const __m128 &a, const __m128 &b)
+{
+    __m128 product = _mm_mul_ps(a, b);
+    product = _mm_add_ps(product, _mm_shuffle_ps(product, product, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_add_ps(product, _mm_shuffle_ps(product, product, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+#endif
+
+/**
+ * Normalized lerp of every rotation of target toward source along the shorter arc.
+ */
+void BlendRotations(glm::quat *target, const glm::quat *source, const float *weights, const size_t &size)
+{
+    size_t i = 0;
+#ifdef UNIENGINE_ANIMATION_SSE
+    static_assert(sizeof(glm::quat) == sizeof(float) * 4);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    for (; i < size; i++)
+    {
+        const __m128 a = _mm_loadu_ps(&target[i].x);
+        __m128 b = _mm_loadu_ps(&source[i].x);
+        b = _mm_xor_ps(b, _mm_and_ps(Dot4(a, b), signMask));
+        const __m128 result = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), _mm_set1_ps(weights[i])));
+        _mm_storeu_ps(&target[i].x, _mm_div_ps(result, _mm_sqrt_ps(Dot4(result, result))));
+    }
+#endif
+    for (; i < size; i++)
+    {
+        const glm::quat &b = glm::dot(target[i], source[i]) < 0.0f ? -source[i] : source[i];
+        target[i] = glm::normalize(target[i] + (b - target[i]) * weights[i]);
+    }
+}
+
+void BlendPose(AnimationPose &target, const AnimationPose &source, const float *weights)
+{
+    const auto size = target.m_positions.size();
+    for (size_t i = 0; i < size; i++)
+    {
+        target.m_positions[i] += (source.m_positions[i] - target.m_positions[i]) * weights[i];
+        target.m_scales[i] += (source.m_scales[i] - target.m_scales[i]) * weights[i];
+    }
+    BlendRotations(target.m_rotations.data(), source.m_rotations.data(), weights, size);
+}
+
+void AddPose(AnimationPose &target, const AnimationPose &source, const AnimationPose &reference, const float *weights)
+{
+    const auto size = target.m_positions.size();
+    const glm::quat identity = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    for (size_t i = 0; i < size; i++)
+    {
+        const float weight = weights[i];
+        target.m_positions[i] += (source.m_positions[i] - reference.m_positions[i]) * weight;
+        target.m_scales[i] *= glm::mix(glm::vec3(1.0f), source.m_scales[i] / reference.m_scales[i], weight);
+        glm::quat delta = glm::inverse(reference.m_rotations[i]) * source.m_rotations[i];
+        if (delta.w < 0.0f)
+            delta = -delta;
+        target.m_rotations[i] =
+            glm::normalize(target.m_rotations[i] * glm::normalize(identity + (delta - identity) * weight));
+    }
+}
+} // namespace
+
+int AnimationGraph::AddClipNode(const std::string &clipName, const float &speed, const bool &loop)
+{
+    AnimationGraphNode node;
+    node.m_type = AnimationGraphNodeType::Clip;
+    node.m_clipName = clipName;
+    node.m_speed = speed;
+    node.m_loop = loop;
+    m_nodes.push_back(node);
+    m_cursors.emplace_back();
+    m_referenceCursors.emplace_back();
+    return static_cast<int>(m_nodes.size() - 1);
+}
+
+int AnimationGraph::AddBlendNode(const std::vector<int> &inputs, const std::vector<float> &weights)
+{
+    if (inputs.size() != weights.size())
+    {
+        UNIENGINE_ERROR("Blend inputs and weights differ in size!");
+        return -1;
+    }
+    for (const auto &i : inputs)
+    {
+        if (i < 0 || static_cast<size_t>(i) >= m_nodes.size())
+        {
+            UNIENGINE_ERROR("Blend input not found!");
+            return -1;
+        }
+    }
+    AnimationGraphNode node;
+    node.m_type = AnimationGraphNodeType::Blend;
+    node.m_inputs = inputs;
+    node.m_weights = weights;
+    m_nodes.push_back(node);
+    m_cursors.emplace_back();
+    m_referenceCursors.emplace_back();
+    return static_cast<int>(m_nodes.size() - 1);
+}
+
+void AnimationGraph::SetBlendWeights(const int &node, const std::vector<float> &weights)
+{
+    if (node < 0 || static_cast<size_t>(node) >= m_nodes.size() || m_nodes[node].m_type != AnimationGraphNodeType::Blend ||
+        m_nodes[node].m_inputs.size() != weights.size())
+    {
+        UNIENGINE_ERROR("Blend node not found!");
+        return;
+    }
+    m_nodes[node].m_weights = weights;
+}
+
+int AnimationGraph::AddLayer(const std::string &name, const float &weight, const bool &additive)
+{
+    AnimationGraphLayer layer;
+    layer.m_name = name;
+    layer.m_weight = weight;
+    layer.m_additive = additive;
+    m_layers.push_back(layer);
+    return static_cast<int>(m_layers.size() - 1);
+}
+
+void AnimationGraph::SetLayerWeight(const int &layer, const float &weight)
+{
+    if (layer < 0 || static_cast<size_t>(layer) >= m_layers.size())
+    {
+        UNIENGINE_ERROR("Layer not found!");
+        return;
+    }
+    m_layers[layer].m_weight = weight;
+}
+
+void AnimationGraph::SetBoneMask(const int &layer, const std::vector<float> &boneMask)
+{
+    if (layer < 0 || static_cast<size_t>(layer) >= m_layers.size())
+    {
+        UNIENGINE_ERROR("Layer not found!");
+        return;
+    }
+    m_layers[layer].m_boneMask = boneMask;
+}
+
+std::vector<float> AnimationGraph::CreateBoneMask(
+    const std::shared_ptr<Animation> &animation, const std::string &boneName)
+{
+    std::vector<float> boneMask;
+    if (!animation || !animation->m_rootBone)
+        return boneMask;
+    boneMask.resize(animation->m_boneSize, 0.0f);
+    std::vector<std::pair<std::shared_ptr<Bone>, bool>> bones = {{animation->m_rootBone, false}};
+    while (!bones.empty())
+    {
+        const auto bone = bones.back().first;
+        const bool masked = bones.back().second || bone->m_name == boneName;
+        bones.pop_back();
+        if (masked && bone->m_index < boneMask.size())
+            boneMask[bone->m_index] = 1.0f;
+        for (const auto &child : bone->m_children)
+            bones.emplace_back(child, masked);
+    }
+    return boneMask;
+}
+
+int AnimationGraph::AddState(const int &layer, const std::string &name, const int &node)
+{
+    if (layer < 0 || static_cast<size_t>(layer) >= m_layers.size() || node < 0 || static_cast<size_t>(node) >= m_nodes.size())
+    {
+        UNIENGINE_ERROR("Layer or node not found!");
+        return -1;
+    }
+    auto &states = m_layers[layer].m_states;
+    states.push_back({name, node});
+    if (m_layers[layer].m_currentState == -1)
+        m_layers[layer].m_currentState = 0;
+    return static_cast<int>(states.size() - 1);
+}
+
+bool AnimationGraph::Play(const int &layer, const std::string &state)
+{
+    return CrossFade(layer, state, 0.0f);
+}
+
+bool AnimationGraph::CrossFade(const int &layer, const std::string &state, const float &duration)
+{
+    if (layer < 0 || static_cast<size_t>(layer) >= m_layers.size())
+    {
+        UNIENGINE_ERROR("Layer not found!");
+        return false;
+    }
+    auto &graphLayer = m_layers[layer];
+    const auto search =
+        std::find_if(graphLayer.m_states.begin(), graphLayer.m_states.end(), [&](const AnimationGraphState &i) {
+            return i.m_name == state;
+        });
+    if (search == graphLayer.m_states.end())
+    {
+        UNIENGINE_ERROR("State not found!");
+        return false;
+    }
+    const bool fade = duration > 0.0f && graphLayer.m_currentState != -1;
+    graphLayer.m_previousState = fade ? graphLayer.m_currentState : -1;
+    graphLayer.m_previousTime = graphLayer.m_currentTime;
+    graphLayer.m_transitionTime = 0.0f;
+    graphLayer.m_transitionDuration = duration;
+    graphLayer.m_currentState = static_cast<int>(search - graphLayer.m_states.begin());
+    graphLayer.m_currentTime = 0.0f;
+    return true;
+}
+
+bool AnimationGraph::Empty() const
+{
+    return m_layers.empty();
+}
+
+const std::vector<AnimationGraphNode> &AnimationGraph::PeekNodes() const
+{
+    return m_nodes;
+}
+
+const std::vector<AnimationGraphLayer> &AnimationGraph::PeekLayers() const
+{
+    return m_layers;
+}
+
+void AnimationGraph::Update(const float &deltaTime)
+{
+    for (auto &layer : m_layers)
+    {
+        layer.m_currentTime += deltaTime;
+        if (layer.m_previousState == -1)
+            continue;
+        layer.m_previousTime += deltaTime;
+        layer.m_transitionTime += deltaTime;
+        if (layer.m_transitionTime >= layer.m_transitionDuration)
+            layer.m_previousState = -1;
+    }
+}
+
+void AnimationGraph::EvaluateNode(
+    Animation &animation,
+    const int &node,
+    const float &time,
+    AnimationPose &pose,
+    std::vector<AnimationCursor> &cursors)
+{
+    const auto &graphNode = m_nodes[node];
+    if (graphNode.m_type == AnimationGraphNodeType::Clip)
+    {
+        const int clipIndex = animation.GetClipIndex(graphNode.m_clipName);
+        float clipTime = time * graphNode.m_speed;
+        if (clipIndex != -1)
+        {
+            const float length = animation.GetBaked().m_clips[clipIndex].m_length;
+            if (length > 0.0f)
+                clipTime = graphNode.m_loop ? glm::mod(clipTime, length) : glm::clamp(clipTime, 0.0f, length);
+        }
+        animation.SamplePose(clipIndex, clipTime, pose, &cursors[node]);
+        return;
+    }
+    // Running weighted average, every input is blended in by its share of the weights so far.
+    const auto boneAmount = pose.m_positions.size();
+    float totalWeight = 0.0f;
+    for (size_t i = 0; i < graphNode.m_inputs.size(); i++)
+    {
+        const float weight = graphNode.m_weights[i];
+        if (weight <= 0.0f)
+            continue;
+        if (totalWeight == 0.0f)
+        {
+            EvaluateNode(animation, graphNode.m_inputs[i], time, pose, cursors);
+        }
+        else
+        {
+            PooledPose input(boneAmount);
+            EvaluateNode(animation, graphNode.m_inputs[i], time, *input, cursors);
+            auto &weights = t_posePool.m_blendWeights;
+            weights.assign(boneAmount, weight / (totalWeight + weight));
+            BlendPose(pose, *input, weights.data());
+        }
+        totalWeight += weight;
+    }
+    if (totalWeight == 0.0f)
+        pose.SetIdentity();
+}
+
+void AnimationGraph::EvaluateState(
+    Animation &animation,
+    const AnimationGraphLayer &layer,
+    const int &state,
+    const float &time,
+    AnimationPose &pose,
+    std::vector<AnimationCursor> &cursors)
+{
+    EvaluateNode(animation, layer.m_states[state].m_node, time, pose, cursors);
+}
+
+void AnimationGraph::EvaluatePose(Animation &animation, AnimationPose &pose)
+{
+    const auto &baked = animation.GetBaked();
+    const auto boneAmount = baked.m_boneIndices.size();
+    pose.Resize(boneAmount);
+    pose.SetIdentity();
+    for (const auto &layer : m_layers)
+    {
+        if (layer.m_currentState == -1 || layer.m_weight <= 0.0f)
+            continue;
+        PooledPose layerPose(boneAmount);
+        EvaluateState(animation, layer, layer.m_currentState, layer.m_currentTime, *layerPose, m_cursors);
+        if (layer.m_previousState != -1 && layer.m_transitionDuration > 0.0f)
+        {
+            PooledPose previousPose(boneAmount);
+            EvaluateState(
+                animation, layer, layer.m_previousState, layer.m_previousTime, *previousPose, m_cursors);
+            auto &transitionWeights = t_posePool.m_blendWeights;
+            transitionWeights.assign(
+                boneAmount, glm::clamp(layer.m_transitionTime / layer.m_transitionDuration, 0.0f, 1.0f));
+            BlendPose(*previousPose, *layerPose, transitionWeights.data());
+            std::swap(*previousPose, *layerPose);
+        }
+        auto &weights = t_posePool.m_layerWeights;
+        weights.assign(boneAmount, layer.m_weight);
+        if (!layer.m_boneMask.empty())
+        {
+            for (size_t i = 0; i < boneAmount; i++)
+            {
+                const auto boneIndex = baked.m_boneIndices[i];
+                weights[i] *= boneIndex < layer.m_boneMask.size() ? layer.m_boneMask[boneIndex] : 0.0f;
+            }
+        }
+        if (layer.m_additive)
+        {
+            PooledPose reference(boneAmount);
+            // Its own cursors, so the reference does not rewind the cursors of the current time.
+            EvaluateState(animation, layer, layer.m_currentState, 0.0f, *reference, m_referenceCursors);
+            AddPose(pose, *layerPose, *reference, weights.data());
+        }
+        else
+        {
+            BlendPose(pose, *layerPose, weights.data());
+        }
+    }
+}
+
+void AnimationGraph::Evaluate(Animation &animation, const glm::mat4 &rootTransform, std::vector<glm::mat4> &results)
+{
+    PooledPose result(animation.GetBaked().m_boneIndices.size());
+    EvaluatePose(animation, *result);
+    animation.ComposePose(*result, rootTransform, results);
+}
+
+void AnimationGraph::Blend(AnimationPose &target, const AnimationPose &source, const float &weight)
+{
+    auto &weights = t_posePool.m_blendWeights;
+    weights.assign(target.m_positions.size(), weight);
+    BlendPose(target, source, weights.data());
+}
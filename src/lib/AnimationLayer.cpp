@@ -2,90 +2,157 @@
 #include "Scene.hpp"
 #include "AnimationLayer.hpp"
 #include "Animator.hpp"
+#include "BonePalette.hpp"
+#include "Camera.hpp"
+#include "Culling.hpp"
+#include "EditorLayer.hpp"
 #include "SkinnedMeshRenderer.hpp"
 using namespace UniEngine;
 void AnimationLayer::PreUpdate()
 {
-    ProfilerLayer::StartEvent("AnimationManager");
+    ProfilerLayer::StartEvent(UNIENGINE_PROFILE_EVENT("AnimationManager"));
     auto scene = GetScene();
     auto *owners =
         scene->UnsafeGetPrivateComponentOwnersList<Animator>();
     if (!owners)
     {
-        ProfilerLayer::EndEvent("AnimationManager");
+        ProfilerLayer::EndEvent(UNIENGINE_PROFILE_EVENT("AnimationManager"));
         return;
     }
-    auto &workers = Jobs::Workers();
-    std::vector<std::shared_future<void>> results;
-    auto threadSize = workers.Size();
-    auto threadLoad = owners->size() / threadSize;
-    auto loadReminder = owners->size() % threadSize;
-    for (int threadIndex = 0; threadIndex < threadSize; threadIndex++)
+#pragma region Update rate LOD
+    struct CameraEntry
+    {
+        glm::vec3 m_position;
+        Frustum m_frustum;
+    };
+    std::vector<CameraEntry> cameraEntries;
+    const auto addCamera = [&](const std::shared_ptr<Camera> &camera, const glm::vec3 &position, const glm::quat &rotation) {
+        const glm::vec3 front = rotation * glm::vec3(0, 0, -1);
+        const glm::vec3 up = rotation * glm::vec3(0, 1, 0);
+        cameraEntries.push_back(
+            {position, Frustum(camera->GetProjection() * glm::lookAt(position, position + front, up))});
+    };
+    auto editorLayer = Application::GetLayer<EditorLayer>();
+    if (editorLayer && editorLayer->m_sceneCamera && editorLayer->m_sceneCamera->IsEnabled())
+    {
+        addCamera(editorLayer->m_sceneCamera, editorLayer->m_sceneCameraPosition, editorLayer->m_sceneCameraRotation);
+    }
+    if (const auto *cameraOwners = scene->UnsafeGetPrivateComponentOwnersList<Camera>())
+    {
+        for (const auto &i : *cameraOwners)
+        {
+            if (!scene->IsEntityEnabled(i))
+                continue;
+            auto camera = scene->GetOrSetPrivateComponent<Camera>(i).lock();
+            if (!camera || !camera->IsEnabled())
+                continue;
+            const auto globalTransform = scene->GetDataComponent<GlobalTransform>(i);
+            addCamera(camera, globalTransform.GetPosition(), globalTransform.GetRotation());
+        }
+    }
+    // The bound of an animator is the union of the bind pose bounds of the renderers it skins. Ragdolls are posed
+    // in world space and give no bound.
+    const auto *rendererOwners = scene->UnsafeGetPrivateComponentOwnersList<SkinnedMeshRenderer>();
+    if (rendererOwners && !cameraEntries.empty())
     {
-        results.push_back(workers
-                              .Push([=](int id) {
-                                  for (int i = threadIndex * threadLoad; i < (threadIndex + 1) * threadLoad; i++)
-                                  {
-                                       auto animator = scene->GetOrSetPrivateComponent<Animator>(owners->at(i)).lock();
-                                      if (animator->m_animatedCurrentFrame)
-                                      {
-                                          animator->m_animatedCurrentFrame = false;
-                                      }
-                                      if (!Application::IsPlaying() && animator->m_autoPlay)
-                                      {
-                                          animator->AutoPlay();
-                                      }
-                                      animator->Apply();
-                                  }
-                                  if (threadIndex < loadReminder)
-                                  {
-                                      const int i = threadIndex + threadSize * threadLoad;
-                                      auto animator = scene->GetOrSetPrivateComponent<Animator>(owners->at(i)).lock();
-                                      if (animator->m_animatedCurrentFrame)
-                                      {
-                                          animator->m_animatedCurrentFrame = false;
-                                      }
-                                      if (!Application::IsPlaying() && animator->m_autoPlay)
-                                      {
-                                          animator->AutoPlay();
-                                      }
-                                      animator->Apply();
-                                  }
-                              })
-                              .share());
+        for (const auto &owner : *rendererOwners)
+        {
+            if (!scene->IsEntityEnabled(owner))
+                continue;
+            auto smmc = scene->GetOrSetPrivateComponent<SkinnedMeshRenderer>(owner).lock();
+            auto animator = smmc->m_animator.Get<Animator>();
+            auto skinnedMesh = smmc->m_skinnedMesh.Get<SkinnedMesh>();
+            if (!smmc->IsEnabled() || smmc->m_ragDoll || !animator || !skinnedMesh)
+                continue;
+            auto bound = skinnedMesh->GetBound();
+            bound.ApplyTransform(scene->GetDataComponent<GlobalTransform>(owner).m_value);
+            if (!animator->m_lodHasBound)
+            {
+                animator->m_lodBound = bound;
+                animator->m_lodHasBound = true;
+                continue;
+            }
+            animator->m_lodBound.m_min = (glm::min)(animator->m_lodBound.m_min, bound.m_min);
+            animator->m_lodBound.m_max = (glm::max)(animator->m_lodBound.m_max, bound.m_max);
+        }
     }
+#pragma endregion
+    std::vector<std::shared_future<void>> results;
+    const bool isPlaying = Application::IsPlaying();
+    const float deltaTime = Application::Time().DeltaTime() * 1000.0f;
+    std::atomic<size_t> evaluatedAmount = 0;
+    std::atomic<size_t> interpolatedAmount = 0;
+    std::atomic<size_t> pausedAmount = 0;
+    Jobs::ParallelFor(
+        owners->size(),
+        [&](unsigned i) {
+            const auto owner = owners->at(i);
+            auto animator = scene->GetOrSetPrivateComponent<Animator>(owner).lock();
+            if (animator->m_animatedCurrentFrame)
+            {
+                animator->m_animatedCurrentFrame = false;
+            }
+            if (!animator->m_graph.Empty())
+            {
+                // Graphs advance in the same units as AutoPlay, and also while playing.
+                if (isPlaying || animator->m_autoPlay)
+                {
+                    animator->m_graph.Update(deltaTime);
+                    animator->m_needAnimate = true;
+                }
+            }
+            else if (!isPlaying && animator->m_autoPlay)
+            {
+                animator->AutoPlay();
+            }
+            // Time keeps advancing at the full rate, only the evaluation is throttled.
+            animator->m_lodInterval = 1;
+            animator->m_lodVisible = true;
+            if (animator->m_updateRateLod && !cameraEntries.empty())
+            {
+                const bool hasBound = animator->m_lodHasBound;
+                const glm::vec3 center = hasBound ? animator->m_lodBound.Center()
+                                                  : scene->GetDataComponent<GlobalTransform>(owner).GetPosition();
+                const float radius = hasBound ? glm::length(animator->m_lodBound.Size()) : 0.0f;
+                // Without a renderer there is nothing to see, the animator stays visible.
+                bool visible = !hasBound || !animator->m_pauseWhenInvisible;
+                float distance = FLT_MAX;
+                for (const auto &cameraEntry : cameraEntries)
+                {
+                    distance = (glm::min)(distance, glm::distance(cameraEntry.m_position, center) - radius);
+                    if (!visible && cameraEntry.m_frustum.Intersect(center, radius))
+                        visible = true;
+                }
+                if (distance > animator->m_fullRateDistance)
+                    animator->m_lodInterval = (glm::max)(animator->m_reducedRateInterval, 1u);
+                animator->m_lodVisible = visible;
+            }
+            animator->m_lodHasBound = false;
+            if (animator->ApplyAtRate())
+                evaluatedAmount++;
+            else if (animator->m_animatedCurrentFrame)
+                interpolatedAmount++;
+            else if (!animator->m_lodVisible)
+                pausedAmount++;
+        },
+        results);
     for (const auto &i : results)
         i.wait();
     results.clear();
+    ProfilerLayer::SetCounter("Animators evaluated", evaluatedAmount, owners->size());
+    ProfilerLayer::SetCounter("Animators interpolated", interpolatedAmount, owners->size());
+    ProfilerLayer::SetCounter("Animators paused", pausedAmount, owners->size());
 
     owners = scene->UnsafeGetPrivateComponentOwnersList<SkinnedMeshRenderer>();
     if (!owners)
     {
-        ProfilerLayer::EndEvent("AnimationManager");
+        ProfilerLayer::EndEvent(UNIENGINE_PROFILE_EVENT("AnimationManager"));
         return;
     }
-    threadSize = workers.Size();
-    threadLoad = owners->size() / threadSize;
-    loadReminder = owners->size() % threadSize;
-    for (int threadIndex = 0; threadIndex < threadSize; threadIndex++)
-    {
-        results.push_back(workers
-                              .Push([=](int id) {
-                                  for (int i = threadIndex * threadLoad; i < (threadIndex + 1) * threadLoad; i++)
-                                  {
-                                      auto smmc = scene->GetOrSetPrivateComponent<SkinnedMeshRenderer>(owners->at(i)).lock();
-                                      smmc->GetBoneMatrices();
-                                  }
-                                  if (threadIndex < loadReminder)
-                                  {
-                                      const int i = threadIndex + threadSize * threadLoad;
-                                      auto smmc = scene->GetOrSetPrivateComponent<SkinnedMeshRenderer>(owners->at(i)).lock();
-                                      smmc->GetBoneMatrices();
-                                  }
-                              })
-                              .share());
-    }
-    for (const auto &i : results)
-        i.wait();
-    ProfilerLayer::EndEvent("AnimationManager");
-}
\ No newline at end of file
+    // Bone matrices only change with the pose of the animator, apart from ragdolls and renderers that moved in the
+    // palette. The upload happens before the first skinned draw.
+    BonePalette::Build(scene, *owners);
+    const auto updatedAmount = BonePalette::GetUpdatedAmount();
+    ProfilerLayer::SetCounter("Bone matrices updated", updatedAmount, owners->size());
+    ProfilerLayer::EndEvent(UNIENGINE_PROFILE_EVENT("AnimationManager"));
+}
@@ -1,6 +1,7 @@
 #include "Application.hpp"
 #include "Graphics.hpp"
 #include <Animator.hpp>
+#include <BonePalette.hpp>
 #include "Editor.hpp"
 #include "ClassRegistry.hpp"
 using namespace UniEngine;
@@ -90,6 +91,18 @@ void Animator::OnInspect()
                 ImGui::EndCombo();
             }
             if(!Application::IsPlaying()) ImGui::Checkbox("AutoPlay", &m_autoPlay);
+            if (ImGui::TreeNode("Update rate LOD##Animator"))
+            {
+                ImGui::Checkbox("Enabled##Animator", &m_updateRateLod);
+                ImGui::DragFloat("Full rate distance##Animator", &m_fullRateDistance, 0.5f, 0.0f, 10000.0f);
+                int interval = static_cast<int>(m_reducedRateInterval);
+                if (ImGui::DragInt("Reduced rate interval##Animator", &interval, 1, 1, 60))
+                    m_reducedRateInterval = static_cast<unsigned>((glm::max)(interval, 1));
+                ImGui::Checkbox("Interpolate reduced rate##Animator", &m_interpolateReducedRate);
+                ImGui::Checkbox("Pause when invisible##Animator", &m_pauseWhenInvisible);
+                ImGui::Text("Current interval: %u%s", m_lodInterval, m_lodVisible ? "" : " (paused)");
+                ImGui::TreePop();
+            }
             if (ImGui::SliderFloat(
                     "Animation time",
                     &m_currentAnimationTime,
@@ -152,33 +165,126 @@ void Animator::Animate(float time)
         glm::mod(time, animation->m_animationNameAndLength[m_currentActivatedAnimation]);
     m_needAnimate = true;
 }
+std::shared_ptr<Animation> Animator::PrepareApply()
+{
+    auto animation = m_animation.Get<Animation>();
+    if (!animation)
+        return nullptr;
+    if (m_needAnimationSetup)
+        Setup();
+
+    if (animation->m_animationNameAndLength.find(m_currentActivatedAnimation) ==
+        animation->m_animationNameAndLength.end())
+    {
+        m_currentActivatedAnimation = animation->m_animationNameAndLength.begin()->first;
+        m_currentAnimationTime = 0.0f;
+    }
+    if (GetOwner().GetIndex() == 0)
+        return nullptr;
+    return animation;
+}
+
 void Animator::Apply()
 {
     if (!m_needAnimate)
         return;
-    auto animation = m_animation.Get<Animation>();
-    if (animation)
+    if (const auto animation = PrepareApply())
     {
-        if (m_needAnimationSetup)
-            Setup();
-
-        if (animation->m_animationNameAndLength.find(m_currentActivatedAnimation) ==
-            animation->m_animationNameAndLength.end())
+        if (!m_graph.Empty())
         {
-            m_currentActivatedAnimation = animation->m_animationNameAndLength.begin()->first;
-            m_currentAnimationTime = 0.0f;
+            m_graph.Evaluate(*animation, glm::mat4(1.0f), m_transformChain);
         }
-        auto owner = GetOwner();
-        if (owner.GetIndex() != 0)
+        else
         {
-            animation->Animate(m_currentActivatedAnimation, m_currentAnimationTime, glm::mat4(1.0f), m_transformChain);
-            ApplyOffsetMatrices();
+            animation->Animate(
+                animation->GetClipIndex(m_currentActivatedAnimation),
+                m_currentAnimationTime,
+                glm::mat4(1.0f),
+                m_transformChain,
+                &m_cursor);
         }
+        ApplyOffsetMatrices();
     }
     m_needAnimate = false;
     m_animatedCurrentFrame = true;
 }
 
+void Animator::ComposeLodPose(const std::shared_ptr<Animation> &animation)
+{
+    animation->ComposePose(m_lodPose, glm::mat4(1.0f), m_transformChain);
+    ApplyOffsetMatrices();
+    m_animatedCurrentFrame = true;
+}
+
+bool Animator::ApplyAtRate()
+{
+    if (!m_lodVisible)
+        return false;
+    if (m_lodInterval <= 1)
+    {
+        m_lodHasPose = false;
+        m_lodBlending = false;
+        const bool evaluate = m_needAnimate;
+        Apply();
+        return evaluate;
+    }
+    bool evaluated = false;
+    std::shared_ptr<Animation> animation;
+    if (m_lodFrame >= m_lodInterval || !m_lodHasPose)
+    {
+        if (!m_needAnimate)
+            return false;
+        animation = PrepareApply();
+        m_needAnimate = false;
+        m_animatedCurrentFrame = true;
+        // The pose shown now is where the blend toward the new evaluation starts.
+        const bool hadPose = m_lodHasPose;
+        std::swap(m_lodPreviousPose, m_lodPose);
+        m_lodHasPose = animation != nullptr;
+        m_lodBlending = false;
+        if (m_lodHasPose)
+        {
+            if (!m_graph.Empty())
+                m_graph.EvaluatePose(*animation, m_lodTargetPose);
+            else
+                animation->SamplePose(
+                    animation->GetClipIndex(m_currentActivatedAnimation),
+                    m_currentAnimationTime,
+                    m_lodTargetPose,
+                    &m_cursor);
+            m_lodBlending = hadPose && m_interpolateReducedRate &&
+                            m_lodPreviousPose.m_positions.size() == m_lodTargetPose.m_positions.size();
+            if (!m_lodBlending)
+            {
+                std::swap(m_lodPose, m_lodTargetPose);
+                ComposeLodPose(animation);
+            }
+        }
+        m_lodFrame = 0;
+        evaluated = true;
+    }
+    if (m_lodFrame < m_lodInterval)
+        m_lodFrame++;
+    if (m_lodBlending)
+    {
+        if (!animation)
+            animation = m_animation.Get<Animation>();
+        if (!animation)
+        {
+            m_lodHasPose = false;
+            m_lodBlending = false;
+            return evaluated;
+        }
+        m_lodPose = m_lodPreviousPose;
+        AnimationGraph::Blend(
+            m_lodPose, m_lodTargetPose, static_cast<float>(m_lodFrame) / static_cast<float>(m_lodInterval));
+        ComposeLodPose(animation);
+        if (m_lodFrame >= m_lodInterval)
+            m_lodBlending = false;
+    }
+    return evaluated;
+}
+
 void Animator::BoneSetter(const std::shared_ptr<Bone> &boneWalker)
 {
     m_names[boneWalker->m_index] = boneWalker->m_name;
@@ -200,10 +306,11 @@ void Animator::Setup(std::vector<std::string> &name, std::vector<glm::mat4> &off
 
 void Animator::ApplyOffsetMatrices()
 {
-    for (int i = 0; i < m_transformChain.size(); i++)
-    {
-        m_transformChain[i] *= m_offsetMatrices[i];
-    }
+    BonePalette::MultiplyAffine(
+        m_transformChain.data(),
+        m_offsetMatrices.data(),
+        m_transformChain.data(),
+        (std::min)(m_transformChain.size(), m_offsetMatrices.size()));
 }
 
 glm::mat4 Animator::GetReverseTransform(const int &index, const Entity& entity)
@@ -225,6 +332,11 @@ void Animator::CollectAssetRef(std::vector<AssetRef> &list)
 void Animator::Serialize(YAML::Emitter &out)
 {
     out << YAML::Key << "m_autoPlay" << YAML::Value << m_autoPlay;
+    out << YAML::Key << "m_updateRateLod" << YAML::Value << m_updateRateLod;
+    out << YAML::Key << "m_fullRateDistance" << YAML::Value << m_fullRateDistance;
+    out << YAML::Key << "m_reducedRateInterval" << YAML::Value << m_reducedRateInterval;
+    out << YAML::Key << "m_interpolateReducedRate" << YAML::Value << m_interpolateReducedRate;
+    out << YAML::Key << "m_pauseWhenInvisible" << YAML::Value << m_pauseWhenInvisible;
 
     if (m_animation.Get<Animation>())
     {
@@ -260,6 +372,16 @@ void Animator::Serialize(YAML::Emitter &out)
 void Animator::Deserialize(const YAML::Node &in)
 {
     m_autoPlay = in["m_autoPlay"].as<bool>();
+    if (in["m_updateRateLod"])
+        m_updateRateLod = in["m_updateRateLod"].as<bool>();
+    if (in["m_fullRateDistance"])
+        m_fullRateDistance = in["m_fullRateDistance"].as<float>();
+    if (in["m_reducedRateInterval"])
+        m_reducedRateInterval = (glm::max)(in["m_reducedRateInterval"].as<unsigned>(), 1u);
+    if (in["m_interpolateReducedRate"])
+        m_interpolateReducedRate = in["m_interpolateReducedRate"].as<bool>();
+    if (in["m_pauseWhenInvisible"])
+        m_pauseWhenInvisible = in["m_pauseWhenInvisible"].as<bool>();
     m_animation.Load("m_animation", in);
     if (m_animation.Get<Animation>())
     {
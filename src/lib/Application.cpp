@@ -21,15 +21,16 @@ using namespace UniEngine;
 void Application::Create(const ApplicationConfigs &applicationConfigs)
 {
     auto &application = GetInstance();
-    Windows::Init(applicationConfigs.m_applicationName, applicationConfigs.m_fullScreen);
-    OpenGLUtils::Init();
+    Windows::Init(applicationConfigs.m_applicationName, applicationConfigs.m_fullScreen, applicationConfigs.m_headless);
+    OpenGLUtils::Init(applicationConfigs.m_headless);
     application.m_applicationConfigs = applicationConfigs;
 
     Inputs::Init();
     Jobs::Init();
     DefaultResources::Load();
     Entities::Init();
-    Editor::Init(applicationConfigs.m_enableDocking, applicationConfigs.m_enableViewport);
+    Editor::Init(
+        applicationConfigs.m_enableDocking, applicationConfigs.m_enableViewport, applicationConfigs.m_headless);
 
     PushLayer<ProfilerLayer>();
     PushLayer<TransformLayer>();
@@ -61,7 +62,7 @@ void ApplicationTime::SetTimeStep(const double &value)
 }
 double ApplicationTime::FixedDeltaTime() const
 {
-    return glfwGetTime() - m_lastFixedUpdateTime;
+    return Windows::GetTime() - m_lastFixedUpdateTime;
 }
 
 double ApplicationTime::DeltaTime() const
@@ -70,7 +71,7 @@ double ApplicationTime::DeltaTime() const
 }
 double ApplicationTime::CurrentTime() const
 {
-    return glfwGetTime();
+    return Windows::GetTime();
 }
 
 double ApplicationTime::LastFrameTime() const
@@ -79,7 +80,7 @@ double ApplicationTime::LastFrameTime() const
 }
 void ApplicationTime::StartFixedUpdate()
 {
-    m_fixedUpdateTimeStamp = glfwGetTime();
+    m_fixedUpdateTimeStamp = Windows::GetTime();
 }
 
 void ApplicationTime::EndFixedUpdate()
@@ -90,8 +91,8 @@ void Application::PreUpdateInternal()
 {
     auto &application = GetInstance();
     Windows::PreUpdate();
-    application.m_time.m_deltaTime = glfwGetTime() - application.m_time.m_frameStartTime;
-    application.m_time.m_frameStartTime = glfwGetTime();
+    application.m_time.m_deltaTime = Windows::GetTime() - application.m_time.m_frameStartTime;
+    application.m_time.m_frameStartTime = Windows::GetTime();
     Editor::ImGuiPreUpdate();
     OpenGLUtils::PreUpdate();
     if (application.m_applicationStatus == ApplicationStatus::Initialized)
@@ -199,7 +200,7 @@ void Application::LateUpdateInternal()
     Editor::ImGuiLateUpdate();
     // Swap Window's framebuffer
     Windows::LateUpdate();
-    application.m_time.m_lastUpdateTime = glfwGetTime();
+    application.m_time.m_lastUpdateTime = Windows::GetTime();
 }
 
 ApplicationTime &Application::Time()
@@ -246,8 +247,11 @@ void Application::Start()
         }
     }
     application.m_gameStatus = GameStatus::Stop;
-    while (application.m_applicationStatus != ApplicationStatus::OnDestroy)
+    const auto frameLimit = application.m_applicationConfigs.m_frameLimit;
+    for (size_t frame = 0; application.m_applicationStatus != ApplicationStatus::OnDestroy; frame++)
     {
+        if (frameLimit != 0 && frame == frameLimit)
+            break;
         PreUpdateInternal();
         UpdateInternal();
         LateUpdateInternal();
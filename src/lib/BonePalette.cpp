@@ -0,0 +1,204 @@
+#include <BonePalette.hpp>
+#include <Jobs.hpp>
+#include <SkinnedMeshRenderer.hpp>
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define UNIENGINE_BONE_PALETTE_SSE
+#include <xmmintrin.h>
+#endif
+using namespace UniEngine;
+
+void BonePalette::MultiplyAffine(const glm::mat4 *a, const glm::mat4 *b, glm::mat4 *results, const size_t &amount)
+{
+#ifdef UNIENGINE_BONE_PALETTE_SSE
+    // Column c of the product is the sum of the columns of a weighted by column c of b. The last row of b is
+    // (0, 0, 0, 1), so only the translation column takes the last column of a.
+    for (size_t i = 0; i < amount; i++)
+    {
+        const float *left = &a[i][0][0];
+        const float *right = &b[i][0][0];
+        const __m128 a0 = _mm_loadu_ps(left);
+        const __m128 a1 = _mm_loadu_ps(left + 4);
+        const __m128 a2 = _mm_loadu_ps(left + 8);
+        const __m128 a3 = _mm_loadu_ps(left + 12);
+        __m128 columns[4];
+        for (int c = 0; c < 4; c++)
+        {
+            const __m128 column = _mm_loadu_ps(right + c * 4);
+            columns[c] = _mm_add_ps(
+                _mm_add_ps(
+                    _mm_mul_ps(a0, _mm_shuffle_ps(column, column, _MM_SHUFFLE(0, 0, 0, 0))),
+                    _mm_mul_ps(a1, _mm_shuffle_ps(column, column, _MM_SHUFFLE(1, 1, 1, 1)))),
+                _mm_mul_ps(a2, _mm_shuffle_ps(column, column, _MM_SHUFFLE(2, 2, 2, 2))));
+        }
+        columns[3] = _mm_add_ps(columns[3], a3);
+        float *result = &results[i][0][0];
+        for (int c = 0; c < 4; c++)
+            _mm_storeu_ps(result + c * 4, columns[c]);
+    }
+#else
+    for (size_t i = 0; i < amount; i++)
+        results[i] = a[i] * b[i];
+#endif
+}
+
+void BonePalette::Build(const std::shared_ptr<Scene> &scene, const std::vector<Entity> &owners)
+{
+    auto &palette = GetInstance();
+    palette.m_version++;
+    struct Entry
+    {
+        std::shared_ptr<SkinnedMeshRenderer> m_renderer;
+        std::shared_ptr<Animator> m_animator;
+        std::shared_ptr<SkinnedMesh> m_skinnedMesh;
+        size_t m_offset;
+        bool m_dirty;
+    };
+    std::vector<Entry> entries;
+    entries.reserve(owners.size());
+    size_t size = 0;
+    for (const auto &owner : owners)
+    {
+        auto smmc = scene->GetOrSetPrivateComponent<SkinnedMeshRenderer>(owner).lock();
+        auto animator = smmc->m_animator.Get<Animator>();
+        auto skinnedMesh = smmc->m_skinnedMesh.Get<SkinnedMesh>();
+        if (!animator || !skinnedMesh || (!smmc->m_ragDoll && animator->m_boneSize == 0))
+            continue;
+        const size_t amount = skinnedMesh->m_boneAnimatorIndices.size();
+        auto &boneMatrices = *smmc->m_finalResults;
+        // The matrices written last frame are only still valid if the renderer kept its place.
+        const bool moved = boneMatrices.m_paletteVersion + 1 != palette.m_version ||
+                           boneMatrices.m_paletteOffset != size || boneMatrices.m_paletteSize != amount;
+        const bool ragDollMoving = smmc->m_ragDoll && !smmc->m_ragDollFreeze;
+        entries.push_back(
+            {smmc, animator, skinnedMesh, size, moved || ragDollMoving || animator->m_animatedCurrentFrame});
+        boneMatrices.m_paletteOffset = size;
+        boneMatrices.m_paletteSize = amount;
+        boneMatrices.m_paletteVersion = palette.m_version;
+        size += (amount + Alignment - 1) / Alignment * Alignment;
+    }
+    palette.m_matrices.resize(size);
+
+#pragma region Ragdolls
+    std::vector<Entity> entities;
+    std::vector<glm::mat4> offsetMatrices;
+    std::vector<glm::mat4 *> targets;
+    for (const auto &entry : entries)
+    {
+        const auto &smmc = entry.m_renderer;
+        if (!entry.m_dirty || !smmc->m_ragDoll || smmc->m_ragDollFreeze)
+            continue;
+        const size_t amount = (std::min)(
+            {smmc->m_boundEntities.size(),
+             smmc->m_ragDollTransformChain.size(),
+             entry.m_animator->m_offsetMatrices.size()});
+        for (size_t i = 0; i < amount; i++)
+        {
+            const auto entity = smmc->m_boundEntities[i].Get();
+            if (entity.GetIndex() == 0)
+                continue;
+            entities.push_back(entity);
+            offsetMatrices.push_back(entry.m_animator->m_offsetMatrices[i]);
+            targets.push_back(&smmc->m_ragDollTransformChain[i]);
+        }
+    }
+    if (!entities.empty())
+    {
+        std::vector<GlobalTransform> globalTransforms;
+        scene->GetGlobalTransforms(entities, globalTransforms);
+        static_assert(sizeof(GlobalTransform) == sizeof(glm::mat4));
+        std::vector<glm::mat4> ragDollMatrices(entities.size());
+        MultiplyAffine(
+            reinterpret_cast<const glm::mat4 *>(globalTransforms.data()),
+            offsetMatrices.data(),
+            ragDollMatrices.data(),
+            ragDollMatrices.size());
+        for (size_t i = 0; i < targets.size(); i++)
+            *targets[i] = ragDollMatrices[i];
+    }
+#pragma endregion
+
+    size_t dirtyBegin = size;
+    size_t dirtyEnd = 0;
+    size_t updatedAmount = 0;
+    for (const auto &entry : entries)
+    {
+        if (!entry.m_dirty)
+            continue;
+        dirtyBegin = (std::min)(dirtyBegin, entry.m_offset);
+        dirtyEnd = (std::max)(dirtyEnd, entry.m_offset + entry.m_skinnedMesh->m_boneAnimatorIndices.size());
+        updatedAmount++;
+    }
+    std::vector<std::shared_future<void>> results;
+    Jobs::ParallelFor(
+        entries.size(),
+        [&](unsigned i) {
+            const auto &entry = entries[i];
+            if (!entry.m_dirty)
+                return;
+            const auto &indices = entry.m_skinnedMesh->m_boneAnimatorIndices;
+            const auto &source = entry.m_renderer->m_ragDoll ? entry.m_renderer->m_ragDollTransformChain
+                                                             : entry.m_animator->m_transformChain;
+            glm::mat4 *matrices = palette.m_matrices.data() + entry.m_offset;
+            for (size_t j = 0; j < indices.size(); j++)
+                matrices[j] = indices[j] < source.size() ? source[indices[j]] : glm::mat4(1.0f);
+            entry.m_renderer->m_finalResults->Update();
+        },
+        results);
+    for (const auto &i : results)
+        i.wait();
+
+    if (dirtyBegin < dirtyEnd)
+    {
+        if (palette.m_dirtyBegin < palette.m_dirtyEnd)
+        {
+            dirtyBegin = (std::min)(dirtyBegin, palette.m_dirtyBegin);
+            dirtyEnd = (std::max)(dirtyEnd, palette.m_dirtyEnd);
+        }
+        palette.m_dirtyBegin = dirtyBegin;
+        palette.m_dirtyEnd = (std::min)(dirtyEnd, size);
+    }
+    palette.m_updatedAmount = updatedAmount;
+}
+
+void BonePalette::Upload()
+{
+    auto &palette = GetInstance();
+    if (palette.m_dirtyBegin >= palette.m_dirtyEnd)
+        return;
+    if (!palette.m_buffer)
+        palette.m_buffer = std::make_unique<OpenGLUtils::GLBuffer>(OpenGLUtils::GLBufferTarget::ShaderStorage, 8);
+    if (palette.m_bufferCapacity < palette.m_matrices.size())
+    {
+        palette.m_bufferCapacity = (std::max)(palette.m_matrices.size(), palette.m_bufferCapacity * 2);
+        palette.m_buffer->SetData(
+            static_cast<GLsizei>(palette.m_bufferCapacity * sizeof(glm::mat4)), nullptr, GL_STREAM_DRAW);
+        palette.m_dirtyBegin = 0;
+        palette.m_dirtyEnd = palette.m_matrices.size();
+    }
+    palette.m_buffer->SubData(
+        palette.m_dirtyBegin * sizeof(glm::mat4),
+        (palette.m_dirtyEnd - palette.m_dirtyBegin) * sizeof(glm::mat4),
+        palette.m_matrices.data() + palette.m_dirtyBegin);
+    palette.m_dirtyBegin = palette.m_dirtyEnd = 0;
+}
+
+bool BonePalette::Bind(const BoneMatrices &boneMatrices)
+{
+    auto &palette = GetInstance();
+    if (boneMatrices.m_paletteVersion != palette.m_version || boneMatrices.m_paletteSize == 0)
+        return false;
+    Upload();
+    palette.m_buffer->SetRange(
+        8, boneMatrices.m_paletteOffset * sizeof(glm::mat4), boneMatrices.m_paletteSize * sizeof(glm::mat4));
+    return true;
+}
+
+size_t BonePalette::GetMatrixAmount()
+{
+    return GetInstance().m_matrices.size();
+}
+
+size_t BonePalette::GetUpdatedAmount()
+{
+    return GetInstance().m_updatedAmount;
+}
@@ -0,0 +1,577 @@
+#include <BoundingVolumeHierarchy.hpp>
+using namespace UniEngine;
+
+namespace
+{
+enum class FrustumTest
+{
+    Outside,
+    Intersect,
+    Inside
+};
+
+thread_local std::vector<int> t_stack;
+
+Bound Union(const Bound &a, const Bound &b)
+{
+    Bound retVal;
+    retVal.m_min = glm::min(a.m_min, b.m_min);
+    retVal.m_max = glm::max(a.m_max, b.m_max);
+    return retVal;
+}
+
+float SurfaceArea(const Bound &bound)
+{
+    const glm::vec3 size = bound.m_max - bound.m_min;
+    return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+bool Encloses(const Bound &outer, const Bound &inner)
+{
+    return glm::all(glm::lessThanEqual(outer.m_min, inner.m_min)) &&
+           glm::all(glm::greaterThanEqual(outer.m_max, inner.m_max));
+}
+
+bool Overlap(const Bound &a, const Bound &b)
+{
+    return glm::all(glm::lessThanEqual(a.m_min, b.m_max)) && glm::all(glm::lessThanEqual(b.m_min, a.m_max));
+}
+
+Bound Fatten(const Bound &bound, const float &margin)
+{
+    const glm::vec3 padding = (bound.m_max - bound.m_min) * 0.05f + glm::vec3(margin);
+    Bound retVal;
+    retVal.m_min = bound.m_min - padding;
+    retVal.m_max = bound.m_max + padding;
+    return retVal;
+}
+
+FrustumTest TestFrustum(const Frustum &frustum, const Bound &bound)
+{
+    const glm::vec3 center = bound.Center();
+    const glm::vec3 extent = bound.Size();
+    FrustumTest retVal = FrustumTest::Inside;
+    for (const auto &plane : frustum.m_planes)
+    {
+        const glm::vec3 normal = plane;
+        const float distance = glm::dot(normal, center) + plane.w;
+        const float radius = glm::dot(glm::abs(normal), extent);
+        if (distance + radius < 0.0f)
+            return FrustumTest::Outside;
+        if (distance - radius < 0.0f)
+            retVal = FrustumTest::Intersect;
+    }
+    return retVal;
+}
+
+/**
+ * Reciprocal of the ray direction for TestRay. Components near 0 are replaced by a tiny value of the same sign, so a ray
+ * parallel to a slab gets a huge but finite reciprocal: 0 times infinity would give NaN when the origin lies on a face
+ * of the slab.
+ */
+glm::vec3 GetInverseDirection(const glm::vec3 &direction)
+{
+    constexpr float epsilon = 1e-12f;
+    glm::vec3 clamped = direction;
+    for (int i = 0; i < 3; i++)
+    {
+        if (glm::abs(clamped[i]) < epsilon)
+            clamped[i] = std::signbit(clamped[i]) ? -epsilon : epsilon;
+    }
+    return 1.0f / clamped;
+}
+
+// Slab test, distance is the entry point along the ray, 0 when the ray starts inside the bound.
+bool TestRay(
+    const glm::vec3 &origin,
+    const glm::vec3 &inverseDirection,
+    const float &maxDistance,
+    const Bound &bound,
+    float &distance)
+{
+    const glm::vec3 t0 = (bound.m_min - origin) * inverseDirection;
+    const glm::vec3 t1 = (bound.m_max - origin) * inverseDirection;
+    const glm::vec3 tNear = glm::min(t0, t1);
+    const glm::vec3 tFar = glm::max(t0, t1);
+    const float entry = (glm::max)((glm::max)(tNear.x, tNear.y), (glm::max)(tNear.z, 0.0f));
+    const float exit = (glm::min)((glm::min)(tFar.x, tFar.y), (glm::min)(tFar.z, maxDistance));
+    if (entry > exit)
+        return false;
+    distance = entry;
+    return true;
+}
+
+float SquaredDistance(const Bound &bound, const glm::vec3 &point)
+{
+    const glm::vec3 closest = glm::clamp(point, bound.m_min, bound.m_max);
+    const glm::vec3 delta = closest - point;
+    return glm::dot(delta, delta);
+}
+} // namespace
+
+bool BoundingVolumeHierarchy::Node::IsLeaf() const
+{
+    return m_children[0] == NullNode;
+}
+
+int BoundingVolumeHierarchy::AllocateNode()
+{
+    if (m_freeList == NullNode)
+    {
+        m_nodes.emplace_back();
+        m_nodes.back().m_height = 0;
+        return static_cast<int>(m_nodes.size()) - 1;
+    }
+    const int index = m_freeList;
+    m_freeList = m_nodes[index].m_parent;
+    m_nodes[index] = Node();
+    m_nodes[index].m_height = 0;
+    return index;
+}
+
+void BoundingVolumeHierarchy::FreeNode(const int &index)
+{
+    auto &node = m_nodes[index];
+    node.m_parent = m_freeList;
+    node.m_children[0] = node.m_children[1] = NullNode;
+    node.m_height = -1;
+    m_freeList = index;
+}
+
+void BoundingVolumeHierarchy::InsertLeaf(const int &leaf)
+{
+    if (m_root == NullNode)
+    {
+        m_root = leaf;
+        m_nodes[leaf].m_parent = NullNode;
+        return;
+    }
+    // Walk down to the sibling with the lowest surface area heuristic cost.
+    const Bound leafBound = m_nodes[leaf].m_bound;
+    int index = m_root;
+    while (!m_nodes[index].IsLeaf())
+    {
+        const auto &node = m_nodes[index];
+        const float area = SurfaceArea(node.m_bound);
+        const float combinedArea = SurfaceArea(Union(node.m_bound, leafBound));
+        // Cost of making a new parent for this node and the leaf, and the cost pushed down to the children.
+        const float cost = 2.0f * combinedArea;
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+        float childCosts[2];
+        for (int i = 0; i < 2; i++)
+        {
+            const auto &child = m_nodes[node.m_children[i]];
+            const float childArea = SurfaceArea(Union(child.m_bound, leafBound));
+            childCosts[i] = (child.IsLeaf() ? childArea : childArea - SurfaceArea(child.m_bound)) + inheritanceCost;
+        }
+        if (cost < childCosts[0] && cost < childCosts[1])
+            break;
+        index = childCosts[0] < childCosts[1] ? node.m_children[0] : node.m_children[1];
+    }
+    const int sibling = index;
+    const int oldParent = m_nodes[sibling].m_parent;
+    const int newParent = AllocateNode();
+    m_nodes[newParent].m_parent = oldParent;
+    m_nodes[newParent].m_bound = Union(leafBound, m_nodes[sibling].m_bound);
+    m_nodes[newParent].m_height = m_nodes[sibling].m_height + 1;
+    m_nodes[newParent].m_children[0] = sibling;
+    m_nodes[newParent].m_children[1] = leaf;
+    m_nodes[sibling].m_parent = newParent;
+    m_nodes[leaf].m_parent = newParent;
+    if (oldParent == NullNode)
+    {
+        m_root = newParent;
+    }
+    else
+    {
+        auto &parent = m_nodes[oldParent];
+        parent.m_children[parent.m_children[0] == sibling ? 0 : 1] = newParent;
+    }
+    index = m_nodes[leaf].m_parent;
+    while (index != NullNode)
+    {
+        index = Balance(index);
+        auto &node = m_nodes[index];
+        const auto &child0 = m_nodes[node.m_children[0]];
+        const auto &child1 = m_nodes[node.m_children[1]];
+        node.m_height = 1 + (glm::max)(child0.m_height, child1.m_height);
+        node.m_bound = Union(child0.m_bound, child1.m_bound);
+        index = node.m_parent;
+    }
+}
+
+void BoundingVolumeHierarchy::RemoveLeaf(const int &leaf)
+{
+    if (leaf == m_root)
+    {
+        m_root = NullNode;
+        return;
+    }
+    const int parent = m_nodes[leaf].m_parent;
+    const int grandParent = m_nodes[parent].m_parent;
+    const int sibling =
+        m_nodes[parent].m_children[0] == leaf ? m_nodes[parent].m_children[1] : m_nodes[parent].m_children[0];
+    FreeNode(parent);
+    if (grandParent == NullNode)
+    {
+        m_root = sibling;
+        m_nodes[sibling].m_parent = NullNode;
+        return;
+    }
+    auto &grandParentNode = m_nodes[grandParent];
+    grandParentNode.m_children[grandParentNode.m_children[0] == parent ? 0 : 1] = sibling;
+    m_nodes[sibling].m_parent = grandParent;
+    int index = grandParent;
+    while (index != NullNode)
+    {
+        index = Balance(index);
+        auto &node = m_nodes[index];
+        const auto &child0 = m_nodes[node.m_children[0]];
+        const auto &child1 = m_nodes[node.m_children[1]];
+        node.m_height = 1 + (glm::max)(child0.m_height, child1.m_height);
+        node.m_bound = Union(child0.m_bound, child1.m_bound);
+        index = node.m_parent;
+    }
+}
+
+int BoundingVolumeHierarchy::Balance(const int &index)
+{
+    // Rotate the taller grandchild up when the children heights differ by more than one.
+    const int a = index;
+    if (m_nodes[a].IsLeaf() || m_nodes[a].m_height < 2)
+        return a;
+    const int b = m_nodes[a].m_children[0];
+    const int c = m_nodes[a].m_children[1];
+    const int balance = m_nodes[c].m_height - m_nodes[b].m_height;
+    if (balance > 1 || balance < -1)
+    {
+        // up is promoted to the place of a, down stays as the other child of a.
+        const int upSide = balance > 1 ? 1 : 0;
+        const int up = m_nodes[a].m_children[upSide];
+        const int down = m_nodes[a].m_children[1 - upSide];
+        const int f = m_nodes[up].m_children[0];
+        const int g = m_nodes[up].m_children[1];
+
+        m_nodes[up].m_children[0] = a;
+        m_nodes[up].m_parent = m_nodes[a].m_parent;
+        m_nodes[a].m_parent = up;
+        if (m_nodes[up].m_parent != NullNode)
+        {
+            auto &parent = m_nodes[m_nodes[up].m_parent];
+            parent.m_children[parent.m_children[0] == a ? 0 : 1] = up;
+        }
+        else
+        {
+            m_root = up;
+        }
+        // The taller child of up stays with it, the shorter one replaces up under a.
+        const int keep = m_nodes[f].m_height > m_nodes[g].m_height ? f : g;
+        const int move = keep == f ? g : f;
+        m_nodes[up].m_children[1] = keep;
+        m_nodes[a].m_children[upSide] = move;
+        m_nodes[move].m_parent = a;
+
+        m_nodes[a].m_bound = Union(m_nodes[down].m_bound, m_nodes[move].m_bound);
+        m_nodes[a].m_height = 1 + (glm::max)(m_nodes[down].m_height, m_nodes[move].m_height);
+        m_nodes[up].m_bound = Union(m_nodes[a].m_bound, m_nodes[keep].m_bound);
+        m_nodes[up].m_height = 1 + (glm::max)(m_nodes[a].m_height, m_nodes[keep].m_height);
+        return up;
+    }
+    return a;
+}
+
+void BoundingVolumeHierarchy::UpdateNode(const int &leaf, const Bound &bound)
+{
+    auto &node = m_nodes[leaf];
+    node.m_tightBound = bound;
+    node.m_stamp = m_stamp;
+    const Bound fatBound = Fatten(bound, m_margin);
+    // Re-insert when the entity left its fat bound, or when it shrank so much that the fat bound is mostly empty.
+    if (Encloses(node.m_bound, bound) && SurfaceArea(node.m_bound) <= 4.0f * SurfaceArea(fatBound))
+        return;
+    RemoveLeaf(leaf);
+    m_nodes[leaf].m_bound = fatBound;
+    InsertLeaf(leaf);
+}
+
+int BoundingVolumeHierarchy::FindLeaf(const Entity &entity) const
+{
+    const auto index = entity.GetIndex();
+    if (index >= m_leaves.size())
+        return NullNode;
+    return m_leaves[index];
+}
+
+void BoundingVolumeHierarchy::Clear()
+{
+    m_nodes.clear();
+    m_leaves.clear();
+    m_leafCount = 0;
+    m_root = NullNode;
+    m_freeList = NullNode;
+}
+
+void BoundingVolumeHierarchy::Update(const Entity &entity, const Bound &bound)
+{
+    const int found = FindLeaf(entity);
+    if (found != NullNode)
+    {
+        // The index was reused by another entity, which does not inherit the pin.
+        if (m_nodes[found].m_entity != entity)
+            m_nodes[found].m_pinned = false;
+        m_nodes[found].m_entity = entity;
+        UpdateNode(found, bound);
+        return;
+    }
+    const int leaf = AllocateNode();
+    auto &node = m_nodes[leaf];
+    node.m_entity = entity;
+    node.m_tightBound = bound;
+    node.m_bound = Fatten(bound, m_margin);
+    node.m_stamp = m_stamp;
+    node.m_pinned = false;
+    if (entity.GetIndex() >= m_leaves.size())
+        m_leaves.resize(entity.GetIndex() + 1, NullNode);
+    m_leaves[entity.GetIndex()] = leaf;
+    m_leafCount++;
+    InsertLeaf(leaf);
+}
+
+void BoundingVolumeHierarchy::Merge(const Entity &entity, const Bound &bound)
+{
+    const int found = FindLeaf(entity);
+    if (found != NullNode && (m_nodes[found].m_stamp == m_stamp || m_nodes[found].m_pinned) &&
+        m_nodes[found].m_entity == entity)
+    {
+        UpdateNode(found, Union(m_nodes[found].m_tightBound, bound));
+        return;
+    }
+    Update(entity, bound);
+}
+
+void BoundingVolumeHierarchy::Remove(const Entity &entity)
+{
+    const int found = FindLeaf(entity);
+    if (found == NullNode || m_nodes[found].m_entity != entity)
+        return;
+    RemoveLeaf(found);
+    FreeNode(found);
+    m_leaves[entity.GetIndex()] = NullNode;
+    m_leafCount--;
+}
+
+void BoundingVolumeHierarchy::Pin(const Entity &entity, const bool &value)
+{
+    const int found = FindLeaf(entity);
+    if (found != NullNode && m_nodes[found].m_entity == entity)
+        m_nodes[found].m_pinned = value;
+}
+
+size_t BoundingVolumeHierarchy::RemoveStale()
+{
+    size_t removed = 0;
+    for (auto &leaf : m_leaves)
+    {
+        if (leaf == NullNode || m_nodes[leaf].m_stamp == m_stamp || m_nodes[leaf].m_pinned)
+            continue;
+        RemoveLeaf(leaf);
+        FreeNode(leaf);
+        leaf = NullNode;
+        removed++;
+    }
+    m_leafCount -= removed;
+    m_stamp++;
+    return removed;
+}
+
+bool BoundingVolumeHierarchy::Contains(const Entity &entity) const
+{
+    const int found = FindLeaf(entity);
+    return found != NullNode && m_nodes[found].m_entity == entity;
+}
+
+bool BoundingVolumeHierarchy::GetBound(const Entity &entity, Bound &bound) const
+{
+    const int found = FindLeaf(entity);
+    if (found == NullNode || m_nodes[found].m_entity != entity)
+        return false;
+    bound = m_nodes[found].m_tightBound;
+    return true;
+}
+
+size_t BoundingVolumeHierarchy::Size() const
+{
+    return m_leafCount;
+}
+
+int BoundingVolumeHierarchy::GetHeight() const
+{
+    return m_root == NullNode ? 0 : m_nodes[m_root].m_height;
+}
+
+void BoundingVolumeHierarchy::QueryFrustum(const Frustum &frustum, std::vector<Entity> &results) const
+{
+    if (m_root == NullNode)
+        return;
+    auto &stack = t_stack;
+    stack.clear();
+    stack.push_back(m_root);
+    while (!stack.empty())
+    {
+        const auto &node = m_nodes[stack.back()];
+        stack.pop_back();
+        if (node.IsLeaf())
+        {
+            if (frustum.Intersect(node.m_tightBound))
+                results.push_back(node.m_entity);
+            continue;
+        }
+        const auto test = TestFrustum(frustum, node.m_bound);
+        if (test == FrustumTest::Outside)
+            continue;
+        if (test == FrustumTest::Intersect)
+        {
+            stack.push_back(node.m_children[0]);
+            stack.push_back(node.m_children[1]);
+            continue;
+        }
+        // The whole subtree is inside, collect it without further plane tests.
+        const size_t base = stack.size();
+        stack.push_back(node.m_children[0]);
+        stack.push_back(node.m_children[1]);
+        while (stack.size() > base)
+        {
+            const auto &child = m_nodes[stack.back()];
+            stack.pop_back();
+            if (child.IsLeaf())
+            {
+                results.push_back(child.m_entity);
+                continue;
+            }
+            stack.push_back(child.m_children[0]);
+            stack.push_back(child.m_children[1]);
+        }
+    }
+}
+
+void BoundingVolumeHierarchy::QueryBound(const Bound &bound, std::vector<Entity> &results) const
+{
+    if (m_root == NullNode)
+        return;
+    auto &stack = t_stack;
+    stack.clear();
+    stack.push_back(m_root);
+    while (!stack.empty())
+    {
+        const auto &node = m_nodes[stack.back()];
+        stack.pop_back();
+        if (!Overlap(node.m_bound, bound))
+            continue;
+        if (node.IsLeaf())
+        {
+            if (Overlap(node.m_tightBound, bound))
+                results.push_back(node.m_entity);
+            continue;
+        }
+        stack.push_back(node.m_children[0]);
+        stack.push_back(node.m_children[1]);
+    }
+}
+
+void BoundingVolumeHierarchy::QuerySphere(
+    const glm::vec3 &center, const float &radius, std::vector<Entity> &results) const
+{
+    if (m_root == NullNode)
+        return;
+    const float squaredRadius = radius * radius;
+    auto &stack = t_stack;
+    stack.clear();
+    stack.push_back(m_root);
+    while (!stack.empty())
+    {
+        const auto &node = m_nodes[stack.back()];
+        stack.pop_back();
+        if (SquaredDistance(node.m_bound, center) > squaredRadius)
+            continue;
+        if (node.IsLeaf())
+        {
+            if (SquaredDistance(node.m_tightBound, center) <= squaredRadius)
+                results.push_back(node.m_entity);
+            continue;
+        }
+        stack.push_back(node.m_children[0]);
+        stack.push_back(node.m_children[1]);
+    }
+}
+
+void BoundingVolumeHierarchy::QueryRay(const Ray &ray, std::vector<std::pair<float, Entity>> &results) const
+{
+    if (m_root == NullNode)
+        return;
+    const glm::vec3 inverseDirection = GetInverseDirection(ray.m_direction);
+    const size_t begin = results.size();
+    auto &stack = t_stack;
+    stack.clear();
+    stack.push_back(m_root);
+    float distance;
+    while (!stack.empty())
+    {
+        const auto &node = m_nodes[stack.back()];
+        stack.pop_back();
+        if (!TestRay(ray.m_start, inverseDirection, ray.m_length, node.m_bound, distance))
+            continue;
+        if (node.IsLeaf())
+        {
+            if (TestRay(ray.m_start, inverseDirection, ray.m_length, node.m_tightBound, distance))
+                results.emplace_back(distance, node.m_entity);
+            continue;
+        }
+        stack.push_back(node.m_children[0]);
+        stack.push_back(node.m_children[1]);
+    }
+    std::sort(results.begin() + begin, results.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+}
+
+bool BoundingVolumeHierarchy::RayCast(const Ray &ray, Entity &entity, float &distance) const
+{
+    if (m_root == NullNode)
+        return false;
+    const glm::vec3 inverseDirection = GetInverseDirection(ray.m_direction);
+    float closest = ray.m_length;
+    bool hit = false;
+    auto &stack = t_stack;
+    stack.clear();
+    stack.push_back(m_root);
+    float entry;
+    while (!stack.empty())
+    {
+        const auto &node = m_nodes[stack.back()];
+        stack.pop_back();
+        // Anything entered beyond the closest hit so far can not beat it.
+        if (!TestRay(ray.m_start, inverseDirection, closest, node.m_bound, entry))
+            continue;
+        if (node.IsLeaf())
+        {
+            if (TestRay(ray.m_start, inverseDirection, closest, node.m_tightBound, entry) && (!hit || entry < closest))
+            {
+                closest = entry;
+                entity = node.m_entity;
+                hit = true;
+            }
+            continue;
+        }
+        // Visit the nearer child first so the closest hit shrinks early.
+        float entries[2];
+        const bool hits[2] = {
+            TestRay(ray.m_start, inverseDirection, closest, m_nodes[node.m_children[0]].m_bound, entries[0]),
+            TestRay(ray.m_start, inverseDirection, closest, m_nodes[node.m_children[1]].m_bound, entries[1])};
+        const int nearChild = hits[0] && (!hits[1] || entries[0] <= entries[1]) ? 0 : 1;
+        if (hits[1 - nearChild])
+            stack.push_back(node.m_children[1 - nearChild]);
+        if (hits[nearChild])
+            stack.push_back(node.m_children[nearChild]);
+    }
+    if (hit)
+        distance = closest;
+    return hit;
+}
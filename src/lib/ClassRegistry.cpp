@@ -2,6 +2,7 @@
 #include "Engine/Rendering/Graphics.hpp"
 #include <Camera.hpp>
 #include <ClassRegistry.hpp>
+#include <MeshLodChain.hpp>
 #include <MeshRenderer.hpp>
 #include <PhysicsLayer.hpp>
 #include <PlayerController.hpp>
@@ -30,6 +31,7 @@ SystemRegistration<PhysicsSystem> PhysicsSystemRegistry("PhysicsSystem");
 AssetRegistration<IAsset> IAssetRegistry("IAsset", {".ueasset"});
 AssetRegistration<Material> MaterialRegistry("Material", {".uemat"});
 AssetRegistration<Mesh> MeshRegistry("Mesh", {".uemesh"});
+AssetRegistration<MeshLodChain> MeshLodChainRegistry("MeshLodChain", {".uelod"});
 AssetRegistration<Texture2D> Texture2DReg("Texture2D", {".png", ".jpg", ".jpeg", ".tga", ".hdr"});
 AssetRegistration<Cubemap> CubemapReg("Cubemap", {".uecubemap"});
 AssetRegistration<LightProbe> LightProbeReg("LightProbe", {".uelightprobe"});
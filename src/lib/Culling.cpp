@@ -0,0 +1,517 @@
+#include <Culling.hpp>
+#include <Jobs.hpp>
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define UNIENGINE_CULLING_SSE
+#include <xmmintrin.h>
+#endif
+using namespace UniEngine;
+
+Frustum::Frustum(const glm::mat4 &projectionView)
+{
+    Set(projectionView);
+}
+
+void Frustum::Set(const glm::mat4 &projectionView)
+{
+    // glm is column major, row i of the matrix is (m[0][i], m[1][i], m[2][i], m[3][i]).
+    const glm::vec4 row0 = glm::vec4(projectionView[0][0], projectionView[1][0], projectionView[2][0], projectionView[3][0]);
+    const glm::vec4 row1 = glm::vec4(projectionView[0][1], projectionView[1][1], projectionView[2][1], projectionView[3][1]);
+    const glm::vec4 row2 = glm::vec4(projectionView[0][2], projectionView[1][2], projectionView[2][2], projectionView[3][2]);
+    const glm::vec4 row3 = glm::vec4(projectionView[0][3], projectionView[1][3], projectionView[2][3], projectionView[3][3]);
+    m_planes[0] = row3 + row0; // Left
+    m_planes[1] = row3 - row0; // Right
+    m_planes[2] = row3 + row1; // Bottom
+    m_planes[3] = row3 - row1; // Top
+    m_planes[4] = row3 + row2; // Near
+    m_planes[5] = row3 - row2; // Far
+    for (auto &plane : m_planes)
+    {
+        const float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f)
+            plane /= length;
+    }
+}
+
+bool Frustum::Intersect(const Bound &bound) const
+{
+    const auto center = bound.Center();
+    const auto extent = bound.Size();
+    for (const auto &plane : m_planes)
+    {
+        const glm::vec3 normal = plane;
+        if (glm::dot(normal, center) + glm::dot(glm::abs(normal), extent) + plane.w < 0.0f)
+            return false;
+    }
+    return true;
+}
+
+bool Frustum::Intersect(const glm::vec3 &center, const float &radius) const
+{
+    for (const auto &plane : m_planes)
+    {
+        if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+            return false;
+    }
+    return true;
+}
+
+void PackedBounds::Clear()
+{
+    m_centerX.clear();
+    m_centerY.clear();
+    m_centerZ.clear();
+    m_extentX.clear();
+    m_extentY.clear();
+    m_extentZ.clear();
+}
+
+void PackedBounds::Reserve(const size_t &size)
+{
+    m_centerX.reserve(size);
+    m_centerY.reserve(size);
+    m_centerZ.reserve(size);
+    m_extentX.reserve(size);
+    m_extentY.reserve(size);
+    m_extentZ.reserve(size);
+}
+
+size_t PackedBounds::Push(const Bound &bound)
+{
+    const auto center = bound.Center();
+    const auto extent = bound.Size();
+    m_centerX.push_back(center.x);
+    m_centerY.push_back(center.y);
+    m_centerZ.push_back(center.z);
+    m_extentX.push_back(extent.x);
+    m_extentY.push_back(extent.y);
+    m_extentZ.push_back(extent.z);
+    return m_centerX.size() - 1;
+}
+
+void PackedBounds::Set(const size_t &index, const Bound &bound)
+{
+    const auto center = bound.Center();
+    const auto extent = bound.Size();
+    m_centerX[index] = center.x;
+    m_centerY[index] = center.y;
+    m_centerZ[index] = center.z;
+    m_extentX[index] = extent.x;
+    m_extentY[index] = extent.y;
+    m_extentZ[index] = extent.z;
+}
+
+void PackedBounds::Resize(const size_t &size)
+{
+    m_centerX.resize(size, 0.0f);
+    m_centerY.resize(size, 0.0f);
+    m_centerZ.resize(size, 0.0f);
+    m_extentX.resize(size, 0.0f);
+    m_extentY.resize(size, 0.0f);
+    m_extentZ.resize(size, 0.0f);
+}
+
+size_t PackedBounds::Size() const
+{
+    return m_centerX.size();
+}
+
+Bound PackedBounds::Get(const size_t &index) const
+{
+    Bound bound;
+    const auto center = glm::vec3(m_centerX[index], m_centerY[index], m_centerZ[index]);
+    const auto extent = glm::vec3(m_extentX[index], m_extentY[index], m_extentZ[index]);
+    bound.m_min = center - extent;
+    bound.m_max = center + extent;
+    return bound;
+}
+
+size_t PackedBounds::Cull(const Frustum &frustum, std::vector<unsigned char> &visibility) const
+{
+    // Bounds tested by one job, a multiple of the SIMD width.
+    constexpr unsigned ChunkSize = 256;
+    const auto size = Size();
+    visibility.resize(size);
+    const auto chunkAmount = static_cast<unsigned>((size + ChunkSize - 1) / ChunkSize);
+    std::vector<size_t> visibleCounts(chunkAmount, 0);
+    const auto cullChunk = [&](unsigned chunkIndex) {
+        const size_t begin = static_cast<size_t>(chunkIndex) * ChunkSize;
+        const size_t end = (glm::min)(begin + ChunkSize, size);
+        size_t i = begin;
+        size_t visibleCount = 0;
+#ifdef UNIENGINE_CULLING_SSE
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        for (; i + 4 <= end; i += 4)
+        {
+            const __m128 centerX = _mm_loadu_ps(&m_centerX[i]);
+            const __m128 centerY = _mm_loadu_ps(&m_centerY[i]);
+            const __m128 centerZ = _mm_loadu_ps(&m_centerZ[i]);
+            const __m128 extentX = _mm_loadu_ps(&m_extentX[i]);
+            const __m128 extentY = _mm_loadu_ps(&m_extentY[i]);
+            const __m128 extentZ = _mm_loadu_ps(&m_extentZ[i]);
+            __m128 outside = _mm_setzero_ps();
+            for (const auto &plane : frustum.m_planes)
+            {
+                const __m128 normalX = _mm_set1_ps(plane.x);
+                const __m128 normalY = _mm_set1_ps(plane.y);
+                const __m128 normalZ = _mm_set1_ps(plane.z);
+                // Distance of the center plus the projected radius of the box on the plane normal.
+                __m128 distance = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(centerX, normalX), _mm_mul_ps(centerY, normalY)),
+                    _mm_add_ps(_mm_mul_ps(centerZ, normalZ), _mm_set1_ps(plane.w)));
+                const __m128 radius = _mm_add_ps(
+                    _mm_add_ps(
+                        _mm_mul_ps(extentX, _mm_andnot_ps(signMask, normalX)),
+                        _mm_mul_ps(extentY, _mm_andnot_ps(signMask, normalY))),
+                    _mm_mul_ps(extentZ, _mm_andnot_ps(signMask, normalZ)));
+                distance = _mm_add_ps(distance, radius);
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, zero));
+            }
+            const int mask = _mm_movemask_ps(outside);
+            for (int j = 0; j < 4; j++)
+            {
+                const bool visible = !(mask & (1 << j));
+                visibility[i + j] = visible;
+                visibleCount += visible;
+            }
+        }
+#endif
+        for (; i < end; i++)
+        {
+            const auto center = glm::vec3(m_centerX[i], m_centerY[i], m_centerZ[i]);
+            const auto extent = glm::vec3(m_extentX[i], m_extentY[i], m_extentZ[i]);
+            bool visible = true;
+            for (const auto &plane : frustum.m_planes)
+            {
+                const glm::vec3 normal = plane;
+                if (glm::dot(normal, center) + glm::dot(glm::abs(normal), extent) + plane.w < 0.0f)
+                {
+                    visible = false;
+                    break;
+                }
+            }
+            visibility[i] = visible;
+            visibleCount += visible;
+        }
+        visibleCounts[chunkIndex] = visibleCount;
+    };
+    if (chunkAmount > 1 && Jobs::Workers().Size() > 1)
+    {
+        std::vector<std::shared_future<void>> results;
+        Jobs::ParallelFor(chunkAmount, cullChunk, results);
+        for (const auto &i : results)
+            i.wait();
+    }
+    else
+    {
+        for (unsigned i = 0; i < chunkAmount; i++)
+            cullChunk(i);
+    }
+    size_t visibleCount = 0;
+    for (const auto &i : visibleCounts)
+        visibleCount += i;
+    return visibleCount;
+}
+
+void OcclusionBuffer::Begin(const glm::mat4 &projectionView, const unsigned &width, const unsigned &height)
+{
+    m_projectionView = projectionView;
+    m_width = (glm::max)(4u, (width + 3u) & ~3u);
+    m_height = (glm::max)(1u, height);
+    m_triangles.clear();
+    m_levelSizes.clear();
+    glm::uvec2 size = glm::uvec2(m_width, m_height);
+    m_levelSizes.push_back(size);
+    while (size.x > 1 || size.y > 1)
+    {
+        size = glm::uvec2((size.x + 1) / 2, (size.y + 1) / 2);
+        m_levelSizes.push_back(size);
+    }
+    m_levels.resize(m_levelSizes.size());
+    for (size_t i = 0; i < m_levels.size(); i++)
+        m_levels[i].resize(static_cast<size_t>(m_levelSizes[i].x) * m_levelSizes[i].y);
+}
+
+void OcclusionBuffer::AddTriangle(const glm::vec4 &a, const glm::vec4 &b, const glm::vec4 &c)
+{
+    ScreenTriangle triangle;
+    const glm::vec4 *clipPositions[3] = {&a, &b, &c};
+    glm::vec2 min = glm::vec2(FLT_MAX);
+    glm::vec2 max = glm::vec2(-FLT_MAX);
+    for (int i = 0; i < 3; i++)
+    {
+        const auto &clip = *clipPositions[i];
+        const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        triangle.m_vertices[i] = glm::vec3(
+            (ndc.x * 0.5f + 0.5f) * m_width, (ndc.y * 0.5f + 0.5f) * m_height, ndc.z * 0.5f + 0.5f);
+        min = glm::min(min, glm::vec2(triangle.m_vertices[i]));
+        max = glm::max(max, glm::vec2(triangle.m_vertices[i]));
+    }
+    // Pixels whose center is inside the bounding rectangle.
+    const glm::ivec2 first = glm::max(glm::ivec2(glm::ceil(min - 0.5f)), glm::ivec2(0));
+    const glm::ivec2 last =
+        glm::min(glm::ivec2(glm::floor(max - 0.5f)), glm::ivec2(m_width - 1, m_height - 1));
+    if (first.x > last.x || first.y > last.y)
+        return;
+    triangle.m_rect = glm::ivec4(first, last);
+    m_triangles.push_back(triangle);
+}
+
+void OcclusionBuffer::AddOccluder(
+    const std::vector<glm::vec3> &positions, const std::vector<glm::uvec3> &triangles, const glm::mat4 &model)
+{
+    const glm::mat4 transform = m_projectionView * model;
+    std::vector<glm::vec4> clipPositions(positions.size());
+    for (size_t i = 0; i < positions.size(); i++)
+        clipPositions[i] = transform * glm::vec4(positions[i], 1.0f);
+    // Signed distance to the near plane, z = -w in OpenGL clip space.
+    const auto nearDistance = [](const glm::vec4 &clip) { return clip.z + clip.w; };
+    for (const auto &triangle : triangles)
+    {
+        const glm::vec4 &a = clipPositions[triangle.x];
+        const glm::vec4 &b = clipPositions[triangle.y];
+        const glm::vec4 &c = clipPositions[triangle.z];
+        // Trivially outside of one side of the frustum.
+        if ((a.x > a.w && b.x > b.w && c.x > c.w) || (a.x < -a.w && b.x < -b.w && c.x < -c.w) ||
+            (a.y > a.w && b.y > b.w && c.y > c.w) || (a.y < -a.w && b.y < -b.w && c.y < -c.w))
+            continue;
+        const float distances[3] = {nearDistance(a), nearDistance(b), nearDistance(c)};
+        if (distances[0] >= 0.0f && distances[1] >= 0.0f && distances[2] >= 0.0f)
+        {
+            AddTriangle(a, b, c);
+            continue;
+        }
+        if (distances[0] < 0.0f && distances[1] < 0.0f && distances[2] < 0.0f)
+            continue;
+        // Clip against the near plane, the result has 3 or 4 vertices.
+        const glm::vec4 *vertices[3] = {&a, &b, &c};
+        glm::vec4 polygon[4];
+        int count = 0;
+        for (int i = 0; i < 3; i++)
+        {
+            const int next = (i + 1) % 3;
+            if (distances[i] >= 0.0f)
+                polygon[count++] = *vertices[i];
+            if ((distances[i] >= 0.0f) != (distances[next] >= 0.0f))
+            {
+                const float t = distances[i] / (distances[i] - distances[next]);
+                polygon[count++] = glm::mix(*vertices[i], *vertices[next], t);
+            }
+        }
+        for (int i = 2; i < count; i++)
+            AddTriangle(polygon[0], polygon[i - 1], polygon[i]);
+    }
+}
+
+void OcclusionBuffer::RasterizeBand(const unsigned &rowStart, const unsigned &rowEnd)
+{
+    auto &depth = m_levels[0];
+    std::fill(depth.begin() + static_cast<size_t>(rowStart) * m_width, depth.begin() + static_cast<size_t>(rowEnd) * m_width, 1.0f);
+    for (const auto &triangle : m_triangles)
+    {
+        const int yStart = (glm::max)(triangle.m_rect.y, static_cast<int>(rowStart));
+        const int yEnd = (glm::min)(triangle.m_rect.w, static_cast<int>(rowEnd) - 1);
+        if (yStart > yEnd)
+            continue;
+        const glm::vec3 &v0 = triangle.m_vertices[0];
+        glm::vec3 v1 = triangle.m_vertices[1];
+        glm::vec3 v2 = triangle.m_vertices[2];
+        float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+        if (glm::abs(area) < 1e-8f)
+            continue;
+        if (area < 0.0f)
+        {
+            std::swap(v1, v2);
+            area = -area;
+        }
+        // Edge functions e = a * x + b * y + c, positive inside. Edge i is opposite to vertex i.
+        const glm::vec3 edgeA = glm::vec3(v1.y - v2.y, v2.y - v0.y, v0.y - v1.y);
+        const glm::vec3 edgeB = glm::vec3(v2.x - v1.x, v0.x - v2.x, v1.x - v0.x);
+        const glm::vec3 edgeC = glm::vec3(
+            v1.x * v2.y - v2.x * v1.y, v2.x * v0.y - v0.x * v2.y, v0.x * v1.y - v1.x * v0.y);
+        // Depth is affine in screen space, z = depthA * x + depthB * y + depthC.
+        const glm::vec3 z = glm::vec3(v0.z, v1.z, v2.z) / area;
+        const float depthA = glm::dot(z, edgeA);
+        const float depthB = glm::dot(z, edgeB);
+        const float depthC = glm::dot(z, edgeC);
+        const int xStart = triangle.m_rect.x & ~3;
+        const int xEnd = triangle.m_rect.z;
+        for (int y = yStart; y <= yEnd; y++)
+        {
+            const float pixelY = y + 0.5f;
+            const glm::vec3 rowEdge = edgeB * pixelY + edgeC;
+            const float rowDepth = depthB * pixelY + depthC;
+            float *row = &depth[static_cast<size_t>(y) * m_width];
+            int x = xStart;
+#ifdef UNIENGINE_CULLING_SSE
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+            for (; x <= xEnd; x += 4)
+            {
+                const __m128 pixelX = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), offsets);
+                const __m128 e0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA.x), pixelX), _mm_set1_ps(rowEdge.x));
+                const __m128 e1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA.y), pixelX), _mm_set1_ps(rowEdge.y));
+                const __m128 e2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA.z), pixelX), _mm_set1_ps(rowEdge.z));
+                const __m128 inside =
+                    _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+                if (_mm_movemask_ps(inside) == 0)
+                    continue;
+                const __m128 pixelDepth = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(depthA), pixelX), _mm_set1_ps(rowDepth));
+                const __m128 current = _mm_loadu_ps(row + x);
+                const __m128 closest = _mm_min_ps(current, pixelDepth);
+                _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, closest), _mm_andnot_ps(inside, current)));
+            }
+#endif
+            for (; x <= xEnd; x++)
+            {
+                const float pixelX = x + 0.5f;
+                if (edgeA.x * pixelX + rowEdge.x < 0.0f || edgeA.y * pixelX + rowEdge.y < 0.0f ||
+                    edgeA.z * pixelX + rowEdge.z < 0.0f)
+                    continue;
+                row[x] = (glm::min)(row[x], depthA * pixelX + rowDepth);
+            }
+        }
+    }
+}
+
+void OcclusionBuffer::Rasterize()
+{
+    // Rows per job, small enough to spread a 256 pixel high buffer over the workers.
+    constexpr unsigned BandHeight = 16;
+    const unsigned bandAmount = (m_height + BandHeight - 1) / BandHeight;
+    const auto rasterizeBand = [&](unsigned bandIndex) {
+        RasterizeBand(bandIndex * BandHeight, (glm::min)((bandIndex + 1) * BandHeight, m_height));
+    };
+    if (bandAmount > 1 && Jobs::Workers().Size() > 1 && !m_triangles.empty())
+    {
+        std::vector<std::shared_future<void>> results;
+        Jobs::ParallelFor(bandAmount, rasterizeBand, results);
+        for (const auto &i : results)
+            i.wait();
+    }
+    else
+    {
+        for (unsigned i = 0; i < bandAmount; i++)
+            rasterizeBand(i);
+    }
+    for (size_t level = 1; level < m_levels.size(); level++)
+    {
+        const auto &source = m_levels[level - 1];
+        const auto &sourceSize = m_levelSizes[level - 1];
+        auto &target = m_levels[level];
+        const auto &targetSize = m_levelSizes[level];
+        for (unsigned y = 0; y < targetSize.y; y++)
+        {
+            const unsigned y0 = y * 2;
+            const unsigned y1 = (glm::min)(y0 + 1, sourceSize.y - 1);
+            for (unsigned x = 0; x < targetSize.x; x++)
+            {
+                const unsigned x0 = x * 2;
+                const unsigned x1 = (glm::min)(x0 + 1, sourceSize.x - 1);
+                target[static_cast<size_t>(y) * targetSize.x + x] = (glm::max)(
+                    (glm::max)(source[y0 * sourceSize.x + x0], source[y0 * sourceSize.x + x1]),
+                    (glm::max)(source[y1 * sourceSize.x + x0], source[y1 * sourceSize.x + x1]));
+            }
+        }
+    }
+}
+
+size_t OcclusionBuffer::GetTriangleAmount() const
+{
+    return m_triangles.size();
+}
+
+unsigned OcclusionBuffer::GetWidth() const
+{
+    return m_width;
+}
+
+unsigned OcclusionBuffer::GetHeight() const
+{
+    return m_height;
+}
+
+const std::vector<float> &OcclusionBuffer::PeekDepth() const
+{
+    return m_levels[0];
+}
+
+bool OcclusionBuffer::IsVisible(const Bound &bound) const
+{
+    if (m_levels.empty())
+        return true;
+    glm::vec2 min = glm::vec2(FLT_MAX);
+    glm::vec2 max = glm::vec2(-FLT_MAX);
+    float closestDepth = FLT_MAX;
+    for (int i = 0; i < 8; i++)
+    {
+        const glm::vec3 corner = glm::vec3(
+            i & 1 ? bound.m_max.x : bound.m_min.x, i & 2 ? bound.m_max.y : bound.m_min.y, i & 4 ? bound.m_max.z : bound.m_min.z);
+        const glm::vec4 clip = m_projectionView * glm::vec4(corner, 1.0f);
+        if (clip.z < -clip.w || clip.w <= 0.0f)
+            return true;
+        const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        const glm::vec2 screen = (glm::vec2(ndc) * 0.5f + 0.5f) * glm::vec2(m_width, m_height);
+        min = glm::min(min, screen);
+        max = glm::max(max, screen);
+        closestDepth = (glm::min)(closestDepth, ndc.z * 0.5f + 0.5f);
+    }
+    // Every pixel the rectangle touches, not only the ones whose center it covers.
+    const glm::ivec2 first = glm::max(glm::ivec2(glm::floor(min)), glm::ivec2(0));
+    const glm::ivec2 last = glm::min(glm::ivec2(glm::floor(max)), glm::ivec2(m_width - 1, m_height - 1));
+    if (first.x > last.x || first.y > last.y)
+        return true;
+    // The coarsest level where the rectangle spans at most 2x2 texels.
+    const int extent = (glm::max)(last.x - first.x, last.y - first.y) + 1;
+    int level = 0;
+    while ((1 << level) < extent)
+        level++;
+    level = (glm::min)(level, static_cast<int>(m_levels.size()) - 1);
+    const auto &depth = m_levels[level];
+    const auto &size = m_levelSizes[level];
+    for (int y = first.y >> level; y <= last.y >> level; y++)
+    {
+        for (int x = first.x >> level; x <= last.x >> level; x++)
+        {
+            if (depth[static_cast<size_t>(y) * size.x + x] >= closestDepth)
+                return true;
+        }
+    }
+    return false;
+}
+
+size_t OcclusionBuffer::Test(const PackedBounds &bounds, std::vector<unsigned char> &visibility) const
+{
+    constexpr unsigned ChunkSize = 256;
+    const auto size = (glm::min)(bounds.Size(), visibility.size());
+    const auto chunkAmount = static_cast<unsigned>((size + ChunkSize - 1) / ChunkSize);
+    std::vector<size_t> occludedCounts(chunkAmount, 0);
+    const auto testChunk = [&](unsigned chunkIndex) {
+        const size_t begin = static_cast<size_t>(chunkIndex) * ChunkSize;
+        const size_t end = (glm::min)(begin + ChunkSize, size);
+        for (size_t i = begin; i < end; i++)
+        {
+            if (visibility[i] && !IsVisible(bounds.Get(i)))
+            {
+                visibility[i] = 0;
+                occludedCounts[chunkIndex]++;
+            }
+        }
+    };
+    if (chunkAmount > 1 && Jobs::Workers().Size() > 1)
+    {
+        std::vector<std::shared_future<void>> results;
+        Jobs::ParallelFor(chunkAmount, testChunk, results);
+        for (const auto &i : results)
+            i.wait();
+    }
+    else
+    {
+        for (unsigned i = 0; i < chunkAmount; i++)
+            testChunk(i);
+    }
+    size_t occludedCount = 0;
+    for (const auto &i : occludedCounts)
+        occludedCount += i;
+    return occludedCount;
+}
@@ -277,8 +277,11 @@ bool Editor::DragAndDropButton(
 void Editor::ImGuiPreUpdate()
 {
 #pragma region ImGui
-    ImGui_ImplOpenGL3_NewFrame();
-    ImGui_ImplGlfw_NewFrame();
+    if (!GetInstance().m_headless)
+    {
+        ImGui_ImplOpenGL3_NewFrame();
+        ImGui_ImplGlfw_NewFrame();
+    }
     ImGui::NewFrame();
     ImGuizmo::BeginFrame();
 #pragma endregion
@@ -330,6 +333,8 @@ void Editor::ImGuiLateUpdate()
 #pragma region ImGui
     RenderTarget::BindDefault();
     ImGui::Render();
+    if (GetInstance().m_headless)
+        return;
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
     // Update and Render additional Platform Windows
@@ -345,15 +350,17 @@ void Editor::ImGuiLateUpdate()
     }
 #pragma endregion
 }
-void Editor::Init(bool docking, bool viewport)
+void Editor::Init(bool docking, bool viewport, bool headless)
 {
+    GetInstance().m_headless = headless;
 #pragma region ImGUI
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
     ImGuiIO &io = ImGui::GetIO();
     if (docking)
         io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
-    if (viewport)
+    // Platform windows need the platform backend.
+    if (viewport && !headless)
         io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;
     ImGui::StyleColorsDark();
     ImGuiStyle &style = ImGui::GetStyle();
@@ -362,7 +369,17 @@ void Editor::Init(bool docking, bool viewport)
         style.WindowRounding = 0.0f;
         style.Colors[ImGuiCol_WindowBg].w = 1.0f;
     }
-    ImGui_ImplGlfw_InitForOpenGL(Windows::GetWindow(), true);
-    ImGui_ImplOpenGL3_Init("#version 450 core");
+    if (headless)
+    {
+        // The backends would load GL from the driver and fill these in every frame.
+        const auto &size = Application::GetInstance().m_applicationConfigs.m_defaultWindowSize;
+        io.DisplaySize = ImVec2(static_cast<float>(size.x), static_cast<float>(size.y));
+        io.Fonts->Build();
+    }
+    else
+    {
+        ImGui_ImplGlfw_InitForOpenGL(Windows::GetWindow(), true);
+        ImGui_ImplOpenGL3_Init("#version 450 core");
+    }
 #pragma endregion
 }
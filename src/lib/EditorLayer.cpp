@@ -18,6 +18,7 @@
 #include "Particles.hpp"
 #include "PhysicsLayer.hpp"
 #include "PlayerController.hpp"
+#include "PointCloudOctree.hpp"
 #include "PostProcessing.hpp"
 #include "ProjectManager.hpp"
 #include "RigidBody.hpp"
@@ -497,7 +498,7 @@ void EditorLayer::RenderToSceneCamera() {
     auto renderLayer = Application::GetLayer<RenderLayer>();
     if (!renderLayer)
         return;
-    ProfilerLayer::StartEvent("RenderToSceneCamera");
+    ProfilerLayer::StartEvent(UNIENGINE_PROFILE_EVENT("RenderToSceneCamera"));
 
     const auto resolution = m_sceneCamera->UnsafeGetGBuffer()->GetResolution();
     if (m_sceneCameraResolutionX != 0 && m_sceneCameraResolutionY != 0 &&
@@ -530,133 +531,133 @@ void EditorLayer::RenderToSceneCamera() {
         GlobalTransform sceneCameraGT;
         sceneCameraGT.SetValue(m_sceneCameraPosition, m_sceneCameraRotation, glm::vec3(1.0f));
         renderLayer->RenderToCamera(m_sceneCamera, sceneCameraGT);
+        PointCloudOctree::StreamOpenOctrees(m_sceneCamera, m_sceneCameraPosition, m_sceneCameraRotation);
 #pragma region For entity selection
         OpenGLUtils::SetEnable(OpenGLCapability::DepthTest, true);
         OpenGLUtils::SetPolygonMode(OpenGLPolygonMode::Fill);
         OpenGLUtils::SetEnable(OpenGLCapability::Blend, false);
         OpenGLUtils::SetEnable(OpenGLCapability::CullFace, false);
         m_sceneCameraEntityRecorder->Bind();
-        for (auto &i: renderLayer->m_deferredRenderInstances) {
-            const auto &cameraComponent = i.first;
-            renderLayer->DispatchRenderCommands(
-                    i.second,
-                    [&](const std::shared_ptr<Material> &material, const RenderCommand &renderCommand) {
-                        switch (renderCommand.m_geometryType) {
-                            case RenderGeometryType::Mesh: {
-                                auto &program = DefaultResources::m_sceneCameraEntityRecorderProgram;
-                                program->Bind();
-                                program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
-                                DefaultResources::m_sceneCameraEntityRecorderProgram->SetInt(
-                                        "EntityIndex", renderCommand.m_owner.GetIndex());
-                                renderCommand.m_renderGeometry->Draw();
-                                break;
-                            }
-                            case RenderGeometryType::SkinnedMesh: {
-                                auto &program = DefaultResources::m_sceneCameraEntitySkinnedRecorderProgram;
-                                program->Bind();
-                                program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
-                                renderCommand.m_boneMatrices->UploadBones(
-                                    std::dynamic_pointer_cast<SkinnedMesh>(renderCommand.m_renderGeometry));
-                                DefaultResources::m_sceneCameraEntitySkinnedRecorderProgram->SetInt(
-                                        "EntityIndex", renderCommand.m_owner.GetIndex());
-                                renderCommand.m_renderGeometry->Draw();
-                                break;
-                            }
-                            case RenderGeometryType::Strands: {
-                                auto& program = DefaultResources::m_sceneCameraEntityStrandsRecorderProgram;
-                                program->Bind();
-                                program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
-                                DefaultResources::m_sceneCameraEntityStrandsRecorderProgram->SetInt(
+        // Only the commands the scene camera draws, they are already culled against its frustum.
+        const auto sceneCameraSlot = renderLayer->GetCameraSlot(m_sceneCamera);
+        renderLayer->DispatchRenderCommands(
+                RenderCommandPass::Deferred,
+                sceneCameraSlot,
+                [&](const std::shared_ptr<Material> &material, const RenderCommand &renderCommand) {
+                    switch (renderCommand.m_geometryType) {
+                        case RenderGeometryType::Mesh: {
+                            auto &program = DefaultResources::m_sceneCameraEntityRecorderProgram;
+                            program->Bind();
+                            program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
+                            DefaultResources::m_sceneCameraEntityRecorderProgram->SetInt(
                                     "EntityIndex", renderCommand.m_owner.GetIndex());
-                                renderCommand.m_renderGeometry->Draw();
-                                break;
-                            }
+                            renderLayer->GetGeometry<RenderGeometry>(renderCommand)->Draw();
+                            break;
                         }
-                    },
-                    false);
-        }
-        for (auto &i: renderLayer->m_deferredInstancedRenderInstances) {
-            renderLayer->DispatchRenderCommands(
-                    i.second,
-                    [&](const std::shared_ptr<Material> &material, const RenderCommand &renderCommand) {
-                        switch (renderCommand.m_geometryType) {
-                            case RenderGeometryType::Mesh: {
-                                auto &program = DefaultResources::m_sceneCameraEntityInstancedRecorderProgram;
-                                program->Bind();
-                                program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
-                                DefaultResources::m_sceneCameraEntityInstancedRecorderProgram->SetInt(
-                                        "EntityIndex", renderCommand.m_owner.GetIndex());
-                                DefaultResources::m_sceneCameraEntityInstancedRecorderProgram->SetFloat4x4(
-                                        "model", renderCommand.m_globalTransform.m_value);
-                                renderCommand.m_renderGeometry->DrawInstanced(renderCommand.m_matrices);
-                                break;
-                            }
+                        case RenderGeometryType::SkinnedMesh: {
+                            auto &program = DefaultResources::m_sceneCameraEntitySkinnedRecorderProgram;
+                            program->Bind();
+                            program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
+                            renderLayer->GetBoneMatrices(renderCommand)->UploadBones(
+                                renderLayer->GetGeometry<SkinnedMesh>(renderCommand));
+                            DefaultResources::m_sceneCameraEntitySkinnedRecorderProgram->SetInt(
+                                    "EntityIndex", renderCommand.m_owner.GetIndex());
+                            renderLayer->GetGeometry<RenderGeometry>(renderCommand)->Draw();
+                            break;
                         }
-                    },
-                    false);
-        }
-        for (auto &i: renderLayer->m_forwardRenderInstances) {
-            renderLayer->DispatchRenderCommands(
-                    i.second,
-                    [&](const std::shared_ptr<Material> &material, const RenderCommand &renderCommand) {
-                        switch (renderCommand.m_geometryType) {
-                            case RenderGeometryType::Mesh: {
-                                auto &program = DefaultResources::m_sceneCameraEntityRecorderProgram;
-                                program->Bind();
-                                program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
-                                DefaultResources::m_sceneCameraEntityRecorderProgram->SetInt(
-                                        "EntityIndex", renderCommand.m_owner.GetIndex());
-                                renderCommand.m_renderGeometry->Draw();
-                                break;
-                            }
-                            case RenderGeometryType::SkinnedMesh: {
-                                auto &program = DefaultResources::m_sceneCameraEntitySkinnedRecorderProgram;
-                                program->Bind();
-                                program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
-                                renderCommand.m_boneMatrices->UploadBones(
-                                        std::dynamic_pointer_cast<SkinnedMesh>(renderCommand.m_renderGeometry));
-                                DefaultResources::m_sceneCameraEntitySkinnedRecorderProgram->SetInt(
-                                        "EntityIndex", renderCommand.m_owner.GetIndex());
-                                renderCommand.m_renderGeometry->Draw();
-                                break;
-                            }
-                            case RenderGeometryType::Strands: {
-                                auto& program = DefaultResources::m_sceneCameraEntityStrandsRecorderProgram;
-                                program->Bind();
-                                program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
-                                DefaultResources::m_sceneCameraEntityStrandsRecorderProgram->SetInt(
+                        case RenderGeometryType::Strands: {
+                            auto& program = DefaultResources::m_sceneCameraEntityStrandsRecorderProgram;
+                            program->Bind();
+                            program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
+                            DefaultResources::m_sceneCameraEntityStrandsRecorderProgram->SetInt(
+                                "EntityIndex", renderCommand.m_owner.GetIndex());
+                            renderLayer->GetGeometry<RenderGeometry>(renderCommand)->Draw();
+                            break;
+                        }
+                    }
+                },
+                false);
+        renderLayer->DispatchRenderCommands(
+                RenderCommandPass::DeferredInstanced,
+                sceneCameraSlot,
+                [&](const std::shared_ptr<Material> &material, const RenderCommand &renderCommand) {
+                    switch (renderCommand.m_geometryType) {
+                        case RenderGeometryType::Mesh: {
+                            auto &program = DefaultResources::m_sceneCameraEntityInstancedRecorderProgram;
+                            program->Bind();
+                            program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
+                            DefaultResources::m_sceneCameraEntityInstancedRecorderProgram->SetInt(
                                     "EntityIndex", renderCommand.m_owner.GetIndex());
-                                renderCommand.m_renderGeometry->Draw();
-                                break;
-                            }
+                            DefaultResources::m_sceneCameraEntityInstancedRecorderProgram->SetFloat4x4(
+                                    "model", renderCommand.m_globalTransform.m_value);
+                            renderLayer->GetGeometry<Mesh>(renderCommand)->DrawInstanced(
+                                renderLayer->GetParticleMatrices(renderCommand));
+                            break;
                         }
-                    },
-                    false);
-        }
-        for (auto &i: renderLayer->m_forwardInstancedRenderInstances) {
-            renderLayer->DispatchRenderCommands(
-                    i.second,
-                    [&](const std::shared_ptr<Material> &material, const RenderCommand &renderCommand) {
-                        switch (renderCommand.m_geometryType) {
-                            case RenderGeometryType::Mesh: {
-                                auto &program = DefaultResources::m_sceneCameraEntityInstancedRecorderProgram;
-                                program->Bind();
-                                program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
-                                DefaultResources::m_sceneCameraEntityInstancedRecorderProgram->SetInt(
-                                        "EntityIndex", renderCommand.m_owner.GetIndex());
-                                DefaultResources::m_sceneCameraEntityInstancedRecorderProgram->SetFloat4x4(
-                                        "model", renderCommand.m_globalTransform.m_value);
-                                renderCommand.m_renderGeometry->DrawInstanced(renderCommand.m_matrices);
-                                break;
-                            }
+                    }
+                },
+                false);
+        renderLayer->DispatchRenderCommands(
+                RenderCommandPass::Forward,
+                sceneCameraSlot,
+                [&](const std::shared_ptr<Material> &material, const RenderCommand &renderCommand) {
+                    switch (renderCommand.m_geometryType) {
+                        case RenderGeometryType::Mesh: {
+                            auto &program = DefaultResources::m_sceneCameraEntityRecorderProgram;
+                            program->Bind();
+                            program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
+                            DefaultResources::m_sceneCameraEntityRecorderProgram->SetInt(
+                                    "EntityIndex", renderCommand.m_owner.GetIndex());
+                            renderLayer->GetGeometry<RenderGeometry>(renderCommand)->Draw();
+                            break;
                         }
-                    },
-                    false);
-        }
+                        case RenderGeometryType::SkinnedMesh: {
+                            auto &program = DefaultResources::m_sceneCameraEntitySkinnedRecorderProgram;
+                            program->Bind();
+                            program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
+                            renderLayer->GetBoneMatrices(renderCommand)->UploadBones(
+                                renderLayer->GetGeometry<SkinnedMesh>(renderCommand));
+                            DefaultResources::m_sceneCameraEntitySkinnedRecorderProgram->SetInt(
+                                    "EntityIndex", renderCommand.m_owner.GetIndex());
+                            renderLayer->GetGeometry<RenderGeometry>(renderCommand)->Draw();
+                            break;
+                        }
+                        case RenderGeometryType::Strands: {
+                            auto& program = DefaultResources::m_sceneCameraEntityStrandsRecorderProgram;
+                            program->Bind();
+                            program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
+                            DefaultResources::m_sceneCameraEntityStrandsRecorderProgram->SetInt(
+                                "EntityIndex", renderCommand.m_owner.GetIndex());
+                            renderLayer->GetGeometry<RenderGeometry>(renderCommand)->Draw();
+                            break;
+                        }
+                    }
+                },
+                false);
+        renderLayer->DispatchRenderCommands(
+                RenderCommandPass::ForwardInstanced,
+                sceneCameraSlot,
+                [&](const std::shared_ptr<Material> &material, const RenderCommand &renderCommand) {
+                    switch (renderCommand.m_geometryType) {
+                        case RenderGeometryType::Mesh: {
+                            auto &program = DefaultResources::m_sceneCameraEntityInstancedRecorderProgram;
+                            program->Bind();
+                            program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
+                            DefaultResources::m_sceneCameraEntityInstancedRecorderProgram->SetInt(
+                                    "EntityIndex", renderCommand.m_owner.GetIndex());
+                            DefaultResources::m_sceneCameraEntityInstancedRecorderProgram->SetFloat4x4(
+                                    "model", renderCommand.m_globalTransform.m_value);
+                            renderLayer->GetGeometry<Mesh>(renderCommand)->DrawInstanced(
+                                renderLayer->GetParticleMatrices(renderCommand));
+                            break;
+                        }
+                    }
+                },
+                false);
 #pragma endregion
     } else {
     }
-    ProfilerLayer::EndEvent("RenderToSceneCamera");
+    ProfilerLayer::EndEvent(UNIENGINE_PROFILE_EVENT("RenderToSceneCamera"));
 }
 
 void EditorLayer::DrawEntityNode(const Entity &entity, const unsigned &hierarchyLevel) {
@@ -909,28 +909,15 @@ void Graphics::DrawMesh(
 		RenderCommand renderCommand;
 		renderCommand.m_commandType = RenderCommandType::FromAPI;
 		renderCommand.m_geometryType = RenderGeometryType::Mesh;
-		renderCommand.m_renderGeometry = mesh;
+		renderCommand.m_geometryIndex = renderLayer->m_renderResources.Add(mesh);
+		renderCommand.m_materialIndex = renderLayer->m_renderResources.Add(material);
 		renderCommand.m_receiveShadow = receiveShadow;
 		renderCommand.m_castShadow = castShadow;
 		renderCommand.m_globalTransform.m_value = model;
-		auto &group = renderLayer->m_forwardRenderInstances[cameraComponent->GetHandle()];
-		group.m_camera = cameraComponent;
-		auto &commands = group.m_renderCommandsGroups[material->GetHandle()];
-		commands.m_material = material;
-		commands.m_renderCommands[mesh->GetHandle()].push_back(
-						renderCommand);
-		auto editorLayer = Application::GetLayer<EditorLayer>();
-		if (editorLayer) {
-				auto &sceneCamera = editorLayer->m_sceneCamera;
-				if (sceneCamera && sceneCamera->IsEnabled()) {
-						auto &group = renderLayer->m_forwardRenderInstances[sceneCamera->GetHandle()];
-						group.m_camera = sceneCamera;
-						auto &commands = group.m_renderCommandsGroups[material->GetHandle()];
-						commands.m_material = material;
-						commands.m_renderCommands[mesh->GetHandle()].push_back(
-										renderCommand);
-				}
-		}
+		renderCommand.m_center = glm::vec3(model[3]);
+		renderCommand.m_sortKey = RenderSort::OpaqueKey(
+						static_cast<unsigned>(RenderCommandPass::Forward), renderCommand.m_materialIndex, renderCommand.m_geometryIndex, 0.0f);
+		renderLayer->PushApiRenderCommand(renderCommand, cameraComponent);
 }
 
 void Graphics::DrawMeshInstanced(
@@ -948,30 +935,16 @@ void Graphics::DrawMeshInstanced(
 		RenderCommand renderCommand;
 		renderCommand.m_commandType = RenderCommandType::FromAPI;
 		renderCommand.m_geometryType = RenderGeometryType::Mesh;
-		renderCommand.m_renderGeometry = mesh;
-		renderCommand.m_matrices = matrices;
+		renderCommand.m_geometryIndex = renderLayer->m_renderResources.Add(mesh);
+		renderCommand.m_materialIndex = renderLayer->m_renderResources.Add(material);
+		renderCommand.m_matricesIndex = renderLayer->m_renderResources.Add(matrices);
 		renderCommand.m_receiveShadow = receiveShadow;
 		renderCommand.m_castShadow = castShadow;
 		renderCommand.m_globalTransform.m_value = model;
-
-		auto &group = renderLayer->m_forwardInstancedRenderInstances[cameraComponent->GetHandle()];
-		group.m_camera = cameraComponent;
-		auto &commands = group.m_renderCommandsGroups[material->GetHandle()];
-		commands.m_material = material;
-		commands.m_renderCommands[mesh->GetHandle()].push_back(
-						renderCommand);
-		auto editorLayer = Application::GetLayer<EditorLayer>();
-		if (editorLayer) {
-				auto &sceneCamera = editorLayer->m_sceneCamera;
-				if (sceneCamera && sceneCamera->IsEnabled()) {
-						auto &group = renderLayer->m_forwardInstancedRenderInstances[sceneCamera->GetHandle()];
-						group.m_camera = sceneCamera;
-						auto &commands = group.m_renderCommandsGroups[material->GetHandle()];
-						commands.m_material = material;
-						commands.m_renderCommands[mesh->GetHandle()]
-										.push_back(renderCommand);
-				}
-		}
+		renderCommand.m_center = glm::vec3(model[3]);
+		renderCommand.m_sortKey = RenderSort::OpaqueKey(
+						static_cast<unsigned>(RenderCommandPass::ForwardInstanced), renderCommand.m_materialIndex, renderCommand.m_geometryIndex, 0.0f);
+		renderLayer->PushApiRenderCommand(renderCommand, cameraComponent);
 }
 
 /*
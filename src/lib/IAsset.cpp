@@ -1,5 +1,6 @@
 #include <DefaultResources.hpp>
 #include <IAsset.hpp>
+#include <MemoryStats.hpp>
 #include <ProjectManager.hpp>
 using namespace UniEngine;
 bool IAsset::Save()
@@ -57,7 +58,8 @@ bool IAsset::LoadInternal(const std::filesystem::path &path)
         std::ifstream stream(path.string());
         std::stringstream stringStream;
         stringStream << stream.rdbuf();
-        YAML::Node in = YAML::Load(stringStream.str());
+        MemoryStats::ScopedAllocation yamlBuffer(MemoryTag::YamlBuffers, static_cast<size_t>(stringStream.tellp()));
+        YAML::Node in = YAML::Load(stringStream);
         Deserialize(in);
     }
     catch (std::exception e)
@@ -2,8 +2,16 @@
 #include "Entities.hpp"
 #include "Application.hpp"
 #include "Scene.hpp"
+#include "TraceRecorder.hpp"
 using namespace UniEngine;
 
+uint32_t ISystem::GetProfilerScope()
+{
+    if (!m_profilerScope)
+        m_profilerScope = TraceRecorder::RegisterScope(GetTypeName());
+    return *m_profilerScope;
+}
+
 ISystem::ISystem()
 {
     m_enabled = false;
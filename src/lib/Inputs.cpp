@@ -13,7 +13,7 @@ void Inputs::Init()
 bool Inputs::GetKey(int key)
 {
     bool retVal = false;
-    if (Application::GetLayer<EditorLayer>()->MainCameraWindowFocused())
+    if (Windows::GetWindow() && Application::GetLayer<EditorLayer>()->MainCameraWindowFocused())
     {
         const auto state = glfwGetKey(Windows::GetWindow(), key);
         retVal = state == GLFW_PRESS || state == GLFW_REPEAT;
@@ -24,7 +24,7 @@ bool Inputs::GetKey(int key)
 bool Inputs::GetMouse(int button)
 {
     bool retVal = false;
-    if (Application::GetLayer<EditorLayer>()->MainCameraWindowFocused())
+    if (Windows::GetWindow() && Application::GetLayer<EditorLayer>()->MainCameraWindowFocused())
     {
         retVal = glfwGetMouseButton(Windows::GetWindow(), button) == GLFW_PRESS;
     }
@@ -34,7 +34,7 @@ glm::vec2 Inputs::GetMouseAbsolutePosition()
 {
     double x = FLT_MIN;
     double y = FLT_MIN;
-    if (Application::GetLayer<EditorLayer>()->MainCameraWindowFocused())
+    if (Windows::GetWindow() && Application::GetLayer<EditorLayer>()->MainCameraWindowFocused())
     {
         glfwGetCursorPos(Windows::GetWindow(), &x, &y);
     }
@@ -80,12 +80,16 @@ bool Inputs::GetMousePosition(glm::vec2 &pos)
 
 bool Inputs::GetKeyInternal(int key, GLFWwindow *window)
 {
+    if (!window)
+        return false;
     auto state = glfwGetKey(window, key);
     return state == GLFW_PRESS;
 }
 
 bool Inputs::GetMouseInternal(int button, GLFWwindow *window)
 {
+    if (!window)
+        return false;
     return glfwGetMouseButton(window, button) == GLFW_PRESS;
 }
 
@@ -93,6 +97,7 @@ glm::vec2 Inputs::GetMouseAbsolutePositionInternal(GLFWwindow *window)
 {
     double x = FLT_MIN;
     double y = FLT_MIN;
-    glfwGetCursorPos(window, &x, &y);
+    if (window)
+        glfwGetCursorPos(window, &x, &y);
     return glm::vec2(x, y);
 }
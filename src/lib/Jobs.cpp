@@ -16,6 +16,11 @@ void Jobs::Init()
 {
     Workers().Resize(std::thread::hardware_concurrency() - 1);
 }
+
+bool Jobs::IsWorkerThread()
+{
+    return GetInstance().m_workers.IsWorkerThread();
+}
 void Jobs::ParallelFor(
     unsigned size, const std::function<void(unsigned i)> &func, std::vector<std::shared_future<void>> &results)
 {
@@ -0,0 +1,204 @@
+#include "MemoryStats.hpp"
+#include "Animation.hpp"
+#include "Application.hpp"
+#include "Console.hpp"
+#include "PointCloud.hpp"
+#include "ProjectManager.hpp"
+#include "Scene.hpp"
+#include "SkinnedMesh.hpp"
+using namespace UniEngine;
+
+namespace
+{
+void CountBoneKeyFrames(const std::shared_ptr<Bone> &bone, size_t &bytes, size_t &amount)
+{
+    if (!bone)
+        return;
+    for (const auto &i : bone->m_animations)
+    {
+        const auto &keyFrames = i.second;
+        bytes += keyFrames.m_positions.capacity() * sizeof(BonePosition) +
+                 keyFrames.m_rotations.capacity() * sizeof(BoneRotation) +
+                 keyFrames.m_scales.capacity() * sizeof(BoneScale);
+        amount += keyFrames.m_positions.size() + keyFrames.m_rotations.size() + keyFrames.m_scales.size();
+    }
+    for (const auto &i : bone->m_children)
+        CountBoneKeyFrames(i, bytes, amount);
+}
+
+/**
+ * Bytes the string holds on the heap, 0 when its characters live inside of the string object.
+ */
+size_t GetHeapBytes(const std::string &value)
+{
+    const auto *data = value.data();
+    const auto *object = reinterpret_cast<const char *>(&value);
+    if (data >= object && data < object + sizeof(std::string))
+        return 0;
+    return value.capacity() + 1;
+}
+} // namespace
+
+MemoryStats::ScopedAllocation::ScopedAllocation(const MemoryTag &tag, const size_t &bytes) : m_tag(tag), m_bytes(bytes)
+{
+    Allocate(m_tag, m_bytes);
+}
+
+MemoryStats::ScopedAllocation::~ScopedAllocation()
+{
+    Free(m_tag, m_bytes);
+}
+
+void MemoryStats::Allocate(const MemoryTag &tag, const size_t &bytes)
+{
+    auto &memoryStats = GetInstance();
+    const auto index = static_cast<size_t>(tag);
+    const size_t current = memoryStats.m_allocatedBytes[index].fetch_add(bytes) + bytes;
+    memoryStats.m_allocatedAmount[index]++;
+    auto &peak = memoryStats.m_allocatedPeakBytes[index];
+    size_t previousPeak = peak.load();
+    while (previousPeak < current && !peak.compare_exchange_weak(previousPeak, current))
+        ;
+}
+
+void MemoryStats::Free(const MemoryTag &tag, const size_t &bytes)
+{
+    auto &memoryStats = GetInstance();
+    const auto index = static_cast<size_t>(tag);
+    memoryStats.m_allocatedBytes[index] -= bytes;
+    memoryStats.m_allocatedAmount[index]--;
+}
+
+void MemoryStats::Collect()
+{
+    auto &memoryStats = GetInstance();
+    std::array<size_t, TagAmount> bytes{};
+    std::array<size_t, TagAmount> amount{};
+    const auto add = [&](const MemoryTag &tag, const size_t &tagBytes, const size_t &tagAmount) {
+        bytes[static_cast<size_t>(tag)] += tagBytes;
+        amount[static_cast<size_t>(tag)] += tagAmount;
+    };
+
+    std::vector<std::shared_ptr<Scene>> scenes;
+    if (const auto activeScene = Application::GetActiveScene())
+        scenes.push_back(activeScene);
+    for (const auto &i : ProjectManager::GetInstance().m_assetRegistry)
+    {
+        const auto asset = i.second.lock();
+        if (!asset)
+            continue;
+        if (const auto scene = std::dynamic_pointer_cast<Scene>(asset))
+        {
+            if (scenes.empty() || scene != scenes.front())
+                scenes.push_back(scene);
+        }
+        else if (const auto mesh = std::dynamic_pointer_cast<Mesh>(asset))
+            add(MemoryTag::MeshVertices, mesh->GetMemoryUsage(), mesh->GetVerticesAmount());
+        else if (const auto skinnedMesh = std::dynamic_pointer_cast<SkinnedMesh>(asset))
+            add(MemoryTag::MeshVertices, skinnedMesh->GetMemoryUsage(), skinnedMesh->GetSkinnedVerticesAmount());
+        else if (const auto pointCloud = std::dynamic_pointer_cast<PointCloud>(asset))
+            add(MemoryTag::PointClouds, pointCloud->GetMemoryUsage(), pointCloud->m_points.size());
+        else if (const auto animation = std::dynamic_pointer_cast<Animation>(asset))
+        {
+            size_t keyFrameBytes = 0;
+            size_t keyFrameAmount = 0;
+            CountBoneKeyFrames(animation->m_rootBone, keyFrameBytes, keyFrameAmount);
+            // The keys of a quantized animation are only held by its baked clips.
+            if (animation->IsQuantized())
+            {
+                const auto &baked = animation->GetBaked();
+                keyFrameBytes += baked.GetMemoryUsage();
+                for (const auto &clip : baked.m_clips)
+                    keyFrameAmount +=
+                        clip.m_positionTimes.size() + clip.m_rotationTimes.size() + clip.m_scaleTimes.size();
+            }
+            add(MemoryTag::AnimationKeyFrames, keyFrameBytes, keyFrameAmount);
+        }
+    }
+
+    const size_t chunkSize = Entities::GetArchetypeChunkSize();
+    for (const auto &scene : scenes)
+    {
+        const auto &storage = scene->m_sceneDataStorage;
+        // The storage at index 0 is a placeholder without chunks.
+        for (size_t i = 1; i < storage.m_dataComponentStorages.size(); i++)
+        {
+            const auto chunkAmount = storage.m_dataComponentStorages[i].m_chunkArray.m_chunks.size();
+            add(MemoryTag::ArchetypeChunks, chunkAmount * chunkSize, chunkAmount);
+        }
+        size_t metadataBytes = storage.m_entityMetadataList.capacity() * sizeof(EntityMetadata);
+        for (const auto &metadata : storage.m_entityMetadataList)
+        {
+            metadataBytes += metadata.m_privateComponentElements.capacity() * sizeof(PrivateComponentElement) +
+                             metadata.m_children.capacity() * sizeof(Entity);
+            metadataBytes += GetHeapBytes(metadata.m_name);
+        }
+        add(MemoryTag::EntityMetadata, metadataBytes, storage.m_entityMetadataList.size());
+        // Only the pool is measured, the size of the pooled components is not known here.
+        for (const auto &pool : storage.m_entityPrivateComponentStorage.m_privateComponentPool)
+            add(MemoryTag::PrivateComponentPool,
+                pool.second.capacity() * sizeof(std::shared_ptr<IPrivateComponent>),
+                pool.second.size());
+    }
+
+    for (size_t i = 0; i < TagAmount; i++)
+    {
+        auto &stats = memoryStats.m_collected[i];
+        stats.m_bytes = bytes[i] + memoryStats.m_allocatedBytes[i];
+        stats.m_amount = amount[i] + memoryStats.m_allocatedAmount[i];
+        stats.m_peakBytes = (std::max)({stats.m_peakBytes, stats.m_bytes, memoryStats.m_allocatedPeakBytes[i].load()});
+        stats.m_budget = memoryStats.m_budgets[i];
+        const bool overBudget = stats.m_budget != 0 && stats.m_bytes > stats.m_budget;
+        if (overBudget && !memoryStats.m_overBudget[i])
+        {
+            UNIENGINE_WARNING(
+                std::string(GetTagName(static_cast<MemoryTag>(i))) + " uses " + std::to_string(stats.m_bytes / 1024) +
+                " KB, over its budget of " + std::to_string(stats.m_budget / 1024) + " KB");
+        }
+        memoryStats.m_overBudget[i] = overBudget;
+    }
+}
+
+MemoryTagStats MemoryStats::Get(const MemoryTag &tag)
+{
+    return GetInstance().m_collected[static_cast<size_t>(tag)];
+}
+
+size_t MemoryStats::GetTotalBytes()
+{
+    size_t total = 0;
+    for (const auto &i : GetInstance().m_collected)
+        total += i.m_bytes;
+    return total;
+}
+
+const char *MemoryStats::GetTagName(const MemoryTag &tag)
+{
+    switch (tag)
+    {
+    case MemoryTag::ArchetypeChunks:
+        return "Archetype chunks";
+    case MemoryTag::EntityMetadata:
+        return "Entity metadata";
+    case MemoryTag::MeshVertices:
+        return "Mesh vertices";
+    case MemoryTag::PointClouds:
+        return "Point clouds";
+    case MemoryTag::AnimationKeyFrames:
+        return "Animation key frames";
+    case MemoryTag::PrivateComponentPool:
+        return "Private component pool";
+    case MemoryTag::YamlBuffers:
+        return "YAML buffers";
+    default:
+        return "Unknown";
+    }
+}
+
+void MemoryStats::SetBudget(const MemoryTag &tag, const size_t &bytes)
+{
+    auto &memoryStats = GetInstance();
+    const auto index = static_cast<size_t>(tag);
+    memoryStats.m_budgets[index] = bytes;
+    memoryStats.m_collected[index].m_budget = bytes;
+}
@@ -1,5 +1,6 @@
 #include "Console.hpp"
 #include "Mesh.hpp"
+#include "MeshUtilities.hpp"
 #include "Particles.hpp"
 #include "Camera.hpp"
 #include "Application.hpp"
@@ -12,7 +13,20 @@ void Mesh::OnInspect()
 {
 	ImGui::Text(("Vertices size: " + std::to_string(m_verticesSize)).c_str());
 	ImGui::Text(("Triangle amount: " + std::to_string(m_triangleSize)).c_str());
-	if (!m_vertices.empty()) {
+	ImGui::Text(
+		("CPU memory: " + std::to_string(GetMemoryUsage() / 1024) + " KB (interleaved: " +
+			std::to_string((m_vertexStreams.Size() * sizeof(Vertex) + m_triangles.size() * sizeof(glm::uvec3)) / 1024) +
+			" KB)")
+		.c_str());
+	if (!m_vertexStreams.Empty() && ImGui::Button("Optimize")) {
+		const auto report = Optimize();
+		UNIENGINE_LOG(
+			"Optimized mesh: vertices " + std::to_string(report.m_verticesBefore) + " -> " +
+			std::to_string(report.m_verticesAfter) + ", ACMR " + std::to_string(report.m_acmrBefore) + " -> " +
+			std::to_string(report.m_acmrAfter));
+		m_saved = false;
+	}
+	if (!m_vertexStreams.Empty()) {
 		FileUtils::SaveFile(
 			"Export as OBJ",
 			"Mesh",
@@ -66,7 +80,7 @@ void Mesh::OnCreate()
 
 void Mesh::Upload()
 {
-	if (m_vertices.empty())
+	if (m_vertexStreams.Empty())
 	{
 		UNIENGINE_ERROR("Vertices empty!")
 			return;
@@ -76,28 +90,83 @@ void Mesh::Upload()
 		UNIENGINE_ERROR("Triangles empty!")
 			return;
 	}
+	UploadVertexStreams(*m_vao, m_vertexStreams, 0);
+	m_vao->Ebo().SetData((GLsizei)m_triangles.size() * sizeof(glm::uvec3), m_triangles.data(), GL_STATIC_DRAW);
+	m_verticesSize = m_vertexStreams.Size();
+	m_triangleSize = m_triangles.size();
+	m_version++;
+}
+
+size_t Mesh::UploadVertexStreams(
+	OpenGLUtils::GLVAO& vao, const VertexStreams& vertexStreams, const size_t& reservedBytes)
+{
+	// Streams are uploaded back to back (SoA) so depth only passes, which only read location 0, fetch a tightly
+	// packed position array. Locations of missing attributes read a constant from the defaults block at the end.
+	const size_t size = vertexStreams.Size();
+	const size_t positionBytes = size * sizeof(glm::vec3);
+	const size_t normalBytes = vertexStreams.m_normals.size() * sizeof(glm::vec3);
+	const size_t tangentBytes = vertexStreams.m_tangents.size() * sizeof(glm::vec3);
+	const size_t colorBytes = vertexStreams.m_colors.size() * sizeof(glm::vec4);
+	const size_t texCoordBytes = vertexStreams.m_texCoords.size() * sizeof(glm::vec2);
+	const size_t streamBytes = positionBytes + normalBytes + tangentBytes + colorBytes + texCoordBytes;
+	const size_t defaultsOffset = streamBytes + reservedBytes;
+	static const VertexAttributeDefaults defaults;
 #pragma region Data
-	m_vao->SetData((GLsizei)(m_vertices.size() * sizeof(Vertex)), nullptr, GL_STATIC_DRAW);
-	m_vao->SubData(0, m_vertices.size() * sizeof(Vertex), m_vertices.data());
+	vao.SetData((GLsizei)(defaultsOffset + sizeof(VertexAttributeDefaults)), nullptr, GL_STATIC_DRAW);
+	vao.SubData(defaultsOffset, sizeof(VertexAttributeDefaults), &defaults);
+	size_t offset = 0;
+	vao.SubData(offset, positionBytes, vertexStreams.m_positions.data());
+	vao.EnableAttributeArray(0);
+	vao.SetAttributePointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)offset);
+	offset += positionBytes;
 #pragma endregion
-
 #pragma region AttributePointer
-	m_vao->EnableAttributeArray(0);
-	m_vao->SetAttributePointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), 0);
-	m_vao->EnableAttributeArray(1);
-	m_vao->SetAttributePointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offsetof(Vertex, m_normal)));
-	m_vao->EnableAttributeArray(2);
-	m_vao->SetAttributePointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offsetof(Vertex, m_tangent)));
-	m_vao->EnableAttributeArray(3);
-	m_vao->SetAttributePointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offsetof(Vertex, m_color)));
-
-	m_vao->EnableAttributeArray(4);
-	m_vao->SetAttributePointer(4, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offsetof(Vertex, m_texCoord)));
+	if (normalBytes != 0)
+	{
+		vao.SubData(offset, normalBytes, vertexStreams.m_normals.data());
+		vao.EnableAttributeArray(1);
+		vao.SetAttributePointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)offset);
+		offset += normalBytes;
+	}
+	else
+	{
+		vao.SetAttributeConstant(1, 3, GL_FLOAT, defaultsOffset + offsetof(VertexAttributeDefaults, m_normal));
+	}
+	if (tangentBytes != 0)
+	{
+		vao.SubData(offset, tangentBytes, vertexStreams.m_tangents.data());
+		vao.EnableAttributeArray(2);
+		vao.SetAttributePointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)offset);
+		offset += tangentBytes;
+	}
+	else
+	{
+		vao.SetAttributeConstant(2, 3, GL_FLOAT, defaultsOffset + offsetof(VertexAttributeDefaults, m_tangent));
+	}
+	if (colorBytes != 0)
+	{
+		vao.SubData(offset, colorBytes, vertexStreams.m_colors.data());
+		vao.EnableAttributeArray(3);
+		vao.SetAttributePointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec4), (void*)offset);
+		offset += colorBytes;
+	}
+	else
+	{
+		vao.SetAttributeConstant(3, 3, GL_FLOAT, defaultsOffset + offsetof(VertexAttributeDefaults, m_color));
+	}
+	if (texCoordBytes != 0)
+	{
+		vao.SubData(offset, texCoordBytes, vertexStreams.m_texCoords.data());
+		vao.EnableAttributeArray(4);
+		vao.SetAttributePointer(4, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), (void*)offset);
+		offset += texCoordBytes;
+	}
+	else
+	{
+		vao.SetAttributeConstant(4, 2, GL_FLOAT, defaultsOffset + offsetof(VertexAttributeDefaults, m_texCoord));
+	}
 #pragma endregion
-	m_vao->Ebo().SetData((GLsizei)m_triangles.size() * sizeof(glm::uvec3), m_triangles.data(), GL_STATIC_DRAW);
-	m_verticesSize = m_vertices.size();
-	m_triangleSize = m_triangles.size();
-	m_version++;
+	return offset;
 }
 
 auto Mesh::SetVertices(const unsigned& mask, std::vector<Vertex>& vertices,
@@ -126,29 +195,42 @@ void Mesh::SetVertices(const unsigned& mask, const std::vector<Vertex>& vertices
 		UNIENGINE_ERROR("No Position Data!");
 		return;
 	}
-	m_mask = mask;
-	m_vertices = vertices;
+	VertexStreams vertexStreams;
+	vertexStreams.Import(mask, vertices);
+	SetVertices(std::move(vertexStreams), triangles);
+}
+
+void Mesh::SetVertices(VertexStreams&& vertexStreams, const std::vector<glm::uvec3>& triangles)
+{
+	if (vertexStreams.Empty() || triangles.empty())
+	{
+		UNIENGINE_LOG("Vertices or triangles empty!");
+		return;
+	}
+	m_vertexStreams = std::move(vertexStreams);
+	m_vertexStreams.m_mask |= static_cast<unsigned>(VertexAttribute::Position);
 	m_triangles = triangles;
 #pragma region Bound
-	glm::vec3 minBound = m_vertices.at(0).m_position;
-	glm::vec3 maxBound = m_vertices.at(0).m_position;
-	for (auto& vertex : m_vertices)
+	glm::vec3 minBound = m_vertexStreams.m_positions.at(0);
+	glm::vec3 maxBound = m_vertexStreams.m_positions.at(0);
+	for (const auto& position : m_vertexStreams.m_positions)
 	{
 		minBound = glm::vec3(
-			(glm::min)(minBound.x, vertex.m_position.x),
-			(glm::min)(minBound.y, vertex.m_position.y),
-			(glm::min)(minBound.z, vertex.m_position.z));
+			(glm::min)(minBound.x, position.x),
+			(glm::min)(minBound.y, position.y),
+			(glm::min)(minBound.z, position.z));
 		maxBound = glm::vec3(
-			(glm::max)(maxBound.x, vertex.m_position.x),
-			(glm::max)(maxBound.y, vertex.m_position.y),
-			(glm::max)(maxBound.z, vertex.m_position.z));
+			(glm::max)(maxBound.x, position.x),
+			(glm::max)(maxBound.y, position.y),
+			(glm::max)(maxBound.z, position.z));
 	}
 	m_bound.m_max = maxBound;
 	m_bound.m_min = minBound;
 #pragma endregion
-	if (!(m_mask & static_cast<unsigned>(VertexAttribute::Normal)))
+	if (!m_vertexStreams.Has(VertexAttribute::Normal))
 		RecalculateNormal();
-	if (!(m_mask & static_cast<unsigned>(VertexAttribute::Tangent)))
+	// Tangents are derived from texture coordinates, without them there is nothing to compute.
+	if (!m_vertexStreams.Has(VertexAttribute::Tangent) && m_vertexStreams.Has(VertexAttribute::TexCoord))
 		RecalculateTangent();
 	Upload();
 }
@@ -171,78 +253,29 @@ void Mesh::UnsafeSetTrianglesAmount(const unsigned size)
 {
 	m_triangleSize = size;
 }
-void Mesh::RecalculateNormal()
+void Mesh::RecalculateNormal(const NormalWeighting& weighting)
 {
-	std::vector<std::vector<glm::vec3>> normalLists = std::vector<std::vector<glm::vec3>>();
-	auto size = m_vertices.size();
-	for (auto i = 0; i < size; i++)
-	{
-		normalLists.emplace_back();
-	}
-	for (size_t i = 0; i < m_triangles.size(); i++)
-	{
-		const auto i1 = m_triangles[i].x;
-		const auto i2 = m_triangles[i].y;
-		const auto i3 = m_triangles[i].z;
-		auto v1 = m_vertices[i1].m_position;
-		auto v2 = m_vertices[i2].m_position;
-		auto v3 = m_vertices[i3].m_position;
-		auto normal = glm::normalize(glm::cross(v1 - v2, v1 - v3));
-		normalLists[i1].push_back(normal);
-		normalLists[i2].push_back(normal);
-		normalLists[i3].push_back(normal);
-	}
-	for (auto i = 0; i < size; i++)
+	m_vertexStreams.SetAttribute(VertexAttribute::Normal, true);
+	MeshUtilities::RecalculateNormal(m_vertexStreams.m_positions, m_triangles, m_vertexStreams.m_normals, weighting);
+}
+
+MeshOptimizationReport Mesh::Optimize()
+{
+	if (m_vertexStreams.Empty() || m_triangles.empty())
 	{
-		auto normal = glm::vec3(0.0f);
-		for (auto j : normalLists[i])
-		{
-			normal += j;
-		}
-		m_vertices[i].m_normal = glm::normalize(normal);
+		UNIENGINE_ERROR("Vertices or triangles empty!");
+		return {};
 	}
+	const auto report = MeshUtilities::Optimize(m_vertexStreams, m_triangles);
+	Upload();
+	return report;
 }
 
 void Mesh::RecalculateTangent()
 {
-	auto tangentLists = std::vector<std::vector<glm::vec3>>();
-	auto size = m_vertices.size();
-	for (auto i = 0; i < size; i++)
-	{
-		tangentLists.emplace_back();
-	}
-	for (auto& triangle : m_triangles)
-	{
-		const auto i1 = triangle.x;
-		const auto i2 = triangle.y;
-		const auto i3 = triangle.z;
-		auto p1 = m_vertices[i1].m_position;
-		auto p2 = m_vertices[i2].m_position;
-		auto p3 = m_vertices[i3].m_position;
-		auto uv1 = m_vertices[i1].m_texCoord;
-		auto uv2 = m_vertices[i2].m_texCoord;
-		auto uv3 = m_vertices[i3].m_texCoord;
-
-		auto e21 = p2 - p1;
-		auto d21 = uv2 - uv1;
-		auto e31 = p3 - p1;
-		auto d31 = uv3 - uv1;
-		float f = 1.0f / (d21.x * d31.y - d31.x * d21.y);
-		auto tangent =
-			f * glm::vec3(d31.y * e21.x - d21.y * e31.x, d31.y * e21.y - d21.y * e31.y, d31.y * e21.z - d21.y * e31.z);
-		tangentLists[i1].push_back(tangent);
-		tangentLists[i2].push_back(tangent);
-		tangentLists[i3].push_back(tangent);
-	}
-	for (auto i = 0; i < size; i++)
-	{
-		auto tangent = glm::vec3(0.0f);
-		for (auto j : tangentLists[i])
-		{
-			tangent += j;
-		}
-		m_vertices[i].m_tangent = glm::normalize(tangent);
-	}
+	m_vertexStreams.SetAttribute(VertexAttribute::Tangent, true);
+	MeshUtilities::RecalculateTangent(
+		m_vertexStreams.m_positions, m_vertexStreams.m_texCoords, m_triangles, m_vertexStreams.m_tangents);
 }
 
 std::shared_ptr<OpenGLUtils::GLVAO> Mesh::Vao() const
@@ -260,13 +293,35 @@ size_t& Mesh::GetVersion()
 	return m_version;
 }
 
+const std::vector<glm::uvec3>& Mesh::PeekTriangles() const
+{
+	return m_triangles;
+}
 std::vector<glm::uvec3>& Mesh::UnsafeGetTriangles()
 {
 	return m_triangles;
 }
-std::vector<Vertex>& Mesh::UnsafeGetVertices()
+std::vector<Vertex> Mesh::GetVertices() const
+{
+	std::vector<Vertex> vertices;
+	m_vertexStreams.Export(vertices);
+	return vertices;
+}
+unsigned Mesh::GetMask() const
 {
-	return m_vertices;
+	return m_vertexStreams.m_mask;
+}
+const VertexStreams& Mesh::PeekVertexStreams() const
+{
+	return m_vertexStreams;
+}
+VertexStreams& Mesh::UnsafeGetVertexStreams()
+{
+	return m_vertexStreams;
+}
+size_t Mesh::GetMemoryUsage() const
+{
+	return m_vertexStreams.GetMemoryUsage() + m_triangles.capacity() * sizeof(glm::uvec3);
 }
 void Mesh::Draw() const
 {
@@ -413,16 +468,37 @@ void Mesh::DrawInstanced(const std::vector<GlobalTransform>& matrices) const
 
 	glDrawElementsInstanced(GL_TRIANGLES, (GLsizei)m_triangleSize * 3, GL_UNSIGNED_INT, 0, (GLsizei)count);
 }
+void Mesh::DrawInstanced(const OpenGLUtils::GLBuffer& matricesBuffer, const size_t& first, const size_t& count) const
+{
+	if (count == 0) return;
+	m_vao->Bind();
+	matricesBuffer.Bind();
+	m_vao->EnableAttributeArray(12);
+	m_vao->SetAttributePointer(12, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)0);
+	m_vao->EnableAttributeArray(13);
+	m_vao->SetAttributePointer(13, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(sizeof(glm::vec4)));
+	m_vao->EnableAttributeArray(14);
+	m_vao->SetAttributePointer(14, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(2 * sizeof(glm::vec4)));
+	m_vao->EnableAttributeArray(15);
+	m_vao->SetAttributePointer(15, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(3 * sizeof(glm::vec4)));
+	m_vao->SetAttributeDivisor(12, 1);
+	m_vao->SetAttributeDivisor(13, 1);
+	m_vao->SetAttributeDivisor(14, 1);
+	m_vao->SetAttributeDivisor(15, 1);
+	// The base instance offsets the per instance attributes, so batches share one buffer.
+	glDrawElementsInstancedBaseInstance(
+		GL_TRIANGLES, (GLsizei)m_triangleSize * 3, GL_UNSIGNED_INT, 0, (GLsizei)count, (GLuint)first);
+}
+
 void Mesh::Serialize(YAML::Emitter& out)
 {
-	out << YAML::Key << "m_mask" << YAML::Value << m_mask;
+	out << YAML::Key << "m_mask" << YAML::Value << m_vertexStreams.m_mask;
 	out << YAML::Key << "m_offset" << YAML::Value << m_offset;
 	out << YAML::Key << "m_version" << YAML::Value << m_version;
 
-	if (!m_vertices.empty() && !m_triangles.empty())
+	if (!m_vertexStreams.Empty() && !m_triangles.empty())
 	{
-		out << YAML::Key << "m_vertices" << YAML::Value
-			<< YAML::Binary((const unsigned char*)m_vertices.data(), m_vertices.size() * sizeof(Vertex));
+		SerializeVertexStreams(m_vertexStreams, out);
 		out << YAML::Key << "m_triangles" << YAML::Value
 			<< YAML::Binary((const unsigned char*)m_triangles.data(), m_triangles.size() * sizeof(glm::uvec3));
 	}
@@ -430,25 +506,97 @@ void Mesh::Serialize(YAML::Emitter& out)
 
 void Mesh::Deserialize(const YAML::Node& in)
 {
-	if (in["m_mask"]) m_mask = in["m_mask"].as<unsigned>();
+	unsigned mask = 0;
+	if (in["m_mask"]) mask = in["m_mask"].as<unsigned>();
 	if (in["m_offset"]) m_offset = in["m_offset"].as<size_t>();
 	if (in["m_version"]) m_version = in["m_version"].as<size_t>();
 
-	if (in["m_vertices"] && in["m_triangles"])
+	if (in["m_triangles"])
 	{
-		auto vertexData = in["m_vertices"].as<YAML::Binary>();
-		std::vector<Vertex> vertices;
-		vertices.resize(vertexData.size() / sizeof(Vertex));
-		std::memcpy(vertices.data(), vertexData.data(), vertexData.size());
-
 		auto triangleData = in["m_triangles"].as<YAML::Binary>();
 		std::vector<glm::uvec3> triangles;
 		triangles.resize(triangleData.size() / sizeof(glm::uvec3));
 		std::memcpy(triangles.data(), triangleData.data(), triangleData.size());
-
-		SetVertices(m_mask, vertices, triangles);
+		if (in["m_positions"])
+		{
+			VertexStreams vertexStreams;
+			DeserializeVertexStreams(mask, vertexStreams, in);
+			SetVertices(std::move(vertexStreams), triangles);
+		}
+		else if (in["m_vertices"])
+		{
+			// Assets saved before vertex streams were introduced.
+			auto vertexData = in["m_vertices"].as<YAML::Binary>();
+			std::vector<Vertex> vertices;
+			vertices.resize(vertexData.size() / sizeof(Vertex));
+			std::memcpy(vertices.data(), vertexData.data(), vertexData.size());
+			SetVertices(mask, vertices, triangles);
+		}
 	}
 }
+
+template <typename T> static void SerializeStream(const std::string& name, const std::vector<T>& stream, YAML::Emitter& out)
+{
+	if (stream.empty())
+		return;
+	out << YAML::Key << name << YAML::Value
+		<< YAML::Binary((const unsigned char*)stream.data(), stream.size() * sizeof(T));
+}
+
+template <typename T> static void DeserializeStream(const std::string& name, std::vector<T>& stream, const YAML::Node& in)
+{
+	if (!in[name])
+		return;
+	auto data = in[name].as<YAML::Binary>();
+	stream.resize(data.size() / sizeof(T));
+	std::memcpy(stream.data(), data.data(), data.size());
+}
+
+void Mesh::SerializeVertexStreams(const VertexStreams& vertexStreams, YAML::Emitter& out)
+{
+	SerializeStream("m_positions", vertexStreams.m_positions, out);
+	SerializeStream("m_normals", vertexStreams.m_normals, out);
+	SerializeStream("m_tangents", vertexStreams.m_tangents, out);
+	SerializeStream("m_colors", vertexStreams.m_colors, out);
+	SerializeStream("m_texCoords", vertexStreams.m_texCoords, out);
+}
+
+void Mesh::DeserializeVertexStreams(const unsigned& mask, VertexStreams& vertexStreams, const YAML::Node& in)
+{
+	vertexStreams.Clear();
+	DeserializeStream("m_positions", vertexStreams.m_positions, in);
+	DeserializeStream("m_normals", vertexStreams.m_normals, in);
+	DeserializeStream("m_tangents", vertexStreams.m_tangents, in);
+	DeserializeStream("m_colors", vertexStreams.m_colors, in);
+	DeserializeStream("m_texCoords", vertexStreams.m_texCoords, in);
+	vertexStreams.m_mask = static_cast<unsigned>(VertexAttribute::Position);
+	const auto size = vertexStreams.Size();
+	// A stream only counts if the mask has it and its length matches the positions.
+	const auto check = [&](VertexAttribute attribute, size_t streamSize) {
+		vertexStreams.SetAttribute(attribute, (mask & static_cast<unsigned>(attribute)) && streamSize == size);
+	};
+	check(VertexAttribute::Normal, vertexStreams.m_normals.size());
+	check(VertexAttribute::Tangent, vertexStreams.m_tangents.size());
+	check(VertexAttribute::Color, vertexStreams.m_colors.size());
+	check(VertexAttribute::TexCoord, vertexStreams.m_texCoords.size());
+}
+
+void Mesh::SerializeBoneWeightStreams(const BoneWeightStreams& boneWeightStreams, YAML::Emitter& out)
+{
+	SerializeStream("m_boneIds", boneWeightStreams.m_boneIds, out);
+	SerializeStream("m_weights", boneWeightStreams.m_weights, out);
+	SerializeStream("m_boneIds2", boneWeightStreams.m_boneIds2, out);
+	SerializeStream("m_weights2", boneWeightStreams.m_weights2, out);
+}
+
+void Mesh::DeserializeBoneWeightStreams(BoneWeightStreams& boneWeightStreams, const YAML::Node& in)
+{
+	boneWeightStreams.Clear();
+	DeserializeStream("m_boneIds", boneWeightStreams.m_boneIds, in);
+	DeserializeStream("m_weights", boneWeightStreams.m_weights, in);
+	DeserializeStream("m_boneIds2", boneWeightStreams.m_boneIds2, in);
+	DeserializeStream("m_weights2", boneWeightStreams.m_weights2, in);
+}
 bool Mesh::SaveInternal(const std::filesystem::path& path)
 {
 	if (path.extension() == ".uemesh") {
@@ -464,32 +612,37 @@ bool Mesh::SaveInternal(const std::filesystem::path& path)
 			of.flush();
 			unsigned startIndex = 1;
 			if (!m_triangles.empty()) {
+				const auto& positions = m_vertexStreams.m_positions;
+				const auto& normals = m_vertexStreams.m_normals;
+				const auto& colors = m_vertexStreams.m_colors;
+				const auto& texCoords = m_vertexStreams.m_texCoords;
 				std::string header =
-					"#Vertices: " + std::to_string(m_vertices.size()) +
+					"#Vertices: " + std::to_string(positions.size()) +
 					", tris: " + std::to_string(m_triangles.size());
 				header += "\n";
 				of.write(header.c_str(), header.size());
 				of.flush();
 				std::string data;
 #pragma region Data collection
-				for (auto i = 0; i < m_vertices.size(); i++) {
-					auto& vertexPosition = m_vertices.at(i).m_position;
-					auto& color = m_vertices.at(i).m_color;
+				for (auto i = 0; i < positions.size(); i++) {
+					auto& vertexPosition = positions.at(i);
+					auto color = colors.empty() ? glm::vec4(1.0f) : colors.at(i);
 					data += "v " + std::to_string(vertexPosition.x) + " " +
 						std::to_string(vertexPosition.y) + " " +
 						std::to_string(vertexPosition.z) + " " +
 						std::to_string(color.x) + " " + std::to_string(color.y) + " " +
 						std::to_string(color.z) + "\n";
 				}
-				for (const auto& vertex : m_vertices) {
-					data += "vn " + std::to_string(vertex.m_normal.x) + " " +
-						std::to_string(vertex.m_normal.y) + " " +
-						std::to_string(vertex.m_normal.z) + "\n";
+				for (const auto& normal : normals) {
+					data += "vn " + std::to_string(normal.x) + " " +
+						std::to_string(normal.y) + " " +
+						std::to_string(normal.z) + "\n";
 				}
 
-				for (const auto& vertex : m_vertices) {
-					data += "vt " + std::to_string(vertex.m_texCoord.x) + " " +
-						std::to_string(vertex.m_texCoord.y) + "\n";
+				for (auto i = 0; i < positions.size(); i++) {
+					auto texCoord = texCoords.empty() ? glm::vec2(0.0f) : texCoords.at(i);
+					data += "vt " + std::to_string(texCoord.x) + " " +
+						std::to_string(texCoord.y) + "\n";
 				}
 				// data += "s off\n";
 				data += "# List of indices for faces vertices, with (x, y, z).\n";
@@ -505,7 +658,7 @@ bool Mesh::SaveInternal(const std::filesystem::path& path)
 						std::to_string(f3) + "/" + std::to_string(f3) + "/" +
 						std::to_string(f3) + "\n";
 				}
-				startIndex += m_vertices.size();
+				startIndex += positions.size();
 #pragma endregion
 				of.write(data.c_str(), data.size());
 				of.flush();
@@ -0,0 +1,154 @@
+#include "Editor.hpp"
+#include <MeshLodChain.hpp>
+#include <ProjectManager.hpp>
+using namespace UniEngine;
+
+void MeshLodChain::Generate(const std::shared_ptr<Mesh> &mesh, const unsigned &levelCount, const float &reduction)
+{
+    m_levels.clear();
+    m_version++;
+    if (!mesh)
+        return;
+    if (mesh->PeekVertexStreams().Empty())
+    {
+        UNIENGINE_ERROR("Mesh has no CPU vertices to simplify!");
+        return;
+    }
+    float screenSize = 0.5f;
+    m_levels.push_back({mesh, screenSize});
+    auto vertexStreams = mesh->PeekVertexStreams();
+    auto triangles = mesh->UnsafeGetTriangles();
+    for (unsigned i = 1; i < levelCount; i++)
+    {
+        const auto previousSize = triangles.size();
+        const auto targetSize = static_cast<size_t>(previousSize * reduction);
+        if (targetSize < 4)
+            break;
+        const auto error = MeshUtilities::Simplify(vertexStreams, triangles, targetSize);
+        if (triangles.size() >= previousSize)
+            break;
+        std::vector<unsigned> clusterOffsets;
+        MeshUtilities::OptimizeVertexCache(triangles, vertexStreams.Size(), clusterOffsets);
+        MeshUtilities::OptimizeVertexFetch(vertexStreams, triangles);
+        auto lodMesh = ProjectManager::CreateTemporaryAsset<Mesh>();
+        auto lodVertexStreams = vertexStreams;
+        lodMesh->SetVertices(std::move(lodVertexStreams), triangles);
+        screenSize *= 0.5f;
+        m_levels.push_back({lodMesh, screenSize});
+        UNIENGINE_LOG(
+            "LOD " + std::to_string(i) + ": " + std::to_string(triangles.size()) + " triangles, error " +
+            std::to_string(error));
+    }
+    // The coarsest level is kept however small the object gets.
+    m_levels.back().m_screenSize = 0.0f;
+    m_saved = false;
+}
+
+unsigned MeshLodChain::SelectLevel(const float &screenSize, const unsigned &currentLevel) const
+{
+    if (m_levels.empty())
+        return 0;
+    const auto levelSize = static_cast<unsigned>(m_levels.size());
+    unsigned level = glm::min(currentLevel, levelSize - 1);
+    while (level + 1 < levelSize && screenSize < m_levels[level].m_screenSize * (1.0f - m_hysteresis))
+        level++;
+    while (level > 0 && screenSize > m_levels[level - 1].m_screenSize * (1.0f + m_hysteresis))
+        level--;
+    return level;
+}
+
+std::shared_ptr<Mesh> MeshLodChain::GetMesh(const unsigned &level)
+{
+    if (level >= m_levels.size())
+        return nullptr;
+    return m_levels[level].m_mesh.Get<Mesh>();
+}
+
+size_t MeshLodChain::GetVersion() const
+{
+    return m_version;
+}
+
+void MeshLodChain::OnInspect()
+{
+    static AssetRef sourceMesh;
+    static int levelCount = 4;
+    static float reduction = 0.5f;
+    Editor::DragAndDropButton<Mesh>(sourceMesh, "Source mesh");
+    ImGui::DragInt("Levels##MeshLodChain", &levelCount, 1, 1, 8);
+    ImGui::DragFloat("Reduction##MeshLodChain", &reduction, 0.01f, 0.05f, 0.95f);
+    if (sourceMesh.Get<Mesh>() && ImGui::Button("Generate##MeshLodChain"))
+    {
+        Generate(sourceMesh.Get<Mesh>(), levelCount, reduction);
+    }
+    if (ImGui::DragFloat("Hysteresis##MeshLodChain", &m_hysteresis, 0.01f, 0.0f, 0.5f))
+        m_saved = false;
+    for (size_t i = 0; i < m_levels.size(); i++)
+    {
+        auto &level = m_levels[i];
+        auto mesh = level.m_mesh.Get<Mesh>();
+        ImGui::Text(
+            ("LOD " + std::to_string(i) + ": " + (mesh ? std::to_string(mesh->GetTriangleAmount()) : "0") +
+             " triangles")
+                .c_str());
+        if (ImGui::DragFloat(("Screen size##LOD" + std::to_string(i)).c_str(), &level.m_screenSize, 0.001f, 0.0f, 1.0f))
+            m_saved = false;
+    }
+}
+
+void MeshLodChain::CollectAssetRef(std::vector<AssetRef> &list)
+{
+    for (const auto &level : m_levels)
+        list.push_back(level.m_mesh);
+}
+
+void MeshLodChain::Serialize(YAML::Emitter &out)
+{
+    out << YAML::Key << "m_hysteresis" << YAML::Value << m_hysteresis;
+    out << YAML::Key << "m_levels" << YAML::Value << YAML::BeginSeq;
+    for (auto &level : m_levels)
+    {
+        out << YAML::BeginMap;
+        out << YAML::Key << "m_screenSize" << YAML::Value << level.m_screenSize;
+        auto mesh = level.m_mesh.Get<Mesh>();
+        if (mesh && mesh->IsTemporary())
+        {
+            // Generated levels have no file of their own and are stored with the chain.
+            out << YAML::Key << "m_meshData" << YAML::Value << YAML::BeginMap;
+            mesh->Serialize(out);
+            out << YAML::EndMap;
+        }
+        else
+        {
+            level.m_mesh.Save("m_mesh", out);
+        }
+        out << YAML::EndMap;
+    }
+    out << YAML::EndSeq;
+}
+
+void MeshLodChain::Deserialize(const YAML::Node &in)
+{
+    if (in["m_hysteresis"])
+        m_hysteresis = in["m_hysteresis"].as<float>();
+    m_levels.clear();
+    m_version++;
+    if (!in["m_levels"])
+        return;
+    for (const auto &inLevel : in["m_levels"])
+    {
+        MeshLodLevel level;
+        level.m_screenSize = inLevel["m_screenSize"].as<float>();
+        if (inLevel["m_meshData"])
+        {
+            auto mesh = ProjectManager::CreateTemporaryAsset<Mesh>();
+            mesh->Deserialize(inLevel["m_meshData"]);
+            level.m_mesh = mesh;
+        }
+        else
+        {
+            level.m_mesh.Load("m_mesh", inLevel);
+        }
+        m_levels.push_back(level);
+    }
+}
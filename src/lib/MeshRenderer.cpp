@@ -27,12 +27,22 @@ void MeshRenderer::RenderBound(glm::vec4 &color)
 
 void MeshRenderer::OnInspect()
 {
-    ImGui::Checkbox("Forward Rendering##MeshRenderer", &m_forwardRendering);
-    if (!m_forwardRendering)
-        ImGui::Checkbox("Receive shadow##MeshRenderer", &m_receiveShadow);
-    ImGui::Checkbox("Cast shadow##MeshRenderer", &m_castShadow);
-    Editor::DragAndDropButton<Material>(m_material, "Material");
-    Editor::DragAndDropButton<Mesh>(m_mesh, "Mesh");
+    bool changed = false;
+    if (ImGui::Checkbox("Forward Rendering##MeshRenderer", &m_forwardRendering))
+        changed = true;
+    if (!m_forwardRendering && ImGui::Checkbox("Receive shadow##MeshRenderer", &m_receiveShadow))
+        changed = true;
+    if (ImGui::Checkbox("Cast shadow##MeshRenderer", &m_castShadow))
+        changed = true;
+    ImGui::Checkbox("Occluder##MeshRenderer", &m_occluder);
+    if (Editor::DragAndDropButton<Material>(m_material, "Material"))
+        changed = true;
+    if (Editor::DragAndDropButton<Mesh>(m_mesh, "Mesh"))
+        changed = true;
+    if (Editor::DragAndDropButton<MeshLodChain>(m_lodChain, "LOD chain"))
+        changed = true;
+    if (changed)
+        GetScene()->MarkStaticChanged();
     if (m_mesh.Get<Mesh>())
     {
         if (ImGui::TreeNode("Mesh##MeshRenderer"))
@@ -55,15 +65,29 @@ void MeshRenderer::OnCreate()
     SetEnabled(true);
 }
 
+void MeshRenderer::OnEnable()
+{
+    if (const auto scene = GetScene())
+        scene->MarkStaticChanged();
+}
+
+void MeshRenderer::OnDisable()
+{
+    if (const auto scene = GetScene())
+        scene->MarkStaticChanged();
+}
+
 
 void MeshRenderer::Serialize(YAML::Emitter &out)
 {
     out << YAML::Key << "m_forwardRendering" << m_forwardRendering;
     out << YAML::Key << "m_castShadow" << m_castShadow;
     out << YAML::Key << "m_receiveShadow" << m_receiveShadow;
+    out << YAML::Key << "m_occluder" << m_occluder;
 
     m_mesh.Save("m_mesh", out);
     m_material.Save("m_material", out);
+    m_lodChain.Save("m_lodChain", out);
 }
 
 void MeshRenderer::Deserialize(const YAML::Node &in)
@@ -71,9 +95,12 @@ void MeshRenderer::Deserialize(const YAML::Node &in)
     m_forwardRendering = in["m_forwardRendering"].as<bool>();
     m_castShadow = in["m_castShadow"].as<bool>();
     m_receiveShadow = in["m_receiveShadow"].as<bool>();
+    if (in["m_occluder"])
+        m_occluder = in["m_occluder"].as<bool>();
 
     m_mesh.Load("m_mesh", in);
     m_material.Load("m_material", in);
+    m_lodChain.Load("m_lodChain", in);
 }
 void MeshRenderer::PostCloneAction(const std::shared_ptr<IPrivateComponent> &target)
 {
@@ -82,14 +109,19 @@ void MeshRenderer::CollectAssetRef(std::vector<AssetRef> &list)
 {
     list.push_back(m_mesh);
     list.push_back(m_material);
+    list.push_back(m_lodChain);
 }
 void MeshRenderer::OnDestroy()
 {
     m_mesh.Clear();
     m_material.Clear();
+    m_lodChain.Clear();
+    m_lodLevels.clear();
+    m_lodLevelsChain = 0;
 
     m_material.Clear();
     m_forwardRendering = false;
     m_castShadow = true;
     m_receiveShadow = true;
+    m_occluder = false;
 }
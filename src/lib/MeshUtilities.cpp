@@ -0,0 +1,834 @@
+#include "MeshUtilities.hpp"
+#include "Jobs.hpp"
+#include <numeric>
+#include <queue>
+#include <unordered_map>
+using namespace UniEngine;
+
+namespace
+{
+constexpr unsigned InvalidIndex = UINT_MAX;
+// Below this many elements the dispatch overhead outweighs the work.
+constexpr size_t MinParallelSize = 4096;
+
+struct AdjacencyScratch
+{
+    // m_offsets[v]..m_offsets[v + 1] is the range in m_corners referencing vertex v.
+    std::vector<unsigned> m_offsets;
+    // Each entry is triangleIndex * 3 + corner.
+    std::vector<unsigned> m_corners;
+    std::vector<glm::vec3> m_faceValues;
+};
+thread_local AdjacencyScratch t_scratch;
+
+void ParallelForEach(const size_t &size, const std::function<void(unsigned i)> &func)
+{
+    // Waiting on jobs from inside a worker can deadlock the pool, so the kernels run inline there.
+    if (size < MinParallelSize || Jobs::Workers().Size() <= 1 || Jobs::IsWorkerThread())
+    {
+        for (unsigned i = 0; i < size; i++)
+            func(i);
+        return;
+    }
+    std::vector<std::shared_future<void>> results;
+    Jobs::ParallelFor(size, func, results);
+    for (const auto &i : results)
+        i.wait();
+}
+
+void BuildAdjacency(const size_t &vertexCount, const std::vector<glm::uvec3> &triangles, AdjacencyScratch &scratch)
+{
+    auto &offsets = scratch.m_offsets;
+    auto &corners = scratch.m_corners;
+    offsets.assign(vertexCount + 1, 0);
+    for (const auto &triangle : triangles)
+    {
+        offsets[triangle.x + 1]++;
+        offsets[triangle.y + 1]++;
+        offsets[triangle.z + 1]++;
+    }
+    for (size_t i = 1; i <= vertexCount; i++)
+        offsets[i] += offsets[i - 1];
+    corners.resize(triangles.size() * 3);
+    // Reuse the entries of offsets as write cursors, then shift them back.
+    for (unsigned i = 0; i < triangles.size(); i++)
+    {
+        const auto &triangle = triangles[i];
+        corners[offsets[triangle.x]++] = i * 3;
+        corners[offsets[triangle.y]++] = i * 3 + 1;
+        corners[offsets[triangle.z]++] = i * 3 + 2;
+    }
+    for (size_t i = vertexCount; i > 0; i--)
+        offsets[i] = offsets[i - 1];
+    offsets[0] = 0;
+}
+
+glm::vec3 SafeNormalize(const glm::vec3 &value, const glm::vec3 &fallback)
+{
+    const float length2 = glm::dot(value, value);
+    if (length2 <= 0.0f || !(length2 == length2))
+        return fallback;
+    return value / glm::sqrt(length2);
+}
+
+float CornerAngle(const std::vector<glm::vec3> &positions, const glm::uvec3 &triangle, const unsigned &corner)
+{
+    const auto &p = positions[triangle[corner]];
+    const auto e1 = SafeNormalize(positions[triangle[(corner + 1) % 3]] - p, glm::vec3(0.0f));
+    const auto e2 = SafeNormalize(positions[triangle[(corner + 2) % 3]] - p, glm::vec3(0.0f));
+    return glm::acos(glm::clamp(glm::dot(e1, e2), -1.0f, 1.0f));
+}
+
+template <typename T> void HashStream(uint64_t &hash, const std::vector<T> &stream, const unsigned &index)
+{
+    if (stream.empty())
+        return;
+    // FNV-1a over the bytes of the attribute.
+    const auto *bytes = reinterpret_cast<const unsigned char *>(&stream[index]);
+    for (size_t i = 0; i < sizeof(T); i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+}
+
+template <typename T> bool StreamEqual(const std::vector<T> &stream, const unsigned &a, const unsigned &b)
+{
+    return stream.empty() || std::memcmp(&stream[a], &stream[b], sizeof(T)) == 0;
+}
+
+template <typename T> void RemapStream(std::vector<T> &stream, const std::vector<unsigned> &remap, const size_t &size)
+{
+    if (stream.empty())
+        return;
+    std::vector<T> result(size);
+    for (size_t i = 0; i < remap.size(); i++)
+    {
+        if (remap[i] != InvalidIndex)
+            result[remap[i]] = stream[i];
+    }
+    stream.swap(result);
+}
+
+void RemapStreams(VertexStreams &vertexStreams, const std::vector<unsigned> &remap, const size_t &size)
+{
+    RemapStream(vertexStreams.m_positions, remap, size);
+    RemapStream(vertexStreams.m_normals, remap, size);
+    RemapStream(vertexStreams.m_tangents, remap, size);
+    RemapStream(vertexStreams.m_colors, remap, size);
+    RemapStream(vertexStreams.m_texCoords, remap, size);
+}
+
+// Symmetric 4x4 error quadric, error(p) = p^T A p + 2 b.p + c, normalized by the accumulated weight.
+struct Quadric
+{
+    double m_a00 = 0, m_a01 = 0, m_a02 = 0, m_a11 = 0, m_a12 = 0, m_a22 = 0;
+    double m_b0 = 0, m_b1 = 0, m_b2 = 0, m_c = 0;
+    double m_weight = 0;
+    void AddPlane(const glm::dvec3 &normal, const double &distance, const double &weight)
+    {
+        m_a00 += weight * normal.x * normal.x;
+        m_a01 += weight * normal.x * normal.y;
+        m_a02 += weight * normal.x * normal.z;
+        m_a11 += weight * normal.y * normal.y;
+        m_a12 += weight * normal.y * normal.z;
+        m_a22 += weight * normal.z * normal.z;
+        m_b0 += weight * normal.x * distance;
+        m_b1 += weight * normal.y * distance;
+        m_b2 += weight * normal.z * distance;
+        m_c += weight * distance * distance;
+        m_weight += weight;
+    }
+    void Add(const Quadric &other)
+    {
+        m_a00 += other.m_a00;
+        m_a01 += other.m_a01;
+        m_a02 += other.m_a02;
+        m_a11 += other.m_a11;
+        m_a12 += other.m_a12;
+        m_a22 += other.m_a22;
+        m_b0 += other.m_b0;
+        m_b1 += other.m_b1;
+        m_b2 += other.m_b2;
+        m_c += other.m_c;
+        m_weight += other.m_weight;
+    }
+    [[nodiscard]] double Evaluate(const glm::dvec3 &p) const
+    {
+        const double error = m_a00 * p.x * p.x + 2.0 * m_a01 * p.x * p.y + 2.0 * m_a02 * p.x * p.z +
+                             m_a11 * p.y * p.y + 2.0 * m_a12 * p.y * p.z + m_a22 * p.z * p.z +
+                             2.0 * (m_b0 * p.x + m_b1 * p.y + m_b2 * p.z) + m_c;
+        return m_weight > 0.0 ? glm::abs(error) / m_weight : 0.0;
+    }
+};
+
+struct Collapse
+{
+    float m_cost;
+    unsigned m_from;
+    unsigned m_to;
+    unsigned m_fromVersion;
+    unsigned m_toVersion;
+    bool operator>(const Collapse &other) const
+    {
+        return m_cost > other.m_cost;
+    }
+};
+} // namespace
+
+void MeshUtilities::RecalculateNormal(
+    const std::vector<glm::vec3> &positions,
+    const std::vector<glm::uvec3> &triangles,
+    std::vector<glm::vec3> &normals,
+    const NormalWeighting &weighting)
+{
+    const auto vertexCount = positions.size();
+    normals.resize(vertexCount);
+    auto &scratch = t_scratch;
+    auto &faceValues = scratch.m_faceValues;
+    faceValues.resize(triangles.size());
+    ParallelForEach(triangles.size(), [&](unsigned i) {
+        const auto &triangle = triangles[i];
+        const auto &v1 = positions[triangle.x];
+        const auto normal = glm::cross(v1 - positions[triangle.y], v1 - positions[triangle.z]);
+        // The length of the cross product is twice the triangle area.
+        faceValues[i] = weighting == NormalWeighting::Area ? normal : SafeNormalize(normal, glm::vec3(0.0f));
+    });
+    BuildAdjacency(vertexCount, triangles, scratch);
+    const auto &offsets = scratch.m_offsets;
+    const auto &corners = scratch.m_corners;
+    ParallelForEach(vertexCount, [&](unsigned i) {
+        auto normal = glm::vec3(0.0f);
+        for (auto j = offsets[i]; j < offsets[i + 1]; j++)
+        {
+            const auto triangleIndex = corners[j] / 3;
+            if (weighting == NormalWeighting::Angle)
+                normal += faceValues[triangleIndex] * CornerAngle(positions, triangles[triangleIndex], corners[j] % 3);
+            else
+                normal += faceValues[triangleIndex];
+        }
+        normals[i] = SafeNormalize(normal, glm::vec3(0.0f, 1.0f, 0.0f));
+    });
+}
+
+void MeshUtilities::RecalculateTangent(
+    const std::vector<glm::vec3> &positions,
+    const std::vector<glm::vec2> &texCoords,
+    const std::vector<glm::uvec3> &triangles,
+    std::vector<glm::vec3> &tangents)
+{
+    const auto vertexCount = positions.size();
+    tangents.resize(vertexCount);
+    auto &scratch = t_scratch;
+    auto &faceValues = scratch.m_faceValues;
+    faceValues.resize(triangles.size());
+    const bool hasTexCoords = texCoords.size() == vertexCount;
+    ParallelForEach(triangles.size(), [&](unsigned i) {
+        if (!hasTexCoords)
+        {
+            faceValues[i] = glm::vec3(0.0f);
+            return;
+        }
+        const auto &triangle = triangles[i];
+        const auto &p1 = positions[triangle.x];
+        const auto &uv1 = texCoords[triangle.x];
+        const auto e21 = positions[triangle.y] - p1;
+        const auto d21 = texCoords[triangle.y] - uv1;
+        const auto e31 = positions[triangle.z] - p1;
+        const auto d31 = texCoords[triangle.z] - uv1;
+        const float determinant = d21.x * d31.y - d31.x * d21.y;
+        // Faces with a degenerate UV mapping carry no tangent information.
+        faceValues[i] = determinant == 0.0f ? glm::vec3(0.0f) : (d31.y * e21 - d21.y * e31) / determinant;
+    });
+    BuildAdjacency(vertexCount, triangles, scratch);
+    const auto &offsets = scratch.m_offsets;
+    const auto &corners = scratch.m_corners;
+    ParallelForEach(vertexCount, [&](unsigned i) {
+        auto tangent = glm::vec3(0.0f);
+        for (auto j = offsets[i]; j < offsets[i + 1]; j++)
+            tangent += faceValues[corners[j] / 3];
+        tangents[i] = SafeNormalize(tangent, glm::vec3(1.0f, 0.0f, 0.0f));
+    });
+}
+
+#pragma region Optimization
+size_t MeshUtilities::WeldVertices(VertexStreams &vertexStreams, std::vector<glm::uvec3> &triangles)
+{
+    const auto size = vertexStreams.Size();
+    size_t tableSize = 1;
+    while (tableSize < size * 2)
+        tableSize <<= 1;
+    // Open addressing table holding the first vertex of every unique value.
+    std::vector<unsigned> table(tableSize, InvalidIndex);
+    std::vector<unsigned> remap(size);
+    unsigned uniqueSize = 0;
+    for (unsigned i = 0; i < size; i++)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        HashStream(hash, vertexStreams.m_positions, i);
+        HashStream(hash, vertexStreams.m_normals, i);
+        HashStream(hash, vertexStreams.m_tangents, i);
+        HashStream(hash, vertexStreams.m_colors, i);
+        HashStream(hash, vertexStreams.m_texCoords, i);
+        auto slot = static_cast<size_t>(hash) & (tableSize - 1);
+        while (true)
+        {
+            const auto candidate = table[slot];
+            if (candidate == InvalidIndex)
+            {
+                table[slot] = i;
+                remap[i] = uniqueSize++;
+                break;
+            }
+            if (StreamEqual(vertexStreams.m_positions, candidate, i) &&
+                StreamEqual(vertexStreams.m_normals, candidate, i) &&
+                StreamEqual(vertexStreams.m_tangents, candidate, i) &&
+                StreamEqual(vertexStreams.m_colors, candidate, i) &&
+                StreamEqual(vertexStreams.m_texCoords, candidate, i))
+            {
+                remap[i] = remap[candidate];
+                break;
+            }
+            slot = (slot + 1) & (tableSize - 1);
+        }
+    }
+    // Triangles that were degenerate before welding are dropped as well, so the remap runs even without merges.
+    if (uniqueSize != size)
+        RemapStreams(vertexStreams, remap, uniqueSize);
+    size_t triangleSize = 0;
+    for (const auto &triangle : triangles)
+    {
+        const glm::uvec3 remapped = {remap[triangle.x], remap[triangle.y], remap[triangle.z]};
+        if (remapped.x == remapped.y || remapped.y == remapped.z || remapped.z == remapped.x)
+            continue;
+        triangles[triangleSize++] = remapped;
+    }
+    triangles.resize(triangleSize);
+    return uniqueSize;
+}
+
+void MeshUtilities::OptimizeVertexCache(
+    std::vector<glm::uvec3> &triangles,
+    const size_t &vertexCount,
+    std::vector<unsigned> &clusterOffsets,
+    const unsigned &cacheSize)
+{
+    clusterOffsets.clear();
+    if (triangles.empty())
+        return;
+    // Sander et al. 2007, "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw".
+    auto &scratch = t_scratch;
+    BuildAdjacency(vertexCount, triangles, scratch);
+    const auto &offsets = scratch.m_offsets;
+    const auto &corners = scratch.m_corners;
+    std::vector<unsigned> liveTriangles(vertexCount);
+    for (size_t i = 0; i < vertexCount; i++)
+        liveTriangles[i] = offsets[i + 1] - offsets[i];
+    std::vector<unsigned> timestamps(vertexCount, 0);
+    std::vector<bool> emitted(triangles.size(), false);
+    std::vector<unsigned> deadEnd;
+    deadEnd.reserve(triangles.size() * 3);
+    std::vector<unsigned> candidates;
+    std::vector<glm::uvec3> result;
+    result.reserve(triangles.size());
+
+    unsigned time = cacheSize + 1;
+    unsigned cursor = 0;
+    auto fanning = static_cast<int>(triangles[0].x);
+    clusterOffsets.push_back(0);
+    while (fanning >= 0)
+    {
+        candidates.clear();
+        for (auto j = offsets[fanning]; j < offsets[fanning + 1]; j++)
+        {
+            const auto triangleIndex = corners[j] / 3;
+            if (emitted[triangleIndex])
+                continue;
+            const auto &triangle = triangles[triangleIndex];
+            for (int k = 0; k < 3; k++)
+            {
+                const auto vertex = triangle[k];
+                deadEnd.push_back(vertex);
+                candidates.push_back(vertex);
+                liveTriangles[vertex]--;
+                if (time - timestamps[vertex] > cacheSize)
+                    timestamps[vertex] = time++;
+            }
+            emitted[triangleIndex] = true;
+            result.push_back(triangle);
+        }
+        // Prefer the oldest candidate that is still in the cache after its whole fan is emitted.
+        int next = -1;
+        int bestPriority = -1;
+        for (const auto &vertex : candidates)
+        {
+            if (liveTriangles[vertex] == 0)
+                continue;
+            int priority = 0;
+            if (time - timestamps[vertex] + 2 * liveTriangles[vertex] <= cacheSize)
+                priority = time - timestamps[vertex];
+            if (priority > bestPriority)
+            {
+                bestPriority = priority;
+                next = vertex;
+            }
+        }
+        if (next == -1)
+        {
+            while (!deadEnd.empty())
+            {
+                const auto vertex = deadEnd.back();
+                deadEnd.pop_back();
+                if (liveTriangles[vertex] > 0)
+                {
+                    next = vertex;
+                    break;
+                }
+            }
+        }
+        if (next == -1)
+        {
+            while (cursor < vertexCount)
+            {
+                if (liveTriangles[cursor] > 0)
+                {
+                    next = cursor;
+                    break;
+                }
+                cursor++;
+            }
+        }
+        if (next >= 0 && time - timestamps[next] > cacheSize && result.size() != clusterOffsets.back())
+            clusterOffsets.push_back(result.size());
+        fanning = next;
+    }
+    triangles.swap(result);
+}
+
+void MeshUtilities::OptimizeOverdraw(
+    const std::vector<glm::vec3> &positions,
+    std::vector<glm::uvec3> &triangles,
+    const std::vector<unsigned> &clusterOffsets)
+{
+    const auto clusterSize = clusterOffsets.size();
+    if (clusterSize < 2)
+        return;
+    std::vector<glm::vec3> clusterCenters(clusterSize);
+    std::vector<glm::vec3> clusterNormals(clusterSize);
+    glm::vec3 meshCenter = glm::vec3(0.0f);
+    float meshArea = 0.0f;
+    for (size_t i = 0; i < clusterSize; i++)
+    {
+        const auto end = i + 1 < clusterSize ? clusterOffsets[i + 1] : triangles.size();
+        glm::vec3 center = glm::vec3(0.0f);
+        glm::vec3 normal = glm::vec3(0.0f);
+        float area = 0.0f;
+        for (auto j = clusterOffsets[i]; j < end; j++)
+        {
+            const auto &p0 = positions[triangles[j].x];
+            const auto &p1 = positions[triangles[j].y];
+            const auto &p2 = positions[triangles[j].z];
+            const auto faceNormal = glm::cross(p1 - p0, p2 - p0);
+            const auto faceArea = glm::length(faceNormal);
+            center += (p0 + p1 + p2) * (faceArea / 3.0f);
+            normal += faceNormal;
+            area += faceArea;
+        }
+        meshCenter += center;
+        meshArea += area;
+        clusterCenters[i] = area > 0.0f ? center / area : positions[triangles[clusterOffsets[i]].x];
+        clusterNormals[i] = SafeNormalize(normal, glm::vec3(0.0f));
+    }
+    if (meshArea > 0.0f)
+        meshCenter /= meshArea;
+    std::vector<float> sortKeys(clusterSize);
+    for (size_t i = 0; i < clusterSize; i++)
+        sortKeys[i] = glm::dot(clusterCenters[i] - meshCenter, clusterNormals[i]);
+    std::vector<unsigned> order(clusterSize);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](const unsigned &a, const unsigned &b) {
+        return sortKeys[a] > sortKeys[b];
+    });
+    std::vector<glm::uvec3> result;
+    result.reserve(triangles.size());
+    for (const auto &i : order)
+    {
+        const auto end = i + 1 < clusterSize ? clusterOffsets[i + 1] : triangles.size();
+        result.insert(result.end(), triangles.begin() + clusterOffsets[i], triangles.begin() + end);
+    }
+    triangles.swap(result);
+}
+
+void MeshUtilities::OptimizeVertexFetch(VertexStreams &vertexStreams, std::vector<glm::uvec3> &triangles)
+{
+    std::vector<unsigned> remap(vertexStreams.Size(), InvalidIndex);
+    unsigned size = 0;
+    for (auto &triangle : triangles)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            auto &index = triangle[i];
+            if (remap[index] == InvalidIndex)
+                remap[index] = size++;
+            index = remap[index];
+        }
+    }
+    RemapStreams(vertexStreams, remap, size);
+}
+
+float MeshUtilities::CalculateAcmr(
+    const std::vector<glm::uvec3> &triangles, const size_t &vertexCount, const unsigned &cacheSize)
+{
+    if (triangles.empty())
+        return 0.0f;
+    // FIFO cache, a vertex stays cached until cacheSize other vertices were loaded after it.
+    std::vector<unsigned> timestamps(vertexCount, 0);
+    unsigned time = cacheSize + 1;
+    size_t misses = 0;
+    for (const auto &triangle : triangles)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            const auto vertex = triangle[i];
+            if (time - timestamps[vertex] > cacheSize)
+            {
+                timestamps[vertex] = time++;
+                misses++;
+            }
+        }
+    }
+    return static_cast<float>(misses) / triangles.size();
+}
+
+MeshOptimizationReport MeshUtilities::Optimize(VertexStreams &vertexStreams, std::vector<glm::uvec3> &triangles)
+{
+    MeshOptimizationReport report;
+    report.m_verticesBefore = vertexStreams.Size();
+    report.m_acmrBefore = CalculateAcmr(triangles, report.m_verticesBefore);
+    WeldVertices(vertexStreams, triangles);
+    std::vector<unsigned> clusterOffsets;
+    OptimizeVertexCache(triangles, vertexStreams.Size(), clusterOffsets);
+    OptimizeOverdraw(vertexStreams.m_positions, triangles, clusterOffsets);
+    OptimizeVertexFetch(vertexStreams, triangles);
+    report.m_verticesAfter = vertexStreams.Size();
+    report.m_triangles = triangles.size();
+    report.m_acmrAfter = CalculateAcmr(triangles, report.m_verticesAfter);
+    return report;
+}
+#pragma endregion
+
+#pragma region Simplification
+float MeshUtilities::Simplify(
+    VertexStreams &vertexStreams,
+    std::vector<glm::uvec3> &triangles,
+    const size_t &targetTriangleCount,
+    const float &maxError)
+{
+    const auto vertexCount = vertexStreams.Size();
+    const auto &positions = vertexStreams.m_positions;
+    if (triangles.size() <= targetTriangleCount || vertexCount == 0)
+        return 0.0f;
+#pragma region Seams
+    // Vertices at the same position are wedges of one corner of the surface, split by an attribute seam. remap points
+    // at the first wedge of a position and wedges form a circular list through wedge.
+    std::vector<unsigned> remap(vertexCount);
+    std::vector<unsigned> wedge(vertexCount);
+    std::vector<unsigned> wedgeCount(vertexCount, 0);
+    {
+        size_t tableSize = 1;
+        while (tableSize < vertexCount * 2)
+            tableSize <<= 1;
+        std::vector<unsigned> table(tableSize, InvalidIndex);
+        for (unsigned i = 0; i < vertexCount; i++)
+        {
+            uint64_t hash = 14695981039346656037ull;
+            HashStream(hash, positions, i);
+            auto slot = static_cast<size_t>(hash) & (tableSize - 1);
+            remap[i] = i;
+            wedge[i] = i;
+            while (true)
+            {
+                const auto candidate = table[slot];
+                if (candidate == InvalidIndex)
+                {
+                    table[slot] = i;
+                    break;
+                }
+                if (StreamEqual(positions, candidate, i))
+                {
+                    remap[i] = candidate;
+                    wedge[i] = wedge[candidate];
+                    wedge[candidate] = i;
+                    break;
+                }
+                slot = (slot + 1) & (tableSize - 1);
+            }
+            wedgeCount[remap[i]]++;
+        }
+    }
+    const auto edgeKey = [](unsigned a, unsigned b) {
+        if (a > b)
+            std::swap(a, b);
+        return (static_cast<uint64_t>(a) << 32) | b;
+    };
+    // Edges counted once per vertex pair and once per position pair. An edge used by one triangle in position space is
+    // an open border, one used by one triangle in vertex space but two in position space is an attribute seam.
+    std::unordered_map<uint64_t, unsigned> edgeUsage;
+    std::unordered_map<uint64_t, unsigned> positionEdgeUsage;
+    for (const auto &triangle : triangles)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            const auto a = triangle[j];
+            const auto b = triangle[(j + 1) % 3];
+            edgeUsage[edgeKey(a, b)]++;
+            positionEdgeUsage[edgeKey(remap[a], remap[b])]++;
+        }
+    }
+    // Border and non-manifold positions never move. Positions with a single wedge collapse freely, positions with two
+    // wedges move along their seam with both wedges at once, anything else sits where seams meet and stays.
+    enum class VertexKind : uint8_t
+    {
+        Manifold,
+        Seam,
+        Locked
+    };
+    std::vector<VertexKind> kinds(vertexCount);
+    for (unsigned i = 0; i < vertexCount; i++)
+    {
+        const auto count = wedgeCount[remap[i]];
+        kinds[i] = count == 1 ? VertexKind::Manifold : count == 2 ? VertexKind::Seam : VertexKind::Locked;
+    }
+    for (const auto &[key, usage] : positionEdgeUsage)
+    {
+        if (usage == 2)
+            continue;
+        for (const auto position : {static_cast<unsigned>(key >> 32), static_cast<unsigned>(key & 0xffffffffu)})
+        {
+            auto vertex = position;
+            do
+            {
+                kinds[vertex] = VertexKind::Locked;
+                vertex = wedge[vertex];
+            } while (vertex != position);
+        }
+    }
+    const auto isSeamEdge = [&](const unsigned &a, const unsigned &b) {
+        const auto usage = edgeUsage.find(edgeKey(a, b));
+        return usage != edgeUsage.end() && usage->second == 1 &&
+               positionEdgeUsage[edgeKey(remap[a], remap[b])] == 2;
+    };
+#pragma endregion
+#pragma region Quadrics
+    // Quadrics are accumulated per position, so both sides of a seam see the whole surface around them.
+    std::vector<Quadric> quadrics(vertexCount);
+    std::vector<std::vector<unsigned>> adjacency(vertexCount);
+    for (unsigned i = 0; i < triangles.size(); i++)
+    {
+        const auto &triangle = triangles[i];
+        const glm::dvec3 p0 = positions[triangle.x];
+        auto normal = glm::cross(glm::dvec3(positions[triangle.y]) - p0, glm::dvec3(positions[triangle.z]) - p0);
+        const double area = glm::length(normal);
+        if (area > 0.0)
+        {
+            normal /= area;
+            const double distance = -glm::dot(normal, p0);
+            for (int j = 0; j < 3; j++)
+                quadrics[remap[triangle[j]]].AddPlane(normal, distance, area);
+        }
+        for (int j = 0; j < 3; j++)
+            adjacency[triangle[j]].push_back(i);
+    }
+    // Open borders get a plane perpendicular to the face through the edge, which makes collapsing onto them expensive.
+    for (const auto &triangle : triangles)
+    {
+        const glm::dvec3 p0 = positions[triangle.x];
+        const auto faceNormal =
+            glm::cross(glm::dvec3(positions[triangle.y]) - p0, glm::dvec3(positions[triangle.z]) - p0);
+        for (int j = 0; j < 3; j++)
+        {
+            const auto a = triangle[j];
+            const auto b = triangle[(j + 1) % 3];
+            if (positionEdgeUsage[edgeKey(remap[a], remap[b])] != 1)
+                continue;
+            const auto edge = glm::dvec3(positions[b]) - glm::dvec3(positions[a]);
+            auto normal = glm::cross(edge, faceNormal);
+            const double length = glm::length(normal);
+            if (length <= 0.0)
+                continue;
+            normal /= length;
+            const double distance = -glm::dot(normal, glm::dvec3(positions[a]));
+            const double weight = glm::dot(edge, edge) * 10.0;
+            quadrics[remap[a]].AddPlane(normal, distance, weight);
+            quadrics[remap[b]].AddPlane(normal, distance, weight);
+        }
+    }
+#pragma endregion
+#pragma region Collapse
+    std::vector<unsigned> versions(vertexCount, 0);
+    std::vector<bool> removedVertices(vertexCount, false);
+    std::vector<bool> removedTriangles(triangles.size(), false);
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<>> queue;
+    const auto collapseCost = [&](const unsigned &from, const unsigned &to) {
+        Quadric quadric = quadrics[remap[from]];
+        quadric.Add(quadrics[remap[to]]);
+        return static_cast<float>(quadric.Evaluate(positions[to]));
+    };
+    const auto pushCollapse = [&](const unsigned &from, const unsigned &to) {
+        if (kinds[from] == VertexKind::Locked)
+            return;
+        if (kinds[from] == VertexKind::Seam && !isSeamEdge(from, to))
+            return;
+        queue.push({collapseCost(from, to), from, to, versions[from], versions[to]});
+    };
+    // The wedge on the other side of the seam that from's sibling has to collapse onto, or InvalidIndex.
+    const auto findSiblingTarget = [&](const unsigned &fromSibling, const unsigned &to) {
+        for (const auto &triangleIndex : adjacency[fromSibling])
+        {
+            if (removedTriangles[triangleIndex])
+                continue;
+            const auto &triangle = triangles[triangleIndex];
+            for (int j = 0; j < 3; j++)
+            {
+                if (remap[triangle[j]] == remap[to] && isSeamEdge(fromSibling, triangle[j]))
+                    return triangle[j];
+            }
+        }
+        return InvalidIndex;
+    };
+    // A collapse is valid when from and to share a triangle and no remaining triangle around from flips.
+    const auto canCollapse = [&](const unsigned &from, const unsigned &to) {
+        bool connected = false;
+        const glm::vec3 target = positions[to];
+        for (const auto &triangleIndex : adjacency[from])
+        {
+            if (removedTriangles[triangleIndex])
+                continue;
+            const auto &triangle = triangles[triangleIndex];
+            if (triangle.x == to || triangle.y == to || triangle.z == to)
+            {
+                connected = true;
+                continue;
+            }
+            glm::vec3 moved[3];
+            for (int j = 0; j < 3; j++)
+                moved[j] = triangle[j] == from ? target : positions[triangle[j]];
+            const auto before = glm::cross(
+                positions[triangle.y] - positions[triangle.x], positions[triangle.z] - positions[triangle.x]);
+            const auto after = glm::cross(moved[1] - moved[0], moved[2] - moved[0]);
+            if (glm::dot(before, after) <= 0.0f)
+                return false;
+        }
+        return connected;
+    };
+    size_t triangleCount = triangles.size();
+    // Edge usage follows the collapses, so seams stay recognizable after their vertices moved.
+    const auto countEdges = [&](const glm::uvec3 &triangle, const bool &add) {
+        for (int j = 0; j < 3; j++)
+        {
+            const auto a = triangle[j];
+            const auto b = triangle[(j + 1) % 3];
+            auto &usage = edgeUsage[edgeKey(a, b)];
+            auto &positionUsage = positionEdgeUsage[edgeKey(remap[a], remap[b])];
+            usage = add ? usage + 1 : usage - 1;
+            positionUsage = add ? positionUsage + 1 : positionUsage - 1;
+        }
+    };
+    const auto applyCollapse = [&](const unsigned &from, const unsigned &to) {
+        for (const auto &triangleIndex : adjacency[from])
+        {
+            if (removedTriangles[triangleIndex])
+                continue;
+            auto &triangle = triangles[triangleIndex];
+            countEdges(triangle, false);
+            if (triangle.x == to || triangle.y == to || triangle.z == to)
+            {
+                removedTriangles[triangleIndex] = true;
+                triangleCount--;
+                continue;
+            }
+            for (int j = 0; j < 3; j++)
+            {
+                if (triangle[j] == from)
+                    triangle[j] = to;
+            }
+            countEdges(triangle, true);
+            adjacency[to].push_back(triangleIndex);
+        }
+        removedVertices[from] = true;
+        versions[to]++;
+    };
+    const auto pushNeighbours = [&](const unsigned &from, const unsigned &to) {
+        for (const auto &triangleIndex : adjacency[from])
+        {
+            if (removedTriangles[triangleIndex])
+                continue;
+            const auto &triangle = triangles[triangleIndex];
+            for (int j = 0; j < 3; j++)
+            {
+                if (triangle[j] == to)
+                    continue;
+                pushCollapse(triangle[j], to);
+                pushCollapse(to, triangle[j]);
+            }
+        }
+        adjacency[from].clear();
+    };
+    for (const auto &triangle : triangles)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            pushCollapse(triangle[j], triangle[(j + 1) % 3]);
+            pushCollapse(triangle[(j + 1) % 3], triangle[j]);
+        }
+    }
+    float maxSquaredError = 0.0f;
+    const float maxErrorLimit = maxError < FLT_MAX ? maxError * maxError : FLT_MAX;
+    while (triangleCount > targetTriangleCount && !queue.empty())
+    {
+        const auto collapse = queue.top();
+        queue.pop();
+        const auto from = collapse.m_from;
+        const auto to = collapse.m_to;
+        if (removedVertices[from] || removedVertices[to])
+            continue;
+        if (collapse.m_fromVersion != versions[from] || collapse.m_toVersion != versions[to])
+        {
+            pushCollapse(from, to);
+            continue;
+        }
+        if (collapse.m_cost > maxErrorLimit)
+            break;
+        // A seam vertex moves together with its sibling, which slides along the same seam edge on the other side.
+        auto fromSibling = InvalidIndex;
+        auto toSibling = InvalidIndex;
+        if (kinds[from] == VertexKind::Seam)
+        {
+            fromSibling = wedge[from];
+            toSibling = findSiblingTarget(fromSibling, to);
+            if (toSibling == InvalidIndex || removedVertices[fromSibling] || removedVertices[toSibling])
+                continue;
+        }
+        if (!canCollapse(from, to) || (fromSibling != InvalidIndex && !canCollapse(fromSibling, toSibling)))
+            continue;
+        applyCollapse(from, to);
+        if (fromSibling != InvalidIndex)
+            applyCollapse(fromSibling, toSibling);
+        quadrics[remap[to]].Add(quadrics[remap[from]]);
+        maxSquaredError = glm::max(maxSquaredError, collapse.m_cost);
+        pushNeighbours(from, to);
+        if (fromSibling != InvalidIndex)
+            pushNeighbours(fromSibling, toSibling);
+    }
+#pragma endregion
+    size_t triangleSize = 0;
+    for (size_t i = 0; i < triangles.size(); i++)
+    {
+        if (!removedTriangles[i])
+            triangles[triangleSize++] = triangles[i];
+    }
+    triangles.resize(triangleSize);
+    OptimizeVertexFetch(vertexStreams, triangles);
+    return glm::sqrt(maxSquaredError);
+}
+#pragma endregion
@@ -0,0 +1,679 @@
+#include "OpenGLUtils.hpp"
+#include <cstring>
+#include <map>
+#include <type_traits>
+#include <unordered_map>
+using namespace UniEngine;
+
+// Entry points handed to glad when the application is created headless. Nothing reaches a driver: names are handed
+// out from counters, queries report a complete GL 4.5 context, and every call is recorded in the statistics.
+namespace
+{
+GLStatistics statistics;
+GLuint nextName = 1;
+
+// Texture sizes and bindings, only tracked so reading a texture back can clear as many bytes as the driver would write.
+struct TextureInfo
+{
+    GLenum m_target = 0;
+    GLsizei m_width = 0;
+    GLsizei m_height = 1;
+    GLsizei m_depth = 1;
+};
+std::unordered_map<GLuint, TextureInfo> textures;
+std::map<std::pair<GLuint, GLenum>, GLuint> boundTextures;
+GLuint activeTextureUnit = 0;
+GLint packAlignment = 4;
+
+size_t ComponentAmount(const GLenum &format)
+{
+    switch (format)
+    {
+    case GL_RED:
+    case GL_RED_INTEGER:
+    case GL_DEPTH_COMPONENT:
+    case GL_STENCIL_INDEX:
+        return 1;
+    case GL_RG:
+    case GL_RG_INTEGER:
+    case GL_DEPTH_STENCIL:
+        return 2;
+    case GL_RGB:
+    case GL_BGR:
+    case GL_RGB_INTEGER:
+        return 3;
+    default:
+        return 4;
+    }
+}
+
+size_t PixelSize(const GLenum &format, const GLenum &type)
+{
+    switch (type)
+    {
+    case GL_UNSIGNED_BYTE:
+    case GL_BYTE:
+        return ComponentAmount(format);
+    case GL_UNSIGNED_SHORT:
+    case GL_SHORT:
+    case GL_HALF_FLOAT:
+        return 2 * ComponentAmount(format);
+    case GL_UNSIGNED_INT_24_8:
+    case GL_UNSIGNED_INT_10F_11F_11F_REV:
+    case GL_UNSIGNED_INT_2_10_10_10_REV:
+        return 4;
+    case GL_FLOAT_32_UNSIGNED_INT_24_8_REV:
+        return 8;
+    default:
+        return 4 * ComponentAmount(format);
+    }
+}
+
+GLenum BindingTarget(const GLenum &target)
+{
+    if (target >= GL_TEXTURE_CUBE_MAP_POSITIVE_X && target <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z)
+        return GL_TEXTURE_CUBE_MAP;
+    return target;
+}
+
+TextureInfo *BoundTexture(const GLenum &target)
+{
+    const auto binding = boundTextures.find({activeTextureUnit, BindingTarget(target)});
+    if (binding == boundTextures.end())
+        return nullptr;
+    const auto texture = textures.find(binding->second);
+    return texture == textures.end() ? nullptr : &texture->second;
+}
+
+void SetTextureSize(TextureInfo *texture, const GLsizei &width, const GLsizei &height, const GLsizei &depth)
+{
+    if (!texture)
+        return;
+    texture->m_width = width;
+    texture->m_height = height;
+    texture->m_depth = depth;
+}
+
+void RecordUpload(const size_t &bytes, const void *data)
+{
+    statistics.m_calls++;
+    // Allocations without data and uploads from a bound unpack buffer do not leave memory.
+    if (data)
+        statistics.m_bytesUploaded += bytes;
+}
+
+GLint64 IntegerValue(const GLenum &pname)
+{
+    switch (pname)
+    {
+    case GL_MAJOR_VERSION:
+        return 4;
+    case GL_MINOR_VERSION:
+        return 5;
+    case GL_NUM_EXTENSIONS:
+        return 1;
+    case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
+        return 80;
+    case GL_MAX_TEXTURE_IMAGE_UNITS:
+        return 16;
+    case GL_MAX_TEXTURE_SIZE:
+    case GL_MAX_VIEWPORT_DIMS:
+        return 16384;
+    default:
+        return 0;
+    }
+}
+
+size_t ValueAmount(const GLenum &pname)
+{
+    switch (pname)
+    {
+    case GL_VIEWPORT:
+    case GL_SCISSOR_BOX:
+    case GL_COLOR_CLEAR_VALUE:
+    case GL_BLEND_COLOR:
+    case GL_COLOR_WRITEMASK:
+        return 4;
+    case GL_DEPTH_RANGE:
+    case GL_MAX_VIEWPORT_DIMS:
+    case GL_ALIASED_LINE_WIDTH_RANGE:
+    case GL_POINT_SIZE_RANGE:
+    case GL_POLYGON_MODE:
+        return 2;
+    default:
+        return 1;
+    }
+}
+
+template <typename T> void WriteValues(const GLenum &pname, T *data)
+{
+    statistics.m_calls++;
+    const auto value = static_cast<T>(IntegerValue(pname));
+    for (size_t i = 0; i < ValueAmount(pname); i++)
+        data[i] = value;
+}
+
+#pragma region Typed entry points
+const GLubyte *APIENTRY GetString(GLenum name)
+{
+    statistics.m_calls++;
+    const char *value = name == GL_VERSION ? "4.5.0 UniEngine headless" : "UniEngine headless";
+    return reinterpret_cast<const GLubyte *>(value);
+}
+const GLubyte *APIENTRY GetStringi(GLenum, GLuint)
+{
+    statistics.m_calls++;
+    // glad refuses to load without at least one extension.
+    return reinterpret_cast<const GLubyte *>("GL_UNIENGINE_headless");
+}
+GLenum APIENTRY GetError()
+{
+    statistics.m_calls++;
+    return GL_NO_ERROR;
+}
+void APIENTRY GetIntegerv(GLenum pname, GLint *data)
+{
+    WriteValues(pname, data);
+}
+void APIENTRY GetInteger64v(GLenum pname, GLint64 *data)
+{
+    WriteValues(pname, data);
+}
+void APIENTRY GetFloatv(GLenum pname, GLfloat *data)
+{
+    WriteValues(pname, data);
+}
+void APIENTRY GetDoublev(GLenum pname, GLdouble *data)
+{
+    WriteValues(pname, data);
+}
+void APIENTRY GetBooleanv(GLenum pname, GLboolean *data)
+{
+    WriteValues(pname, data);
+}
+GLboolean APIENTRY IsEnabled(GLenum)
+{
+    statistics.m_calls++;
+    return GL_FALSE;
+}
+void APIENTRY GetObjectiv(GLuint, GLenum pname, GLint *params)
+{
+    statistics.m_calls++;
+    // Shaders compile and programs link, with empty logs.
+    *params = pname == GL_COMPILE_STATUS || pname == GL_LINK_STATUS || pname == GL_VALIDATE_STATUS ? GL_TRUE : 0;
+}
+void APIENTRY GetObjectInfoLog(GLuint, GLsizei bufSize, GLsizei *length, GLchar *infoLog)
+{
+    statistics.m_calls++;
+    if (length)
+        *length = 0;
+    if (infoLog && bufSize > 0)
+        infoLog[0] = '\0';
+}
+GLint APIENTRY GetLocation(GLuint, const GLchar *)
+{
+    statistics.m_calls++;
+    return 0;
+}
+GLuint APIENTRY GetUniformBlockIndex(GLuint, const GLchar *)
+{
+    statistics.m_calls++;
+    return 0;
+}
+GLuint APIENTRY CreateObject()
+{
+    statistics.m_calls++;
+    return nextName++;
+}
+GLuint APIENTRY CreateShader(GLenum)
+{
+    return CreateObject();
+}
+void APIENTRY GenNames(GLsizei n, GLuint *names)
+{
+    statistics.m_calls++;
+    for (GLsizei i = 0; i < n; i++)
+        names[i] = nextName++;
+}
+void APIENTRY CreateNamesOfTarget(GLenum, GLsizei n, GLuint *names)
+{
+    GenNames(n, names);
+}
+GLenum APIENTRY CheckFramebufferStatus(GLenum)
+{
+    statistics.m_calls++;
+    return GL_FRAMEBUFFER_COMPLETE;
+}
+GLenum APIENTRY CheckNamedFramebufferStatus(GLuint, GLenum target)
+{
+    return CheckFramebufferStatus(target);
+}
+void APIENTRY ReadPixels(GLint, GLint, GLsizei width, GLsizei height, GLenum format, GLenum type, void *pixels)
+{
+    statistics.m_calls++;
+    if (pixels && width > 0 && height > 0)
+        std::memset(pixels, 0, static_cast<size_t>(width) * height * PixelSize(format, type));
+}
+
+void APIENTRY BufferData(GLenum, GLsizeiptr size, const void *data, GLenum)
+{
+    RecordUpload(size, data);
+}
+void APIENTRY NamedBufferData(GLuint, GLsizeiptr size, const void *data, GLenum)
+{
+    RecordUpload(size, data);
+}
+void APIENTRY BufferSubData(GLenum, GLintptr, GLsizeiptr size, const void *data)
+{
+    RecordUpload(size, data);
+}
+void APIENTRY NamedBufferSubData(GLuint, GLintptr, GLsizeiptr size, const void *data)
+{
+    RecordUpload(size, data);
+}
+void APIENTRY TexImage2D(
+    GLenum target,
+    GLint level,
+    GLint,
+    GLsizei width,
+    GLsizei height,
+    GLint,
+    GLenum format,
+    GLenum type,
+    const void *pixels)
+{
+    if (level == 0)
+        SetTextureSize(BoundTexture(target), width, height, 1);
+    RecordUpload(static_cast<size_t>(width) * height * PixelSize(format, type), pixels);
+}
+void APIENTRY TexImage3D(
+    GLenum target,
+    GLint level,
+    GLint,
+    GLsizei width,
+    GLsizei height,
+    GLsizei depth,
+    GLint,
+    GLenum format,
+    GLenum type,
+    const void *pixels)
+{
+    if (level == 0)
+        SetTextureSize(BoundTexture(target), width, height, depth);
+    RecordUpload(static_cast<size_t>(width) * height * depth * PixelSize(format, type), pixels);
+}
+void APIENTRY TexSubImage1D(
+    GLenum, GLint, GLint, GLsizei width, GLenum format, GLenum type, const void *pixels)
+{
+    RecordUpload(static_cast<size_t>(width) * PixelSize(format, type), pixels);
+}
+void APIENTRY TexSubImage2D(
+    GLenum,
+    GLint,
+    GLint,
+    GLint,
+    GLsizei width,
+    GLsizei height,
+    GLenum format,
+    GLenum type,
+    const void *pixels)
+{
+    RecordUpload(static_cast<size_t>(width) * height * PixelSize(format, type), pixels);
+}
+void APIENTRY TexSubImage3D(
+    GLenum,
+    GLint,
+    GLint,
+    GLint,
+    GLint,
+    GLsizei width,
+    GLsizei height,
+    GLsizei depth,
+    GLenum format,
+    GLenum type,
+    const void *pixels)
+{
+    RecordUpload(static_cast<size_t>(width) * height * depth * PixelSize(format, type), pixels);
+}
+void APIENTRY TextureSubImage1D(
+    GLuint, GLint level, GLint xoffset, GLsizei width, GLenum format, GLenum type, const void *pixels)
+{
+    TexSubImage1D(0, level, xoffset, width, format, type, pixels);
+}
+void APIENTRY TextureSubImage2D(
+    GLuint,
+    GLint level,
+    GLint xoffset,
+    GLint yoffset,
+    GLsizei width,
+    GLsizei height,
+    GLenum format,
+    GLenum type,
+    const void *pixels)
+{
+    TexSubImage2D(0, level, xoffset, yoffset, width, height, format, type, pixels);
+}
+void APIENTRY TextureSubImage3D(
+    GLuint,
+    GLint level,
+    GLint xoffset,
+    GLint yoffset,
+    GLint zoffset,
+    GLsizei width,
+    GLsizei height,
+    GLsizei depth,
+    GLenum format,
+    GLenum type,
+    const void *pixels)
+{
+    TexSubImage3D(0, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels);
+}
+void APIENTRY TexStorage1D(GLenum target, GLsizei, GLenum, GLsizei width)
+{
+    statistics.m_calls++;
+    SetTextureSize(BoundTexture(target), width, 1, 1);
+}
+void APIENTRY TexStorage2D(GLenum target, GLsizei, GLenum, GLsizei width, GLsizei height)
+{
+    statistics.m_calls++;
+    SetTextureSize(BoundTexture(target), width, height, 1);
+}
+void APIENTRY TexStorage3D(
+    GLenum target, GLsizei, GLenum, GLsizei width, GLsizei height, GLsizei depth)
+{
+    statistics.m_calls++;
+    SetTextureSize(BoundTexture(target), width, height, depth);
+}
+void APIENTRY TextureStorage2D(GLuint texture, GLsizei, GLenum, GLsizei width, GLsizei height)
+{
+    statistics.m_calls++;
+    SetTextureSize(&textures[texture], width, height, 1);
+}
+void APIENTRY TextureStorage3D(
+    GLuint texture, GLsizei, GLenum, GLsizei width, GLsizei height, GLsizei depth)
+{
+    statistics.m_calls++;
+    SetTextureSize(&textures[texture], width, height, depth);
+}
+void APIENTRY GenTextures(GLsizei n, GLuint *names)
+{
+    GenNames(n, names);
+    for (GLsizei i = 0; i < n; i++)
+        textures[names[i]] = TextureInfo();
+}
+void APIENTRY CreateTextures(GLenum target, GLsizei n, GLuint *names)
+{
+    GenNames(n, names);
+    for (GLsizei i = 0; i < n; i++)
+        textures[names[i]].m_target = target;
+}
+void APIENTRY DeleteTextures(GLsizei n, const GLuint *names)
+{
+    statistics.m_calls++;
+    for (GLsizei i = 0; i < n; i++)
+        textures.erase(names[i]);
+}
+void APIENTRY ActiveTexture(GLenum texture)
+{
+    statistics.m_calls++;
+    statistics.m_stateChanges++;
+    activeTextureUnit = texture - GL_TEXTURE0;
+}
+void APIENTRY BindTexture(GLenum target, GLuint texture)
+{
+    statistics.m_calls++;
+    statistics.m_stateChanges++;
+    boundTextures[{activeTextureUnit, target}] = texture;
+    if (texture != 0)
+        textures[texture].m_target = target;
+}
+void APIENTRY BindTextureUnit(GLuint unit, GLuint texture)
+{
+    statistics.m_calls++;
+    statistics.m_stateChanges++;
+    const auto search = textures.find(texture);
+    if (search != textures.end() && search->second.m_target != 0)
+        boundTextures[{unit, search->second.m_target}] = texture;
+}
+void APIENTRY PixelStorei(GLenum pname, GLint param)
+{
+    statistics.m_calls++;
+    if (pname == GL_PACK_ALIGNMENT)
+        packAlignment = param;
+}
+void APIENTRY GetTexImage(GLenum target, GLint level, GLenum format, GLenum type, void *pixels)
+{
+    statistics.m_calls++;
+    const auto *texture = BoundTexture(target);
+    if (!pixels || !texture || texture->m_width == 0)
+        return;
+    // Rows are padded to the pack alignment, except the last one.
+    const size_t width = (std::max)(texture->m_width >> level, 1);
+    const size_t rows = static_cast<size_t>((std::max)(texture->m_height >> level, 1)) *
+                        (target == GL_TEXTURE_3D ? (std::max)(texture->m_depth >> level, 1) : texture->m_depth);
+    const size_t rowSize = width * PixelSize(format, type);
+    const size_t alignment = packAlignment > 0 ? packAlignment : 1;
+    const size_t paddedRowSize = (rowSize + alignment - 1) / alignment * alignment;
+    std::memset(pixels, 0, paddedRowSize * (rows - 1) + rowSize);
+}
+void APIENTRY GetTextureImage(
+    GLuint, GLint, GLenum, GLenum, GLsizei bufSize, void *pixels)
+{
+    statistics.m_calls++;
+    if (pixels && bufSize > 0)
+        std::memset(pixels, 0, bufSize);
+}
+void APIENTRY GetnTexImage(GLenum, GLint level, GLenum format, GLenum type, GLsizei bufSize, void *pixels)
+{
+    GetTextureImage(0, level, format, type, bufSize, pixels);
+}
+void APIENTRY GetBufferSubData(GLenum, GLintptr, GLsizeiptr size, void *data)
+{
+    statistics.m_calls++;
+    if (data && size > 0)
+        std::memset(data, 0, size);
+}
+void APIENTRY GetNamedBufferSubData(GLuint, GLintptr offset, GLsizeiptr size, void *data)
+{
+    GetBufferSubData(0, offset, size, data);
+}
+#pragma endregion
+
+#pragma region Generated entry points
+// Every other entry point gets a stub with the exact signature of its glad function pointer type, one instantiation per
+// signature and statistic. The stubs return a value-initialized result and clear the first element of every output
+// parameter of scalar or pointer type. Outputs whose size depends on other arguments are typed entry points above.
+enum class Record
+{
+    Call,
+    Draw,
+    StateChange,
+    Uniform
+};
+
+template <Record Kind> void Count()
+{
+    statistics.m_calls++;
+    if constexpr (Kind == Record::Draw)
+        statistics.m_drawCalls++;
+    else if constexpr (Kind == Record::StateChange)
+        statistics.m_stateChanges++;
+    else if constexpr (Kind == Record::Uniform)
+        statistics.m_uniformUpdates++;
+}
+
+template <typename T> void ZeroOutput(T argument)
+{
+    if constexpr (std::is_pointer_v<T>)
+    {
+        using Value = std::remove_pointer_t<T>;
+        if constexpr (!std::is_const_v<Value> && (std::is_arithmetic_v<Value> || std::is_pointer_v<Value>))
+        {
+            if (argument)
+                *argument = Value();
+        }
+    }
+}
+
+template <typename Signature> struct Stub;
+template <typename Result, typename... Arguments> struct Stub<Result(APIENTRY *)(Arguments...)>
+{
+    template <Record Kind> static Result APIENTRY Run(Arguments... arguments)
+    {
+        Count<Kind>();
+        (ZeroOutput(arguments), ...);
+        if constexpr (!std::is_void_v<Result>)
+            return Result();
+    }
+};
+#pragma endregion
+
+struct EntryPoint
+{
+    const char *m_name;
+    void *m_function;
+};
+
+template <typename T> void *Function(T function)
+{
+    return reinterpret_cast<void *>(function);
+}
+
+const EntryPoint TypedEntryPoints[] = {
+    {"glGetString", Function(GetString)},
+    {"glGetStringi", Function(GetStringi)},
+    {"glGetError", Function(GetError)},
+    {"glGetIntegerv", Function(GetIntegerv)},
+    {"glGetInteger64v", Function(GetInteger64v)},
+    {"glGetFloatv", Function(GetFloatv)},
+    {"glGetDoublev", Function(GetDoublev)},
+    {"glGetBooleanv", Function(GetBooleanv)},
+    {"glIsEnabled", Function(IsEnabled)},
+    {"glGetShaderiv", Function(GetObjectiv)},
+    {"glGetProgramiv", Function(GetObjectiv)},
+    {"glGetShaderInfoLog", Function(GetObjectInfoLog)},
+    {"glGetProgramInfoLog", Function(GetObjectInfoLog)},
+    {"glGetUniformLocation", Function(GetLocation)},
+    {"glGetAttribLocation", Function(GetLocation)},
+    {"glGetUniformBlockIndex", Function(GetUniformBlockIndex)},
+    {"glCreateShader", Function(CreateShader)},
+    {"glCreateProgram", Function(CreateObject)},
+    {"glGenBuffers", Function(GenNames)},
+    {"glGenVertexArrays", Function(GenNames)},
+    {"glGenTextures", Function(GenTextures)},
+    {"glGenFramebuffers", Function(GenNames)},
+    {"glGenRenderbuffers", Function(GenNames)},
+    {"glGenQueries", Function(GenNames)},
+    {"glGenSamplers", Function(GenNames)},
+    {"glCreateBuffers", Function(GenNames)},
+    {"glCreateVertexArrays", Function(GenNames)},
+    {"glCreateFramebuffers", Function(GenNames)},
+    {"glCreateRenderbuffers", Function(GenNames)},
+    {"glCreateSamplers", Function(GenNames)},
+    {"glCreateTextures", Function(CreateTextures)},
+    {"glCreateQueries", Function(CreateNamesOfTarget)},
+    {"glCheckFramebufferStatus", Function(CheckFramebufferStatus)},
+    {"glCheckNamedFramebufferStatus", Function(CheckNamedFramebufferStatus)},
+    {"glReadPixels", Function(ReadPixels)},
+    {"glBufferData", Function(BufferData)},
+    {"glNamedBufferData", Function(NamedBufferData)},
+    {"glBufferSubData", Function(BufferSubData)},
+    {"glNamedBufferSubData", Function(NamedBufferSubData)},
+    {"glTexImage2D", Function(TexImage2D)},
+    {"glTexImage3D", Function(TexImage3D)},
+    {"glTexSubImage1D", Function(TexSubImage1D)},
+    {"glTexSubImage2D", Function(TexSubImage2D)},
+    {"glTexSubImage3D", Function(TexSubImage3D)},
+    {"glTextureSubImage1D", Function(TextureSubImage1D)},
+    {"glTextureSubImage2D", Function(TextureSubImage2D)},
+    {"glTextureSubImage3D", Function(TextureSubImage3D)},
+    {"glTexStorage1D", Function(TexStorage1D)},
+    {"glTexStorage2D", Function(TexStorage2D)},
+    {"glTexStorage3D", Function(TexStorage3D)},
+    {"glTextureStorage2D", Function(TextureStorage2D)},
+    {"glTextureStorage3D", Function(TextureStorage3D)},
+    {"glDeleteTextures", Function(DeleteTextures)},
+    {"glActiveTexture", Function(ActiveTexture)},
+    {"glBindTexture", Function(BindTexture)},
+    {"glBindTextureUnit", Function(BindTextureUnit)},
+    {"glPixelStorei", Function(PixelStorei)},
+    {"glGetTexImage", Function(GetTexImage)},
+    {"glGetTextureImage", Function(GetTextureImage)},
+    {"glGetnTexImage", Function(GetnTexImage)},
+    {"glGetBufferSubData", Function(GetBufferSubData)},
+    {"glGetNamedBufferSubData", Function(GetNamedBufferSubData)}};
+
+struct StubEntryPoint
+{
+    const char *m_name;
+    // Indexed by Record.
+    void *m_functions[4];
+};
+
+#define UNIENGINE_HEADLESS_ENTRY_POINT(name)                                                                           \
+    {#name,                                                                                                            \
+     {Function(Stub<decltype(glad_##name)>::Run<Record::Call>),                                                        \
+      Function(Stub<decltype(glad_##name)>::Run<Record::Draw>),                                                        \
+      Function(Stub<decltype(glad_##name)>::Run<Record::StateChange>),                                                 \
+      Function(Stub<decltype(glad_##name)>::Run<Record::Uniform>)}},
+const StubEntryPoint StubEntryPoints[] = {
+#include "OpenGLHeadlessEntryPoints.inl"
+};
+#undef UNIENGINE_HEADLESS_ENTRY_POINT
+
+const char *StateChanges[] = {
+    "glEnable", "glDisable", "glEnablei", "glDisablei", "glBlendFunc", "glBlendFuncSeparate", "glBlendEquation",
+    "glBlendEquationSeparate", "glCullFace", "glFrontFace", "glPolygonMode", "glDepthFunc", "glDepthMask",
+    "glColorMask", "glStencilFunc", "glStencilOp", "glStencilMask", "glViewport", "glScissor", "glLineWidth",
+    "glPointSize", "glPatchParameteri", "glUseProgram", "glBindVertexArray", "glBindBuffer", "glBindBufferBase",
+    "glBindBufferRange", "glBindTexture", "glBindTextureUnit", "glActiveTexture", "glBindFramebuffer",
+    "glBindRenderbuffer", "glBindSampler", "glDrawBuffer", "glDrawBuffers", "glNamedFramebufferDrawBuffer",
+    "glNamedFramebufferDrawBuffers"};
+
+const char *DrawPrefixes[] = {
+    "glDrawArrays", "glDrawElements", "glDrawRangeElements", "glDrawTransformFeedback", "glMultiDraw", "glDispatchCompute"};
+
+const char *UniformPrefixes[] = {"glUniform", "glProgramUniform"};
+
+bool StartsWith(const char *name, const char *prefix)
+{
+    return std::strncmp(name, prefix, std::strlen(prefix)) == 0;
+}
+
+
+Record Classify(const char *name)
+{
+    for (const auto &stateChange : StateChanges)
+        if (std::strcmp(name, stateChange) == 0)
+            return Record::StateChange;
+    for (const auto &prefix : DrawPrefixes)
+        if (StartsWith(name, prefix))
+            return Record::Draw;
+    for (const auto &prefix : UniformPrefixes)
+        if (StartsWith(name, prefix))
+            return Record::Uniform;
+    return Record::Call;
+}
+} // namespace
+
+void *OpenGLUtils::HeadlessProcAddress(const char *name)
+{
+    for (const auto &entryPoint : TypedEntryPoints)
+        if (std::strcmp(name, entryPoint.m_name) == 0)
+            return entryPoint.m_function;
+    for (const auto &entryPoint : StubEntryPoints)
+        if (std::strcmp(name, entryPoint.m_name) == 0)
+            return entryPoint.m_functions[static_cast<size_t>(Classify(name))];
+    // Not declared by glad, so glad never asks for it.
+    return nullptr;
+}
+
+const GLStatistics &OpenGLUtils::GetStatistics()
+{
+    return statistics;
+}
+
+void OpenGLUtils::ResetStatistics()
+{
+    statistics = GLStatistics();
+}
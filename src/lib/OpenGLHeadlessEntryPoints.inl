@@ -0,0 +1,718 @@
+// Every entry point declared by 3rdParty/glad/include/glad/glad.h, included by OpenGLHeadless.cpp. Regenerate after
+// updating glad with:
+//   grep -oE '^GLAPI PFN[A-Z0-9_]+PROC glad_gl[A-Za-z0-9_]+' glad.h | sed -E 's/.*glad_(gl.*)/UNIENGINE_HEADLESS_ENTRY_POINT(\1)/'
+UNIENGINE_HEADLESS_ENTRY_POINT(glCullFace)
+UNIENGINE_HEADLESS_ENTRY_POINT(glFrontFace)
+UNIENGINE_HEADLESS_ENTRY_POINT(glHint)
+UNIENGINE_HEADLESS_ENTRY_POINT(glLineWidth)
+UNIENGINE_HEADLESS_ENTRY_POINT(glPointSize)
+UNIENGINE_HEADLESS_ENTRY_POINT(glPolygonMode)
+UNIENGINE_HEADLESS_ENTRY_POINT(glScissor)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexParameterf)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexParameterfv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexParameteri)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexParameteriv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexImage1D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexImage2D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDrawBuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glClear)
+UNIENGINE_HEADLESS_ENTRY_POINT(glClearColor)
+UNIENGINE_HEADLESS_ENTRY_POINT(glClearStencil)
+UNIENGINE_HEADLESS_ENTRY_POINT(glClearDepth)
+UNIENGINE_HEADLESS_ENTRY_POINT(glStencilMask)
+UNIENGINE_HEADLESS_ENTRY_POINT(glColorMask)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDepthMask)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDisable)
+UNIENGINE_HEADLESS_ENTRY_POINT(glEnable)
+UNIENGINE_HEADLESS_ENTRY_POINT(glFinish)
+UNIENGINE_HEADLESS_ENTRY_POINT(glFlush)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBlendFunc)
+UNIENGINE_HEADLESS_ENTRY_POINT(glLogicOp)
+UNIENGINE_HEADLESS_ENTRY_POINT(glStencilFunc)
+UNIENGINE_HEADLESS_ENTRY_POINT(glStencilOp)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDepthFunc)
+UNIENGINE_HEADLESS_ENTRY_POINT(glPixelStoref)
+UNIENGINE_HEADLESS_ENTRY_POINT(glPixelStorei)
+UNIENGINE_HEADLESS_ENTRY_POINT(glReadBuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glReadPixels)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetBooleanv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetDoublev)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetError)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetFloatv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetIntegerv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetString)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetTexImage)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetTexParameterfv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetTexParameteriv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetTexLevelParameterfv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetTexLevelParameteriv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glIsEnabled)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDepthRange)
+UNIENGINE_HEADLESS_ENTRY_POINT(glViewport)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDrawArrays)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDrawElements)
+UNIENGINE_HEADLESS_ENTRY_POINT(glPolygonOffset)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCopyTexImage1D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCopyTexImage2D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCopyTexSubImage1D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCopyTexSubImage2D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexSubImage1D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexSubImage2D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBindTexture)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDeleteTextures)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGenTextures)
+UNIENGINE_HEADLESS_ENTRY_POINT(glIsTexture)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDrawRangeElements)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexImage3D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexSubImage3D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCopyTexSubImage3D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glActiveTexture)
+UNIENGINE_HEADLESS_ENTRY_POINT(glSampleCoverage)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCompressedTexImage3D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCompressedTexImage2D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCompressedTexImage1D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCompressedTexSubImage3D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCompressedTexSubImage2D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCompressedTexSubImage1D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetCompressedTexImage)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBlendFuncSeparate)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMultiDrawArrays)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMultiDrawElements)
+UNIENGINE_HEADLESS_ENTRY_POINT(glPointParameterf)
+UNIENGINE_HEADLESS_ENTRY_POINT(glPointParameterfv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glPointParameteri)
+UNIENGINE_HEADLESS_ENTRY_POINT(glPointParameteriv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBlendColor)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBlendEquation)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGenQueries)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDeleteQueries)
+UNIENGINE_HEADLESS_ENTRY_POINT(glIsQuery)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBeginQuery)
+UNIENGINE_HEADLESS_ENTRY_POINT(glEndQuery)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetQueryiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetQueryObjectiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetQueryObjectuiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBindBuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDeleteBuffers)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGenBuffers)
+UNIENGINE_HEADLESS_ENTRY_POINT(glIsBuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBufferData)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBufferSubData)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetBufferSubData)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMapBuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUnmapBuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetBufferParameteriv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetBufferPointerv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBlendEquationSeparate)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDrawBuffers)
+UNIENGINE_HEADLESS_ENTRY_POINT(glStencilOpSeparate)
+UNIENGINE_HEADLESS_ENTRY_POINT(glStencilFuncSeparate)
+UNIENGINE_HEADLESS_ENTRY_POINT(glStencilMaskSeparate)
+UNIENGINE_HEADLESS_ENTRY_POINT(glAttachShader)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBindAttribLocation)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCompileShader)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCreateProgram)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCreateShader)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDeleteProgram)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDeleteShader)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDetachShader)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDisableVertexAttribArray)
+UNIENGINE_HEADLESS_ENTRY_POINT(glEnableVertexAttribArray)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetActiveAttrib)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetActiveUniform)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetAttachedShaders)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetAttribLocation)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetProgramiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetProgramInfoLog)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetShaderiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetShaderInfoLog)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetShaderSource)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetUniformLocation)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetUniformfv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetUniformiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetVertexAttribdv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetVertexAttribfv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetVertexAttribiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetVertexAttribPointerv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glIsProgram)
+UNIENGINE_HEADLESS_ENTRY_POINT(glIsShader)
+UNIENGINE_HEADLESS_ENTRY_POINT(glLinkProgram)
+UNIENGINE_HEADLESS_ENTRY_POINT(glShaderSource)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUseProgram)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform1f)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform2f)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform3f)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform4f)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform1i)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform2i)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform3i)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform4i)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform1fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform2fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform3fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform4fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform1iv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform2iv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform3iv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform4iv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniformMatrix2fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniformMatrix3fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniformMatrix4fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glValidateProgram)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib1d)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib1dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib1f)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib1fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib1s)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib1sv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib2d)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib2dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib2f)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib2fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib2s)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib2sv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib3d)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib3dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib3f)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib3fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib3s)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib3sv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib4Nbv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib4Niv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib4Nsv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib4Nub)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib4Nubv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib4Nuiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib4Nusv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib4bv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib4d)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib4dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib4f)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib4fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib4iv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib4s)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib4sv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib4ubv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib4uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttrib4usv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribPointer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniformMatrix2x3fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniformMatrix3x2fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniformMatrix2x4fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniformMatrix4x2fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniformMatrix3x4fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniformMatrix4x3fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glColorMaski)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetBooleani_v)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetIntegeri_v)
+UNIENGINE_HEADLESS_ENTRY_POINT(glEnablei)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDisablei)
+UNIENGINE_HEADLESS_ENTRY_POINT(glIsEnabledi)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBeginTransformFeedback)
+UNIENGINE_HEADLESS_ENTRY_POINT(glEndTransformFeedback)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBindBufferRange)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBindBufferBase)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTransformFeedbackVaryings)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetTransformFeedbackVarying)
+UNIENGINE_HEADLESS_ENTRY_POINT(glClampColor)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBeginConditionalRender)
+UNIENGINE_HEADLESS_ENTRY_POINT(glEndConditionalRender)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribIPointer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetVertexAttribIiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetVertexAttribIuiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribI1i)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribI2i)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribI3i)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribI4i)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribI1ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribI2ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribI3ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribI4ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribI1iv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribI2iv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribI3iv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribI4iv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribI1uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribI2uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribI3uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribI4uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribI4bv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribI4sv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribI4ubv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribI4usv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetUniformuiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBindFragDataLocation)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetFragDataLocation)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform1ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform2ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform3ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform4ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform1uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform2uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform3uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform4uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexParameterIiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexParameterIuiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetTexParameterIiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetTexParameterIuiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glClearBufferiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glClearBufferuiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glClearBufferfv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glClearBufferfi)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetStringi)
+UNIENGINE_HEADLESS_ENTRY_POINT(glIsRenderbuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBindRenderbuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDeleteRenderbuffers)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGenRenderbuffers)
+UNIENGINE_HEADLESS_ENTRY_POINT(glRenderbufferStorage)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetRenderbufferParameteriv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glIsFramebuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBindFramebuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDeleteFramebuffers)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGenFramebuffers)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCheckFramebufferStatus)
+UNIENGINE_HEADLESS_ENTRY_POINT(glFramebufferTexture1D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glFramebufferTexture2D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glFramebufferTexture3D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glFramebufferRenderbuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetFramebufferAttachmentParameteriv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGenerateMipmap)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBlitFramebuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glRenderbufferStorageMultisample)
+UNIENGINE_HEADLESS_ENTRY_POINT(glFramebufferTextureLayer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMapBufferRange)
+UNIENGINE_HEADLESS_ENTRY_POINT(glFlushMappedBufferRange)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBindVertexArray)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDeleteVertexArrays)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGenVertexArrays)
+UNIENGINE_HEADLESS_ENTRY_POINT(glIsVertexArray)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDrawArraysInstanced)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDrawElementsInstanced)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexBuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glPrimitiveRestartIndex)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCopyBufferSubData)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetUniformIndices)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetActiveUniformsiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetActiveUniformName)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetUniformBlockIndex)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetActiveUniformBlockiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetActiveUniformBlockName)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniformBlockBinding)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDrawElementsBaseVertex)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDrawRangeElementsBaseVertex)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDrawElementsInstancedBaseVertex)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMultiDrawElementsBaseVertex)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProvokingVertex)
+UNIENGINE_HEADLESS_ENTRY_POINT(glFenceSync)
+UNIENGINE_HEADLESS_ENTRY_POINT(glIsSync)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDeleteSync)
+UNIENGINE_HEADLESS_ENTRY_POINT(glClientWaitSync)
+UNIENGINE_HEADLESS_ENTRY_POINT(glWaitSync)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetInteger64v)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetSynciv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetInteger64i_v)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetBufferParameteri64v)
+UNIENGINE_HEADLESS_ENTRY_POINT(glFramebufferTexture)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexImage2DMultisample)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexImage3DMultisample)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetMultisamplefv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glSampleMaski)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBindFragDataLocationIndexed)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetFragDataIndex)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGenSamplers)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDeleteSamplers)
+UNIENGINE_HEADLESS_ENTRY_POINT(glIsSampler)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBindSampler)
+UNIENGINE_HEADLESS_ENTRY_POINT(glSamplerParameteri)
+UNIENGINE_HEADLESS_ENTRY_POINT(glSamplerParameteriv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glSamplerParameterf)
+UNIENGINE_HEADLESS_ENTRY_POINT(glSamplerParameterfv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glSamplerParameterIiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glSamplerParameterIuiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetSamplerParameteriv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetSamplerParameterIiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetSamplerParameterfv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetSamplerParameterIuiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glQueryCounter)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetQueryObjecti64v)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetQueryObjectui64v)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribDivisor)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribP1ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribP1uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribP2ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribP2uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribP3ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribP3uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribP4ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribP4uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexP2ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexP2uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexP3ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexP3uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexP4ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexP4uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexCoordP1ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexCoordP1uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexCoordP2ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexCoordP2uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexCoordP3ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexCoordP3uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexCoordP4ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexCoordP4uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMultiTexCoordP1ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMultiTexCoordP1uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMultiTexCoordP2ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMultiTexCoordP2uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMultiTexCoordP3ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMultiTexCoordP3uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMultiTexCoordP4ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMultiTexCoordP4uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glNormalP3ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glNormalP3uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glColorP3ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glColorP3uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glColorP4ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glColorP4uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glSecondaryColorP3ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glSecondaryColorP3uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMinSampleShading)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBlendEquationi)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBlendEquationSeparatei)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBlendFunci)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBlendFuncSeparatei)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDrawArraysIndirect)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDrawElementsIndirect)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform1d)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform2d)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform3d)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform4d)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform1dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform2dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform3dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniform4dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniformMatrix2dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniformMatrix3dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniformMatrix4dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniformMatrix2x3dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniformMatrix2x4dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniformMatrix3x2dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniformMatrix3x4dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniformMatrix4x2dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniformMatrix4x3dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetUniformdv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetSubroutineUniformLocation)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetSubroutineIndex)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetActiveSubroutineUniformiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetActiveSubroutineUniformName)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetActiveSubroutineName)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniformSubroutinesuiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetUniformSubroutineuiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetProgramStageiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glPatchParameteri)
+UNIENGINE_HEADLESS_ENTRY_POINT(glPatchParameterfv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBindTransformFeedback)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDeleteTransformFeedbacks)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGenTransformFeedbacks)
+UNIENGINE_HEADLESS_ENTRY_POINT(glIsTransformFeedback)
+UNIENGINE_HEADLESS_ENTRY_POINT(glPauseTransformFeedback)
+UNIENGINE_HEADLESS_ENTRY_POINT(glResumeTransformFeedback)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDrawTransformFeedback)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDrawTransformFeedbackStream)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBeginQueryIndexed)
+UNIENGINE_HEADLESS_ENTRY_POINT(glEndQueryIndexed)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetQueryIndexediv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glReleaseShaderCompiler)
+UNIENGINE_HEADLESS_ENTRY_POINT(glShaderBinary)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetShaderPrecisionFormat)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDepthRangef)
+UNIENGINE_HEADLESS_ENTRY_POINT(glClearDepthf)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetProgramBinary)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramBinary)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramParameteri)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUseProgramStages)
+UNIENGINE_HEADLESS_ENTRY_POINT(glActiveShaderProgram)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCreateShaderProgramv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBindProgramPipeline)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDeleteProgramPipelines)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGenProgramPipelines)
+UNIENGINE_HEADLESS_ENTRY_POINT(glIsProgramPipeline)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetProgramPipelineiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform1i)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform1iv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform1f)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform1fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform1d)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform1dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform1ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform1uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform2i)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform2iv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform2f)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform2fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform2d)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform2dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform2ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform2uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform3i)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform3iv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform3f)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform3fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform3d)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform3dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform3ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform3uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform4i)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform4iv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform4f)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform4fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform4d)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform4dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform4ui)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniform4uiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniformMatrix2fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniformMatrix3fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniformMatrix4fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniformMatrix2dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniformMatrix3dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniformMatrix4dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniformMatrix2x3fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniformMatrix3x2fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniformMatrix2x4fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniformMatrix4x2fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniformMatrix3x4fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniformMatrix4x3fv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniformMatrix2x3dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniformMatrix3x2dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniformMatrix2x4dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniformMatrix4x2dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniformMatrix3x4dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniformMatrix4x3dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glValidateProgramPipeline)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetProgramPipelineInfoLog)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribL1d)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribL2d)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribL3d)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribL4d)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribL1dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribL2dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribL3dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribL4dv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribLPointer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetVertexAttribLdv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glViewportArrayv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glViewportIndexedf)
+UNIENGINE_HEADLESS_ENTRY_POINT(glViewportIndexedfv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glScissorArrayv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glScissorIndexed)
+UNIENGINE_HEADLESS_ENTRY_POINT(glScissorIndexedv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDepthRangeArrayv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDepthRangeIndexed)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetFloati_v)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetDoublei_v)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDrawArraysInstancedBaseInstance)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDrawElementsInstancedBaseInstance)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDrawElementsInstancedBaseVertexBaseInstance)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetInternalformativ)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetActiveAtomicCounterBufferiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBindImageTexture)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMemoryBarrier)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexStorage1D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexStorage2D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexStorage3D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDrawTransformFeedbackInstanced)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDrawTransformFeedbackStreamInstanced)
+UNIENGINE_HEADLESS_ENTRY_POINT(glClearBufferData)
+UNIENGINE_HEADLESS_ENTRY_POINT(glClearBufferSubData)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDispatchCompute)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDispatchComputeIndirect)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCopyImageSubData)
+UNIENGINE_HEADLESS_ENTRY_POINT(glFramebufferParameteri)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetFramebufferParameteriv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetInternalformati64v)
+UNIENGINE_HEADLESS_ENTRY_POINT(glInvalidateTexSubImage)
+UNIENGINE_HEADLESS_ENTRY_POINT(glInvalidateTexImage)
+UNIENGINE_HEADLESS_ENTRY_POINT(glInvalidateBufferSubData)
+UNIENGINE_HEADLESS_ENTRY_POINT(glInvalidateBufferData)
+UNIENGINE_HEADLESS_ENTRY_POINT(glInvalidateFramebuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glInvalidateSubFramebuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMultiDrawArraysIndirect)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMultiDrawElementsIndirect)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetProgramInterfaceiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetProgramResourceIndex)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetProgramResourceName)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetProgramResourceiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetProgramResourceLocation)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetProgramResourceLocationIndex)
+UNIENGINE_HEADLESS_ENTRY_POINT(glShaderStorageBlockBinding)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexBufferRange)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexStorage2DMultisample)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTexStorage3DMultisample)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTextureView)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBindVertexBuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribFormat)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribIFormat)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribLFormat)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribBinding)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexBindingDivisor)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDebugMessageControl)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDebugMessageInsert)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDebugMessageCallback)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetDebugMessageLog)
+UNIENGINE_HEADLESS_ENTRY_POINT(glPushDebugGroup)
+UNIENGINE_HEADLESS_ENTRY_POINT(glPopDebugGroup)
+UNIENGINE_HEADLESS_ENTRY_POINT(glObjectLabel)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetObjectLabel)
+UNIENGINE_HEADLESS_ENTRY_POINT(glObjectPtrLabel)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetObjectPtrLabel)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetPointerv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBufferStorage)
+UNIENGINE_HEADLESS_ENTRY_POINT(glClearTexImage)
+UNIENGINE_HEADLESS_ENTRY_POINT(glClearTexSubImage)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBindBuffersBase)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBindBuffersRange)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBindTextures)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBindSamplers)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBindImageTextures)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBindVertexBuffers)
+UNIENGINE_HEADLESS_ENTRY_POINT(glClipControl)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCreateTransformFeedbacks)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTransformFeedbackBufferBase)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTransformFeedbackBufferRange)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetTransformFeedbackiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetTransformFeedbacki_v)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetTransformFeedbacki64_v)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCreateBuffers)
+UNIENGINE_HEADLESS_ENTRY_POINT(glNamedBufferStorage)
+UNIENGINE_HEADLESS_ENTRY_POINT(glNamedBufferData)
+UNIENGINE_HEADLESS_ENTRY_POINT(glNamedBufferSubData)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCopyNamedBufferSubData)
+UNIENGINE_HEADLESS_ENTRY_POINT(glClearNamedBufferData)
+UNIENGINE_HEADLESS_ENTRY_POINT(glClearNamedBufferSubData)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMapNamedBuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMapNamedBufferRange)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUnmapNamedBuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glFlushMappedNamedBufferRange)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetNamedBufferParameteriv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetNamedBufferParameteri64v)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetNamedBufferPointerv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetNamedBufferSubData)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCreateFramebuffers)
+UNIENGINE_HEADLESS_ENTRY_POINT(glNamedFramebufferRenderbuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glNamedFramebufferParameteri)
+UNIENGINE_HEADLESS_ENTRY_POINT(glNamedFramebufferTexture)
+UNIENGINE_HEADLESS_ENTRY_POINT(glNamedFramebufferTextureLayer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glNamedFramebufferDrawBuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glNamedFramebufferDrawBuffers)
+UNIENGINE_HEADLESS_ENTRY_POINT(glNamedFramebufferReadBuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glInvalidateNamedFramebufferData)
+UNIENGINE_HEADLESS_ENTRY_POINT(glInvalidateNamedFramebufferSubData)
+UNIENGINE_HEADLESS_ENTRY_POINT(glClearNamedFramebufferiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glClearNamedFramebufferuiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glClearNamedFramebufferfv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glClearNamedFramebufferfi)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBlitNamedFramebuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCheckNamedFramebufferStatus)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetNamedFramebufferParameteriv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetNamedFramebufferAttachmentParameteriv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCreateRenderbuffers)
+UNIENGINE_HEADLESS_ENTRY_POINT(glNamedRenderbufferStorage)
+UNIENGINE_HEADLESS_ENTRY_POINT(glNamedRenderbufferStorageMultisample)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetNamedRenderbufferParameteriv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCreateTextures)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTextureBuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTextureBufferRange)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTextureStorage1D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTextureStorage2D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTextureStorage3D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTextureStorage2DMultisample)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTextureStorage3DMultisample)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTextureSubImage1D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTextureSubImage2D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTextureSubImage3D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCompressedTextureSubImage1D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCompressedTextureSubImage2D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCompressedTextureSubImage3D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCopyTextureSubImage1D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCopyTextureSubImage2D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCopyTextureSubImage3D)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTextureParameterf)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTextureParameterfv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTextureParameteri)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTextureParameterIiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTextureParameterIuiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTextureParameteriv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGenerateTextureMipmap)
+UNIENGINE_HEADLESS_ENTRY_POINT(glBindTextureUnit)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetTextureImage)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetCompressedTextureImage)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetTextureLevelParameterfv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetTextureLevelParameteriv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetTextureParameterfv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetTextureParameterIiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetTextureParameterIuiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetTextureParameteriv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCreateVertexArrays)
+UNIENGINE_HEADLESS_ENTRY_POINT(glDisableVertexArrayAttrib)
+UNIENGINE_HEADLESS_ENTRY_POINT(glEnableVertexArrayAttrib)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexArrayElementBuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexArrayVertexBuffer)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexArrayVertexBuffers)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexArrayAttribBinding)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexArrayAttribFormat)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexArrayAttribIFormat)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexArrayAttribLFormat)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexArrayBindingDivisor)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetVertexArrayiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetVertexArrayIndexediv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetVertexArrayIndexed64iv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCreateSamplers)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCreateProgramPipelines)
+UNIENGINE_HEADLESS_ENTRY_POINT(glCreateQueries)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetQueryBufferObjecti64v)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetQueryBufferObjectiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetQueryBufferObjectui64v)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetQueryBufferObjectuiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMemoryBarrierByRegion)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetTextureSubImage)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetCompressedTextureSubImage)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetGraphicsResetStatus)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetnCompressedTexImage)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetnTexImage)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetnUniformdv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetnUniformfv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetnUniformiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetnUniformuiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glReadnPixels)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetnMapdv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetnMapfv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetnMapiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetnPixelMapfv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetnPixelMapuiv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetnPixelMapusv)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetnPolygonStipple)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetnColorTable)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetnConvolutionFilter)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetnSeparableFilter)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetnHistogram)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetnMinmax)
+UNIENGINE_HEADLESS_ENTRY_POINT(glTextureBarrier)
+UNIENGINE_HEADLESS_ENTRY_POINT(glSpecializeShader)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMultiDrawArraysIndirectCount)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMultiDrawElementsIndirectCount)
+UNIENGINE_HEADLESS_ENTRY_POINT(glPolygonOffsetClamp)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetTextureHandleARB)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetTextureSamplerHandleARB)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMakeTextureHandleResidentARB)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMakeTextureHandleNonResidentARB)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetImageHandleARB)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMakeImageHandleResidentARB)
+UNIENGINE_HEADLESS_ENTRY_POINT(glMakeImageHandleNonResidentARB)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniformHandleui64ARB)
+UNIENGINE_HEADLESS_ENTRY_POINT(glUniformHandleui64vARB)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniformHandleui64ARB)
+UNIENGINE_HEADLESS_ENTRY_POINT(glProgramUniformHandleui64vARB)
+UNIENGINE_HEADLESS_ENTRY_POINT(glIsTextureHandleResidentARB)
+UNIENGINE_HEADLESS_ENTRY_POINT(glIsImageHandleResidentARB)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribL1ui64ARB)
+UNIENGINE_HEADLESS_ENTRY_POINT(glVertexAttribL1ui64vARB)
+UNIENGINE_HEADLESS_ENTRY_POINT(glGetVertexAttribLui64vARB)
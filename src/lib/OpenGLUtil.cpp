@@ -20,11 +20,13 @@ void OpenGLUtils::InsertMemoryBarrierByRegion(GLbitfield barriers)
 {
     glMemoryBarrierByRegion(barriers);
 }
-void OpenGLUtils::Init()
+void OpenGLUtils::Init(bool headless)
 {
+    GetInstance().m_headless = headless;
     // glad: load all OpenGL function pointers
     // ---------------------------------------
-    if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress)))
+    const auto loader = headless ? HeadlessProcAddress : reinterpret_cast<GLADloadproc>(glfwGetProcAddress);
+    if (!gladLoadGLLoader(loader))
     {
         UNIENGINE_ERROR("Failed to initialize GLAD");
         exit(-1);
@@ -47,6 +49,11 @@ void OpenGLUtils::Init()
     glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
 }
 
+bool OpenGLUtils::IsHeadless()
+{
+    return GetInstance().m_headless;
+}
+
 GLint OpenGLUtils::GLTexture::m_maxAllowedTexture = 0;
 std::vector<std::pair<GLenum, GLuint>> OpenGLUtils::GLTexture::m_currentBoundTextures;
 std::map<OpenGLUtils::GLBufferTarget, std::map<GLuint, GLuint>> OpenGLUtils::GLBuffer::m_boundBuffers;
@@ -376,6 +383,10 @@ OpenGLUtils::GLBufferTarget OpenGLUtils::GLBuffer::GetTarget() const
 void OpenGLUtils::GLBuffer::SetRange(const GLuint &index, const GLintptr &offset, const GLsizeiptr &size) const
 {
     glBindBufferRange(static_cast<GLenum>(m_target), index, m_id, offset, size);
+    // The slot now holds part of this buffer and the generic binding point all of it, neither matches what Bind caches.
+    auto &boundBuffers = m_boundBuffers[m_target];
+    boundBuffers.erase(index);
+    boundBuffers.erase(0);
 }
 
 OpenGLUtils::GLVAO::~GLVAO()
@@ -462,6 +473,20 @@ void OpenGLUtils::GLVAO::SetAttributeDivisor(const GLuint &index, const GLuint &
     glVertexAttribDivisor(index, divisor);
 }
 
+void OpenGLUtils::GLVAO::SetAttributeConstant(
+    const GLuint &index, const GLint &size, const GLenum &type, const GLintptr &offset)
+{
+    Bind();
+    glEnableVertexAttribArray(index);
+    if (type == GL_FLOAT || type == GL_HALF_FLOAT || type == GL_DOUBLE)
+        glVertexAttribFormat(index, size, type, GL_FALSE, 0);
+    else
+        glVertexAttribIFormat(index, size, type, 0);
+    glVertexAttribBinding(index, index);
+    glVertexBindingDivisor(index, 0);
+    glBindVertexBuffer(index, m_vbo.Id(), offset, 0);
+}
+
 OpenGLUtils::TextureBinding::TextureBinding()
 {
     m_1d = 0;
@@ -0,0 +1,604 @@
+#include <Console.hpp>
+#include <Jobs.hpp>
+#include <PlyReader.hpp>
+#if !(defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__))
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+using namespace UniEngine;
+
+namespace
+{
+// Largest read of a binary file that can not be mapped.
+constexpr size_t FallbackBufferSize = 64 << 20;
+
+bool GetPlyType(const std::string &name, PlyType &type)
+{
+    if (name == "char" || name == "int8")
+        type = PlyType::Int8;
+    else if (name == "uchar" || name == "uint8")
+        type = PlyType::UInt8;
+    else if (name == "short" || name == "int16")
+        type = PlyType::Int16;
+    else if (name == "ushort" || name == "uint16")
+        type = PlyType::UInt16;
+    else if (name == "int" || name == "int32")
+        type = PlyType::Int32;
+    else if (name == "uint" || name == "uint32")
+        type = PlyType::UInt32;
+    else if (name == "float" || name == "float32")
+        type = PlyType::Float32;
+    else if (name == "double" || name == "float64")
+        type = PlyType::Float64;
+    else
+        return false;
+    return true;
+}
+
+size_t GetPlyTypeSize(const PlyType &type)
+{
+    switch (type)
+    {
+    case PlyType::Int8:
+    case PlyType::UInt8:
+        return 1;
+    case PlyType::Int16:
+    case PlyType::UInt16:
+        return 2;
+    case PlyType::Int32:
+    case PlyType::UInt32:
+    case PlyType::Float32:
+        return 4;
+    default:
+        return 8;
+    }
+}
+
+// Integer colors span their whole type, floating point colors are already in [0, 1].
+double GetColorScale(const PlyType &type)
+{
+    switch (type)
+    {
+    case PlyType::Int8:
+        return 1.0 / INT8_MAX;
+    case PlyType::UInt8:
+        return 1.0 / UINT8_MAX;
+    case PlyType::Int16:
+        return 1.0 / INT16_MAX;
+    case PlyType::UInt16:
+        return 1.0 / UINT16_MAX;
+    case PlyType::Int32:
+        return 1.0 / INT32_MAX;
+    case PlyType::UInt32:
+        return 1.0 / UINT32_MAX;
+    default:
+        return 1.0;
+    }
+}
+
+template <typename T, bool Swap> T LoadValue(const char *data)
+{
+    T value;
+    if constexpr (Swap)
+    {
+        char bytes[sizeof(T)];
+        for (size_t i = 0; i < sizeof(T); i++)
+            bytes[i] = data[sizeof(T) - 1 - i];
+        std::memcpy(&value, bytes, sizeof(T));
+    }
+    else
+        std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+template <typename T, bool Swap, typename Write>
+void ReadColumn(const char *data, const size_t &step, const size_t &amount, const Write &write)
+{
+    for (size_t i = 0; i < amount; i++)
+        write(i, static_cast<double>(LoadValue<T, Swap>(data + i * step)));
+}
+
+// Call write(i, value) with the value of the property of amount vertices, step bytes apart, starting at data.
+template <typename Write>
+void ReadColumn(
+    const PlyProperty &property, const char *data, const size_t &step, const size_t &amount, const bool &swap,
+    const Write &write)
+{
+    data += property.m_offset;
+    switch (property.m_type)
+    {
+    case PlyType::Int8:
+        return ReadColumn<int8_t, false>(data, step, amount, write);
+    case PlyType::UInt8:
+        return ReadColumn<uint8_t, false>(data, step, amount, write);
+    case PlyType::Int16:
+        return swap ? ReadColumn<int16_t, true>(data, step, amount, write)
+                    : ReadColumn<int16_t, false>(data, step, amount, write);
+    case PlyType::UInt16:
+        return swap ? ReadColumn<uint16_t, true>(data, step, amount, write)
+                    : ReadColumn<uint16_t, false>(data, step, amount, write);
+    case PlyType::Int32:
+        return swap ? ReadColumn<int32_t, true>(data, step, amount, write)
+                    : ReadColumn<int32_t, false>(data, step, amount, write);
+    case PlyType::UInt32:
+        return swap ? ReadColumn<uint32_t, true>(data, step, amount, write)
+                    : ReadColumn<uint32_t, false>(data, step, amount, write);
+    case PlyType::Float32:
+        return swap ? ReadColumn<float, true>(data, step, amount, write)
+                    : ReadColumn<float, false>(data, step, amount, write);
+    case PlyType::Float64:
+        return swap ? ReadColumn<double, true>(data, step, amount, write)
+                    : ReadColumn<double, false>(data, step, amount, write);
+    }
+}
+
+void SetColor(glm::vec4 &color, const int &channel, const double &value)
+{
+    color[channel] = static_cast<float>(value);
+}
+
+void SetColor(glm::u8vec4 &color, const int &channel, const double &value)
+{
+    color[channel] = static_cast<unsigned char>(glm::clamp(value * 255.0 + 0.5, 0.0, 255.0));
+}
+
+template <typename Color> Color GetWhite();
+template <> glm::vec4 GetWhite()
+{
+    return glm::vec4(1.0f);
+}
+template <> glm::u8vec4 GetWhite()
+{
+    return glm::u8vec4(255);
+}
+} // namespace
+
+#pragma region Mapping
+struct PlyReader::MappedFile
+{
+    const char *m_data = nullptr;
+    size_t m_size = 0;
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+
+    bool Open(const std::filesystem::path &path)
+    {
+        m_file = CreateFileW(
+            path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+            return false;
+        m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m_mapping)
+            return false;
+        m_data = static_cast<const char *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        m_size = static_cast<size_t>(size.QuadPart);
+        return m_data != nullptr;
+    }
+
+    ~MappedFile()
+    {
+        if (m_data)
+            UnmapViewOfFile(m_data);
+        if (m_mapping)
+            CloseHandle(m_mapping);
+        if (m_file != INVALID_HANDLE_VALUE)
+            CloseHandle(m_file);
+    }
+#else
+    int m_descriptor = -1;
+
+    bool Open(const std::filesystem::path &path)
+    {
+        m_descriptor = open(path.c_str(), O_RDONLY);
+        if (m_descriptor == -1)
+            return false;
+        struct stat status;
+        if (fstat(m_descriptor, &status) != 0 || status.st_size == 0)
+            return false;
+        void *data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, m_descriptor, 0);
+        if (data == MAP_FAILED)
+            return false;
+        m_data = static_cast<const char *>(data);
+        m_size = static_cast<size_t>(status.st_size);
+        madvise(data, m_size, MADV_SEQUENTIAL);
+        return true;
+    }
+
+    ~MappedFile()
+    {
+        if (m_data)
+            munmap(const_cast<char *>(m_data), m_size);
+        if (m_descriptor != -1)
+            close(m_descriptor);
+    }
+#endif
+};
+#pragma endregion
+
+PlyReader::PlyReader() = default;
+
+PlyReader::~PlyReader() = default;
+
+void PlyReader::Close()
+{
+    m_mappedFile.reset();
+    m_stream = std::ifstream();
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+    m_path.clear();
+    m_format = PlyFormat::Ascii;
+    m_dataBegin = 0;
+    m_skippedLines = 0;
+    m_nextLine = 0;
+    m_vertexAmount = 0;
+    m_vertexSize = 0;
+    m_properties.clear();
+    std::fill(std::begin(m_position), std::end(m_position), -1);
+    std::fill(std::begin(m_normal), std::end(m_normal), -1);
+    std::fill(std::begin(m_color), std::end(m_color), -1);
+}
+
+bool PlyReader::Open(const std::filesystem::path &path, std::string &error)
+{
+    Close();
+    m_stream.open(path, std::ios::binary);
+    if (!m_stream)
+    {
+        error = "failed to open the file";
+        return false;
+    }
+    std::string line;
+    std::getline(m_stream, line);
+    if (line.rfind("ply", 0) != 0)
+    {
+        error = "not a PLY file";
+        return false;
+    }
+    std::string element;
+    size_t elementAmount = 0;
+    size_t elementSize = 0;
+    bool elementHasList = false;
+    bool vertexFound = false;
+    size_t skippedBytes = 0;
+    const auto finishElement = [&]() -> bool {
+        if (element.empty() || element == "vertex" || vertexFound)
+            return true;
+        if (elementHasList)
+        {
+            error = "element " + element + " with lists before the vertices is not supported";
+            return false;
+        }
+        skippedBytes += elementAmount * elementSize;
+        m_skippedLines += elementAmount;
+        return true;
+    };
+    bool headerEnded = false;
+    while (std::getline(m_stream, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        std::istringstream tokens(line);
+        std::string keyword;
+        tokens >> keyword;
+        if (keyword == "format")
+        {
+            std::string format;
+            tokens >> format;
+            if (format == "ascii")
+                m_format = PlyFormat::Ascii;
+            else if (format == "binary_little_endian")
+                m_format = PlyFormat::BinaryLittleEndian;
+            else if (format == "binary_big_endian")
+                m_format = PlyFormat::BinaryBigEndian;
+            else
+            {
+                error = "unknown format " + format;
+                return false;
+            }
+        }
+        else if (keyword == "element")
+        {
+            if (!finishElement())
+                return false;
+            if (element == "vertex")
+                vertexFound = true;
+            tokens >> element >> elementAmount;
+            elementSize = 0;
+            elementHasList = false;
+            if (element == "vertex" && !vertexFound)
+                m_vertexAmount = elementAmount;
+        }
+        else if (keyword == "property")
+        {
+            std::string typeName;
+            tokens >> typeName;
+            const bool vertexProperty = element == "vertex" && !vertexFound;
+            if (typeName == "list")
+            {
+                elementHasList = true;
+                if (vertexProperty)
+                {
+                    error = "list properties of vertices are not supported";
+                    return false;
+                }
+                continue;
+            }
+            PlyProperty property;
+            tokens >> property.m_name;
+            if (!GetPlyType(typeName, property.m_type))
+            {
+                error = "unknown property type " + typeName;
+                return false;
+            }
+            if (vertexProperty)
+            {
+                property.m_offset = elementSize;
+                property.m_index = m_properties.size();
+                m_properties.push_back(property);
+            }
+            elementSize += GetPlyTypeSize(property.m_type);
+            if (vertexProperty)
+                m_vertexSize = elementSize;
+        }
+        else if (keyword == "end_header")
+        {
+            headerEnded = true;
+            break;
+        }
+    }
+    if (!headerEnded)
+    {
+        error = "the header has no end";
+        return false;
+    }
+    if (!finishElement())
+        return false;
+    for (size_t i = 0; i < m_properties.size(); i++)
+    {
+        const auto &name = m_properties[i].m_name;
+        const int index = static_cast<int>(i);
+        if (name == "x")
+            m_position[0] = index;
+        else if (name == "y")
+            m_position[1] = index;
+        else if (name == "z")
+            m_position[2] = index;
+        else if (name == "nx")
+            m_normal[0] = index;
+        else if (name == "ny")
+            m_normal[1] = index;
+        else if (name == "nz")
+            m_normal[2] = index;
+        else if (name == "red" || name == "r")
+            m_color[0] = index;
+        else if (name == "green" || name == "g")
+            m_color[1] = index;
+        else if (name == "blue" || name == "b")
+            m_color[2] = index;
+        else if (name == "alpha" || name == "a")
+            m_color[3] = index;
+    }
+
+    if (m_format == PlyFormat::Ascii)
+    {
+        for (size_t i = 0; i < m_skippedLines; i++)
+            m_stream.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
+        m_dataBegin = static_cast<size_t>(m_stream.tellg());
+        m_nextLine = 0;
+    }
+    else
+    {
+        m_dataBegin = static_cast<size_t>(m_stream.tellg()) + skippedBytes;
+        const size_t end = m_dataBegin + m_vertexAmount * m_vertexSize;
+        if (std::filesystem::file_size(path) < end)
+        {
+            error = "the file ends before its last vertex";
+            return false;
+        }
+        m_mappedFile = std::make_unique<MappedFile>();
+        if (m_mappedFile->Open(path))
+            m_stream = std::ifstream();
+        else
+            m_mappedFile.reset();
+    }
+    m_path = path;
+    return true;
+}
+
+PlyFormat PlyReader::GetFormat() const
+{
+    return m_format;
+}
+
+size_t PlyReader::GetVertexAmount() const
+{
+    return m_vertexAmount;
+}
+
+const std::vector<PlyProperty> &PlyReader::GetProperties() const
+{
+    return m_properties;
+}
+
+bool PlyReader::IsMapped() const
+{
+    return m_mappedFile != nullptr;
+}
+
+bool PlyReader::HasPositions() const
+{
+    return m_position[0] != -1 && m_position[1] != -1 && m_position[2] != -1;
+}
+
+bool PlyReader::HasNormals() const
+{
+    return m_normal[0] != -1 && m_normal[1] != -1 && m_normal[2] != -1;
+}
+
+bool PlyReader::HasColors() const
+{
+    return m_color[0] != -1 && m_color[1] != -1 && m_color[2] != -1;
+}
+
+const char *PlyReader::GetBinaryData(const size_t &first, const size_t &amount)
+{
+    const size_t begin = m_dataBegin + first * m_vertexSize;
+    if (m_mappedFile)
+        return m_mappedFile->m_data + begin;
+    m_buffer.resize(amount * m_vertexSize);
+    m_stream.clear();
+    m_stream.seekg(static_cast<std::streamoff>(begin));
+    m_stream.read(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+    return m_stream ? m_buffer.data() : nullptr;
+}
+
+void PlyReader::SeekLine(const size_t &vertex)
+{
+    if (vertex < m_nextLine)
+    {
+        m_stream.clear();
+        m_stream.seekg(static_cast<std::streamoff>(m_dataBegin));
+        m_nextLine = 0;
+    }
+    for (; m_nextLine < vertex; m_nextLine++)
+        m_stream.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
+}
+
+template <typename Color>
+size_t PlyReader::ReadVertices(
+    const PlyReadSettings &settings,
+    std::vector<glm::dvec3> &positions,
+    std::vector<glm::dvec3> *normals,
+    std::vector<Color> &colors)
+{
+    const size_t stride = (std::max)(settings.m_stride, static_cast<size_t>(1));
+    const size_t amount = settings.m_first >= m_vertexAmount
+                              ? 0
+                              : (std::min)(settings.m_amount, (m_vertexAmount - settings.m_first + stride - 1) / stride);
+    const bool readPositions = settings.m_positions && HasPositions();
+    const bool readNormals = normals && settings.m_normals && HasNormals();
+    const bool readColors = settings.m_colors && HasColors();
+    positions.resize(readPositions ? amount : 0);
+    if (normals)
+        normals->resize(readNormals ? amount : 0);
+    colors.resize(readColors ? amount : 0);
+    if (readColors && m_color[3] == -1)
+        std::fill(colors.begin(), colors.end(), GetWhite<Color>());
+    const int colorChannels = m_color[3] == -1 ? 3 : 4;
+    if (amount == 0 || m_path.empty())
+        return 0;
+    if (!readPositions && !readNormals && !readColors)
+        return amount;
+    const auto fail = [&]() -> size_t {
+        UNIENGINE_ERROR("Failed to read " + m_path.string() + ": the file ended early");
+        positions.clear();
+        if (normals)
+            normals->clear();
+        colors.clear();
+        m_nextLine = SIZE_MAX;
+        return 0;
+    };
+
+    if (m_format == PlyFormat::Ascii)
+    {
+        std::string line;
+        std::vector<double> values(m_properties.size());
+        for (size_t i = 0; i < amount; i++)
+        {
+            SeekLine(settings.m_first + i * stride);
+            if (!std::getline(m_stream, line))
+                return fail();
+            m_nextLine++;
+            const char *begin = line.c_str();
+            for (auto &value : values)
+            {
+                char *end;
+                value = std::strtod(begin, &end);
+                if (end == begin)
+                    return fail();
+                begin = end;
+            }
+            for (int c = 0; c < 3; c++)
+            {
+                if (readPositions)
+                    positions[i][c] = values[m_position[c]];
+                if (readNormals)
+                    (*normals)[i][c] = values[m_normal[c]];
+            }
+            if (readColors)
+                for (int c = 0; c < colorChannels; c++)
+                    SetColor(colors[i], c, values[m_color[c]] * GetColorScale(m_properties[m_color[c]].m_type));
+        }
+        return amount;
+    }
+
+    // Vertices are converted a block at a time from the mapping, or from the buffer when the file is not mapped, and
+    // every block is split into chunks that convert their vertices one property at a time.
+    const size_t step = stride * m_vertexSize;
+    const size_t blockAmount = m_mappedFile ? amount : (std::max)(FallbackBufferSize / step, static_cast<size_t>(1));
+    const bool swap = m_format == PlyFormat::BinaryBigEndian;
+    const size_t chunkAmount = static_cast<size_t>((std::max)(Jobs::Workers().Size(), 1)) * 4;
+    std::vector<std::shared_future<void>> results;
+    for (size_t blockBegin = 0; blockBegin < amount; blockBegin += blockAmount)
+    {
+        const size_t blockSize = (std::min)(blockAmount, amount - blockBegin);
+        const char *data = GetBinaryData(settings.m_first + blockBegin * stride, (blockSize - 1) * stride + 1);
+        if (!data)
+            return fail();
+        const size_t chunkSize = (blockSize + chunkAmount - 1) / chunkAmount;
+        Jobs::ParallelFor(
+            static_cast<unsigned>((blockSize + chunkSize - 1) / chunkSize),
+            [&](unsigned chunk) {
+                const size_t begin = chunk * chunkSize;
+                const size_t size = (std::min)(chunkSize, blockSize - begin);
+                const char *chunkData = data + begin * step;
+                const size_t first = blockBegin + begin;
+                for (int c = 0; c < 3; c++)
+                {
+                    if (readPositions)
+                        ReadColumn(m_properties[m_position[c]], chunkData, step, size, swap, [&](size_t i, double value) {
+                            positions[first + i][c] = value;
+                        });
+                    if (readNormals)
+                        ReadColumn(m_properties[m_normal[c]], chunkData, step, size, swap, [&](size_t i, double value) {
+                            (*normals)[first + i][c] = value;
+                        });
+                }
+                if (readColors)
+                    for (int c = 0; c < colorChannels; c++)
+                    {
+                        const auto &property = m_properties[m_color[c]];
+                        const double scale = GetColorScale(property.m_type);
+                        ReadColumn(property, chunkData, step, size, swap, [&](size_t i, double value) {
+                            SetColor(colors[first + i], c, value * scale);
+                        });
+                    }
+            },
+            results);
+        for (const auto &i : results)
+            i.wait();
+        results.clear();
+    }
+    return amount;
+}
+
+size_t PlyReader::Read(
+    const PlyReadSettings &settings,
+    std::vector<glm::dvec3> &positions,
+    std::vector<glm::dvec3> &normals,
+    std::vector<glm::vec4> &colors)
+{
+    return ReadVertices(settings, positions, &normals, colors);
+}
+
+size_t PlyReader::Read(
+    const PlyReadSettings &settings, std::vector<glm::dvec3> &positions, std::vector<glm::u8vec4> &colors)
+{
+    return ReadVertices<glm::u8vec4>(settings, positions, nullptr, colors);
+}
@@ -12,6 +12,7 @@
 #include "Graphics.hpp"
 #include "EditorLayer.hpp"
 #include "ClassRegistry.hpp"
+#include "Jobs.hpp"
 using namespace UniEngine;
 using namespace tinyply;
 
@@ -19,206 +20,23 @@ AssetRegistration<PointCloud> PointCloudRegistry("PointCloud", {".uepc"});
 
 void PointCloud::Load(const std::filesystem::path &path)
 {
-    std::unique_ptr<std::istream> file_stream;
-    std::vector<uint8_t> byte_buffer;
-
-    try
-    {
-        file_stream.reset(new std::ifstream(path.string(), std::ios::binary));
-
-        if (!file_stream || file_stream->fail())
-            throw std::runtime_error("file_stream failed to open " + path.string());
-
-        file_stream->seekg(0, std::ios::end);
-        const float size_mb = file_stream->tellg() * float(1e-6);
-        file_stream->seekg(0, std::ios::beg);
-
-        PlyFile file;
-        file.parse_header(*file_stream);
-
-        std::cout << "\t[ply_header] Type: " << (file.is_binary_file() ? "binary" : "ascii") << std::endl;
-        for (const auto &c : file.get_comments())
-            std::cout << "\t[ply_header] Comment: " << c << std::endl;
-        for (const auto &c : file.get_info())
-            std::cout << "\t[ply_header] Info: " << c << std::endl;
-
-        for (const auto &e : file.get_elements())
-        {
-            std::cout << "\t[ply_header] element: " << e.name << " (" << e.size << ")" << std::endl;
-            for (const auto &p : e.properties)
-            {
-                std::cout << "\t[ply_header] \tproperty: " << p.name
-                          << " (type=" << tinyply::PropertyTable[p.propertyType].str << ")";
-                if (p.isList)
-                    std::cout << " (list_type=" << tinyply::PropertyTable[p.listType].str << ")";
-                std::cout << std::endl;
-            }
-        }
-
-        // Because most people have their own mesh types, tinyply treats parsed data as structured/typed byte buffers.
-        // See examples below on how to marry your own application-specific data structures with this one.
-        std::shared_ptr<PlyData> vertices, normals, colors, texcoords, faces, tripstrip;
-
-        // The header information can be used to programmatically extract properties on elements
-        // known to exist in the header prior to reading the data. For brevity of this sample, properties
-        // like vertex position are hard-coded:
-        try
-        {
-            vertices = file.request_properties_from_element("vertex", {"x", "y", "z"});
-        }
-        catch (const std::exception &e)
-        {
-            std::cerr << "tinyply exception: " << e.what() << std::endl;
-        }
-
-        try
-        {
-            normals = file.request_properties_from_element("vertex", {"nx", "ny", "nz"});
-        }
-        catch (const std::exception &e)
-        {
-            std::cerr << "tinyply exception: " << e.what() << std::endl;
-        }
-
-        try
-        {
-            colors = file.request_properties_from_element("vertex", {"red", "green", "blue"});
-        }
-        catch (const std::exception &e)
-        {
-            std::cerr << "tinyply exception: " << e.what() << std::endl;
-        }
-
-        try
-        {
-            colors = file.request_properties_from_element("vertex", {"r", "g", "b", "a"});
-        }
-        catch (const std::exception &e)
-        {
-            std::cerr << "tinyply exception: " << e.what() << std::endl;
-        }
-
-        try
-        {
-            texcoords = file.request_properties_from_element("vertex", {"u", "v"});
-        }
-        catch (const std::exception &e)
-        {
-            std::cerr << "tinyply exception: " << e.what() << std::endl;
-        }
-
-        // Providing a list size hint (the last argument) is a 2x performance improvement. If you have
-        // arbitrary ply files, it is best to leave this 0.
-        try
-        {
-            faces = file.request_properties_from_element("face", {"vertex_indices"}, 3);
-        }
-        catch (const std::exception &e)
-        {
-            std::cerr << "tinyply exception: " << e.what() << std::endl;
-        }
-
-        // Tristrips must always be read with a 0 list size hint (unless you know exactly how many elements
-        // are specifically in the file, which is unlikely);
-        try
-        {
-            tripstrip = file.request_properties_from_element("tristrips", {"vertex_indices"}, 0);
-        }
-        catch (const std::exception &e)
-        {
-            std::cerr << "tinyply exception: " << e.what() << std::endl;
-        }
-        file.read(*file_stream);
-        if (vertices)
-        {
-            m_hasPositions = true;
-            std::cout << "\tRead " << vertices->count << " total vertices " << std::endl;
-        }else{
-            m_hasPositions = false;
-        }
-        if (normals)
-        {
-            std::cout << "\tRead " << normals->count << " total vertex normals " << std::endl;
-            m_hasNormals = true;
-        }else m_hasNormals = false;
-        if (colors)
-        {
-            std::cout << "\tRead " << colors->count << " total vertex colors " << std::endl;
-            m_hasColors = true;
-        }else{
-            m_hasColors = false;
-        }
-        if(m_hasPositions)
-        {
-            // Example One: converting to your own application types
-            const size_t numVerticesBytes = vertices->buffer.size_bytes();
-            if (vertices->t == tinyply::Type::FLOAT64)
-            {
-                std::vector<glm::dvec3> points;
-                points.resize(vertices->count);
-                m_points.resize(vertices->count);
-                std::memcpy(points.data(), vertices->buffer.get(), numVerticesBytes);
-                for (int i = 0; i < vertices->count; i++)
-                {
-                    m_points[i].x = points[i].x;
-                    m_points[i].y = points[i].y;
-                    m_points[i].z = points[i].z;
-                }
-            }
-            else if (vertices->t == tinyply::Type::FLOAT32)
-            {
-                std::vector<glm::vec3> points;
-                points.resize(vertices->count);
-                m_points.resize(vertices->count);
-                std::memcpy(points.data(), vertices->buffer.get(), numVerticesBytes);
-
-                for (int i = 0; i < vertices->count; i++)
-                {
-                    m_points[i].x = points[i].x;
-                    m_points[i].y = points[i].y;
-                    m_points[i].z = points[i].z;
-                }
-            }
-        }
-        if(m_hasColors)
-        {
-            const size_t numVerticesBytes = colors->buffer.size_bytes();
-            if (colors->t == tinyply::Type::UINT8)
-            {
-                std::vector<unsigned char> points;
-                points.resize(colors->count * 3);
-                m_colors.resize(colors->count);
-                std::memcpy(points.data(), colors->buffer.get(), numVerticesBytes);
-                for (int i = 0; i < colors->count; i++)
-                {
-                    m_colors[i].x = points[3 * i] / 255.0f;
-                    m_colors[i].y = points[3 * i + 1] / 255.0f;
-                    m_colors[i].z = points[3 * i + 2] / 255.0f;
-                    m_colors[i].w = 1.0f;
-                }
-            }
-            else if (colors->t == tinyply::Type::FLOAT32)
-            {
-                std::vector<glm::vec3> points;
-                points.resize(colors->count);
-                m_colors.resize(colors->count);
-                std::memcpy(points.data(), colors->buffer.get(), numVerticesBytes);
+    Load(path, PlyReadSettings());
+}
 
-                for (int i = 0; i < colors->count; i++)
-                {
-                    m_colors[i].x = points[i].x;
-                    m_colors[i].y = points[i].y;
-                    m_colors[i].z = points[i].z;
-                    m_colors[i].w = 1.0f;
-                }
-            }
-        }
-        RecalculateBoundingBox();
-    }
-    catch (const std::exception &e)
+void PointCloud::Load(const std::filesystem::path &path, const PlyReadSettings &settings)
+{
+    PlyReader reader;
+    std::string error;
+    if (!reader.Open(path, error))
     {
-        std::cerr << "Caught tinyply exception: " << e.what() << std::endl;
+        UNIENGINE_ERROR("Failed to load " + path.string() + ": " + error);
+        return;
     }
+    reader.Read(settings, m_points, m_normals, m_colors);
+    m_hasPositions = !m_points.empty();
+    m_hasNormals = !m_normals.empty();
+    m_hasColors = !m_colors.empty();
+    RecalculateBoundingBox();
 }
 
 void PointCloud::OnCreate()
@@ -253,11 +71,17 @@ void PointCloud::OnInspect()
         ApplyOriginal();
     }
 
+    static PlyReadSettings loadSettings;
+    static int loadStride = 1;
+    ImGui::Checkbox("Load normals", &loadSettings.m_normals);
+    ImGui::Checkbox("Load colors", &loadSettings.m_colors);
+    ImGui::DragInt("Load every nth point", &loadStride, 1, 1, 1000);
+    loadSettings.m_stride = static_cast<size_t>((std::max)(loadStride, 1));
     FileUtils::OpenFile(
         ("Load PLY file##Particles"), "PointCloud", {".ply"}, [&](const std::filesystem::path &filePath) {
             try
             {
-                Load(filePath);
+                Load(filePath, loadSettings);
                 UNIENGINE_LOG("Loaded from " + filePath.string());
             }
             catch (std::exception &e)
@@ -279,6 +103,41 @@ void PointCloud::OnInspect()
         }, false);
     if (ImGui::Button("Clear all points"))
         m_points.clear();
+
+    static int neighbourAmount = 16;
+    static float stdRatio = 2.0f;
+    ImGui::DragInt("Neighbours", &neighbourAmount, 1, 3, 256);
+    if (ImGui::Button("Estimate normals"))
+        EstimateNormals(neighbourAmount);
+    ImGui::DragFloat("Outlier std ratio", &stdRatio, 0.01f, 0.1f, 10.0f);
+    if (ImGui::Button("Remove outliers"))
+        RemoveStatisticalOutliers(neighbourAmount, stdRatio);
+
+    if (ImGui::TreeNode("Octree"))
+    {
+        FileUtils::OpenFile(
+            ("Build octree from PLY##PointCloudOctree"), "PointCloud", {".ply"}, [&](const std::filesystem::path &filePath) {
+                const auto directory = filePath.parent_path() / (filePath.stem().string() + "_octree");
+                if (!PointCloudOctree::Build(filePath, directory))
+                    return;
+                m_octree = std::make_shared<PointCloudOctree>();
+                if (!m_octree->Open(directory))
+                    m_octree.reset();
+            }, false);
+        FileUtils::OpenFolder(
+            ("Open octree##PointCloudOctree"), [&](const std::filesystem::path &directory) {
+                m_octree = std::make_shared<PointCloudOctree>();
+                if (!m_octree->Open(directory))
+                    m_octree.reset();
+            }, false);
+        if (m_octree)
+        {
+            m_octree->OnInspect();
+            if (ImGui::Button("Close octree"))
+                m_octree.reset();
+        }
+        ImGui::TreePop();
+    }
 }
 void PointCloud::ApplyCompressed()
 {
@@ -291,85 +150,388 @@ void PointCloud::ApplyCompressed()
     auto particleMatrices = particles->m_matrices;
     std::vector<glm::mat4> matrices;
     auto compressed = std::vector<glm::dvec3>();
-    Compress(compressed);
+    std::vector<glm::dvec3> normals;
+    std::vector<glm::vec4> colors;
+    Compress(compressed, normals, colors);
     matrices.resize(compressed.size());
     for (int i = 0; i < matrices.size(); i++)
     {
         matrices[i] = glm::translate((glm::vec3)(compressed[i] + m_offset)) * glm::scale(glm::vec3(m_pointSize));
     }
-    particleMatrices->SetValue(m_colors, matrices);
+    colors.resize(compressed.size(), glm::vec4(1.0f));
+    particleMatrices->SetValue(colors, matrices);
     particleMatrices->Update();
 }
-void PointCloud::Compress(std::vector<glm::dvec3> &points)
+namespace
 {
-    RecalculateBoundingBox();
-    if (m_compressFactor == 0)
+// Points are binned a block at a time, so the scratch memory does not grow with the point cloud.
+constexpr size_t CompressBlockSize = 1 << 20;
+
+struct VoxelKey
+{
+    int64_t m_x;
+    int64_t m_y;
+    int64_t m_z;
+    bool operator==(const VoxelKey &other) const
     {
-        UNIENGINE_ERROR("Resolution invalid!");
-        return;
+        return m_x == other.m_x && m_y == other.m_y && m_z == other.m_z;
     }
-    points.clear();
+};
 
-    double xMin = m_min.x - std::fmod(m_min.x, m_compressFactor) - (m_min.x < 0 ? m_compressFactor : 0);
-    double yMin = m_min.y - std::fmod(m_min.y, m_compressFactor) - (m_min.y < 0 ? m_compressFactor : 0);
-    double zMin = m_min.z - std::fmod(m_min.z, m_compressFactor) - (m_min.z < 0 ? m_compressFactor : 0);
+struct VoxelKeyHash
+{
+    size_t operator()(const VoxelKey &key) const
+    {
+        uint64_t hash = static_cast<uint64_t>(key.m_x) * 0x9E3779B97F4A7C15ull ^
+                        static_cast<uint64_t>(key.m_y) * 0xC2B2AE3D27D4EB4Full ^
+                        static_cast<uint64_t>(key.m_z) * 0x165667B19E3779F9ull;
+        hash ^= hash >> 31;
+        hash *= 0xBF58476D1CE4E5B9ull;
+        hash ^= hash >> 29;
+        return static_cast<size_t>(hash);
+    }
+};
 
-    double xMax = m_max.x - std::fmod(m_max.x, m_compressFactor) + (m_max.x > 0 ? m_compressFactor : 0);
-    double yMax = m_max.y - std::fmod(m_max.y, m_compressFactor) + (m_max.y > 0 ? m_compressFactor : 0);
-    double zMax = m_max.z - std::fmod(m_max.z, m_compressFactor) + (m_max.z > 0 ? m_compressFactor : 0);
+// Sums of the cells of one partition, owned by a single job while binning. Normals and colors stay empty when the
+// point cloud has none.
+struct VoxelPartition
+{
+    std::unordered_map<VoxelKey, size_t, VoxelKeyHash> m_indices;
+    std::vector<glm::dvec3> m_positions;
+    std::vector<glm::dvec3> m_normals;
+    std::vector<glm::dvec4> m_colors;
+    std::vector<size_t> m_amounts;
+};
+
+VoxelKey GetVoxelKey(const glm::dvec3 &point, const double &voxelSize)
+{
+    return {
+        static_cast<int64_t>(std::floor(point.x / voxelSize)),
+        static_cast<int64_t>(std::floor(point.y / voxelSize)),
+        static_cast<int64_t>(std::floor(point.z / voxelSize))};
+}
 
-    UNIENGINE_LOG(
-        "X, Y, Z MIN: [" + std::to_string(xMin) + ", " + std::to_string(yMin) + ", " + std::to_string(zMin) + "]");
-    UNIENGINE_LOG(
-        "X, Y, Z MAX: [" + std::to_string(xMax) + ", " + std::to_string(yMax) + ", " + std::to_string(zMax) + "]");
+// The low bits pick the bucket inside the map of the partition, so the partition comes from the high bits.
+size_t GetVoxelPartition(const VoxelKey &key, const size_t &partitionAmount)
+{
+    return (VoxelKeyHash()(key) >> 40) % partitionAmount;
+}
+} // namespace
 
-    std::vector<int> voxels;
-    int rangeX = (int)(((xMax - xMin) / (double)m_compressFactor));
-    int rangeY = (int)(((yMax - yMin) / (double)m_compressFactor));
-    int rangeZ = (int)(((zMax - zMin) / (double)m_compressFactor));
-    int voxelSize = (rangeX + 1) * (rangeY + 1) * (rangeZ + 1);
+void PointCloud::Compress(std::vector<glm::dvec3> &points)
+{
+    std::vector<glm::dvec3> normals;
+    std::vector<glm::vec4> colors;
+    Compress(points, normals, colors);
+}
 
-    if (voxelSize > 1000000000 || voxelSize < 0)
+void PointCloud::Compress(std::vector<glm::dvec3> &points, std::vector<glm::dvec3> &normals, std::vector<glm::vec4> &colors)
+{
+    RecalculateBoundingBox();
+    points.clear();
+    normals.clear();
+    colors.clear();
+    if (m_compressFactor <= 0)
     {
-        UNIENGINE_ERROR("Resolution too small: " + std::to_string(voxelSize));
+        UNIENGINE_ERROR("Resolution invalid!");
         return;
     }
-    else
-    {
-        UNIENGINE_LOG("Voxel size: " + std::to_string(voxelSize));
-    }
-
-    voxels.resize(voxelSize);
-    memset(voxels.data(), 0, voxelSize * sizeof(int));
-
-    for (const auto &i : m_points)
+    const double voxelSize = m_compressFactor;
+    const bool averageNormals = m_hasNormals && m_normals.size() == m_points.size();
+    const bool averageColors = m_hasColors && m_colors.size() == m_points.size();
+
+    const size_t threadAmount = (std::max)(Jobs::Workers().Size(), 1);
+    const size_t partitionAmount = threadAmount;
+    std::vector<VoxelPartition> partitions(partitionAmount);
+    std::vector<unsigned> pointPartitions;
+    std::vector<unsigned> order;
+    // Points of each chunk of the block per partition, then the first slot of the chunk in order.
+    std::vector<size_t> chunkOffsets(threadAmount * partitionAmount);
+    std::vector<size_t> partitionBegins(partitionAmount + 1);
+    std::vector<std::shared_future<void>> results;
+    for (size_t blockBegin = 0; blockBegin < m_points.size(); blockBegin += CompressBlockSize)
     {
-        int posX = (int)(((i.x - m_min.x) / (double)m_compressFactor));
-        int posY = (int)(((i.y - m_min.y) / (double)m_compressFactor));
-        int posZ = (int)(((i.z - m_min.z) / (double)m_compressFactor));
-        auto index = posX * (rangeY + 1) * (rangeZ + 1) + posY * (rangeZ + 1) + posZ;
-        if (index >= voxelSize)
+        const size_t blockSize = (std::min)(CompressBlockSize, m_points.size() - blockBegin);
+        const size_t chunkSize = (blockSize + threadAmount - 1) / threadAmount;
+        pointPartitions.resize(blockSize);
+        order.resize(blockSize);
+        std::fill(chunkOffsets.begin(), chunkOffsets.end(), 0);
+        Jobs::ParallelFor(
+            threadAmount,
+            [&](unsigned chunk) {
+                const size_t end = (std::min)(blockSize, (chunk + 1) * chunkSize);
+                size_t *counts = &chunkOffsets[chunk * partitionAmount];
+                for (size_t i = chunk * chunkSize; i < end; i++)
+                {
+                    const auto partition = static_cast<unsigned>(
+                        GetVoxelPartition(GetVoxelKey(m_points[blockBegin + i], voxelSize), partitionAmount));
+                    pointPartitions[i] = partition;
+                    counts[partition]++;
+                }
+            },
+            results);
+        for (const auto &i : results)
+            i.wait();
+        results.clear();
+        size_t offset = 0;
+        for (size_t partition = 0; partition < partitionAmount; partition++)
         {
-            UNIENGINE_ERROR("Out of range!");
-            continue;
+            partitionBegins[partition] = offset;
+            for (size_t chunk = 0; chunk < threadAmount; chunk++)
+            {
+                const size_t count = chunkOffsets[chunk * partitionAmount + partition];
+                chunkOffsets[chunk * partitionAmount + partition] = offset;
+                offset += count;
+            }
         }
-        voxels[index]++;
+        partitionBegins[partitionAmount] = offset;
+        // Within a partition the points keep their order, so the output does not depend on the scheduling.
+        Jobs::ParallelFor(
+            threadAmount,
+            [&](unsigned chunk) {
+                const size_t end = (std::min)(blockSize, (chunk + 1) * chunkSize);
+                size_t *offsets = &chunkOffsets[chunk * partitionAmount];
+                for (size_t i = chunk * chunkSize; i < end; i++)
+                    order[offsets[pointPartitions[i]]++] = static_cast<unsigned>(i);
+            },
+            results);
+        for (const auto &i : results)
+            i.wait();
+        results.clear();
+        Jobs::ParallelFor(
+            partitionAmount,
+            [&](unsigned partitionIndex) {
+                auto &partition = partitions[partitionIndex];
+                for (size_t i = partitionBegins[partitionIndex]; i < partitionBegins[partitionIndex + 1]; i++)
+                {
+                    const size_t pointIndex = blockBegin + order[i];
+                    const auto &point = m_points[pointIndex];
+                    const auto search = partition.m_indices.emplace(
+                        GetVoxelKey(point, voxelSize), partition.m_amounts.size());
+                    if (search.second)
+                    {
+                        partition.m_positions.emplace_back(0.0);
+                        partition.m_amounts.emplace_back(0);
+                        if (averageNormals)
+                            partition.m_normals.emplace_back(0.0);
+                        if (averageColors)
+                            partition.m_colors.emplace_back(0.0);
+                    }
+                    const size_t voxel = search.first->second;
+                    partition.m_positions[voxel] += point;
+                    partition.m_amounts[voxel]++;
+                    if (averageNormals)
+                        partition.m_normals[voxel] += m_normals[pointIndex];
+                    if (averageColors)
+                        partition.m_colors[voxel] += glm::dvec4(m_colors[pointIndex]);
+                }
+            },
+            results);
+        for (const auto &i : results)
+            i.wait();
+        results.clear();
     }
 
-    for (int x = 0; x <= rangeX; x++)
+    size_t voxelAmount = 0;
+    for (size_t partition = 0; partition < partitionAmount; partition++)
     {
-        for (int y = 0; y <= rangeY; y++)
+        partitionBegins[partition] = voxelAmount;
+        voxelAmount += partitions[partition].m_amounts.size();
+    }
+    points.resize(voxelAmount);
+    if (averageNormals)
+        normals.resize(voxelAmount);
+    if (averageColors)
+        colors.resize(voxelAmount);
+    Jobs::ParallelFor(
+        partitionAmount,
+        [&](unsigned partitionIndex) {
+            auto &partition = partitions[partitionIndex];
+            const size_t begin = partitionBegins[partitionIndex];
+            for (size_t voxel = 0; voxel < partition.m_amounts.size(); voxel++)
+            {
+                const double amount = static_cast<double>(partition.m_amounts[voxel]);
+                points[begin + voxel] = partition.m_positions[voxel] / amount;
+                if (averageNormals)
+                {
+                    const double length = glm::length(partition.m_normals[voxel]);
+                    normals[begin + voxel] = length > 0.0 ? partition.m_normals[voxel] / length : glm::dvec3(0.0);
+                }
+                if (averageColors)
+                    colors[begin + voxel] = glm::vec4(partition.m_colors[voxel] / amount);
+            }
+            partition = VoxelPartition();
+        },
+        results);
+    for (const auto &i : results)
+        i.wait();
+    UNIENGINE_LOG(
+        "Compressed " + std::to_string(m_points.size()) + " points into " + std::to_string(voxelAmount) + " voxels");
+}
+namespace
+{
+// Eigenvector of the smallest eigenvalue of a symmetric matrix, by cyclic Jacobi rotations.
+glm::dvec3 GetSmallestEigenvector(const glm::dmat3 &matrix)
+{
+    double a[3][3];
+    double v[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            a[i][j] = matrix[i][j];
+    const double scale = a[0][0] * a[0][0] + a[1][1] * a[1][1] + a[2][2] * a[2][2];
+    for (int sweep = 0; sweep < 16; sweep++)
+    {
+        const double offDiagonal = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+        if (offDiagonal <= scale * 1e-24)
+            break;
+        for (int p = 0; p < 2; p++)
         {
-            for (int z = 0; z <= rangeZ; z++)
+            for (int q = p + 1; q < 3; q++)
             {
-                auto index = x * (rangeY + 1) * (rangeZ + 1) + y * (rangeZ + 1) + z;
-                if (voxels[index] != 0)
+                if (a[p][q] == 0.0)
+                    continue;
+                const double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+                const double t = (theta >= 0 ? 1.0 : -1.0) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+                const double c = 1.0 / std::sqrt(t * t + 1.0);
+                const double s = t * c;
+                for (int k = 0; k < 3; k++)
                 {
-                    points.push_back(((glm::dvec3(x, y, z)) * (double)m_compressFactor) + m_min);
+                    const double kp = a[k][p];
+                    const double kq = a[k][q];
+                    a[k][p] = c * kp - s * kq;
+                    a[k][q] = s * kp + c * kq;
+                }
+                for (int k = 0; k < 3; k++)
+                {
+                    const double pk = a[p][k];
+                    const double qk = a[q][k];
+                    a[p][k] = c * pk - s * qk;
+                    a[q][k] = s * pk + c * qk;
+                }
+                for (int k = 0; k < 3; k++)
+                {
+                    const double kp = v[k][p];
+                    const double kq = v[k][q];
+                    v[k][p] = c * kp - s * kq;
+                    v[k][q] = s * kp + c * kq;
                 }
             }
         }
     }
+    int smallest = 0;
+    for (int i = 1; i < 3; i++)
+        if (a[i][i] < a[smallest][smallest])
+            smallest = i;
+    return glm::dvec3(v[0][smallest], v[1][smallest], v[2][smallest]);
+}
+} // namespace
+
+void PointCloud::EstimateNormals(const size_t &k)
+{
+    if (m_points.size() < 3)
+    {
+        UNIENGINE_ERROR("Not enough points to estimate normals!");
+        return;
+    }
+    const PointCloudKdTree tree(m_points);
+    const bool orientByNormals = m_hasNormals && m_normals.size() == m_points.size();
+    glm::dvec3 center = glm::dvec3(0.0);
+    for (const auto &point : m_points)
+        center += point;
+    center /= static_cast<double>(m_points.size());
+    std::vector<glm::dvec3> normals(m_points.size());
+    const size_t neighbourAmount = (std::max)(k, static_cast<size_t>(3));
+    std::vector<std::shared_future<void>> results;
+    Jobs::ParallelFor(
+        static_cast<unsigned>(m_points.size()),
+        [&](unsigned i) {
+            thread_local std::vector<unsigned> indices;
+            thread_local std::vector<double> squaredDistances;
+            const auto &point = m_points[i];
+            tree.FindNearest(point, neighbourAmount, indices, squaredDistances);
+            // Relative to the point, so large coordinates do not cost precision.
+            glm::dvec3 mean = glm::dvec3(0.0);
+            for (const auto &index : indices)
+                mean += m_points[index] - point;
+            mean /= static_cast<double>(indices.size());
+            glm::dmat3 covariance = glm::dmat3(0.0);
+            for (const auto &index : indices)
+            {
+                const glm::dvec3 difference = m_points[index] - point - mean;
+                covariance += glm::outerProduct(difference, difference);
+            }
+            glm::dvec3 normal = GetSmallestEigenvector(covariance);
+            const glm::dvec3 reference = orientByNormals ? m_normals[i] : point - center;
+            if (glm::dot(normal, reference) < 0.0)
+                normal = -normal;
+            normals[i] = normal;
+        },
+        results);
+    for (const auto &i : results)
+        i.wait();
+    m_normals = std::move(normals);
+    m_hasNormals = true;
+}
+
+size_t PointCloud::RemoveStatisticalOutliers(const size_t &k, const double &stdRatio)
+{
+    if (m_points.size() < 2 || k == 0)
+        return 0;
+    const PointCloudKdTree tree(m_points);
+    std::vector<double> meanDistances(m_points.size());
+    std::vector<std::shared_future<void>> results;
+    Jobs::ParallelFor(
+        static_cast<unsigned>(m_points.size()),
+        [&](unsigned i) {
+            thread_local std::vector<unsigned> indices;
+            thread_local std::vector<double> squaredDistances;
+            tree.FindNearest(m_points[i], k + 1, indices, squaredDistances);
+            double sum = 0.0;
+            size_t amount = 0;
+            for (size_t j = 0; j < indices.size() && amount < k; j++)
+            {
+                if (indices[j] == i)
+                    continue;
+                sum += std::sqrt(squaredDistances[j]);
+                amount++;
+            }
+            meanDistances[i] = amount == 0 ? 0.0 : sum / static_cast<double>(amount);
+        },
+        results);
+    for (const auto &i : results)
+        i.wait();
+    double mean = 0.0;
+    for (const auto &distance : meanDistances)
+        mean += distance;
+    mean /= static_cast<double>(meanDistances.size());
+    double variance = 0.0;
+    for (const auto &distance : meanDistances)
+        variance += (distance - mean) * (distance - mean);
+    variance /= static_cast<double>(meanDistances.size() - 1);
+    const double threshold = mean + stdRatio * std::sqrt(variance);
+
+    const bool hasNormals = m_normals.size() == m_points.size();
+    const bool hasColors = m_colors.size() == m_points.size();
+    size_t kept = 0;
+    for (size_t i = 0; i < m_points.size(); i++)
+    {
+        if (meanDistances[i] > threshold)
+            continue;
+        m_points[kept] = m_points[i];
+        if (hasNormals)
+            m_normals[kept] = m_normals[i];
+        if (hasColors)
+            m_colors[kept] = m_colors[i];
+        kept++;
+    }
+    const size_t removed = m_points.size() - kept;
+    m_points.resize(kept);
+    if (hasNormals)
+        m_normals.resize(kept);
+    if (hasColors)
+        m_colors.resize(kept);
+    UNIENGINE_LOG("Removed " + std::to_string(removed) + " outliers of " + std::to_string(kept + removed) + " points");
+    return removed;
 }
 void PointCloud::RecalculateBoundingBox()
 {
@@ -396,6 +558,11 @@ void PointCloud::RecalculateBoundingBox()
     }
     m_offset = -m_min;
 }
+size_t PointCloud::GetMemoryUsage() const
+{
+    return m_points.capacity() * sizeof(glm::dvec3) + m_normals.capacity() * sizeof(glm::dvec3) +
+           m_colors.capacity() * sizeof(glm::vec4);
+}
 void PointCloud::Serialize(YAML::Emitter &out)
 {
     out << YAML::Key << "m_offset" << m_offset;
@@ -403,6 +570,15 @@ void PointCloud::Serialize(YAML::Emitter &out)
     out << YAML::Key << "m_compressFactor" << m_compressFactor;
     out << YAML::Key << "m_min" << m_min;
     out << YAML::Key << "m_max" << m_max;
+    if (m_octree)
+    {
+        // Relative to the project when the octree is inside of it, so the project can be moved.
+        const auto directory = std::filesystem::absolute(m_octree->GetDirectory());
+        const auto relativeDirectory = ProjectManager::GetPathRelativeToProject(directory);
+        out << YAML::Key << "m_octreeDirectory"
+            << (relativeDirectory.empty() ? directory.string() : relativeDirectory.string());
+        out << YAML::Key << "m_streamOctree" << m_octree->m_streaming;
+    }
     if (!m_points.empty())
     {
         out << YAML::Key << "m_scatteredPoints" << YAML::Value
@@ -429,6 +605,18 @@ void PointCloud::Deserialize(const YAML::Node &in)
         m_min = in["m_min"].as<glm::dvec3>();
     if (in["m_max"])
         m_max = in["m_max"].as<glm::dvec3>();
+    m_octree.reset();
+    if (in["m_octreeDirectory"])
+    {
+        std::filesystem::path directory = in["m_octreeDirectory"].as<std::string>();
+        if (directory.is_relative())
+            directory = ProjectManager::GetProjectPath().parent_path() / directory;
+        m_octree = std::make_shared<PointCloudOctree>();
+        if (!m_octree->Open(directory))
+            m_octree.reset();
+        else if (in["m_streamOctree"])
+            m_octree->m_streaming = in["m_streamOctree"].as<bool>();
+    }
     if (in["m_scatteredPoints"])
     {
         m_hasPositions = true;
@@ -439,6 +627,16 @@ void PointCloud::Deserialize(const YAML::Node &in)
         m_hasPositions = false;
     }
 
+    if (in["m_normals"])
+    {
+        m_hasNormals = true;
+        auto vertexData = in["m_normals"].as<YAML::Binary>();
+        m_normals.resize(vertexData.size() / sizeof(glm::dvec3));
+        std::memcpy(m_normals.data(), vertexData.data(), vertexData.size());
+    }else{
+        m_hasNormals = false;
+    }
+
     if (in["m_colors"])
     {
         m_hasColors = true;
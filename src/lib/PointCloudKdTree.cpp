@@ -0,0 +1,226 @@
+#include <Jobs.hpp>
+#include <PointCloudKdTree.hpp>
+using namespace UniEngine;
+
+namespace
+{
+thread_local std::vector<std::pair<double, unsigned>> t_heap;
+
+double SquaredDistance(const glm::dvec3 &a, const glm::dvec3 &b)
+{
+    const glm::dvec3 difference = a - b;
+    return glm::dot(difference, difference);
+}
+} // namespace
+
+PointCloudKdTree::PointCloudKdTree(const std::vector<glm::dvec3> &points, const size_t &leafSize)
+{
+    Build(points, leafSize);
+}
+
+void PointCloudKdTree::Clear()
+{
+    m_nodes.clear();
+    m_entries.clear();
+    m_leafDepth = 0;
+}
+
+size_t PointCloudKdTree::GetPointAmount() const
+{
+    return m_entries.size();
+}
+
+size_t PointCloudKdTree::SplitNode(size_t node, size_t begin, size_t end)
+{
+    glm::dvec3 min = m_entries[begin].m_position;
+    glm::dvec3 max = min;
+    for (size_t i = begin + 1; i < end; i++)
+    {
+        min = glm::min(min, m_entries[i].m_position);
+        max = glm::max(max, m_entries[i].m_position);
+    }
+    const glm::dvec3 extent = max - min;
+    const int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+    const size_t middle = begin + (end - begin) / 2;
+    std::nth_element(
+        m_entries.begin() + begin,
+        m_entries.begin() + middle,
+        m_entries.begin() + end,
+        [axis](const Entry &a, const Entry &b) { return a.m_position[axis] < b.m_position[axis]; });
+    m_nodes[node].m_axis = axis;
+    m_nodes[node].m_split = m_entries[middle].m_position[axis];
+    return middle;
+}
+
+void PointCloudKdTree::BuildSubtree(size_t node, int depth, size_t begin, size_t end)
+{
+    if (depth == m_leafDepth)
+        return;
+    const size_t middle = SplitNode(node, begin, end);
+    BuildSubtree(node * 2 + 1, depth + 1, begin, middle);
+    BuildSubtree(node * 2 + 2, depth + 1, middle, end);
+}
+
+void PointCloudKdTree::Build(const std::vector<glm::dvec3> &points, const size_t &leafSize)
+{
+    Clear();
+    if (points.empty())
+        return;
+    const size_t amount = points.size();
+    const size_t capacity = (std::max)(leafSize, static_cast<size_t>(1));
+    // The ranges at the leaf depth hold at most ceil(amount / 2^depth) points.
+    while (((amount + (static_cast<size_t>(1) << m_leafDepth) - 1) >> m_leafDepth) > capacity)
+        m_leafDepth++;
+    m_nodes.resize((static_cast<size_t>(1) << m_leafDepth) - 1);
+    m_entries.resize(amount);
+    for (size_t i = 0; i < amount; i++)
+        m_entries[i] = {points[i], static_cast<unsigned>(i)};
+
+    // Levels with fewer nodes than jobs are split one level at a time, then every job builds whole subtrees, which
+    // keeps the points of a subtree in the cache of one worker.
+    const size_t jobAmount = static_cast<size_t>((std::max)(Jobs::Workers().Size(), 1)) * 4;
+    std::vector<std::pair<size_t, size_t>> ranges = {{0, amount}};
+    std::vector<std::pair<size_t, size_t>> childRanges;
+    std::vector<std::shared_future<void>> results;
+    for (int depth = 0; depth < m_leafDepth; depth++)
+    {
+        const size_t firstNode = (static_cast<size_t>(1) << depth) - 1;
+        if (ranges.size() >= jobAmount)
+        {
+            Jobs::ParallelFor(
+                static_cast<unsigned>(ranges.size()),
+                [&](unsigned i) { BuildSubtree(firstNode + i, depth, ranges[i].first, ranges[i].second); },
+                results);
+            for (const auto &i : results)
+                i.wait();
+            break;
+        }
+        childRanges.resize(ranges.size() * 2);
+        Jobs::ParallelFor(
+            static_cast<unsigned>(ranges.size()),
+            [&](unsigned i) {
+                const size_t middle = SplitNode(firstNode + i, ranges[i].first, ranges[i].second);
+                childRanges[i * 2] = {ranges[i].first, middle};
+                childRanges[i * 2 + 1] = {middle, ranges[i].second};
+            },
+            results);
+        for (const auto &i : results)
+            i.wait();
+        results.clear();
+        std::swap(ranges, childRanges);
+    }
+}
+
+void PointCloudKdTree::SearchNearest(
+    size_t node,
+    int depth,
+    size_t begin,
+    size_t end,
+    const glm::dvec3 &point,
+    size_t k,
+    std::vector<std::pair<double, unsigned>> &heap) const
+{
+    if (depth == m_leafDepth)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            const double squaredDistance = SquaredDistance(m_entries[i].m_position, point);
+            if (heap.size() < k)
+            {
+                heap.emplace_back(squaredDistance, m_entries[i].m_index);
+                std::push_heap(heap.begin(), heap.end());
+            }
+            else if (squaredDistance < heap.front().first)
+            {
+                std::pop_heap(heap.begin(), heap.end());
+                heap.back() = {squaredDistance, m_entries[i].m_index};
+                std::push_heap(heap.begin(), heap.end());
+            }
+        }
+        return;
+    }
+    const auto &current = m_nodes[node];
+    const size_t middle = begin + (end - begin) / 2;
+    const double difference = point[current.m_axis] - current.m_split;
+    // Points equal to the split can be on either side, so the far side is searched when the distance is a tie.
+    if (difference < 0)
+    {
+        SearchNearest(node * 2 + 1, depth + 1, begin, middle, point, k, heap);
+        if (heap.size() < k || difference * difference <= heap.front().first)
+            SearchNearest(node * 2 + 2, depth + 1, middle, end, point, k, heap);
+    }
+    else
+    {
+        SearchNearest(node * 2 + 2, depth + 1, middle, end, point, k, heap);
+        if (heap.size() < k || difference * difference <= heap.front().first)
+            SearchNearest(node * 2 + 1, depth + 1, begin, middle, point, k, heap);
+    }
+}
+
+void PointCloudKdTree::SearchRadius(
+    size_t node,
+    int depth,
+    size_t begin,
+    size_t end,
+    const glm::dvec3 &point,
+    double squaredRadius,
+    std::vector<unsigned> &indices,
+    std::vector<double> &squaredDistances) const
+{
+    if (depth == m_leafDepth)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            const double squaredDistance = SquaredDistance(m_entries[i].m_position, point);
+            if (squaredDistance <= squaredRadius)
+            {
+                indices.push_back(m_entries[i].m_index);
+                squaredDistances.push_back(squaredDistance);
+            }
+        }
+        return;
+    }
+    const auto &current = m_nodes[node];
+    const size_t middle = begin + (end - begin) / 2;
+    const double difference = point[current.m_axis] - current.m_split;
+    if (difference <= 0 || difference * difference <= squaredRadius)
+        SearchRadius(node * 2 + 1, depth + 1, begin, middle, point, squaredRadius, indices, squaredDistances);
+    if (difference >= 0 || difference * difference <= squaredRadius)
+        SearchRadius(node * 2 + 2, depth + 1, middle, end, point, squaredRadius, indices, squaredDistances);
+}
+
+void PointCloudKdTree::FindNearest(
+    const glm::dvec3 &point,
+    const size_t &k,
+    std::vector<unsigned> &indices,
+    std::vector<double> &squaredDistances) const
+{
+    indices.clear();
+    squaredDistances.clear();
+    if (m_entries.empty() || k == 0)
+        return;
+    auto &heap = t_heap;
+    heap.clear();
+    SearchNearest(0, 0, 0, m_entries.size(), point, k, heap);
+    std::sort_heap(heap.begin(), heap.end());
+    indices.resize(heap.size());
+    squaredDistances.resize(heap.size());
+    for (size_t i = 0; i < heap.size(); i++)
+    {
+        squaredDistances[i] = heap[i].first;
+        indices[i] = heap[i].second;
+    }
+}
+
+void PointCloudKdTree::FindInRadius(
+    const glm::dvec3 &point,
+    const double &radius,
+    std::vector<unsigned> &indices,
+    std::vector<double> &squaredDistances) const
+{
+    indices.clear();
+    squaredDistances.clear();
+    if (m_entries.empty() || radius < 0)
+        return;
+    SearchRadius(0, 0, 0, m_entries.size(), point, radius * radius, indices, squaredDistances);
+}
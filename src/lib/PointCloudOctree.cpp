@@ -0,0 +1,766 @@
+#include "PointCloudOctree.hpp"
+#include "Culling.hpp"
+#include "DefaultResources.hpp"
+#include "Jobs.hpp"
+#include "Material.hpp"
+#include "PlyReader.hpp"
+using namespace UniEngine;
+
+namespace
+{
+constexpr size_t ReadBlockSize = 1 << 20;
+// The counting grid has 2^CountingGridLevel cells per axis, chunks are nodes of at most this level unless a cell holds
+// more than the chunk capacity, then its chunk is split while streaming it from disk.
+constexpr int CountingGridLevel = 7;
+// Below this depth a node keeps all its points, so duplicated points end the recursion.
+constexpr int MaxDepth = 24;
+
+#pragma region Build
+struct ChunkPoint
+{
+    glm::dvec3 m_position;
+    glm::u8vec4 m_color;
+};
+
+struct OctreeBuilder
+{
+    const PointCloudOctreeBuildSettings &m_settings;
+    std::filesystem::path m_nodeDirectory;
+    glm::dvec3 m_min;
+    double m_size;
+    std::map<std::string, size_t> m_nodePointAmounts;
+
+    void GetBound(const std::string &name, glm::dvec3 &min, double &size) const
+    {
+        min = m_min;
+        size = m_size;
+        for (size_t i = 1; i < name.size(); i++)
+        {
+            const int child = name[i] - '0';
+            size *= 0.5;
+            min += glm::dvec3(child & 1, (child >> 1) & 1, (child >> 2) & 1) * size;
+        }
+    }
+
+    [[nodiscard]] size_t GetCell(const glm::dvec3 &position, const glm::dvec3 &min, const double &size) const
+    {
+        const auto resolution = static_cast<size_t>(m_settings.m_gridResolution);
+        const glm::dvec3 cell = glm::clamp(
+            glm::floor((position - min) / size * static_cast<double>(resolution)),
+            glm::dvec3(0.0),
+            glm::dvec3(resolution - 1));
+        return static_cast<size_t>(cell.x) + resolution * (static_cast<size_t>(cell.y) + resolution * static_cast<size_t>(cell.z));
+    }
+
+    void WriteNode(const std::string &name, const std::vector<PointCloudOctreePoint> &points)
+    {
+        std::ofstream stream(m_nodeDirectory / (name + ".bin"), std::ios::binary | std::ios::trunc);
+        stream.write(
+            reinterpret_cast<const char *>(points.data()),
+            static_cast<std::streamsize>(points.size() * sizeof(PointCloudOctreePoint)));
+        m_nodePointAmounts[name] = points.size();
+    }
+
+    [[nodiscard]] std::vector<PointCloudOctreePoint> ReadNode(const std::string &name) const
+    {
+        const auto path = m_nodeDirectory / (name + ".bin");
+        std::vector<PointCloudOctreePoint> points(std::filesystem::file_size(path) / sizeof(PointCloudOctreePoint));
+        std::ifstream stream(path, std::ios::binary);
+        stream.read(
+            reinterpret_cast<char *>(points.data()),
+            static_cast<std::streamsize>(points.size() * sizeof(PointCloudOctreePoint)));
+        return points;
+    }
+
+    // Keep one point per grid cell in the node and pass the others to the children.
+    void BuildSubtree(std::vector<ChunkPoint> &&points, const std::string &name, const int &depth)
+    {
+        glm::dvec3 min;
+        double size;
+        GetBound(name, min, size);
+        std::vector<PointCloudOctreePoint> kept;
+        std::array<std::vector<ChunkPoint>, 8> children;
+        const auto toNodePoint = [&](const ChunkPoint &point) {
+            return PointCloudOctreePoint{glm::vec3(point.m_position - m_min), point.m_color};
+        };
+        if (points.size() <= m_settings.m_nodeCapacity || depth >= MaxDepth)
+        {
+            kept.reserve(points.size());
+            for (const auto &point : points)
+                kept.push_back(toNodePoint(point));
+        }
+        else
+        {
+            const auto resolution = static_cast<size_t>(m_settings.m_gridResolution);
+            std::vector<bool> occupied(resolution * resolution * resolution, false);
+            const glm::dvec3 center = min + glm::dvec3(size * 0.5);
+            for (const auto &point : points)
+            {
+                const size_t cell = GetCell(point.m_position, min, size);
+                if (!occupied[cell])
+                {
+                    occupied[cell] = true;
+                    kept.push_back(toNodePoint(point));
+                    continue;
+                }
+                const int child = (point.m_position.x >= center.x ? 1 : 0) | (point.m_position.y >= center.y ? 2 : 0) |
+                                  (point.m_position.z >= center.z ? 4 : 0);
+                children[child].push_back(point);
+            }
+        }
+        points.clear();
+        points.shrink_to_fit();
+        WriteNode(name, kept);
+        kept.clear();
+        kept.shrink_to_fit();
+        for (int child = 0; child < 8; child++)
+        {
+            if (!children[child].empty())
+                BuildSubtree(std::move(children[child]), name + static_cast<char>('0' + child), depth + 1);
+        }
+    }
+
+    // Nodes above the chunks take one point per grid cell from the points of their children.
+    void BuildUpperNode(const std::string &name)
+    {
+        glm::dvec3 min;
+        double size;
+        GetBound(name, min, size);
+        const glm::dvec3 relativeMin = min - m_min;
+        const auto resolution = static_cast<size_t>(m_settings.m_gridResolution);
+        std::vector<bool> occupied(resolution * resolution * resolution, false);
+        std::vector<PointCloudOctreePoint> kept;
+        for (int child = 0; child < 8; child++)
+        {
+            const auto childName = name + static_cast<char>('0' + child);
+            if (m_nodePointAmounts.find(childName) == m_nodePointAmounts.end())
+                continue;
+            auto childPoints = ReadNode(childName);
+            std::vector<PointCloudOctreePoint> remaining;
+            remaining.reserve(childPoints.size());
+            for (const auto &point : childPoints)
+            {
+                const size_t cell = GetCell(glm::dvec3(point.m_position), relativeMin, size);
+                if (!occupied[cell])
+                {
+                    occupied[cell] = true;
+                    kept.push_back(point);
+                }
+                else
+                    remaining.push_back(point);
+            }
+            WriteNode(childName, remaining);
+        }
+        WriteNode(name, kept);
+    }
+};
+
+/**
+ * Octrees opened and not closed yet, in the order they were opened.
+ */
+std::vector<PointCloudOctree *> &GetOpenOctrees()
+{
+    static std::vector<PointCloudOctree *> openOctrees;
+    return openOctrees;
+}
+
+std::string GetNodeName(const int &level, const glm::uvec3 &coordinate)
+{
+    std::string name = "r";
+    for (int i = level - 1; i >= 0; i--)
+    {
+        const int child = ((coordinate.x >> i) & 1) | (((coordinate.y >> i) & 1) << 1) | (((coordinate.z >> i) & 1) << 2);
+        name += static_cast<char>('0' + child);
+    }
+    return name;
+}
+#pragma endregion
+} // namespace
+
+bool PointCloudOctree::Build(
+    const std::filesystem::path &plyPath,
+    const std::filesystem::path &directory,
+    const PointCloudOctreeBuildSettings &settings)
+{
+    PlyReader reader;
+    std::string error;
+    if (!reader.Open(plyPath, error))
+    {
+        UNIENGINE_ERROR("Failed to read " + plyPath.string() + ": " + error);
+        return false;
+    }
+    if (!reader.HasPositions())
+    {
+        UNIENGINE_ERROR("Failed to read " + plyPath.string() + ": vertices have no x, y and z");
+        return false;
+    }
+    if (reader.GetVertexAmount() == 0 || settings.m_gridResolution <= 0)
+    {
+        UNIENGINE_ERROR("Nothing to build from " + plyPath.string());
+        return false;
+    }
+    std::vector<glm::dvec3> positions;
+    std::vector<glm::u8vec4> colors;
+    // Call func with the amount of points of every block read, positions and colors hold the block.
+    const auto readBlocks = [&](const std::function<void(size_t)> &func) {
+        PlyReadSettings readSettings;
+        readSettings.m_amount = ReadBlockSize;
+        for (; readSettings.m_first < reader.GetVertexAmount(); readSettings.m_first += ReadBlockSize)
+        {
+            const size_t count = reader.Read(readSettings, positions, colors);
+            if (count == 0)
+                break;
+            colors.resize(count, glm::u8vec4(255));
+            func(count);
+        }
+    };
+
+    // Bounds.
+    glm::dvec3 min = glm::dvec3(DBL_MAX);
+    glm::dvec3 max = glm::dvec3(-DBL_MAX);
+    size_t pointAmount = 0;
+    readBlocks([&](size_t count) {
+        for (const auto &position : positions)
+        {
+            min = glm::min(min, position);
+            max = glm::max(max, position);
+        }
+        pointAmount += count;
+    });
+    if (pointAmount == 0)
+    {
+        UNIENGINE_ERROR("No points read from " + plyPath.string());
+        return false;
+    }
+    const glm::dvec3 extent = max - min;
+    double size = (glm::max)(extent.x, (glm::max)(extent.y, extent.z));
+    if (size <= 0.0)
+        size = 1.0;
+
+    // Counting grid, then the chunks: the largest nodes holding at most m_chunkCapacity points.
+    constexpr unsigned countingResolution = 1u << CountingGridLevel;
+    const auto getCountingCell = [&](const glm::dvec3 &position) {
+        return glm::uvec3(glm::clamp(
+            glm::floor((position - min) / size * static_cast<double>(countingResolution)),
+            glm::dvec3(0.0),
+            glm::dvec3(countingResolution - 1)));
+    };
+    std::vector<std::vector<size_t>> counts(CountingGridLevel + 1);
+    for (int level = 0; level <= CountingGridLevel; level++)
+        counts[level].resize(size_t(1) << (3 * level));
+    const auto getCountIndex = [](const int &level, const glm::uvec3 &coordinate) {
+        return coordinate.x + (size_t(coordinate.y) << level) + (size_t(coordinate.z) << (2 * level));
+    };
+    readBlocks([&](size_t) {
+        for (const auto &position : positions)
+            counts[CountingGridLevel][getCountIndex(CountingGridLevel, getCountingCell(position))]++;
+    });
+    for (int level = CountingGridLevel - 1; level >= 0; level--)
+    {
+        const unsigned resolution = 1u << level;
+        for (unsigned z = 0; z < resolution; z++)
+            for (unsigned y = 0; y < resolution; y++)
+                for (unsigned x = 0; x < resolution; x++)
+                {
+                    size_t total = 0;
+                    for (int child = 0; child < 8; child++)
+                        total += counts[level + 1][getCountIndex(
+                            level + 1, glm::uvec3(x * 2 + (child & 1), y * 2 + ((child >> 1) & 1), z * 2 + ((child >> 2) & 1)))];
+                    counts[level][getCountIndex(level, glm::uvec3(x, y, z))] = total;
+                }
+    }
+    struct Chunk
+    {
+        int m_level;
+        glm::uvec3 m_coordinate;
+    };
+    std::vector<Chunk> chunks;
+    std::vector<int> cellChunks(counts[CountingGridLevel].size(), -1);
+    std::function<void(int, glm::uvec3)> findChunks = [&](const int level, const glm::uvec3 coordinate) {
+        const size_t count = counts[level][getCountIndex(level, coordinate)];
+        if (count == 0)
+            return;
+        if (count > settings.m_chunkCapacity && level < CountingGridLevel)
+        {
+            for (int child = 0; child < 8; child++)
+                findChunks(
+                    level + 1,
+                    coordinate * 2u + glm::uvec3(child & 1, (child >> 1) & 1, (child >> 2) & 1));
+            return;
+        }
+        const unsigned span = 1u << (CountingGridLevel - level);
+        for (unsigned z = 0; z < span; z++)
+            for (unsigned y = 0; y < span; y++)
+                for (unsigned x = 0; x < span; x++)
+                    cellChunks[getCountIndex(CountingGridLevel, coordinate * span + glm::uvec3(x, y, z))] =
+                        static_cast<int>(chunks.size());
+        chunks.push_back({level, coordinate});
+    };
+    findChunks(0, glm::uvec3(0));
+    counts.clear();
+
+    const auto nodeDirectory = directory / "nodes";
+    const auto chunkDirectory = directory / "chunks";
+    std::filesystem::remove_all(nodeDirectory);
+    std::filesystem::remove_all(chunkDirectory);
+    std::filesystem::create_directories(nodeDirectory);
+    std::filesystem::create_directories(chunkDirectory);
+    const auto getChunkPath = [&](const size_t &chunk) { return chunkDirectory / (std::to_string(chunk) + ".bin"); };
+
+    // Distribute the points to the chunk files.
+    {
+        std::vector<std::vector<ChunkPoint>> buffers(chunks.size());
+        size_t bufferedAmount = 0;
+        const auto flush = [&]() {
+            for (size_t chunk = 0; chunk < buffers.size(); chunk++)
+            {
+                auto &buffer = buffers[chunk];
+                if (buffer.empty())
+                    continue;
+                std::ofstream stream(getChunkPath(chunk), std::ios::binary | std::ios::app);
+                stream.write(
+                    reinterpret_cast<const char *>(buffer.data()),
+                    static_cast<std::streamsize>(buffer.size() * sizeof(ChunkPoint)));
+                buffer.clear();
+                buffer.shrink_to_fit();
+            }
+            bufferedAmount = 0;
+        };
+        readBlocks([&](size_t count) {
+            for (size_t i = 0; i < count; i++)
+            {
+                const int chunk = cellChunks[getCountIndex(CountingGridLevel, getCountingCell(positions[i]))];
+                buffers[chunk].push_back({positions[i], colors[i]});
+            }
+            bufferedAmount += count;
+            if (bufferedAmount >= settings.m_bufferedPoints)
+                flush();
+        });
+        flush();
+    }
+    positions.clear();
+    positions.shrink_to_fit();
+    colors.clear();
+    colors.shrink_to_fit();
+
+    OctreeBuilder builder{settings, nodeDirectory, min, size, {}};
+    // Points of the chunk file at path, appended to the files of the children of the chunk named name in blocks, so
+    // the chunk is never held in memory.
+    const auto splitChunk = [&](const std::filesystem::path &path, const std::string &name) {
+        std::array<std::vector<ChunkPoint>, 8> buffers;
+        std::array<bool, 8> written{};
+        size_t bufferedAmount = 0;
+        const auto flush = [&]() {
+            for (int child = 0; child < 8; child++)
+            {
+                auto &buffer = buffers[child];
+                if (buffer.empty())
+                    continue;
+                std::ofstream stream(
+                    chunkDirectory / (name + static_cast<char>('0' + child) + ".bin"), std::ios::binary | std::ios::app);
+                stream.write(
+                    reinterpret_cast<const char *>(buffer.data()),
+                    static_cast<std::streamsize>(buffer.size() * sizeof(ChunkPoint)));
+                buffer.clear();
+                written[child] = true;
+            }
+            bufferedAmount = 0;
+        };
+        glm::dvec3 chunkMin;
+        double chunkSize;
+        builder.GetBound(name, chunkMin, chunkSize);
+        const glm::dvec3 center = chunkMin + glm::dvec3(chunkSize * 0.5);
+        const size_t pointAmount = std::filesystem::file_size(path) / sizeof(ChunkPoint);
+        std::vector<ChunkPoint> block;
+        {
+            std::ifstream stream(path, std::ios::binary);
+            for (size_t first = 0; first < pointAmount; first += ReadBlockSize)
+            {
+                block.resize((std::min)(ReadBlockSize, pointAmount - first));
+                stream.read(
+                    reinterpret_cast<char *>(block.data()),
+                    static_cast<std::streamsize>(block.size() * sizeof(ChunkPoint)));
+                for (const auto &point : block)
+                {
+                    const int child = (point.m_position.x >= center.x ? 1 : 0) |
+                                      (point.m_position.y >= center.y ? 2 : 0) |
+                                      (point.m_position.z >= center.z ? 4 : 0);
+                    buffers[child].push_back(point);
+                }
+                bufferedAmount += block.size();
+                if (bufferedAmount >= settings.m_bufferedPoints)
+                    flush();
+            }
+        }
+        flush();
+        std::filesystem::remove(path);
+        std::vector<std::string> children;
+        for (int child = 0; child < 8; child++)
+            if (written[child])
+                children.push_back(name + static_cast<char>('0' + child));
+        return children;
+    };
+
+    // The subtree of every chunk, then the nodes above them from the deepest up. Chunks of a counting grid cell that
+    // still hold more than m_chunkCapacity points are split further first.
+    std::set<std::string> upperNodes;
+    std::vector<std::pair<std::string, std::filesystem::path>> pendingChunks;
+    for (size_t chunk = 0; chunk < chunks.size(); chunk++)
+        pendingChunks.emplace_back(GetNodeName(chunks[chunk].m_level, chunks[chunk].m_coordinate), getChunkPath(chunk));
+    size_t chunkAmount = 0;
+    while (!pendingChunks.empty())
+    {
+        const auto [name, path] = std::move(pendingChunks.back());
+        pendingChunks.pop_back();
+        const int depth = static_cast<int>(name.size()) - 1;
+        if (std::filesystem::file_size(path) / sizeof(ChunkPoint) > settings.m_chunkCapacity && depth < MaxDepth)
+        {
+            upperNodes.insert(name);
+            for (const auto &child : splitChunk(path, name))
+                pendingChunks.emplace_back(child, chunkDirectory / (child + ".bin"));
+            continue;
+        }
+        std::vector<ChunkPoint> points(std::filesystem::file_size(path) / sizeof(ChunkPoint));
+        {
+            std::ifstream stream(path, std::ios::binary);
+            stream.read(
+                reinterpret_cast<char *>(points.data()),
+                static_cast<std::streamsize>(points.size() * sizeof(ChunkPoint)));
+        }
+        std::filesystem::remove(path);
+        builder.BuildSubtree(std::move(points), name, depth);
+        for (size_t length = 1; length < name.size(); length++)
+            upperNodes.insert(name.substr(0, length));
+        chunkAmount++;
+    }
+    std::filesystem::remove_all(chunkDirectory);
+    std::vector<std::string> upperNodeList(upperNodes.begin(), upperNodes.end());
+    std::sort(upperNodeList.begin(), upperNodeList.end(), [](const std::string &a, const std::string &b) {
+        return a.size() > b.size();
+    });
+    for (const auto &name : upperNodeList)
+        builder.BuildUpperNode(name);
+
+    YAML::Emitter out;
+    out << YAML::BeginMap;
+    out << YAML::Key << "m_min" << YAML::Value << min;
+    out << YAML::Key << "m_size" << YAML::Value << size;
+    out << YAML::Key << "m_pointAmount" << YAML::Value << pointAmount;
+    out << YAML::Key << "m_nodes" << YAML::Value << YAML::BeginSeq;
+    for (const auto &node : builder.m_nodePointAmounts)
+    {
+        out << YAML::BeginMap;
+        out << YAML::Key << "m_name" << YAML::Value << node.first;
+        out << YAML::Key << "m_pointAmount" << YAML::Value << node.second;
+        out << YAML::EndMap;
+    }
+    out << YAML::EndSeq;
+    out << YAML::EndMap;
+    std::ofstream metadata(directory / "octree.yaml");
+    metadata << out.c_str();
+    metadata.flush();
+    UNIENGINE_LOG(
+        "Built an octree of " + std::to_string(builder.m_nodePointAmounts.size()) + " nodes from " +
+        std::to_string(pointAmount) + " points in " + std::to_string(chunkAmount) + " chunks");
+    return true;
+}
+
+bool PointCloudOctree::Open(const std::filesystem::path &directory)
+{
+    Close();
+    const auto path = directory / "octree.yaml";
+    if (!std::filesystem::exists(path))
+    {
+        UNIENGINE_ERROR("No octree in " + directory.string());
+        return false;
+    }
+    std::ifstream stream(path.string());
+    std::stringstream stringStream;
+    stringStream << stream.rdbuf();
+    YAML::Node in = YAML::Load(stringStream.str());
+    m_min = in["m_min"].as<glm::dvec3>();
+    m_size = in["m_size"].as<double>();
+    m_pointAmount = in["m_pointAmount"].as<size_t>();
+    std::vector<std::pair<std::string, size_t>> nodes;
+    for (const auto &node : in["m_nodes"])
+        nodes.emplace_back(node["m_name"].as<std::string>(), node["m_pointAmount"].as<size_t>());
+    // Parents before their children.
+    std::sort(nodes.begin(), nodes.end(), [](const auto &a, const auto &b) {
+        return a.first.size() != b.first.size() ? a.first.size() < b.first.size() : a.first < b.first;
+    });
+    if (nodes.empty() || nodes.front().first != "r")
+    {
+        UNIENGINE_ERROR("Octree in " + directory.string() + " has no root");
+        return false;
+    }
+    std::unordered_map<std::string, int> indices;
+    m_nodes.resize(nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+        auto &node = m_nodes[i];
+        node.m_name = nodes[i].first;
+        node.m_pointAmount = nodes[i].second;
+        node.m_children.fill(-1);
+        node.m_min = m_min;
+        node.m_size = m_size;
+        for (size_t c = 1; c < node.m_name.size(); c++)
+        {
+            const int child = node.m_name[c] - '0';
+            node.m_size *= 0.5;
+            node.m_min += glm::dvec3(child & 1, (child >> 1) & 1, (child >> 2) & 1) * node.m_size;
+        }
+        indices[node.m_name] = static_cast<int>(i);
+        if (i == 0)
+            continue;
+        const auto parent = indices.find(node.m_name.substr(0, node.m_name.size() - 1));
+        if (parent == indices.end())
+            continue;
+        node.m_parent = parent->second;
+        m_nodes[parent->second].m_children[node.m_name.back() - '0'] = static_cast<int>(i);
+    }
+    m_directory = directory;
+    m_offset = -m_min;
+    GetOpenOctrees().push_back(this);
+    return true;
+}
+
+void PointCloudOctree::Close()
+{
+    for (auto &node : m_nodes)
+        if (node.m_state == PointCloudOctreeNode::State::Loading)
+            node.m_loading.wait();
+    m_nodes.clear();
+    m_visibleNodes.clear();
+    m_visiblePointAmount = 0;
+    m_loadedPointAmount = 0;
+    m_pointAmount = 0;
+    m_directory.clear();
+    auto &openOctrees = GetOpenOctrees();
+    openOctrees.erase(std::remove(openOctrees.begin(), openOctrees.end(), this), openOctrees.end());
+}
+
+PointCloudOctree::~PointCloudOctree()
+{
+    Close();
+}
+
+void PointCloudOctree::Load(PointCloudOctreeNode &node)
+{
+    node.m_state = PointCloudOctreeNode::State::Loading;
+    const auto path = m_directory / "nodes" / (node.m_name + ".bin");
+    auto *target = &node;
+    node.m_loading = Jobs::Workers()
+                         .Push([path, target](int) {
+                             std::ifstream stream(path, std::ios::binary);
+                             target->m_points.resize(target->m_pointAmount);
+                             stream.read(
+                                 reinterpret_cast<char *>(target->m_points.data()),
+                                 static_cast<std::streamsize>(target->m_points.size() * sizeof(PointCloudOctreePoint)));
+                             if (!stream)
+                                 target->m_points.clear();
+                         })
+                         .share();
+}
+
+void PointCloudOctree::Unload(PointCloudOctreeNode &node)
+{
+    node.m_vao.reset();
+    node.m_state = PointCloudOctreeNode::State::Unloaded;
+    m_loadedPointAmount -= node.m_pointAmount;
+}
+
+void PointCloudOctree::Update(
+    const std::shared_ptr<Camera> &camera, const glm::vec3 &cameraPosition, const glm::quat &cameraRotation)
+{
+    if (m_nodes.empty() || !camera)
+        return;
+    m_frame++;
+    int loadingAmount = 0;
+    for (auto &node : m_nodes)
+    {
+        if (node.m_state != PointCloudOctreeNode::State::Loading)
+            continue;
+        if (node.m_loading.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            loadingAmount++;
+            continue;
+        }
+        node.m_loading = {};
+        if (node.m_points.size() != node.m_pointAmount)
+        {
+            UNIENGINE_ERROR("Failed to load octree node " + node.m_name);
+            node.m_points.clear();
+            node.m_pointAmount = 0;
+        }
+        node.m_vao = std::make_unique<OpenGLUtils::GLVAO>();
+        node.m_vao->SetData(
+            static_cast<GLsizei>(node.m_points.size() * sizeof(PointCloudOctreePoint)), node.m_points.data(), GL_STATIC_DRAW);
+        node.m_vao->EnableAttributeArray(0);
+        node.m_vao->SetAttributePointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(PointCloudOctreePoint), (void *)0);
+        node.m_vao->EnableAttributeArray(3);
+        node.m_vao->SetAttributePointer(
+            3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(PointCloudOctreePoint), (void *)offsetof(PointCloudOctreePoint, m_color));
+        OpenGLUtils::GLVAO::BindDefault();
+        node.m_points.clear();
+        node.m_points.shrink_to_fit();
+        node.m_state = PointCloudOctreeNode::State::Loaded;
+        m_loadedPointAmount += node.m_pointAmount;
+    }
+
+    const glm::vec3 front = cameraRotation * glm::vec3(0, 0, -1);
+    const glm::vec3 up = cameraRotation * glm::vec3(0, 1, 0);
+    const Frustum frustum(camera->GetProjection() * glm::lookAt(cameraPosition, cameraPosition + front, up));
+    // GetProjection takes half of m_fov as the vertical field of view.
+    const double slope = glm::tan(glm::radians(camera->m_fov * 0.5) * 0.5);
+    const double screenHeight = camera->GetResolution().y;
+    // Size in pixels of the bounding sphere of a node on screen, negative when it is outside of the frustum.
+    const auto getPriority = [&](const PointCloudOctreeNode &node) {
+        const double radius = node.m_size * 0.5 * glm::sqrt(3.0);
+        const glm::dvec3 center = node.m_min + m_offset + glm::dvec3(node.m_size * 0.5);
+        if (!frustum.Intersect(glm::vec3(center), static_cast<float>(radius)))
+            return -1.0;
+        const double distance = glm::distance(center, glm::dvec3(cameraPosition));
+        if (distance <= radius)
+            return DBL_MAX;
+        return radius / (distance * slope) * screenHeight * 0.5;
+    };
+
+    m_visibleNodes.clear();
+    m_visiblePointAmount = 0;
+    std::priority_queue<std::pair<double, int>> queue;
+    if (const double priority = getPriority(m_nodes[0]); priority >= 0.0)
+        queue.emplace(priority, 0);
+    while (!queue.empty())
+    {
+        const int index = queue.top().second;
+        queue.pop();
+        auto &node = m_nodes[index];
+        if (m_visiblePointAmount + node.m_pointAmount > m_pointBudget)
+            break;
+        m_visibleNodes.push_back(index);
+        m_visiblePointAmount += node.m_pointAmount;
+        node.m_lastVisibleFrame = m_frame;
+        if (node.m_state == PointCloudOctreeNode::State::Unloaded && loadingAmount < m_maxConcurrentLoads)
+        {
+            Load(node);
+            loadingAmount++;
+        }
+        for (const auto &child : node.m_children)
+        {
+            if (child == -1)
+                continue;
+            const double priority = getPriority(m_nodes[child]);
+            if (priority >= m_minNodeSize)
+                queue.emplace(priority, child);
+        }
+    }
+
+    if (m_loadedPointAmount > m_cacheBudget)
+    {
+        std::vector<int> candidates;
+        for (size_t i = 0; i < m_nodes.size(); i++)
+        {
+            const auto &node = m_nodes[i];
+            if (node.m_state == PointCloudOctreeNode::State::Loaded && node.m_lastVisibleFrame != m_frame)
+                candidates.push_back(static_cast<int>(i));
+        }
+        std::sort(candidates.begin(), candidates.end(), [&](const int &a, const int &b) {
+            return m_nodes[a].m_lastVisibleFrame < m_nodes[b].m_lastVisibleFrame;
+        });
+        for (const auto &i : candidates)
+        {
+            if (m_loadedPointAmount <= m_cacheBudget)
+                break;
+            Unload(m_nodes[i]);
+        }
+    }
+}
+
+void PointCloudOctree::Render(
+    const std::shared_ptr<Camera> &camera, const glm::vec3 &cameraPosition, const glm::quat &cameraRotation)
+{
+    if (m_visibleNodes.empty() || !camera)
+        return;
+    Camera::m_cameraInfoBlock.UploadMatrices(camera, cameraPosition, cameraRotation);
+    camera->Bind();
+    OpenGLUtils::SetEnable(OpenGLCapability::DepthTest, true);
+    DrawSettings drawSettings;
+    drawSettings.m_pointSize = m_pointSize;
+    drawSettings.ApplySettings();
+    const auto &program = DefaultResources::GizmoVertexColoredProgram;
+    program->Bind();
+    program->SetFloat4x4("model", glm::translate(glm::vec3(m_min + m_offset)));
+    program->SetFloat4x4("scaleMatrix", glm::mat4(1.0f));
+    for (const auto &index : m_visibleNodes)
+    {
+        const auto &node = m_nodes[index];
+        if (node.m_state != PointCloudOctreeNode::State::Loaded || node.m_pointAmount == 0)
+            continue;
+        node.m_vao->Bind();
+        glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(node.m_pointAmount));
+    }
+    OpenGLUtils::GLVAO::BindDefault();
+}
+
+void PointCloudOctree::StreamOpenOctrees(
+    const std::shared_ptr<Camera> &camera, const glm::vec3 &cameraPosition, const glm::quat &cameraRotation)
+{
+    for (const auto &octree : GetOpenOctrees())
+    {
+        if (!octree->m_streaming)
+            continue;
+        octree->Update(camera, cameraPosition, cameraRotation);
+        octree->Render(camera, cameraPosition, cameraRotation);
+    }
+}
+
+void PointCloudOctree::OnInspect()
+{
+    if (!IsOpen())
+    {
+        ImGui::Text("No octree opened");
+        return;
+    }
+    ImGui::Text(("Directory: " + m_directory.string()).c_str());
+    ImGui::Checkbox("Stream octree", &m_streaming);
+    ImGui::Text(
+        ("Points: " + std::to_string(m_pointAmount) + " in " + std::to_string(m_nodes.size()) + " nodes").c_str());
+    ImGui::Text(("Visible points: " + std::to_string(m_visiblePointAmount)).c_str());
+    ImGui::Text(("Loaded points: " + std::to_string(m_loadedPointAmount)).c_str());
+    ImGui::DragScalarN("Offset", ImGuiDataType_Double, &m_offset.x, 3);
+    ImGui::DragScalar("Point budget", ImGuiDataType_U64, &m_pointBudget, 10000.0f);
+    ImGui::DragScalar("Cache budget", ImGuiDataType_U64, &m_cacheBudget, 10000.0f);
+    ImGui::DragFloat("Min node size", &m_minNodeSize, 1.0f, 1.0f, 1000.0f);
+    ImGui::DragInt("Concurrent loads", &m_maxConcurrentLoads, 1, 1, 64);
+    ImGui::DragFloat("Point size", &m_pointSize, 0.1f, 1.0f, 32.0f);
+}
+
+const std::filesystem::path &PointCloudOctree::GetDirectory() const
+{
+    return m_directory;
+}
+
+bool PointCloudOctree::IsOpen() const
+{
+    return !m_nodes.empty();
+}
+
+size_t PointCloudOctree::GetPointAmount() const
+{
+    return m_pointAmount;
+}
+
+size_t PointCloudOctree::GetNodeAmount() const
+{
+    return m_nodes.size();
+}
+
+size_t PointCloudOctree::GetVisiblePointAmount() const
+{
+    return m_visiblePointAmount;
+}
+
+size_t PointCloudOctree::GetLoadedPointAmount() const
+{
+    return m_loadedPointAmount;
+}
@@ -3,6 +3,7 @@
 #include "Engine/Rendering/Graphics.hpp"
 #include <Application.hpp>
 #include <DefaultResources.hpp>
+#include <MemoryStats.hpp>
 #include <MeshRenderer.hpp>
 #include <Prefab.hpp>
 #include <ProjectManager.hpp>
@@ -126,7 +127,8 @@ bool Prefab::LoadInternal(const std::filesystem::path &path)
         std::ifstream stream(path.string());
         std::stringstream stringStream;
         stringStream << stream.rdbuf();
-        YAML::Node in = YAML::Load(stringStream.str());
+        MemoryStats::ScopedAllocation yamlBuffer(MemoryTag::YamlBuffers, static_cast<size_t>(stringStream.tellp()));
+        YAML::Node in = YAML::Load(stringStream);
 #pragma region Assets
         std::vector<std::shared_ptr<IAsset>> localAssets;
         auto inLocalAssets = in["LocalAssets"];
@@ -233,7 +235,7 @@ bool AssimpNode::NecessaryWalker(std::map<std::string, std::shared_ptr<Bone>> &b
 void Prefab::ReadKeyFrame(BoneKeyFrames &boneAnimation, const aiNodeAnim *channel)
 {
     const auto numPositions = channel->mNumPositionKeys;
-    boneAnimation.m_positions.resize(numPositions);
+    boneAnimation.m_positions.reserve(numPositions);
     for (int positionIndex = 0; positionIndex < numPositions; ++positionIndex)
     {
         const aiVector3D aiPosition = channel->mPositionKeys[positionIndex].mValue;
@@ -246,7 +248,7 @@ void Prefab::ReadKeyFrame(BoneKeyFrames &boneAnimation, const aiNodeAnim *channe
     }
 
     const auto numRotations = channel->mNumRotationKeys;
-    boneAnimation.m_rotations.resize(numRotations);
+    boneAnimation.m_rotations.reserve(numRotations);
     for (int rotationIndex = 0; rotationIndex < numRotations; ++rotationIndex)
     {
         const aiQuaternion aiOrientation = channel->mRotationKeys[rotationIndex].mValue;
@@ -259,7 +261,7 @@ void Prefab::ReadKeyFrame(BoneKeyFrames &boneAnimation, const aiNodeAnim *channe
     }
 
     const auto numScales = channel->mNumScalingKeys;
-    boneAnimation.m_scales.resize(numScales);
+    boneAnimation.m_scales.reserve(numScales);
     for (int keyIndex = 0; keyIndex < numScales; ++keyIndex)
     {
         const aiVector3D scale = channel->mScalingKeys[keyIndex].mValue;
@@ -274,7 +276,8 @@ void Prefab::ReadKeyFrame(BoneKeyFrames &boneAnimation, const aiNodeAnim *channe
 void Prefab::ReadAnimations(
     const aiScene *importerScene,
     std::shared_ptr<Animation> &animator,
-    std::map<std::string, std::shared_ptr<Bone>> &bonesMap)
+    std::map<std::string, std::shared_ptr<Bone>> &bonesMap,
+    const ModelImportSettings &settings)
 {
     for (int i = 0; i < importerScene->mNumAnimations; i++)
     {
@@ -297,6 +300,16 @@ void Prefab::ReadAnimations(
         }
         animator->m_animationNameAndLength[animationName] = maxAnimationTimeStamp;
     }
+    if (!settings.m_animationCompression.m_enabled || importerScene->mNumAnimations == 0)
+        return;
+    for (const auto &report : animator->Compress(settings.m_animationCompression))
+    {
+        UNIENGINE_LOG(
+            "Compressed " + report.m_name + ": keys " + std::to_string(report.m_keysBefore) + " -> " +
+            std::to_string(report.m_keysAfter) + ", " + std::to_string(report.GetRatio()) + "x, max error " +
+            std::to_string(report.m_maxPositionError) + " / " + std::to_string(report.m_maxAngularError) + " deg / " +
+            std::to_string(report.m_maxScaleError));
+    }
 }
 std::shared_ptr<Texture2D> Prefab::CollectTexture(
     const std::string &directory,
@@ -400,7 +413,8 @@ bool Prefab::ProcessNode(
     aiNode *importerNode,
     std::shared_ptr<AssimpNode> assimpNode,
     const aiScene *importerScene,
-    const std::shared_ptr<Animation> &animation)
+    const std::shared_ptr<Animation> &animation,
+    const ModelImportSettings &settings)
 {
     bool addedMeshRenderer = false;
     for (unsigned i = 0; i < importerNode->mNumMeshes; i++)
@@ -450,7 +464,7 @@ bool Prefab::ProcessNode(
         {
             auto meshRenderer = Serialization::ProduceSerializable<MeshRenderer>();
             meshRenderer->m_material.Set<Material>(material);
-            meshRenderer->m_mesh.Set<Mesh>(ReadMesh(importerMesh));
+            meshRenderer->m_mesh.Set<Mesh>(ReadMesh(importerMesh, settings));
             if (!meshRenderer->m_mesh.Get())
                 continue;
             addedMeshRenderer = true;
@@ -487,7 +501,8 @@ bool Prefab::ProcessNode(
             importerNode->mChildren[i],
             childAssimpNode,
             importerScene,
-            animation);
+            animation,
+            settings);
         if (childAdd)
         {
             modelNode->m_children.push_back(std::move(childNode));
@@ -497,11 +512,10 @@ bool Prefab::ProcessNode(
     }
     return addedMeshRenderer;
 }
-std::shared_ptr<Mesh> Prefab::ReadMesh(aiMesh *importerMesh)
+std::shared_ptr<Mesh> Prefab::ReadMesh(aiMesh *importerMesh, const ModelImportSettings &settings)
 {
     unsigned mask = 1;
     std::vector<Vertex> vertices;
-    std::vector<unsigned> indices;
     if (importerMesh->mNumVertices == 0 || !importerMesh->HasFaces())
         return nullptr;
     vertices.resize(importerMesh->mNumVertices);
@@ -557,15 +571,27 @@ std::shared_ptr<Mesh> Prefab::ReadMesh(aiMesh *importerMesh)
     }
     // now walk through each of the mesh's _Faces (a face is a mesh its triangle) and retrieve the corresponding vertex
     // indices.
+    std::vector<glm::uvec3> triangles;
+    triangles.resize(importerMesh->mNumFaces);
     for (int i = 0; i < importerMesh->mNumFaces; i++)
     {
         assert(importerMesh->mFaces[i].mNumIndices == 3);
-        // retrieve all indices of the face and store them in the indices vector
+        // retrieve all indices of the face and store them in the triangles vector
         for (int j = 0; j < 3; j++)
-            indices.push_back(importerMesh->mFaces[i].mIndices[j]);
+            triangles[i][j] = importerMesh->mFaces[i].mIndices[j];
+    }
+    VertexStreams vertexStreams;
+    vertexStreams.Import(mask, vertices);
+    if (settings.m_optimizeMeshes)
+    {
+        const auto report = MeshUtilities::Optimize(vertexStreams, triangles);
+        UNIENGINE_LOG(
+            "Optimized " + std::string(importerMesh->mName.C_Str()) + ": vertices " +
+            std::to_string(report.m_verticesBefore) + " -> " + std::to_string(report.m_verticesAfter) + ", ACMR " +
+            std::to_string(report.m_acmrBefore) + " -> " + std::to_string(report.m_acmrAfter));
     }
     auto mesh = ProjectManager::CreateTemporaryAsset<Mesh>();
-    mesh->SetVertices(mask, vertices, indices);
+    mesh->SetVertices(std::move(vertexStreams), triangles);
     return mesh;
 }
 std::shared_ptr<SkinnedMesh> Prefab::ReadSkinnedMesh(
@@ -965,7 +991,14 @@ void Prefab::RelinkChildren(const std::shared_ptr<Scene>& scene, const Entity &p
 }
 void Prefab::LoadModel(const std::filesystem::path &path, bool optimize, unsigned flags)
 {
-    LoadModelInternal(ProjectManager::GetProjectPath().parent_path() / path, optimize, flags);
+    ModelImportSettings settings;
+    settings.m_optimizeScene = optimize;
+    settings.m_flags = flags;
+    LoadModel(path, settings);
+}
+void Prefab::LoadModel(const std::filesystem::path &path, const ModelImportSettings &settings)
+{
+    LoadModelInternal(ProjectManager::GetProjectPath().parent_path() / path, settings);
 }
 
 void Prefab::SaveModelInternal(const std::filesystem::path &path)
@@ -975,9 +1008,10 @@ void Prefab::SaveModelInternal(const std::filesystem::path &path)
 
     delete scene;
 }
-void Prefab::LoadModelInternal(const std::filesystem::path &path, bool optimize, unsigned int flags)
+void Prefab::LoadModelInternal(const std::filesystem::path &path, const ModelImportSettings &settings)
 {
-    if (optimize)
+    unsigned flags = settings.m_flags;
+    if (settings.m_optimizeScene)
     {
         flags = flags | aiProcess_OptimizeGraph | aiProcess_OptimizeMeshes;
     }
@@ -1012,7 +1046,8 @@ void Prefab::LoadModelInternal(const std::filesystem::path &path, bool optimize,
             scene->mRootNode,
             rootAssimpNode,
             scene,
-            animation))
+            animation,
+            settings))
     {
         UNIENGINE_ERROR("Model is empty!");
         return;
@@ -1023,7 +1058,7 @@ void Prefab::LoadModelInternal(const std::filesystem::path &path, bool optimize,
         size_t index = 0;
         rootAssimpNode->AttachToAnimator(animation, index);
         animation->m_boneSize = index + 1;
-        ReadAnimations(scene, animation, bonesMap);
+        ReadAnimations(scene, animation, bonesMap, settings);
         ApplyBoneIndices(this);
 
         auto animator = Serialization::ProduceSerializable<Animator>();
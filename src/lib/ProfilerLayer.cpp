@@ -1,55 +1,240 @@
 #include <Application.hpp>
 #include <ProfilerLayer.hpp>
+#include <Utilities.hpp>
 using namespace UniEngine;
-CPUUsageEvent::CPUUsageEvent(CPUUsageEvent *parent, const std::string &name)
+CPUUsageEvent::CPUUsageEvent(CPUUsageEvent *parent, const uint32_t &scope)
 {
     m_parent = parent;
-    m_name = name;
+    m_scope = scope;
     m_timeStart = Application::Time().CurrentTime();
 }
 
 void CPUUsageEvent::OnInspect(const float &parentTotalTime) const
 {
     const float time = m_timeEnd - m_timeStart;
-    if (ImGui::TreeNode((m_name).c_str()))
+    if (ImGui::TreeNode(TraceRecorder::GetScopeName(m_scope).c_str()))
     {
         ImGui::SameLine();
-        ImGui::Text(": %.4f ms (%.3f%%)", time, time / parentTotalTime * 100.0f);
+        ImGui::Text(": %.4f ms (%.3f%%)", time * 1000.0f, time / parentTotalTime * 100.0f);
         for (auto &i : m_children)
             i.OnInspect(parentTotalTime);
         ImGui::TreePop();
     }
 }
 
+namespace
+{
+/**
+ * Point the children of a copied event tree to their parents in the copy.
+ */
+void RelinkParents(CPUUsageEvent &event)
+{
+    for (auto &i : event.m_children)
+    {
+        i.m_parent = &event;
+        RelinkParents(i);
+    }
+}
+} // namespace
+
+size_t CPUTimeProfiler::GetHistoryIndex(const size_t &parent, const uint32_t &scope)
+{
+    const uint64_t key = (static_cast<uint64_t>(parent + 1) << 32) | scope;
+    const auto search = m_historyIndices.find(key);
+    if (search != m_historyIndices.end())
+        return search->second;
+    const size_t index = m_history.size();
+    m_history.emplace_back();
+    m_history.back().m_scope = scope;
+    m_history.back().m_parent = parent;
+    m_historyIndices[key] = index;
+    return index;
+}
+
+std::string CPUTimeProfiler::GetHistoryPath(const size_t &index) const
+{
+    std::string path = TraceRecorder::GetScopeName(m_history[index].m_scope);
+    for (size_t i = m_history[index].m_parent; i != SIZE_MAX; i = m_history[i].m_parent)
+        path = TraceRecorder::GetScopeName(m_history[i].m_scope) + "/" + path;
+    return path;
+}
+
 void CPUTimeProfiler::PreUpdate()
 {
     if (m_currentEventPointer != &m_rootEvent)
     {
         UNIENGINE_ERROR("Event not properly registered!");
     }
-    m_rootEvent = CPUUsageEvent(nullptr, "Main Loop");
+    m_rootEvent = CPUUsageEvent(nullptr, m_rootEvent.m_scope);
     m_currentEventPointer = &m_rootEvent;
+    m_historyStack.clear();
+    m_historyStack.push_back(GetHistoryIndex(SIZE_MAX, m_rootEvent.m_scope));
 }
 
-void CPUTimeProfiler::StartEvent(const std::string &name)
+void CPUTimeProfiler::StartEvent(const uint32_t &scope)
 {
-    m_currentEventPointer->m_children.emplace_back(m_currentEventPointer, name);
+    m_currentEventPointer->m_children.emplace_back(m_currentEventPointer, scope);
     m_currentEventPointer = &m_currentEventPointer->m_children.back();
+    m_historyStack.push_back(GetHistoryIndex(m_historyStack.back(), scope));
 }
 
-void CPUTimeProfiler::EndEvent(const std::string &name)
+void CPUTimeProfiler::EndEvent(const uint32_t &scope)
 {
-    if (name != m_currentEventPointer->m_name)
+    if (scope != m_currentEventPointer->m_scope)
     {
         UNIENGINE_ERROR("Event not properly ended!");
     }
     m_currentEventPointer->m_timeEnd = Application::Time().CurrentTime();
+    if (m_historyStack.size() > 1)
+    {
+        auto &history = m_history[m_historyStack.back()];
+        if (history.m_lastFrame != m_frameAmount + 1)
+        {
+            history.m_lastFrame = m_frameAmount + 1;
+            history.m_currentFrameTime = 0;
+        }
+        history.m_currentFrameTime +=
+            static_cast<float>((m_currentEventPointer->m_timeEnd - m_currentEventPointer->m_timeStart) * 1000.0);
+        m_historyStack.pop_back();
+    }
     m_currentEventPointer = m_currentEventPointer->m_parent;
 }
 
 void CPUTimeProfiler::LateUpdate()
 {
     m_currentEventPointer->m_timeEnd = Application::Time().CurrentTime();
+    m_frameAmount++;
+    const auto frameTime = static_cast<float>((m_rootEvent.m_timeEnd - m_rootEvent.m_timeStart) * 1000.0);
+    if (!m_historyStack.empty())
+    {
+        auto &root = m_history[m_historyStack.front()];
+        root.m_lastFrame = m_frameAmount;
+        root.m_currentFrameTime = frameTime;
+    }
+    for (auto &history : m_history)
+    {
+        if (history.m_lastFrame == m_frameAmount)
+        {
+            history.m_frameTimes.push_back(history.m_currentFrameTime);
+            while (history.m_frameTimes.size() > m_historySize)
+                history.m_frameTimes.pop_front();
+        }
+        else if (!history.m_frameTimes.empty() && m_frameAmount - history.m_lastFrame >= m_historySize)
+        {
+            history.m_frameTimes.clear();
+            history.m_frameTimes.shrink_to_fit();
+        }
+    }
+    if (m_spikeThreshold > 0 && frameTime > m_spikeThreshold &&
+        (!m_hasSpike || frameTime > (m_spikeEvent.m_timeEnd - m_spikeEvent.m_timeStart) * 1000.0))
+    {
+        m_spikeEvent = m_rootEvent;
+        RelinkParents(m_spikeEvent);
+        m_hasSpike = true;
+        m_spikeFrame = m_frameAmount;
+    }
+}
+
+std::vector<CPUEventStatistics> CPUTimeProfiler::GetStatistics() const
+{
+    std::vector<CPUEventStatistics> statistics;
+    std::vector<float> sorted;
+    for (size_t i = 0; i < m_history.size(); i++)
+    {
+        const auto &frameTimes = m_history[i].m_frameTimes;
+        if (frameTimes.empty())
+            continue;
+        sorted.assign(frameTimes.begin(), frameTimes.end());
+        std::sort(sorted.begin(), sorted.end());
+        // Nearest rank percentile.
+        const auto percentile = [&](const float &p) {
+            const auto rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+            return sorted[(std::max)(rank, size_t(1)) - 1];
+        };
+        CPUEventStatistics eventStatistics;
+        eventStatistics.m_name = GetHistoryPath(i);
+        eventStatistics.m_samples = sorted.size();
+        eventStatistics.m_min = sorted.front();
+        eventStatistics.m_max = sorted.back();
+        eventStatistics.m_average = std::accumulate(sorted.begin(), sorted.end(), 0.0f) / sorted.size();
+        eventStatistics.m_p50 = percentile(0.5f);
+        eventStatistics.m_p95 = percentile(0.95f);
+        eventStatistics.m_p99 = percentile(0.99f);
+        statistics.push_back(eventStatistics);
+    }
+    std::sort(statistics.begin(), statistics.end(), [](const CPUEventStatistics &a, const CPUEventStatistics &b) {
+        return a.m_name < b.m_name;
+    });
+    return statistics;
+}
+
+void CPUTimeProfiler::ClearHistory()
+{
+    // The paths stay, events may be open while the history is cleared.
+    for (auto &i : m_history)
+    {
+        i.m_frameTimes.clear();
+        i.m_frameTimes.shrink_to_fit();
+        i.m_lastFrame = 0;
+    }
+    m_frameAmount = 0;
+    m_hasSpike = false;
+    m_spikeFrame = 0;
+}
+
+bool CPUTimeProfiler::ExportCsv(const std::filesystem::path &path) const
+{
+    std::ofstream out(path);
+    if (!out)
+        return false;
+    out << "event,samples,min_ms,average_ms,p50_ms,p95_ms,p99_ms,max_ms\n";
+    for (const auto &i : GetStatistics())
+    {
+        std::string name = i.m_name;
+        for (size_t position = name.find('"'); position != std::string::npos; position = name.find('"', position + 2))
+            name.insert(position, 1, '"');
+        out << '"' << name << "\"," << i.m_samples << "," << i.m_min << "," << i.m_average << "," << i.m_p50 << ","
+            << i.m_p95 << "," << i.m_p99 << "," << i.m_max << "\n";
+    }
+    return true;
+}
+
+bool CPUTimeProfiler::ExportJson(const std::filesystem::path &path) const
+{
+    std::ofstream out(path);
+    if (!out)
+        return false;
+    const auto writeString = [&](const std::string &value) {
+        out << '"';
+        for (const auto &c : value)
+        {
+            if (c == '"' || c == '\\')
+                out << '\\';
+            out << c;
+        }
+        out << '"';
+    };
+    out << "{\n  \"frames\": " << m_frameAmount << ",\n  \"events\": [";
+    const auto statistics = GetStatistics();
+    for (size_t i = 0; i < statistics.size(); i++)
+    {
+        const auto &event = statistics[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+        writeString(event.m_name);
+        out << ", \"samples\": " << event.m_samples << ", \"min_ms\": " << event.m_min
+            << ", \"average_ms\": " << event.m_average << ", \"p50_ms\": " << event.m_p50
+            << ", \"p95_ms\": " << event.m_p95 << ", \"p99_ms\": " << event.m_p99 << ", \"max_ms\": " << event.m_max
+            << "}";
+    }
+    out << "\n  ],\n  \"frame_times_ms\": [";
+    if (!m_history.empty())
+    {
+        const auto &frameTimes = m_history.front().m_frameTimes;
+        for (size_t i = 0; i < frameTimes.size(); i++)
+            out << (i == 0 ? "" : ", ") << frameTimes[i];
+    }
+    out << "]\n}\n";
+    return true;
 }
 
 void CPUTimeProfiler::OnInspect()
@@ -57,11 +242,235 @@ void CPUTimeProfiler::OnInspect()
     auto time = m_rootEvent.m_timeEnd - m_rootEvent.m_timeStart;
     if(time < 0.0f) ImGui::Text("No frame recorded!");
     else m_rootEvent.OnInspect(m_rootEvent.m_timeEnd - m_rootEvent.m_timeStart);
+
+    if (ImGui::TreeNode("History"))
+    {
+        int historySize = static_cast<int>(m_historySize);
+        if (ImGui::DragInt("Frames", &historySize, 1, 1, 100000))
+            m_historySize = historySize;
+        if (!m_history.empty())
+        {
+            const auto &rootFrameTimes = m_history.front().m_frameTimes;
+            const std::vector<float> frameTimes(rootFrameTimes.begin(), rootFrameTimes.end());
+            ImGui::PlotLines(
+                "Frame time (ms)",
+                frameTimes.data(),
+                static_cast<int>(frameTimes.size()),
+                0,
+                nullptr,
+                0.0f,
+                FLT_MAX,
+                ImVec2(0, 80));
+        }
+        if (ImGui::BeginTable("Statistics", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable))
+        {
+            for (const auto &i : {"Event", "Min", "Average", "P50", "P95", "P99", "Max"})
+                ImGui::TableSetupColumn(i);
+            ImGui::TableHeadersRow();
+            for (const auto &i : GetStatistics())
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(i.m_name.c_str());
+                for (const auto &value : {i.m_min, i.m_average, i.m_p50, i.m_p95, i.m_p99, i.m_max})
+                {
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.3f", value);
+                }
+            }
+            ImGui::EndTable();
+        }
+        FileUtils::SaveFile("Export CSV", "CSV", {".csv"}, [this](const std::filesystem::path &path) {
+            if (!ExportCsv(path))
+                UNIENGINE_ERROR("Failed to write " + path.string());
+        }, false);
+        ImGui::SameLine();
+        FileUtils::SaveFile("Export JSON", "JSON", {".json"}, [this](const std::filesystem::path &path) {
+            if (!ExportJson(path))
+                UNIENGINE_ERROR("Failed to write " + path.string());
+        }, false);
+        ImGui::SameLine();
+        if (ImGui::Button("Clear"))
+            ClearHistory();
+        ImGui::TreePop();
+    }
+    if (ImGui::TreeNode("Spike"))
+    {
+        ImGui::DragFloat("Threshold (ms)", &m_spikeThreshold, 0.1f, 0.0f, 1000.0f);
+        if (m_hasSpike)
+        {
+            ImGui::Text("Captured at frame %zu", m_spikeFrame);
+            m_spikeEvent.OnInspect(m_spikeEvent.m_timeEnd - m_spikeEvent.m_timeStart);
+        }
+        else
+            ImGui::Text("No spike captured!");
+        ImGui::TreePop();
+    }
+}
+
+void CounterProfiler::PreUpdate()
+{
+    m_counters.clear();
+}
+
+void CounterProfiler::StartEvent(const uint32_t &)
+{
+}
+
+void CounterProfiler::EndEvent(const uint32_t &)
+{
+}
+
+void CounterProfiler::LateUpdate()
+{
+}
+
+void CounterProfiler::OnInspect()
+{
+    if (m_counters.empty())
+    {
+        ImGui::Text("No counter recorded!");
+        return;
+    }
+    for (const auto &i : m_counters)
+    {
+        const auto &value = i.second.first;
+        const auto &total = i.second.second;
+        ImGui::Text(
+            "%s: %zu / %zu (%.1f%%)",
+            i.first.c_str(),
+            value,
+            total,
+            total == 0 ? 0.0f : static_cast<float>(value) / total * 100.0f);
+    }
+}
+
+void CounterProfiler::SetCounter(const std::string &name, const size_t &value, const size_t &total)
+{
+    m_counters[name] = {value, total};
+}
+
+void TraceProfiler::PreUpdate()
+{
+    TraceRecorder::NewFrame();
+}
+
+void TraceProfiler::StartEvent(const uint32_t &scope)
+{
+    TraceRecorder::Begin(scope);
+}
+
+void TraceProfiler::EndEvent(const uint32_t &scope)
+{
+    TraceRecorder::End(scope);
+}
+
+void TraceProfiler::LateUpdate()
+{
+}
+
+void TraceProfiler::OnInspect()
+{
+    const auto &frames = TraceRecorder::GetFrames();
+    size_t eventAmount = 0;
+    for (const auto &i : frames)
+        eventAmount += i.m_events.size();
+    ImGui::Text(
+        "Frames: %zu, events: %zu, dropped: %zu",
+        frames.size(),
+        eventAmount,
+        TraceRecorder::GetDroppedEventAmount());
+    static int maxFrames = 120;
+    if (ImGui::DragInt("Max frames", &maxFrames, 1, 1, 10000))
+        TraceRecorder::SetMaxFrames(maxFrames);
+    FileUtils::SaveFile(
+        "Export Chrome trace",
+        "Trace",
+        {".json"},
+        [](const std::filesystem::path &path) {
+            if (!TraceRecorder::ExportChromeTrace(path))
+                UNIENGINE_ERROR("Failed to write " + path.string());
+        },
+        false);
+    ImGui::SameLine();
+    if (ImGui::Button("Clear"))
+        TraceRecorder::Clear();
+}
+
+void MemoryProfiler::PreUpdate()
+{
+}
+
+void MemoryProfiler::StartEvent(const uint32_t &)
+{
+}
+
+void MemoryProfiler::EndEvent(const uint32_t &)
+{
+}
+
+void MemoryProfiler::LateUpdate()
+{
+}
+
+void MemoryProfiler::OnInspect()
+{
+    if (ImGui::Button("Collect"))
+        MemoryStats::Collect();
+    ImGui::SameLine();
+    if (const auto profilerLayer = Application::GetLayer<ProfilerLayer>())
+    {
+        int interval = static_cast<int>(profilerLayer->m_memoryCollectInterval);
+        ImGui::SetNextItemWidth(100);
+        if (ImGui::DragInt("Collect every (frames, 0 off)", &interval, 1, 0, 100000))
+            profilerLayer->m_memoryCollectInterval = static_cast<size_t>(interval);
+        ImGui::SameLine();
+    }
+    ImGui::Text("Total: %.2f MB", MemoryStats::GetTotalBytes() / 1048576.0f);
+    if (ImGui::BeginTable("Memory", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable))
+    {
+        for (const auto &i : {"Subsystem", "Size (MB)", "Peak (MB)", "Amount", "Budget (MB)"})
+            ImGui::TableSetupColumn(i);
+        ImGui::TableHeadersRow();
+        for (size_t i = 0; i < static_cast<size_t>(MemoryTag::Count); i++)
+        {
+            const auto tag = static_cast<MemoryTag>(i);
+            const auto stats = MemoryStats::Get(tag);
+            const bool overBudget = stats.m_budget != 0 && stats.m_bytes > stats.m_budget;
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            if (overBudget)
+                ImGui::TextColored(ImVec4(1, 0.3f, 0.3f, 1), "%s", MemoryStats::GetTagName(tag));
+            else
+                ImGui::TextUnformatted(MemoryStats::GetTagName(tag));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", stats.m_bytes / 1048576.0f);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", stats.m_peakBytes / 1048576.0f);
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu", stats.m_amount);
+            ImGui::TableNextColumn();
+            float budget = stats.m_budget / 1048576.0f;
+            ImGui::PushID(static_cast<int>(i));
+            ImGui::SetNextItemWidth(-FLT_MIN);
+            if (ImGui::DragFloat("##Budget", &budget, 1.0f, 0.0f, 1048576.0f, "%.0f"))
+                MemoryStats::SetBudget(tag, static_cast<size_t>(budget * 1048576.0));
+            ImGui::PopID();
+        }
+        ImGui::EndTable();
+    }
 }
 
 void ProfilerLayer::PreUpdate()
 {
-    m_record = Application::IsPlaying();
+    if (m_memoryCollectInterval != 0 && m_frameCount++ % m_memoryCollectInterval == 0)
+        MemoryStats::Collect();
+    const bool record = Application::IsPlaying();
+    // Close the last recorded frame before the recorder stops.
+    if (m_record && !record)
+        TraceRecorder::NewFrame();
+    m_record = record;
+    TraceRecorder::SetRecording(m_record);
     if (!m_record)
         return;
     for (auto &i : m_profilers)
@@ -103,27 +512,62 @@ void ProfilerLayer::OnInspect()
 void ProfilerLayer::OnCreate()
 {
     GetOrCreateProfiler<CPUTimeProfiler>("CPU Time");
+    GetOrCreateProfiler<CounterProfiler>("Counters");
+    GetOrCreateProfiler<TraceProfiler>("Trace");
+    GetOrCreateProfiler<MemoryProfiler>("Memory");
+    m_mainThread = std::this_thread::get_id();
+    TraceRecorder::SetThreadName("Main");
 }
-void ProfilerLayer::StartEvent(const std::string &name)
+void ProfilerLayer::StartEvent(const uint32_t &scope)
 {
     auto profilerLayer = Application::GetLayer<ProfilerLayer>();
     if(profilerLayer)
     {
         if (!profilerLayer->m_record)
             return;
+        if (std::this_thread::get_id() != profilerLayer->m_mainThread)
+        {
+            TraceRecorder::Begin(scope);
+            return;
+        }
         for (auto &i : profilerLayer->m_profilers)
-            i.second->StartEvent(name);
+            i.second->StartEvent(scope);
     }
 }
-void ProfilerLayer::EndEvent(const std::string &name)
+void ProfilerLayer::EndEvent(const uint32_t &scope)
 {
     auto profilerLayer = Application::GetLayer<ProfilerLayer>();
     if(profilerLayer)
     {
         if (!profilerLayer->m_record)
             return;
+        if (std::this_thread::get_id() != profilerLayer->m_mainThread)
+        {
+            TraceRecorder::End(scope);
+            return;
+        }
         for (auto &i : profilerLayer->m_profilers)
-            i.second->EndEvent(name);
+            i.second->EndEvent(scope);
+    }
+}
+void ProfilerLayer::StartEvent(const std::string &name)
+{
+    StartEvent(TraceRecorder::RegisterScope(name));
+}
+void ProfilerLayer::EndEvent(const std::string &name)
+{
+    EndEvent(TraceRecorder::RegisterScope(name));
+}
+void ProfilerLayer::SetCounter(const std::string &name, const size_t &value, const size_t &total)
+{
+    auto profilerLayer = Application::GetLayer<ProfilerLayer>();
+    if (profilerLayer)
+    {
+        if (!profilerLayer->m_record || std::this_thread::get_id() != profilerLayer->m_mainThread)
+            return;
+        auto counterProfiler = profilerLayer->GetProfiler<CounterProfiler>();
+        if (counterProfiler)
+            counterProfiler->SetCounter(name, value, total);
     }
 }
 void ProfilerLayer::LateUpdate()
@@ -22,31 +22,180 @@
 using namespace UniEngine;
 
 #pragma region RenderCommand Dispatch
-void RenderLayer::DispatchRenderCommands(
-	const RenderInstances& renderCommands,
-	const std::function<void(const std::shared_ptr<Material>&, const RenderCommand& renderCommand)>& func,
-	const bool& setMaterial)
+static_assert(std::is_trivially_copyable_v<RenderCommand>, "RenderCommand is copied and sorted as plain memory.");
+
+RenderCommandPass RenderCommand::GetPass() const
+{
+	return static_cast<RenderCommandPass>(RenderSort::GetPass(m_sortKey));
+}
+
+void RenderResources::Clear()
 {
+	m_geometries.clear();
+	m_materials.clear();
+	m_particleMatrices.clear();
+	m_boneMatrices.clear();
+	m_geometryIndices.clear();
+	m_materialIndices.clear();
+	m_particleMatricesIndices.clear();
+	m_boneMatricesIndices.clear();
+}
+
+template <typename T>
+static unsigned AddResource(
+	std::vector<std::shared_ptr<T>>& table,
+	std::unordered_map<const T*, unsigned>& indices,
+	const std::shared_ptr<T>& resource)
+{
+	if (!resource)
+		return RenderCommand::NoResource;
+	const auto search = indices.emplace(resource.get(), static_cast<unsigned>(table.size()));
+	if (search.second)
+		table.push_back(resource);
+	return search.first->second;
+}
 
-	for (const auto& renderCollection : renderCommands.m_renderCommandsGroups)
+unsigned RenderResources::Add(const std::shared_ptr<RenderGeometry>& geometry)
+{
+	return AddResource(m_geometries, m_geometryIndices, geometry);
+}
+
+unsigned RenderResources::Add(const std::shared_ptr<Material>& material)
+{
+	return AddResource(m_materials, m_materialIndices, material);
+}
+
+unsigned RenderResources::Add(const std::shared_ptr<ParticleMatrices>& matrices)
+{
+	return AddResource(m_particleMatrices, m_particleMatricesIndices, matrices);
+}
+
+unsigned RenderResources::Add(const std::shared_ptr<BoneMatrices>& matrices)
+{
+	return AddResource(m_boneMatrices, m_boneMatricesIndices, matrices);
+}
+
+const std::shared_ptr<ParticleMatrices>& RenderLayer::GetParticleMatrices(const RenderCommand& renderCommand) const
+{
+	return m_renderResources.m_particleMatrices[renderCommand.m_matricesIndex];
+}
+
+const std::shared_ptr<BoneMatrices>& RenderLayer::GetBoneMatrices(const RenderCommand& renderCommand) const
+{
+	return m_renderResources.m_boneMatrices[renderCommand.m_matricesIndex];
+}
+
+unsigned RenderLayer::RegisterCamera(const std::shared_ptr<Camera>& camera)
+{
+	const auto search = m_cameraSlotIndices.find(camera->GetHandle());
+	if (search != m_cameraSlotIndices.end())
+		return search->second;
+	if (m_cameraSlots.size() >= MaxCameraSlots)
+	{
+		UNIENGINE_ERROR("RenderLayer: More than 64 cameras in one frame, the rest are not rendered!");
+		return NoCameraSlot;
+	}
+	const auto slot = static_cast<unsigned>(m_cameraSlots.size());
+	m_cameraSlots.push_back(camera);
+	m_cameraSlotIndices[camera->GetHandle()] = slot;
+	return slot;
+}
+
+unsigned RenderLayer::GetCameraSlot(const std::shared_ptr<Camera>& camera) const
+{
+	const auto search = m_cameraSlotIndices.find(camera->GetHandle());
+	return search != m_cameraSlotIndices.end() ? search->second : NoCameraSlot;
+}
+
+void RenderLayer::PushApiRenderCommand(RenderCommand renderCommand, const std::shared_ptr<Camera>& camera)
+{
+	const auto cameraSlot = RegisterCamera(camera);
+	if (cameraSlot != NoCameraSlot)
+		renderCommand.m_cameraMask |= uint64_t(1) << cameraSlot;
+	auto editorLayer = Application::GetLayer<EditorLayer>();
+	if (editorLayer)
 	{
-		const auto& material = renderCollection.second.m_material;
-		if (setMaterial)
+		auto& sceneCamera = editorLayer->m_sceneCamera;
+		if (sceneCamera && sceneCamera->IsEnabled())
+		{
+			const auto sceneCameraSlot = RegisterCamera(sceneCamera);
+			if (sceneCameraSlot != NoCameraSlot)
+				renderCommand.m_cameraMask |= uint64_t(1) << sceneCameraSlot;
+		}
+	}
+	m_renderCommands.push_back(renderCommand);
+}
+
+void RenderLayer::DispatchRenderCommands(
+	const RenderCommandPass& pass,
+	const unsigned& cameraSlot,
+	const std::function<void(const std::shared_ptr<Material>&, const RenderCommand& renderCommand)>& func,
+	const bool& setMaterial,
+	const std::function<void(
+		const std::shared_ptr<Material>&, const RenderCommand& renderCommand, const RenderInstanceBatch& batch)>&
+		batchFunc)
+{
+	if (cameraSlot == NoCameraSlot)
+		return;
+	const uint64_t cameraBit = uint64_t(1) << cameraSlot;
+	// Commands are sorted by material, the material state only changes between runs of the same material.
+	unsigned currentMaterialIndex = RenderCommand::NoResource;
+	const auto bindMaterial = [&](const RenderCommand& renderCommand) -> const std::shared_ptr<Material>& {
+		const auto& material = m_renderResources.m_materials[renderCommand.m_materialIndex];
+		if (setMaterial && renderCommand.m_materialIndex != currentMaterialIndex)
 		{
+			if (currentMaterialIndex != RenderCommand::NoResource)
+				ReleaseMaterialSettings(m_renderResources.m_materials[currentMaterialIndex]);
 			MaterialPropertySetter(material, true);
 			m_materialSettings = MaterialSettingsBlock();
 			ApplyMaterialSettings(material);
+			currentMaterialIndex = renderCommand.m_materialIndex;
 		}
-		for (const auto& renderCommands : renderCollection.second.m_renderCommands)
+		return material;
+	};
+	const auto dispatch = [&](const RenderCommand& renderCommand) {
+		func(bindMaterial(renderCommand), renderCommand);
+	};
+	if (pass == RenderCommandPass::Transparent || pass == RenderCommandPass::InstancedTransparent)
+	{
+		// Back to front for this camera, both transparent passes share the list.
+		if (cameraSlot < m_transparentCommandOrders.size())
 		{
-			for (const auto& renderCommand : renderCommands.second)
+			for (const auto& i : m_transparentCommandOrders[cameraSlot])
 			{
-				func(material, renderCommand);
+				if (m_renderCommands[i].GetPass() == pass)
+					dispatch(m_renderCommands[i]);
 			}
 		}
-		if (setMaterial)
-			ReleaseMaterialSettings(material);
 	}
+	else
+	{
+		const auto& range = m_passRanges[static_cast<size_t>(pass)];
+		// Batches only exist for the deferred pass and are in command order.
+		const RenderInstanceBatch* batch = nullptr;
+		const RenderInstanceBatch* batchEnd = nullptr;
+		if (batchFunc && pass == RenderCommandPass::Deferred && cameraSlot < m_cameraInstanceBatches.size() &&
+			!m_cameraInstanceBatches[cameraSlot].empty())
+		{
+			batch = m_cameraInstanceBatches[cameraSlot].data();
+			batchEnd = batch + m_cameraInstanceBatches[cameraSlot].size();
+		}
+		for (size_t i = range.first; i < range.second; i++)
+		{
+			if (batch != batchEnd && i == batch->m_begin)
+			{
+				const auto& renderCommand = m_renderCommands[i];
+				batchFunc(bindMaterial(renderCommand), renderCommand, *batch);
+				i = batch->m_end - 1;
+				batch++;
+				continue;
+			}
+			if (m_renderCommands[i].m_cameraMask & cameraBit)
+				dispatch(m_renderCommands[i]);
+		}
+	}
+	if (setMaterial && currentMaterialIndex != RenderCommand::NoResource)
+		ReleaseMaterialSettings(m_renderResources.m_materials[currentMaterialIndex]);
 }
 
 #pragma endregion
@@ -65,6 +214,7 @@ void RenderLayer::RenderToCamera(const std::shared_ptr<Camera>& cameraComponent,
 	m_kernelBlock->Bind();
 
 	Camera::m_cameraInfoBlock.UploadMatrices(cameraComponent, cameraModel);
+	const auto cameraSlot = GetCameraSlot(cameraComponent);
 	auto scene = GetScene();
 	auto sceneBound = scene->GetBound();
 	RenderShadows(sceneBound, cameraComponent, cameraModel);
@@ -76,12 +226,13 @@ void RenderLayer::RenderToCamera(const std::shared_ptr<Camera>& cameraComponent,
 		{ GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3 });
 	cameraComponent->m_gBuffer->Clear();
 	DispatchRenderCommands(
-		m_deferredRenderInstances[cameraComponent->GetHandle()],
+		RenderCommandPass::Deferred,
+		cameraSlot,
 		[&](const std::shared_ptr<Material>& material, const RenderCommand& renderCommand) {
 			switch (renderCommand.m_geometryType)
 			{
 			case RenderGeometryType::Mesh: {
-				auto mesh = std::dynamic_pointer_cast<Mesh>(renderCommand.m_renderGeometry);
+				auto mesh = GetGeometry<Mesh>(renderCommand);
 				auto& program = DefaultResources::m_gBufferPrepass;
 				program->Bind();
 				ApplyProgramSettings(program, material);
@@ -92,11 +243,11 @@ void RenderLayer::RenderToCamera(const std::shared_ptr<Camera>& cameraComponent,
 				break;
 			}
 			case RenderGeometryType::SkinnedMesh: {
-				auto skinnedMesh = std::dynamic_pointer_cast<SkinnedMesh>(renderCommand.m_renderGeometry);
+				auto skinnedMesh = GetGeometry<SkinnedMesh>(renderCommand);
 				auto& program = DefaultResources::m_gBufferSkinnedPrepass;
 				program->Bind();
 				ApplyProgramSettings(program, material);
-				renderCommand.m_boneMatrices->UploadBones(skinnedMesh);
+				GetBoneMatrices(renderCommand)->UploadBones(skinnedMesh);
 				m_materialSettings.m_receiveShadow = renderCommand.m_receiveShadow;
 				m_materialSettingsBuffer->SubData(0, sizeof(MaterialSettingsBlock), &m_materialSettings);
 				program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
@@ -105,7 +256,7 @@ void RenderLayer::RenderToCamera(const std::shared_ptr<Camera>& cameraComponent,
 			}
 
 			case RenderGeometryType::Strands: {
-				auto strands = std::dynamic_pointer_cast<Strands>(renderCommand.m_renderGeometry);
+				auto strands = GetGeometry<Strands>(renderCommand);
 				auto& program = DefaultResources::m_gBufferStrandsPrepass;
 				program->Bind();
 				ApplyProgramSettings(program, material);
@@ -117,21 +268,35 @@ void RenderLayer::RenderToCamera(const std::shared_ptr<Camera>& cameraComponent,
 			}
 			}
 		},
-		true);
+		true,
+		[&](const std::shared_ptr<Material>& material,
+			const RenderCommand& renderCommand,
+			const RenderInstanceBatch& batch) {
+			// Instance matrices are already in world space.
+			auto mesh = GetGeometry<Mesh>(renderCommand);
+			auto& program = DefaultResources::m_gBufferInstancedPrepass;
+			program->Bind();
+			ApplyProgramSettings(program, material);
+			m_materialSettings.m_receiveShadow = renderCommand.m_receiveShadow;
+			m_materialSettingsBuffer->SubData(0, sizeof(MaterialSettingsBlock), &m_materialSettings);
+			program->SetFloat4x4("model", glm::mat4(1.0f));
+			DeferredPrepassInstancedInternal(mesh, batch);
+		});
 	DispatchRenderCommands(
-		m_deferredInstancedRenderInstances[cameraComponent->GetHandle()],
+		RenderCommandPass::DeferredInstanced,
+		cameraSlot,
 		[&](const std::shared_ptr<Material>& material, const RenderCommand& renderCommand) {
 			switch (renderCommand.m_geometryType)
 			{
 			case RenderGeometryType::Mesh: {
-				auto mesh = std::dynamic_pointer_cast<Mesh>(renderCommand.m_renderGeometry);
+				auto mesh = GetGeometry<Mesh>(renderCommand);
 				auto& program = DefaultResources::m_gBufferInstancedColoredPrepass;
 				program->Bind();
 				ApplyProgramSettings(program, material);
 				m_materialSettings.m_receiveShadow = renderCommand.m_receiveShadow;
 				m_materialSettingsBuffer->SubData(0, sizeof(MaterialSettingsBlock), &m_materialSettings);
 				program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
-				DeferredPrepassInstancedInternal(mesh, renderCommand.m_matrices);
+				DeferredPrepassInstancedInternal(mesh, GetParticleMatrices(renderCommand));
 				break;
 			}
 			}
@@ -173,12 +338,13 @@ void RenderLayer::RenderToCamera(const std::shared_ptr<Camera>& cameraComponent,
 	OpenGLUtils::SetEnable(OpenGLCapability::DepthTest, true);
 #pragma region Forward rendering
 	DispatchRenderCommands(
-		m_forwardRenderInstances[cameraComponent->GetHandle()],
+		RenderCommandPass::Forward,
+		cameraSlot,
 		[&](const std::shared_ptr<Material>& material, const RenderCommand& renderCommand) {
 			switch (renderCommand.m_geometryType)
 			{
 			case RenderGeometryType::Mesh: {
-				auto mesh = std::dynamic_pointer_cast<Mesh>(renderCommand.m_renderGeometry);
+				auto mesh = GetGeometry<Mesh>(renderCommand);
 				m_materialSettings.m_receiveShadow = renderCommand.m_receiveShadow;
 				m_materialSettingsBuffer->SubData(0, sizeof(MaterialSettingsBlock), &m_materialSettings);
 				auto program = material->m_program.Get<OpenGLUtils::GLProgram>();
@@ -191,8 +357,8 @@ void RenderLayer::RenderToCamera(const std::shared_ptr<Camera>& cameraComponent,
 				break;
 			}
 			case RenderGeometryType::SkinnedMesh: {
-				auto skinnedMesh = std::dynamic_pointer_cast<SkinnedMesh>(renderCommand.m_renderGeometry);
-				renderCommand.m_boneMatrices->UploadBones(skinnedMesh);
+				auto skinnedMesh = GetGeometry<SkinnedMesh>(renderCommand);
+				GetBoneMatrices(renderCommand)->UploadBones(skinnedMesh);
 				m_materialSettings.m_receiveShadow = renderCommand.m_receiveShadow;
 				m_materialSettingsBuffer->SubData(0, sizeof(MaterialSettingsBlock), &m_materialSettings);
 				auto program = material->m_program.Get<OpenGLUtils::GLProgram>();
@@ -205,7 +371,7 @@ void RenderLayer::RenderToCamera(const std::shared_ptr<Camera>& cameraComponent,
 				break;
 			}
 			case RenderGeometryType::Strands: {
-				auto strands = std::dynamic_pointer_cast<Strands>(renderCommand.m_renderGeometry);
+				auto strands = GetGeometry<Strands>(renderCommand);
 				m_materialSettings.m_receiveShadow = renderCommand.m_receiveShadow;
 				m_materialSettingsBuffer->SubData(0, sizeof(MaterialSettingsBlock), &m_materialSettings);
 				auto program = material->m_program.Get<OpenGLUtils::GLProgram>();
@@ -221,12 +387,13 @@ void RenderLayer::RenderToCamera(const std::shared_ptr<Camera>& cameraComponent,
 		},
 		true);
 	DispatchRenderCommands(
-		m_forwardInstancedRenderInstances[cameraComponent->GetHandle()],
+		RenderCommandPass::ForwardInstanced,
+		cameraSlot,
 		[&](const std::shared_ptr<Material>& material, const RenderCommand& renderCommand) {
 			switch (renderCommand.m_geometryType)
 			{
 			case RenderGeometryType::Mesh: {
-				auto mesh = std::dynamic_pointer_cast<Mesh>(renderCommand.m_renderGeometry);
+				auto mesh = GetGeometry<Mesh>(renderCommand);
 				m_materialSettings.m_receiveShadow = renderCommand.m_receiveShadow;
 				m_materialSettingsBuffer->SubData(0, sizeof(MaterialSettingsBlock), &m_materialSettings);
 				auto program = material->m_program.Get<OpenGLUtils::GLProgram>();
@@ -235,7 +402,7 @@ void RenderLayer::RenderToCamera(const std::shared_ptr<Camera>& cameraComponent,
 				program->Bind();
 				ApplyProgramSettings(program, material);
 				program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
-				DrawMeshInstancedInternal(mesh, renderCommand.m_matrices);
+				DrawMeshInstancedInternal(mesh, GetParticleMatrices(renderCommand));
 				break;
 			}
 			}
@@ -256,12 +423,13 @@ void RenderLayer::RenderToCamera(const std::shared_ptr<Camera>& cameraComponent,
 #pragma endregion
 #pragma region Transparent
 	DispatchRenderCommands(
-		m_transparentRenderInstances[cameraComponent->GetHandle()],
+		RenderCommandPass::Transparent,
+		cameraSlot,
 		[&](const std::shared_ptr<Material>& material, const RenderCommand& renderCommand) {
 			switch (renderCommand.m_geometryType)
 			{
 			case RenderGeometryType::Mesh: {
-				auto mesh = std::dynamic_pointer_cast<Mesh>(renderCommand.m_renderGeometry);
+				auto mesh = GetGeometry<Mesh>(renderCommand);
 				m_materialSettings.m_receiveShadow = renderCommand.m_receiveShadow;
 				m_materialSettingsBuffer->SubData(0, sizeof(MaterialSettingsBlock), &m_materialSettings);
 				auto program = material->m_program.Get<OpenGLUtils::GLProgram>();
@@ -274,8 +442,8 @@ void RenderLayer::RenderToCamera(const std::shared_ptr<Camera>& cameraComponent,
 				break;
 			}
 			case RenderGeometryType::SkinnedMesh: {
-				auto skinnedMesh = std::dynamic_pointer_cast<SkinnedMesh>(renderCommand.m_renderGeometry);
-				renderCommand.m_boneMatrices->UploadBones(skinnedMesh);
+				auto skinnedMesh = GetGeometry<SkinnedMesh>(renderCommand);
+				GetBoneMatrices(renderCommand)->UploadBones(skinnedMesh);
 				m_materialSettings.m_receiveShadow = renderCommand.m_receiveShadow;
 				m_materialSettingsBuffer->SubData(0, sizeof(MaterialSettingsBlock), &m_materialSettings);
 				auto program = material->m_program.Get<OpenGLUtils::GLProgram>();
@@ -288,7 +456,7 @@ void RenderLayer::RenderToCamera(const std::shared_ptr<Camera>& cameraComponent,
 				break;
 			}
 			case RenderGeometryType::Strands: {
-				auto strands = std::dynamic_pointer_cast<Strands>(renderCommand.m_renderGeometry);
+				auto strands = GetGeometry<Strands>(renderCommand);
 				m_materialSettings.m_receiveShadow = renderCommand.m_receiveShadow;
 				m_materialSettingsBuffer->SubData(0, sizeof(MaterialSettingsBlock), &m_materialSettings);
 				auto program = material->m_program.Get<OpenGLUtils::GLProgram>();
@@ -304,12 +472,13 @@ void RenderLayer::RenderToCamera(const std::shared_ptr<Camera>& cameraComponent,
 		},
 		true);
 	DispatchRenderCommands(
-		m_instancedTransparentRenderInstances[cameraComponent->GetHandle()],
+		RenderCommandPass::InstancedTransparent,
+		cameraSlot,
 		[&](const std::shared_ptr<Material>& material, const RenderCommand& renderCommand) {
 			switch (renderCommand.m_geometryType)
 			{
 			case RenderGeometryType::Mesh: {
-				auto mesh = std::dynamic_pointer_cast<Mesh>(renderCommand.m_renderGeometry);
+				auto mesh = GetGeometry<Mesh>(renderCommand);
 				m_materialSettings.m_receiveShadow = renderCommand.m_receiveShadow;
 				m_materialSettingsBuffer->SubData(0, sizeof(MaterialSettingsBlock), &m_materialSettings);
 				auto program = material->m_program.Get<OpenGLUtils::GLProgram>();
@@ -318,7 +487,7 @@ void RenderLayer::RenderToCamera(const std::shared_ptr<Camera>& cameraComponent,
 				program->Bind();
 				ApplyProgramSettings(program, material);
 				program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
-				DrawMeshInstancedInternal(mesh, renderCommand.m_matrices);
+				DrawMeshInstancedInternal(mesh, GetParticleMatrices(renderCommand));
 				break;
 			}
 			}
@@ -330,37 +499,40 @@ void RenderLayer::RenderToCamera(const std::shared_ptr<Camera>& cameraComponent,
 }
 void RenderLayer::PreUpdate()
 {
-	ProfilerLayer::StartEvent("Graphics");
-
-	ProfilerLayer::StartEvent("Clear GBuffer");
-	m_deferredRenderInstances.clear();
-	m_deferredInstancedRenderInstances.clear();
-	m_forwardRenderInstances.clear();
-	m_forwardInstancedRenderInstances.clear();
-	m_transparentRenderInstances.clear();
-	m_instancedTransparentRenderInstances.clear();
-	ProfilerLayer::EndEvent("Clear GBuffer");
-	ProfilerLayer::EndEvent("Graphics");
+	ProfilerLayer::StartEvent(UNIENGINE_PROFILE_EVENT("Graphics"));
+
+	ProfilerLayer::StartEvent(UNIENGINE_PROFILE_EVENT("Clear GBuffer"));
+	m_renderCommands.clear();
+	m_renderResources.Clear();
+	m_cameraSlots.clear();
+	m_cameraSlotIndices.clear();
+	for (auto& range : m_passRanges)
+		range = { 0, 0 };
+	for (auto& order : m_transparentCommandOrders)
+		order.clear();
+	ProfilerLayer::EndEvent(UNIENGINE_PROFILE_EVENT("Clear GBuffer"));
+	ProfilerLayer::EndEvent(UNIENGINE_PROFILE_EVENT("Graphics"));
 }
 void RenderLayer::LateUpdate()
 {
-	ProfilerLayer::StartEvent("Graphics");
+	ProfilerLayer::StartEvent(UNIENGINE_PROFILE_EVENT("Graphics"));
 	auto scene = GetScene();
 	if (!scene)
 		return;
 
 	std::shared_ptr<Camera> mainCamera = scene->m_mainCamera.Get<Camera>();
 #pragma region Collect RenderCommands
-	ProfilerLayer::StartEvent("RenderCommand Collection");
+	ProfilerLayer::StartEvent(UNIENGINE_PROFILE_EVENT("RenderCommand Collection"));
 	Bound worldBound;
 	CollectRenderInstances(worldBound);
-	ProfilerLayer::EndEvent("RenderCommand Collection");
+	ProfilerLayer::EndEvent(UNIENGINE_PROFILE_EVENT("RenderCommand Collection"));
 	scene->SetBound(worldBound);
 #pragma endregion
 #pragma region Render to cameras
-	ProfilerLayer::StartEvent("Main Rendering");
+	ProfilerLayer::StartEvent(UNIENGINE_PROFILE_EVENT("Main Rendering"));
 	m_triangles = 0;
 	m_drawCall = 0;
+	m_mergedDrawCall = 0;
 	if (mainCamera)
 	{
 		if (m_allowAutoResize)
@@ -381,10 +553,10 @@ void RenderLayer::LateUpdate()
 			}
 		}
 	}
-	ProfilerLayer::EndEvent("Main Rendering");
+	ProfilerLayer::EndEvent(UNIENGINE_PROFILE_EVENT("Main Rendering"));
 #pragma endregion
 #pragma region Post - processing
-	ProfilerLayer::StartEvent("Post Processing");
+	ProfilerLayer::StartEvent(UNIENGINE_PROFILE_EVENT("Post Processing"));
 	const std::vector<Entity>* postProcessingEntities =
 		scene->UnsafeGetPrivateComponentOwnersList<PostProcessing>();
 	if (postProcessingEntities != nullptr)
@@ -398,10 +570,10 @@ void RenderLayer::LateUpdate()
 				postProcessing->Process();
 		}
 	}
-	ProfilerLayer::EndEvent("Post Processing");
+	ProfilerLayer::EndEvent(UNIENGINE_PROFILE_EVENT("Post Processing"));
 #pragma endregion
 	m_frameIndex++;
-	ProfilerLayer::EndEvent("Graphics");
+	ProfilerLayer::EndEvent(UNIENGINE_PROFILE_EVENT("Graphics"));
 }
 glm::vec3 RenderLayer::ClosestPointOnLine(const glm::vec3& point, const glm::vec3& a, const glm::vec3& b)
 {
@@ -457,6 +629,26 @@ void RenderLayer::OnInspect()
 			ImGui::DragFloat("Seam fix ratio", &m_renderSettings.m_seamFixRatio, 0.001f, 0.0f, 0.1f);
 			ImGui::Checkbox("Stable fit", &m_stableFit);
 		}
+		if (ImGui::CollapsingHeader("Occlusion culling"))
+		{
+			ImGui::Checkbox("Enabled##Occlusion culling", &m_occlusionCulling);
+			ImGui::DragFloat("Occluder screen size", &m_occluderScreenSize, 0.01f, 0.0f, 2.0f);
+			ImGui::DragInt("Occluder max triangles", &m_occluderMaxTriangles, 16, 0, 65536);
+			ImGui::DragInt("Max occluders", &m_maxOccluders, 1, 0, 256);
+			ImGui::DragInt("Buffer width", &m_occlusionBufferWidth, 4, 64, 1024);
+		}
+		if (ImGui::CollapsingHeader("Dynamic instancing"))
+		{
+			ImGui::Checkbox("Enabled##Dynamic instancing", &m_dynamicInstancing);
+			ImGui::DragInt("Min batch size", &m_minInstanceBatchSize, 1, 2, 1024);
+			ImGui::Text("Draw calls: %zu, merged: %zu", m_drawCall, m_mergedDrawCall);
+		}
+		if (ImGui::CollapsingHeader("Static render cache"))
+		{
+			if (ImGui::Checkbox("Enabled##Static render cache", &m_staticRenderCache))
+				ClearStaticRenderCache();
+			ImGui::Text("Cached renderers: %zu", m_staticCandidateCount);
+		}
 
 		if (ImGui::TreeNodeEx("Strands settings", ImGuiTreeNodeFlags_DefaultOpen))
 		{
@@ -485,6 +677,7 @@ void RenderLayer::OnCreate()
 
 	m_instancedColorBuffer = std::make_unique<OpenGLUtils::GLBuffer>(OpenGLUtils::GLBufferTarget::Array);
 	m_instancedMatricesBuffer = std::make_unique<OpenGLUtils::GLBuffer>(OpenGLUtils::GLBufferTarget::Array);
+	m_instanceBatchBuffer = std::make_unique<OpenGLUtils::GLBuffer>(OpenGLUtils::GLBufferTarget::Array);
 	SkinnedMesh::m_matricesBuffer = std::make_unique<OpenGLUtils::GLBuffer>(OpenGLUtils::GLBufferTarget::Array);
 #pragma region Kernel Setup
 	std::vector<glm::vec4> uniformKernel;
@@ -535,14 +728,22 @@ void RenderLayer::OnCreate()
 void RenderLayer::CollectRenderInstances(Bound& worldBound)
 {
 	auto scene = GetScene();
-	std::vector<std::pair<std::shared_ptr<Camera>, glm::vec3>> cameraPairs;
+	struct CameraEntry
+	{
+		std::shared_ptr<Camera> m_camera;
+		glm::vec3 m_position;
+		glm::quat m_rotation;
+		std::string m_name;
+	};
+	std::vector<CameraEntry> cameraEntries;
 	auto editorLayer = Application::GetLayer<EditorLayer>();
 	if (editorLayer)
 	{
 		auto& sceneCamera = editorLayer->m_sceneCamera;
 		if (sceneCamera && sceneCamera->IsEnabled())
 		{
-			cameraPairs.emplace_back(sceneCamera, editorLayer->m_sceneCameraPosition);
+			cameraEntries.push_back(
+				{ sceneCamera, editorLayer->m_sceneCameraPosition, editorLayer->m_sceneCameraRotation, "Scene camera" });
 		}
 	}
 	const std::vector<Entity>* cameraEntities =
@@ -557,87 +758,95 @@ void RenderLayer::CollectRenderInstances(Bound& worldBound)
 			auto camera = scene->GetOrSetPrivateComponent<Camera>(i).lock();
 			if (!camera || !camera->IsEnabled())
 				continue;
-			cameraPairs.emplace_back(camera, scene->GetDataComponent<GlobalTransform>(i).GetPosition());
+			const auto globalTransform = scene->GetDataComponent<GlobalTransform>(i);
+			cameraEntries.push_back(
+				{ camera, globalTransform.GetPosition(), globalTransform.GetRotation(), scene->GetEntityName(i) });
 		}
 	}
 	auto& minBound = worldBound.m_min;
 	auto& maxBound = worldBound.m_max;
 	minBound = glm::vec3(INT_MAX);
 	maxBound = glm::vec3(INT_MIN);
-
+#pragma region Gather
+	// Every enabled renderer becomes one candidate with its world space bound packed into m_cullingBounds at the same
+	// index. Mesh renderers of static entities come first and are kept from the previous frames.
+	if (scene->GetHandle().GetValue() != m_sceneBvhHandle)
+	{
+		m_sceneBvh.Clear();
+		ClearStaticRenderCache();
+		m_sceneBvhHandle = scene->GetHandle().GetValue();
+	}
+	const auto expandWorldBound = [&](const Bound& bound) {
+		const glm::vec3 center = bound.Center();
+		const glm::vec3 size = bound.Size();
+		minBound = glm::vec3(
+			(glm::min)(minBound.x, center.x - size.x),
+			(glm::min)(minBound.y, center.y - size.y),
+			(glm::min)(minBound.z, center.z - size.z));
+		maxBound = glm::vec3(
+			(glm::max)(maxBound.x, center.x + size.x),
+			(glm::max)(maxBound.y, center.y + size.y),
+			(glm::max)(maxBound.z, center.z + size.z));
+	};
 	const std::vector<Entity>* owners =
 		scene->UnsafeGetPrivateComponentOwnersList<MeshRenderer>();
-	if (owners)
+	// The split only changes with the entities, which bump the static version of the scene.
+	const size_t staticVersion = scene->GetStaticVersion();
+	const bool sceneChanged = !m_ownersValid || staticVersion != m_ownersVersion;
+	if (sceneChanged)
 	{
-		for (auto owner : *owners)
+		m_staticOwners.clear();
+		m_dynamicOwners.clear();
+		if (owners)
 		{
-			if (!scene->IsEntityEnabled(owner))
-				continue;
-			auto mmc = scene->GetOrSetPrivateComponent<MeshRenderer>(owner).lock();
-			auto material = mmc->m_material.Get<Material>();
-			auto mesh = mmc->m_mesh.Get<Mesh>();
-			if (!mmc->IsEnabled() || material == nullptr || mesh == nullptr)
-				continue;
-			auto gt = scene->GetDataComponent<GlobalTransform>(owner);
-			auto ltw = gt.m_value;
-			auto meshBound = mesh->m_bound;
-			meshBound.ApplyTransform(ltw);
-			glm::vec3 center = meshBound.Center();
-
-			glm::vec3 size = meshBound.Size();
-			minBound = glm::vec3(
-				(glm::min)(minBound.x, center.x - size.x),
-				(glm::min)(minBound.y, center.y - size.y),
-				(glm::min)(minBound.z, center.z - size.z));
-			maxBound = glm::vec3(
-				(glm::max)(maxBound.x, center.x + size.x),
-				(glm::max)(maxBound.y, center.y + size.y),
-				(glm::max)(maxBound.z, center.z + size.z));
-
-			auto meshCenter = gt.m_value * glm::vec4(center, 1.0);
-			for (const auto& pair : cameraPairs)
+			for (const auto& owner : *owners)
 			{
-				auto& deferredRenderInstances = m_deferredRenderInstances[pair.first->GetHandle()];
-				auto& deferredInstancedRenderInstances = m_deferredInstancedRenderInstances[pair.first->GetHandle()];
-				auto& forwardRenderInstances = m_forwardRenderInstances[pair.first->GetHandle()];
-				auto& forwardInstancedRenderInstances = m_forwardInstancedRenderInstances[pair.first->GetHandle()];
-				auto& transparentRenderInstances = m_transparentRenderInstances[pair.first->GetHandle()];
-				auto& instancedTransparentRenderInstances = m_instancedTransparentRenderInstances[pair.first->GetHandle()];
-
-				deferredRenderInstances.m_camera = pair.first;
-				deferredInstancedRenderInstances.m_camera = pair.first;
-				forwardRenderInstances.m_camera = pair.first;
-				forwardInstancedRenderInstances.m_camera = pair.first;
-				transparentRenderInstances.m_camera = pair.first;
-				instancedTransparentRenderInstances.m_camera = pair.first;
-
-				RenderCommand renderInstance;
-				renderInstance.m_owner = owner;
-				renderInstance.m_globalTransform = gt;
-				renderInstance.m_renderGeometry = mesh;
-				renderInstance.m_castShadow = mmc->m_castShadow;
-				renderInstance.m_receiveShadow = mmc->m_receiveShadow;
-				renderInstance.m_geometryType = RenderGeometryType::Mesh;
-				if (material->m_drawSettings.m_blending)
-				{
-					auto& group = transparentRenderInstances.m_renderCommandsGroups[material->GetHandle()];
-					group.m_material = material;
-					group.m_renderCommands[mesh->GetHandle()].push_back(renderInstance);
-				}
-				else if (mmc->m_forwardRendering)
-				{
-					auto& group = forwardRenderInstances.m_renderCommandsGroups[material->GetHandle()];
-					group.m_material = material;
-					group.m_renderCommands[mesh->GetHandle()].push_back(renderInstance);
-				}
+				if (!scene->IsEntityEnabled(owner))
+					continue;
+				if (m_staticRenderCache && scene->IsEntityStatic(owner))
+					m_staticOwners.push_back(owner);
 				else
-				{
-					auto& group = deferredRenderInstances.m_renderCommandsGroups[material->GetHandle()];
-					group.m_material = material;
-					group.m_renderCommands[mesh->GetHandle()].push_back(renderInstance);
-				}
+					m_dynamicOwners.push_back(owner);
 			}
 		}
+		m_ownersVersion = staticVersion;
+		m_ownersValid = true;
+	}
+	ProfilerLayer::StartEvent(UNIENGINE_PROFILE_EVENT("Static render cache"));
+	m_renderCandidates.resize(m_staticCandidateCount);
+	m_cullingBounds.Resize(m_staticCandidateCount);
+	if (UpdateStaticRenderCache(scene, m_staticOwners, sceneChanged))
+		SortStaticDraws();
+	if (m_staticCandidateCount != 0)
+	{
+		minBound = (glm::min)(minBound, m_staticWorldBound.m_min);
+		maxBound = (glm::max)(maxBound, m_staticWorldBound.m_max);
+	}
+	// Frame indices of the static meshes and materials, one lookup for each of them however many renderers use it.
+	m_staticGeometryIndices.resize(m_staticRenderResources.m_geometries.size());
+	for (size_t i = 0; i < m_staticGeometryIndices.size(); i++)
+		m_staticGeometryIndices[i] = m_renderResources.Add(m_staticRenderResources.m_geometries[i]);
+	m_staticMaterialIndices.resize(m_staticRenderResources.m_materials.size());
+	for (size_t i = 0; i < m_staticMaterialIndices.size(); i++)
+		m_staticMaterialIndices[i] = m_renderResources.Add(m_staticRenderResources.m_materials[i]);
+	ProfilerLayer::EndEvent(UNIENGINE_PROFILE_EVENT("Static render cache"));
+	ProfilerLayer::SetCounter("Static renderers", m_staticCandidateCount, m_staticOwners.size() + m_dynamicOwners.size());
+
+	auto& candidates = m_renderCandidates;
+	const auto addCandidate = [&](RenderCandidate&& candidate, const Bound& bound) {
+		expandWorldBound(bound);
+		PrepareRenderCandidate(candidate, bound, m_renderResources);
+		if (!candidate.m_alwaysVisible)
+			m_sceneBvh.Merge(candidate.m_command.m_owner, bound);
+		m_cullingBounds.Push(bound);
+		candidates.push_back(std::move(candidate));
+	};
+	for (const auto& owner : m_dynamicOwners)
+	{
+		RenderCandidate candidate;
+		Bound meshBound;
+		if (GatherMeshRenderer(scene, owner, candidate, meshBound))
+			addCandidate(std::move(candidate), meshBound);
 	}
 	owners = scene->UnsafeGetPrivateComponentOwnersList<Particles>();
 	if (owners)
@@ -652,64 +861,23 @@ void RenderLayer::CollectRenderInstances(Bound& worldBound)
 			if (!particles->IsEnabled() || material == nullptr || mesh == nullptr)
 				continue;
 			auto gt = scene->GetDataComponent<GlobalTransform>(owner);
-			auto ltw = gt.m_value;
 			auto meshBound = mesh->GetBound();
-			meshBound.ApplyTransform(ltw);
-			glm::vec3 center = meshBound.Center();
-
-			glm::vec3 size = meshBound.Size();
-			minBound = glm::vec3(
-				(glm::min)(minBound.x, center.x - size.x),
-				(glm::min)(minBound.y, center.y - size.y),
-				(glm::min)(minBound.z, center.z - size.z));
-
-			maxBound = glm::vec3(
-				(glm::max)(maxBound.x, center.x + size.x),
-				(glm::max)(maxBound.y, center.y + size.y),
-				(glm::max)(maxBound.z, center.z + size.z));
-			for (const auto& pair : cameraPairs)
-			{
-				auto& deferredRenderInstances = m_deferredRenderInstances[pair.first->GetHandle()];
-				auto& deferredInstancedRenderInstances = m_deferredInstancedRenderInstances[pair.first->GetHandle()];
-				auto& forwardRenderInstances = m_forwardRenderInstances[pair.first->GetHandle()];
-				auto& forwardInstancedRenderInstances = m_forwardInstancedRenderInstances[pair.first->GetHandle()];
-				auto& transparentRenderInstances = m_transparentRenderInstances[pair.first->GetHandle()];
-				auto& instancedTransparentRenderInstances = m_instancedTransparentRenderInstances[pair.first->GetHandle()];
-
-				deferredRenderInstances.m_camera = pair.first;
-				deferredInstancedRenderInstances.m_camera = pair.first;
-				forwardRenderInstances.m_camera = pair.first;
-				forwardInstancedRenderInstances.m_camera = pair.first;
-				transparentRenderInstances.m_camera = pair.first;
-				instancedTransparentRenderInstances.m_camera = pair.first;
-
-				RenderCommand renderInstance;
-				renderInstance.m_owner = owner;
-				renderInstance.m_globalTransform = gt;
-				renderInstance.m_renderGeometry = mesh;
-				renderInstance.m_castShadow = particles->m_castShadow;
-				renderInstance.m_receiveShadow = particles->m_receiveShadow;
-				renderInstance.m_matrices = particles->m_matrices;
-				renderInstance.m_geometryType = RenderGeometryType::Mesh;
-				if (material->m_drawSettings.m_blending)
-				{
-					auto& group = instancedTransparentRenderInstances.m_renderCommandsGroups[material->GetHandle()];
-					group.m_material = material;
-					group.m_renderCommands[mesh->GetHandle()].push_back(renderInstance);
-				}
-				else if (particles->m_forwardRendering)
-				{
-					auto& group = forwardInstancedRenderInstances.m_renderCommandsGroups[material->GetHandle()];
-					group.m_material = material;
-					group.m_renderCommands[mesh->GetHandle()].push_back(renderInstance);
-				}
-				else
-				{
-					auto& group = deferredInstancedRenderInstances.m_renderCommandsGroups[material->GetHandle()];
-					group.m_material = material;
-					group.m_renderCommands[mesh->GetHandle()].push_back(renderInstance);
-				}
-			}
+			meshBound.ApplyTransform(gt.m_value);
+
+			RenderCandidate candidate;
+			candidate.m_command.m_owner = owner;
+			candidate.m_command.m_globalTransform = gt;
+			candidate.m_geometry = mesh;
+			candidate.m_command.m_castShadow = particles->m_castShadow;
+			candidate.m_command.m_receiveShadow = particles->m_receiveShadow;
+			candidate.m_command.m_matricesIndex = m_renderResources.Add(particles->m_matrices);
+			candidate.m_command.m_geometryType = RenderGeometryType::Mesh;
+			candidate.m_material = material;
+			candidate.m_forwardRendering = particles->m_forwardRendering;
+			candidate.m_instanced = true;
+			// The bound of the particles is only refreshed on request, it does not follow the instance matrices.
+			candidate.m_alwaysVisible = true;
+			addCandidate(std::move(candidate), meshBound);
 		}
 	}
 	owners = scene->UnsafeGetPrivateComponentOwnersList<SkinnedMeshRenderer>();
@@ -734,63 +902,22 @@ void RenderLayer::CollectRenderInstances(Bound& worldBound)
 			{
 				gt = scene->GetDataComponent<GlobalTransform>(owner);
 			}
-			auto ltw = gt.m_value;
 			auto meshBound = skinnedMesh->GetBound();
-			meshBound.ApplyTransform(ltw);
-			glm::vec3 center = meshBound.Center();
-
-			glm::vec3 size = meshBound.Size();
-			minBound = glm::vec3(
-				(glm::min)(minBound.x, center.x - size.x),
-				(glm::min)(minBound.y, center.y - size.y),
-				(glm::min)(minBound.z, center.z - size.z));
-			maxBound = glm::vec3(
-				(glm::max)(maxBound.x, center.x + size.x),
-				(glm::max)(maxBound.y, center.y + size.y),
-				(glm::max)(maxBound.z, center.z + size.z));
-			for (const auto& pair : cameraPairs)
-			{
-				auto& deferredRenderInstances = m_deferredRenderInstances[pair.first->GetHandle()];
-				auto& deferredInstancedRenderInstances = m_deferredInstancedRenderInstances[pair.first->GetHandle()];
-				auto& forwardRenderInstances = m_forwardRenderInstances[pair.first->GetHandle()];
-				auto& forwardInstancedRenderInstances = m_forwardInstancedRenderInstances[pair.first->GetHandle()];
-				auto& transparentRenderInstances = m_transparentRenderInstances[pair.first->GetHandle()];
-				auto& instancedTransparentRenderInstances = m_instancedTransparentRenderInstances[pair.first->GetHandle()];
-
-				deferredRenderInstances.m_camera = pair.first;
-				deferredInstancedRenderInstances.m_camera = pair.first;
-				forwardRenderInstances.m_camera = pair.first;
-				forwardInstancedRenderInstances.m_camera = pair.first;
-				transparentRenderInstances.m_camera = pair.first;
-				instancedTransparentRenderInstances.m_camera = pair.first;
-
-				RenderCommand renderInstance;
-				renderInstance.m_owner = owner;
-				renderInstance.m_globalTransform = gt;
-				renderInstance.m_renderGeometry = skinnedMesh;
-				renderInstance.m_castShadow = smmc->m_castShadow;
-				renderInstance.m_receiveShadow = smmc->m_receiveShadow;
-				renderInstance.m_geometryType = RenderGeometryType::SkinnedMesh;
-				renderInstance.m_boneMatrices = smmc->m_finalResults;
-				if (material->m_drawSettings.m_blending)
-				{
-					auto& group = transparentRenderInstances.m_renderCommandsGroups[material->GetHandle()];
-					group.m_material = material;
-					group.m_renderCommands[skinnedMesh->GetHandle()].push_back(renderInstance);
-				}
-				else if (smmc->m_forwardRendering)
-				{
-					auto& group = forwardRenderInstances.m_renderCommandsGroups[material->GetHandle()];
-					group.m_material = material;
-					group.m_renderCommands[skinnedMesh->GetHandle()].push_back(renderInstance);
-				}
-				else
-				{
-					auto& group = deferredRenderInstances.m_renderCommandsGroups[material->GetHandle()];
-					group.m_material = material;
-					group.m_renderCommands[skinnedMesh->GetHandle()].push_back(renderInstance);
-				}
-			}
+			meshBound.ApplyTransform(gt.m_value);
+
+			RenderCandidate candidate;
+			candidate.m_command.m_owner = owner;
+			candidate.m_command.m_globalTransform = gt;
+			candidate.m_geometry = skinnedMesh;
+			candidate.m_command.m_castShadow = smmc->m_castShadow;
+			candidate.m_command.m_receiveShadow = smmc->m_receiveShadow;
+			candidate.m_command.m_geometryType = RenderGeometryType::SkinnedMesh;
+			candidate.m_command.m_matricesIndex = m_renderResources.Add(smmc->m_finalResults);
+			candidate.m_material = material;
+			candidate.m_forwardRendering = smmc->m_forwardRendering;
+			// A ragdoll is posed by its bones in world space, the bind pose bound says nothing about where it is.
+			candidate.m_alwaysVisible = smmc->m_ragDoll;
+			addCandidate(std::move(candidate), meshBound);
 		}
 	}
 	owners =
@@ -807,67 +934,796 @@ void RenderLayer::CollectRenderInstances(Bound& worldBound)
 			if (!mmc->IsEnabled() || material == nullptr || strands == nullptr)
 				continue;
 			auto gt = scene->GetDataComponent<GlobalTransform>(owner);
-			auto ltw = gt.m_value;
 			auto meshBound = strands->m_bound;
-			meshBound.ApplyTransform(ltw);
-			glm::vec3 center = meshBound.Center();
-
-			glm::vec3 size = meshBound.Size();
-			minBound = glm::vec3(
-				(glm::min)(minBound.x, center.x - size.x),
-				(glm::min)(minBound.y, center.y - size.y),
-				(glm::min)(minBound.z, center.z - size.z));
-			maxBound = glm::vec3(
-				(glm::max)(maxBound.x, center.x + size.x),
-				(glm::max)(maxBound.y, center.y + size.y),
-				(glm::max)(maxBound.z, center.z + size.z));
-
-			auto meshCenter = gt.m_value * glm::vec4(center, 1.0);
-			for (const auto& pair : cameraPairs)
+			meshBound.ApplyTransform(gt.m_value);
+
+			RenderCandidate candidate;
+			candidate.m_command.m_owner = owner;
+			candidate.m_command.m_globalTransform = gt;
+			candidate.m_geometry = strands;
+			candidate.m_command.m_castShadow = mmc->m_castShadow;
+			candidate.m_command.m_receiveShadow = mmc->m_receiveShadow;
+			candidate.m_command.m_geometryType = RenderGeometryType::Strands;
+			candidate.m_material = material;
+			candidate.m_forwardRendering = mmc->m_forwardRendering;
+			addCandidate(std::move(candidate), meshBound);
+		}
+	}
+	m_sceneBvh.RemoveStale();
+#pragma endregion
+	// Fraction of the screen height covered by the bounding sphere, the vertical fov of the camera projection is
+	// m_fov * 0.5.
+	const auto getScreenSize = [](const CameraEntry& cameraEntry, const RenderCandidate& candidate) {
+		const auto& camera = cameraEntry.m_camera;
+		const float distance =
+			(glm::max)(glm::distance(cameraEntry.m_position, candidate.m_command.m_center), camera->m_nearDistance);
+		return candidate.m_radius / (distance * glm::tan(glm::radians(camera->m_fov * 0.25f)));
+	};
+	constexpr size_t MinSliceSize = 1024;
+	const auto workerAmount = static_cast<size_t>(Jobs::Workers().Size());
+	const auto getSliceAmount = [&](const size_t& count) {
+		return static_cast<unsigned>(
+			workerAmount > 1 ? (glm::clamp)(count / MinSliceSize, static_cast<size_t>(1), workerAmount) : 1);
+	};
+	// Split [0, count) into at most one slice per worker.
+	const auto forEachSlice = [&](const size_t& count,
+								  const std::function<void(unsigned sliceIndex, size_t begin, size_t end)>& func) {
+		const auto sliceAmount = getSliceAmount(count);
+		const size_t sliceSize = (count + sliceAmount - 1) / sliceAmount;
+		const auto runSlice = [&](unsigned sliceIndex) {
+			func(sliceIndex, sliceIndex * sliceSize, (glm::min)(count, (sliceIndex + 1) * sliceSize));
+		};
+		if (sliceAmount > 1)
+		{
+			std::vector<std::shared_future<void>> results;
+			Jobs::ParallelFor(sliceAmount, runSlice, results);
+			for (const auto& i : results)
+				i.wait();
+		}
+		else
+		{
+			runSlice(0);
+		}
+	};
+	// Camera slot -> position, view direction, near distance and depth range, for the transparent order.
+	struct CameraView
+	{
+		glm::vec3 m_position = glm::vec3(0.0f);
+		glm::vec3 m_front = glm::vec3(0, 0, -1);
+		float m_nearDistance = 0.0f;
+		float m_depthRange = 1.0f;
+	};
+	std::vector<CameraView> cameraViews;
+#pragma region Cull
+	// Cached static candidates still hold the masks of the previous frame.
+	forEachSlice(m_staticCandidateCount, [&](unsigned sliceIndex, size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++)
+		{
+			auto& candidate = candidates[i];
+			candidate.m_cameraMask = 0;
+			std::fill(candidate.m_lodCameraMasks.begin(), candidate.m_lodCameraMasks.end(), 0);
+		}
+	});
+	for (const auto& cameraEntry : cameraEntries)
+	{
+		const auto& camera = cameraEntry.m_camera;
+		const auto cameraHandle = camera->GetHandle();
+		const auto cameraSlot = RegisterCamera(camera);
+		if (cameraSlot == NoCameraSlot)
+			continue;
+		const uint64_t cameraBit = uint64_t(1) << cameraSlot;
+
+		const glm::vec3 front = cameraEntry.m_rotation * glm::vec3(0, 0, -1);
+		const glm::vec3 up = cameraEntry.m_rotation * glm::vec3(0, 1, 0);
+		if (cameraViews.size() <= cameraSlot)
+			cameraViews.resize(cameraSlot + 1);
+		cameraViews[cameraSlot] = { cameraEntry.m_position,
+									front,
+									camera->m_nearDistance,
+									(glm::max)(camera->m_farDistance - camera->m_nearDistance, FLT_EPSILON) };
+		const glm::mat4 projectionView =
+			camera->GetProjection() * glm::lookAt(cameraEntry.m_position, cameraEntry.m_position + front, up);
+		const Frustum frustum(projectionView);
+		m_cullingBounds.Cull(frustum, m_cullingVisibility);
+
+		size_t occludedCount = 0;
+		if (m_occlusionCulling)
+		{
+			ProfilerLayer::StartEvent(UNIENGINE_PROFILE_EVENT("Occlusion culling"));
+			// Flagged occluders first, then the largest opaque meshes on screen that are cheap enough to rasterize.
+			std::vector<std::pair<float, size_t>> occluders;
+			for (size_t i = 0; i < candidates.size(); i++)
+			{
+				const auto& candidate = candidates[i];
+				if (!m_cullingVisibility[i] || candidate.m_alwaysVisible || !candidate.m_meshRenderer ||
+					candidate.m_material->m_drawSettings.m_blending)
+					continue;
+				const auto mesh = std::static_pointer_cast<Mesh>(candidate.m_geometry);
+				if (candidate.m_meshRenderer->m_occluder)
+				{
+					occluders.emplace_back(FLT_MAX, i);
+					continue;
+				}
+				if (mesh->GetTriangleAmount() > static_cast<size_t>(m_occluderMaxTriangles))
+					continue;
+				const float screenSize = getScreenSize(cameraEntry, candidate);
+				if (screenSize >= m_occluderScreenSize)
+					occluders.emplace_back(screenSize, i);
+			}
+			if (!occluders.empty())
 			{
-				auto& deferredRenderInstances = m_deferredRenderInstances[pair.first->GetHandle()];
-				auto& deferredInstancedRenderInstances = m_deferredInstancedRenderInstances[pair.first->GetHandle()];
-				auto& forwardRenderInstances = m_forwardRenderInstances[pair.first->GetHandle()];
-				auto& forwardInstancedRenderInstances = m_forwardInstancedRenderInstances[pair.first->GetHandle()];
-				auto& transparentRenderInstances = m_transparentRenderInstances[pair.first->GetHandle()];
-				auto& instancedTransparentRenderInstances = m_instancedTransparentRenderInstances[pair.first->GetHandle()];
-
-				deferredRenderInstances.m_camera = pair.first;
-				deferredInstancedRenderInstances.m_camera = pair.first;
-				forwardRenderInstances.m_camera = pair.first;
-				forwardInstancedRenderInstances.m_camera = pair.first;
-				transparentRenderInstances.m_camera = pair.first;
-				instancedTransparentRenderInstances.m_camera = pair.first;
-
-				RenderCommand renderInstance;
-				renderInstance.m_owner = owner;
-				renderInstance.m_globalTransform = gt;
-				renderInstance.m_renderGeometry = strands;
-				renderInstance.m_castShadow = mmc->m_castShadow;
-				renderInstance.m_receiveShadow = mmc->m_receiveShadow;
-				renderInstance.m_geometryType = RenderGeometryType::Strands;
-				if (material->m_drawSettings.m_blending)
+				std::sort(occluders.begin(), occluders.end(), [](const auto& a, const auto& b) {
+					return a.first > b.first;
+				});
+				if (occluders.size() > static_cast<size_t>(m_maxOccluders))
+					occluders.resize((glm::max)(m_maxOccluders, 0));
+				const auto width = static_cast<unsigned>((glm::max)(m_occlusionBufferWidth, 4));
+				const auto height = static_cast<unsigned>((glm::max)(width / camera->GetResolutionRatio(), 1.0f));
+				m_occlusionBuffer.Begin(projectionView, width, height);
+				m_occluderIndices.clear();
+				for (const auto& occluder : occluders)
 				{
-					auto& group = transparentRenderInstances.m_renderCommandsGroups[material->GetHandle()];
-					group.m_material = material;
-					group.m_renderCommands[strands->GetHandle()].push_back(renderInstance);
+					const auto& candidate = candidates[occluder.second];
+					const auto mesh = std::static_pointer_cast<Mesh>(candidate.m_geometry);
+					m_occlusionBuffer.AddOccluder(
+						mesh->PeekVertexStreams().m_positions, mesh->PeekTriangles(),
+						candidate.m_command.m_globalTransform.m_value);
+					m_occluderIndices.push_back(occluder.second);
 				}
-				else if (mmc->m_forwardRendering)
+				m_occlusionBuffer.Rasterize();
+				// Occluders are visible by construction, testing them against their own depth is only a chance to
+				// lose them to rounding.
+				for (const auto& i : m_occluderIndices)
+					m_cullingVisibility[i] = 0;
+				occludedCount = m_occlusionBuffer.Test(m_cullingBounds, m_cullingVisibility);
+				for (const auto& i : m_occluderIndices)
+					m_cullingVisibility[i] = 1;
+			}
+			ProfilerLayer::EndEvent(UNIENGINE_PROFILE_EVENT("Occlusion culling"));
+		}
+
+		// Candidates are only touched by the slice that owns them, so the masks and LOD levels need no locking.
+		std::vector<size_t> visibleCounts(getSliceAmount(candidates.size()), 0);
+		forEachSlice(candidates.size(), [&](unsigned sliceIndex, size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++)
+			{
+				auto& candidate = candidates[i];
+				if (!m_cullingVisibility[i] && !candidate.m_alwaysVisible)
+					continue;
+				visibleCounts[sliceIndex]++;
+				if (candidate.m_lodChain)
 				{
-					auto& group = forwardRenderInstances.m_renderCommandsGroups[material->GetHandle()];
-					group.m_material = material;
-					group.m_renderCommands[strands->GetHandle()].push_back(renderInstance);
+					const float screenSize = getScreenSize(cameraEntry, candidate);
+					auto& level = candidate.m_meshRenderer->m_lodLevels[cameraHandle];
+					level = candidate.m_lodChain->SelectLevel(screenSize, level);
+					candidate.m_lodCameraMasks[(glm::min)(level, static_cast<unsigned>(candidate.m_lodCameraMasks.size() - 1))] |=
+						cameraBit;
 				}
 				else
 				{
-					auto& group = deferredRenderInstances.m_renderCommandsGroups[material->GetHandle()];
-					group.m_material = material;
-					group.m_renderCommands[strands->GetHandle()].push_back(renderInstance);
+					candidate.m_cameraMask |= cameraBit;
 				}
 			}
+		});
+		size_t visibleCount = 0;
+		for (const auto& i : visibleCounts)
+			visibleCount += i;
+		ProfilerLayer::SetCounter("Visible renderers (" + cameraEntry.m_name + ")", visibleCount, candidates.size());
+		if (m_occlusionCulling)
+			ProfilerLayer::SetCounter(
+				"Occluded renderers (" + cameraEntry.m_name + ")", occludedCount, visibleCount + occludedCount);
+	}
+#pragma endregion
+#pragma region Emit
+	// One command per candidate seen by any camera or casting shadows, one per used level for LOD chains. Every slice
+	// writes into its own buffer. Cached static candidates are emitted in the order of m_staticDraws, the others are
+	// appended after the commands from the Graphics API and sorted below.
+	std::vector<uint64_t> frameCameras;
+	frameCameras.reserve(cameraEntries.size());
+	for (const auto& cameraEntry : cameraEntries)
+		frameCameras.push_back(cameraEntry.m_camera->GetHandle().GetValue());
+	const auto push = [&](std::vector<RenderCommand>& buffer,
+						  const RenderCandidate& candidate,
+						  const unsigned& geometryIndex,
+						  const uint64_t& cameraMask,
+						  const bool& castShadow) {
+		buffer.push_back(candidate.m_command);
+		auto& renderCommand = buffer.back();
+		renderCommand.m_geometryIndex = geometryIndex;
+		if (candidate.m_static)
+		{
+			renderCommand.m_geometryIndex = m_staticGeometryIndices[geometryIndex];
+			renderCommand.m_materialIndex = m_staticMaterialIndices[renderCommand.m_materialIndex];
+		}
+		renderCommand.m_cameraMask = cameraMask;
+		renderCommand.m_castShadow = castShadow;
+		// No depth, the order is shared by every camera. Transparent commands are ordered per camera below.
+		renderCommand.m_sortKey = RenderSort::OpaqueKey(
+			static_cast<unsigned>(candidate.m_pass),
+			renderCommand.m_materialIndex,
+			renderCommand.m_geometryIndex,
+			0.0f);
+	};
+	// Casters use the finest level any camera picked for them, this frame or the last time they were seen. The result
+	// is the amount of levels when there is none, the base mesh casts the shadow then.
+	const auto getCasterLevel = [&](const RenderCandidate& candidate) {
+		// Levels of cameras that no longer render are dropped, they would otherwise pile up for every camera that ever
+		// saw the renderer and hold the caster level.
+		auto& lodLevels = candidate.m_meshRenderer->m_lodLevels;
+		for (auto it = lodLevels.begin(); it != lodLevels.end();)
+		{
+			if (std::find(frameCameras.begin(), frameCameras.end(), it->first.GetValue()) == frameCameras.end())
+				it = lodLevels.erase(it);
+			else
+				++it;
+		}
+		const auto levelAmount = static_cast<unsigned>(candidate.m_lodCameraMasks.size());
+		unsigned casterLevel = levelAmount;
+		for (unsigned level = 0; level < levelAmount && casterLevel == levelAmount; level++)
+		{
+			if (candidate.m_lodCameraMasks[level])
+				casterLevel = level;
+		}
+		if (casterLevel == levelAmount)
+		{
+			for (const auto& level : lodLevels)
+				casterLevel = (glm::min)(casterLevel, level.second);
+		}
+		return casterLevel;
+	};
+	const size_t dynamicCount = candidates.size() - m_staticCandidateCount;
+	const auto bufferAmount = (glm::max)(getSliceAmount(m_staticDraws.size()), getSliceAmount(dynamicCount));
+	if (m_renderCommandBuffers.size() < bufferAmount)
+		m_renderCommandBuffers.resize(bufferAmount);
+
+	m_staticCasterLevels.resize(m_staticCandidateCount);
+	forEachSlice(m_staticCandidateCount, [&](unsigned sliceIndex, size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++)
+		{
+			if (candidates[i].m_lodChain)
+				m_staticCasterLevels[i] = getCasterLevel(candidates[i]);
+		}
+	});
+	const auto staticSliceAmount = getSliceAmount(m_staticDraws.size());
+	forEachSlice(m_staticDraws.size(), [&](unsigned sliceIndex, size_t begin, size_t end) {
+		auto& buffer = m_renderCommandBuffers[sliceIndex];
+		buffer.clear();
+		for (size_t i = begin; i < end; i++)
+		{
+			const auto& draw = m_staticDraws[i];
+			const auto& candidate = candidates[draw.m_candidate];
+			const bool castShadow = candidate.m_command.m_castShadow;
+			if (!candidate.m_lodChain)
+			{
+				if (candidate.m_cameraMask || castShadow)
+					push(buffer, candidate, candidate.m_command.m_geometryIndex, candidate.m_cameraMask, castShadow);
+				continue;
+			}
+			const auto casterLevel = m_staticCasterLevels[draw.m_candidate];
+			if (draw.m_level == StaticDraw::BaseLevel)
+			{
+				if (castShadow && casterLevel >= candidate.m_lodCameraMasks.size())
+					push(buffer, candidate, candidate.m_command.m_geometryIndex, 0, true);
+				continue;
+			}
+			const auto cameraMask = candidate.m_lodCameraMasks[draw.m_level];
+			const bool caster = castShadow && draw.m_level == casterLevel;
+			if (cameraMask || caster)
+				push(buffer, candidate, candidate.m_lodGeometryIndices[draw.m_level], cameraMask, caster);
+		}
+	});
+	m_staticRenderCommands.clear();
+	for (unsigned sliceIndex = 0; sliceIndex < staticSliceAmount; sliceIndex++)
+	{
+		const auto& buffer = m_renderCommandBuffers[sliceIndex];
+		m_staticRenderCommands.insert(m_staticRenderCommands.end(), buffer.begin(), buffer.end());
+	}
+
+	const auto dynamicSliceAmount = getSliceAmount(dynamicCount);
+	forEachSlice(dynamicCount, [&](unsigned sliceIndex, size_t begin, size_t end) {
+		auto& buffer = m_renderCommandBuffers[sliceIndex];
+		buffer.clear();
+		for (size_t i = m_staticCandidateCount + begin; i < m_staticCandidateCount + end; i++)
+		{
+			const auto& candidate = candidates[i];
+			const bool castShadow = candidate.m_command.m_castShadow;
+			if (!candidate.m_lodChain)
+			{
+				if (candidate.m_cameraMask || castShadow)
+					push(buffer, candidate, candidate.m_command.m_geometryIndex, candidate.m_cameraMask, castShadow);
+				continue;
+			}
+			const auto levelAmount = static_cast<unsigned>(candidate.m_lodCameraMasks.size());
+			const auto casterLevel = getCasterLevel(candidate);
+			for (unsigned level = 0; level < levelAmount; level++)
+			{
+				const bool caster = castShadow && level == casterLevel;
+				if (candidate.m_lodCameraMasks[level] || caster)
+					push(buffer, candidate, candidate.m_lodGeometryIndices[level], candidate.m_lodCameraMasks[level], caster);
+			}
+			if (castShadow && casterLevel >= levelAmount)
+				push(buffer, candidate, candidate.m_command.m_geometryIndex, 0, true);
+		}
+	});
+	for (unsigned sliceIndex = 0; sliceIndex < dynamicSliceAmount; sliceIndex++)
+	{
+		const auto& buffer = m_renderCommandBuffers[sliceIndex];
+		m_renderCommands.insert(m_renderCommands.end(), buffer.begin(), buffer.end());
+	}
+#pragma endregion
+#pragma region Sort
+	// Sort the dynamic and Graphics API commands by pass, material and geometry, and merge them by pass with the static
+	// commands, which are already in that order. The order is the same for every camera, the depth is only used for the
+	// transparent passes, which are ordered again for each camera.
+	m_renderSortItems.resize(m_renderCommands.size());
+	for (size_t i = 0; i < m_renderCommands.size(); i++)
+		m_renderSortItems[i] = { m_renderCommands[i].m_sortKey, static_cast<unsigned>(i) };
+	RenderSort::RadixSort(m_renderSortItems, m_renderSortScratch);
+	m_sortedRenderCommands.resize(m_renderCommands.size());
+	for (size_t i = 0; i < m_renderSortItems.size(); i++)
+		m_sortedRenderCommands[i] = m_renderCommands[m_renderSortItems[i].m_index];
+	m_renderCommands.resize(m_staticRenderCommands.size() + m_sortedRenderCommands.size());
+	std::merge(
+		m_staticRenderCommands.begin(),
+		m_staticRenderCommands.end(),
+		m_sortedRenderCommands.begin(),
+		m_sortedRenderCommands.end(),
+		m_renderCommands.begin(),
+		[](const RenderCommand& a, const RenderCommand& b) { return a.GetPass() < b.GetPass(); });
+	size_t passStart = 0;
+	for (unsigned pass = 0; pass < static_cast<unsigned>(RenderCommandPass::Count); pass++)
+	{
+		size_t passEnd = passStart;
+		while (passEnd < m_renderCommands.size() && static_cast<unsigned>(m_renderCommands[passEnd].GetPass()) == pass)
+			passEnd++;
+		m_passRanges[pass] = { passStart, passEnd };
+		passStart = passEnd;
+	}
+	// Back to front for every camera, over both transparent passes at once.
+	if (m_transparentCommandOrders.size() < m_cameraSlots.size())
+		m_transparentCommandOrders.resize(m_cameraSlots.size());
+	const size_t transparentStart = m_passRanges[static_cast<size_t>(RenderCommandPass::Transparent)].first;
+	const size_t transparentEnd = m_passRanges[static_cast<size_t>(RenderCommandPass::InstancedTransparent)].second;
+	for (unsigned cameraSlot = 0; cameraSlot < cameraViews.size() && transparentStart != transparentEnd; cameraSlot++)
+	{
+		const auto& view = cameraViews[cameraSlot];
+		const uint64_t cameraBit = uint64_t(1) << cameraSlot;
+		m_renderSortItems.clear();
+		for (size_t i = transparentStart; i < transparentEnd; i++)
+		{
+			const auto& renderCommand = m_renderCommands[i];
+			if (!(renderCommand.m_cameraMask & cameraBit))
+				continue;
+			const float depth =
+				(glm::dot(renderCommand.m_center - view.m_position, view.m_front) - view.m_nearDistance) / view.m_depthRange;
+			m_renderSortItems.push_back(
+				{ RenderSort::TransparentKey(
+					  static_cast<unsigned>(RenderCommandPass::Transparent),
+					  renderCommand.m_materialIndex,
+					  renderCommand.m_geometryIndex,
+					  depth),
+				  static_cast<unsigned>(i) });
+		}
+		RenderSort::RadixSort(m_renderSortItems, m_renderSortScratch);
+		auto& order = m_transparentCommandOrders[cameraSlot];
+		order.clear();
+		for (const auto& item : m_renderSortItems)
+			order.push_back(item.m_index);
+	}
+#pragma endregion
+	BuildInstanceBatches();
+}
+
+/**
+ * Split [begin, end) of the sorted commands into runs of members that can share a draw with the first member of the
+ * run. Commands the pass does not draw are skipped, a drawn command that is not a member ends the run. Runs of at least
+ * minBatchSize members become batches, with their matrices appended to instanceMatrices.
+ */
+template <typename Drawn, typename Member, typename Compatible>
+static void FindInstanceBatches(
+	const std::vector<RenderCommand>& renderCommands,
+	const size_t& begin,
+	const size_t& end,
+	const unsigned& minBatchSize,
+	const Drawn& isDrawn,
+	const Member& isMember,
+	const Compatible& isCompatible,
+	std::vector<RenderInstanceBatch>& batches,
+	std::vector<glm::mat4>& instanceMatrices)
+{
+	size_t i = begin;
+	while (i < end)
+	{
+		const auto& first = renderCommands[i];
+		if (!isDrawn(first) || !isMember(first))
+		{
+			i++;
+			continue;
+		}
+		size_t runEnd = i + 1;
+		unsigned count = 1;
+		size_t lastMember = i;
+		for (; runEnd < end; runEnd++)
+		{
+			const auto& renderCommand = renderCommands[runEnd];
+			if (!isDrawn(renderCommand))
+				continue;
+			if (!isMember(renderCommand) || !isCompatible(first, renderCommand))
+				break;
+			count++;
+			lastMember = runEnd;
+		}
+		if (count >= minBatchSize)
+		{
+			RenderInstanceBatch batch;
+			batch.m_begin = static_cast<unsigned>(i);
+			batch.m_end = static_cast<unsigned>(lastMember + 1);
+			batch.m_firstInstance = static_cast<unsigned>(instanceMatrices.size());
+			batch.m_instanceCount = count;
+			for (size_t j = i; j <= lastMember; j++)
+			{
+				if (isDrawn(renderCommands[j]))
+					instanceMatrices.push_back(renderCommands[j].m_globalTransform.m_value);
+			}
+			batches.push_back(batch);
+		}
+		i = lastMember + 1;
+	}
+}
+
+void RenderLayer::BuildInstanceBatches()
+{
+	m_instanceBatchMatrices.clear();
+	m_shadowInstanceBatches.clear();
+	for (auto& batches : m_cameraInstanceBatches)
+		batches.clear();
+	if (!m_dynamicInstancing)
+		return;
+	if (m_cameraInstanceBatches.size() < m_cameraSlots.size())
+		m_cameraInstanceBatches.resize(m_cameraSlots.size());
+	const auto minBatchSize = static_cast<unsigned>((std::max)(m_minInstanceBatchSize, 2));
+	const auto isMeshMember = [](const RenderCommand& renderCommand) {
+		return renderCommand.m_geometryType == RenderGeometryType::Mesh &&
+			   renderCommand.m_commandType != RenderCommandType::FromAPIInstanced;
+	};
+	// Deferred meshes only, forward and transparent materials bring their own programs, which are not instanced.
+	const auto& deferredRange = m_passRanges[static_cast<size_t>(RenderCommandPass::Deferred)];
+	for (unsigned cameraSlot = 0; cameraSlot < m_cameraSlots.size(); cameraSlot++)
+	{
+		const uint64_t cameraBit = uint64_t(1) << cameraSlot;
+		FindInstanceBatches(
+			m_renderCommands,
+			deferredRange.first,
+			deferredRange.second,
+			minBatchSize,
+			[&](const RenderCommand& renderCommand) { return (renderCommand.m_cameraMask & cameraBit) != 0; },
+			isMeshMember,
+			[](const RenderCommand& first, const RenderCommand& renderCommand) {
+				return renderCommand.m_geometryIndex == first.m_geometryIndex &&
+					   renderCommand.m_materialIndex == first.m_materialIndex &&
+					   renderCommand.m_castShadow == first.m_castShadow &&
+					   renderCommand.m_receiveShadow == first.m_receiveShadow;
+			},
+			m_cameraInstanceBatches[cameraSlot],
+			m_instanceBatchMatrices);
+	}
+	// The shadow programs ignore the material, casters only need the same mesh.
+	for (const auto& pass : { RenderCommandPass::Deferred, RenderCommandPass::Forward, RenderCommandPass::Transparent })
+	{
+		const auto& range = m_passRanges[static_cast<size_t>(pass)];
+		FindInstanceBatches(
+			m_renderCommands,
+			range.first,
+			range.second,
+			minBatchSize,
+			[](const RenderCommand& renderCommand) { return renderCommand.m_castShadow; },
+			isMeshMember,
+			[](const RenderCommand& first, const RenderCommand& renderCommand) {
+				return renderCommand.m_geometryIndex == first.m_geometryIndex;
+			},
+			m_shadowInstanceBatches,
+			m_instanceBatchMatrices);
+	}
+	if (!m_instanceBatchMatrices.empty())
+		m_instanceBatchBuffer->SetData(
+			static_cast<GLsizei>(m_instanceBatchMatrices.size() * sizeof(glm::mat4)),
+			m_instanceBatchMatrices.data(),
+			GL_STREAM_DRAW);
+}
+
+bool RenderLayer::GatherMeshRenderer(
+	const std::shared_ptr<Scene>& scene, const Entity& owner, RenderCandidate& candidate, Bound& bound)
+{
+	auto mmc = scene->GetOrSetPrivateComponent<MeshRenderer>(owner).lock();
+	auto material = mmc->m_material.Get<Material>();
+	auto mesh = mmc->m_mesh.Get<Mesh>();
+	auto lodChain = mmc->m_lodChain.Get<MeshLodChain>();
+	if (lodChain && lodChain->m_levels.empty())
+		lodChain.reset();
+	const uint64_t lodChainHandle = lodChain ? lodChain->GetHandle().GetValue() : 0;
+	if (mmc->m_lodLevelsChain != lodChainHandle)
+	{
+		mmc->m_lodLevels.clear();
+		mmc->m_lodLevelsChain = lodChainHandle;
+	}
+	if (!mesh && lodChain)
+		mesh = lodChain->GetMesh(0);
+	if (!mmc->IsEnabled() || material == nullptr || mesh == nullptr)
+		return false;
+	auto gt = scene->GetDataComponent<GlobalTransform>(owner);
+	bound = mesh->m_bound;
+	bound.ApplyTransform(gt.m_value);
+
+	candidate.m_command.m_owner = owner;
+	candidate.m_command.m_globalTransform = gt;
+	candidate.m_geometry = mesh;
+	candidate.m_command.m_castShadow = mmc->m_castShadow;
+	candidate.m_command.m_receiveShadow = mmc->m_receiveShadow;
+	candidate.m_command.m_geometryType = RenderGeometryType::Mesh;
+	candidate.m_material = material;
+	candidate.m_forwardRendering = mmc->m_forwardRendering;
+	candidate.m_meshRenderer = mmc;
+	candidate.m_lodChain = lodChain;
+	return true;
+}
+
+void RenderLayer::PrepareRenderCandidate(RenderCandidate& candidate, const Bound& bound, RenderResources& resources)
+{
+	candidate.m_radius = glm::length(bound.Size());
+	auto& command = candidate.m_command;
+	command.m_center = bound.Center();
+	command.m_commandType = RenderCommandType::FromRenderer;
+	command.m_materialIndex = resources.Add(candidate.m_material);
+	command.m_geometryIndex = resources.Add(candidate.m_geometry);
+	if (candidate.m_lodChain)
+	{
+		for (unsigned level = 0; level < candidate.m_lodChain->m_levels.size(); level++)
+		{
+			const auto lodMesh = candidate.m_lodChain->GetMesh(level);
+			candidate.m_lodGeometryIndices.push_back(lodMesh ? resources.Add(lodMesh) : command.m_geometryIndex);
+		}
+		candidate.m_lodCameraMasks.resize(candidate.m_lodGeometryIndices.size(), 0);
+	}
+	if (candidate.m_material->m_drawSettings.m_blending)
+		candidate.m_pass = candidate.m_instanced ? RenderCommandPass::InstancedTransparent : RenderCommandPass::Transparent;
+	else if (candidate.m_forwardRendering)
+		candidate.m_pass = candidate.m_instanced ? RenderCommandPass::ForwardInstanced : RenderCommandPass::Forward;
+	else
+		candidate.m_pass = candidate.m_instanced ? RenderCommandPass::DeferredInstanced : RenderCommandPass::Deferred;
+}
+
+#pragma region Static render cache
+RenderLayer::StaticRenderState RenderLayer::CaptureStaticRenderState(const RenderCandidate& candidate)
+{
+	const auto& meshRenderer = candidate.m_meshRenderer;
+	StaticRenderState state;
+	state.m_mesh = meshRenderer->m_mesh.GetAssetHandle().GetValue();
+	state.m_material = meshRenderer->m_material.GetAssetHandle().GetValue();
+	state.m_lodChain = meshRenderer->m_lodChain.GetAssetHandle().GetValue();
+	state.m_lodChainAsset = meshRenderer->m_lodChain.Get<MeshLodChain>();
+	state.m_meshVersion = static_cast<const Mesh*>(candidate.m_geometry.get())->m_version;
+	state.m_materialVersion = candidate.m_material->m_version;
+	state.m_lodChainVersion = state.m_lodChainAsset ? state.m_lodChainAsset->GetVersion() : 0;
+	state.m_castShadow = meshRenderer->m_castShadow;
+	state.m_receiveShadow = meshRenderer->m_receiveShadow;
+	state.m_forwardRendering = meshRenderer->m_forwardRendering;
+	state.m_blending = candidate.m_material->m_drawSettings.m_blending;
+	state.m_globalTransform = candidate.m_command.m_globalTransform.m_value;
+	return state;
+}
+
+bool RenderLayer::IsStaticRenderStateValid(
+	const StaticRenderState& state, const RenderCandidate& candidate, const GlobalTransform& globalTransform)
+{
+	const auto& meshRenderer = candidate.m_meshRenderer;
+	// Handles are compared first, the versions are only meaningful while the renderer still uses the same assets.
+	if (!meshRenderer->IsEnabled() || meshRenderer->m_mesh.GetAssetHandle().GetValue() != state.m_mesh ||
+		meshRenderer->m_material.GetAssetHandle().GetValue() != state.m_material ||
+		meshRenderer->m_lodChain.GetAssetHandle().GetValue() != state.m_lodChain)
+		return false;
+	if (static_cast<const Mesh*>(candidate.m_geometry.get())->m_version != state.m_meshVersion ||
+		candidate.m_material->m_version != state.m_materialVersion ||
+		candidate.m_material->m_drawSettings.m_blending != state.m_blending ||
+		(state.m_lodChainAsset && state.m_lodChainAsset->GetVersion() != state.m_lodChainVersion))
+		return false;
+	return meshRenderer->m_castShadow == state.m_castShadow && meshRenderer->m_receiveShadow == state.m_receiveShadow &&
+		   meshRenderer->m_forwardRendering == state.m_forwardRendering &&
+		   globalTransform.m_value == state.m_globalTransform;
+}
+
+void RenderLayer::ClearStaticRenderCache()
+{
+	for (const auto& owner : m_staticCandidateOwners)
+		m_sceneBvh.Pin(owner, false);
+	m_renderCandidates.clear();
+	m_cullingBounds.Clear();
+	m_staticCandidateCount = 0;
+	m_staticRendererOwners.clear();
+	m_staticCandidateOwners.clear();
+	m_staticRenderStates.clear();
+	m_pendingStaticOwners.clear();
+	m_staticRenderResources.Clear();
+	m_staticOwners.clear();
+	m_dynamicOwners.clear();
+	m_ownersValid = false;
+	m_staticAssetVersions.clear();
+	m_staticLodChains.clear();
+	m_staticDraws.clear();
+}
+
+void RenderLayer::RebuildStaticRenderCache(const std::shared_ptr<Scene>& scene)
+{
+	for (const auto& owner : m_staticCandidateOwners)
+		m_sceneBvh.Pin(owner, false);
+	m_renderCandidates.clear();
+	m_cullingBounds.Clear();
+	m_staticCandidateOwners.clear();
+	m_staticRenderStates.clear();
+	m_pendingStaticOwners.clear();
+	m_staticRenderResources.Clear();
+	m_staticLodChains.clear();
+	m_staticWorldBound.m_min = glm::vec3(FLT_MAX);
+	m_staticWorldBound.m_max = glm::vec3(-FLT_MAX);
+	for (const auto& owner : m_staticRendererOwners)
+	{
+		RenderCandidate candidate;
+		Bound bound;
+		if (!GatherMeshRenderer(scene, owner, candidate, bound))
+		{
+			m_pendingStaticOwners.push_back(owner);
+			continue;
+		}
+		candidate.m_static = true;
+		PrepareRenderCandidate(candidate, bound, m_staticRenderResources);
+		m_staticRenderStates.push_back(CaptureStaticRenderState(candidate));
+		const auto& lodChain = m_staticRenderStates.back().m_lodChainAsset;
+		if (lodChain && std::find(m_staticLodChains.begin(), m_staticLodChains.end(), lodChain) == m_staticLodChains.end())
+			m_staticLodChains.push_back(lodChain);
+		m_staticCandidateOwners.push_back(owner);
+		m_staticWorldBound.m_min = (glm::min)(m_staticWorldBound.m_min, bound.m_min);
+		m_staticWorldBound.m_max = (glm::max)(m_staticWorldBound.m_max, bound.m_max);
+		m_cullingBounds.Push(bound);
+		m_sceneBvh.Update(owner, bound);
+		m_sceneBvh.Pin(owner, true);
+		m_renderCandidates.push_back(std::move(candidate));
+	}
+	m_staticCandidateCount = m_renderCandidates.size();
+	CaptureStaticAssetVersions(m_staticAssetVersions);
+}
+
+void RenderLayer::CaptureStaticAssetVersions(std::vector<size_t>& versions) const
+{
+	versions.clear();
+	for (const auto& geometry : m_staticRenderResources.m_geometries)
+		versions.push_back(static_cast<const Mesh*>(geometry.get())->m_version);
+	for (const auto& material : m_staticRenderResources.m_materials)
+	{
+		versions.push_back(material->m_version);
+		versions.push_back(material->m_drawSettings.m_blending);
+	}
+	for (const auto& lodChain : m_staticLodChains)
+		versions.push_back(lodChain->GetVersion());
+}
+
+void RenderLayer::SortStaticDraws()
+{
+	std::vector<StaticDraw> draws;
+	m_renderSortItems.clear();
+	// Keys use the indices of the static tables, which map one to one to the tables of any frame, so draws that share
+	// mesh and material stay next to each other.
+	const auto add = [&](const unsigned& candidateIndex, const unsigned& level, const unsigned& geometryIndex) {
+		const auto& candidate = m_renderCandidates[candidateIndex];
+		m_renderSortItems.push_back(
+			{ RenderSort::OpaqueKey(
+				  static_cast<unsigned>(candidate.m_pass), candidate.m_command.m_materialIndex, geometryIndex, 0.0f),
+			  static_cast<unsigned>(draws.size()) });
+		draws.push_back({ candidateIndex, level });
+	};
+	for (unsigned i = 0; i < m_staticCandidateCount; i++)
+	{
+		const auto& candidate = m_renderCandidates[i];
+		add(i, StaticDraw::BaseLevel, candidate.m_command.m_geometryIndex);
+		for (unsigned level = 0; level < candidate.m_lodGeometryIndices.size(); level++)
+			add(i, level, candidate.m_lodGeometryIndices[level]);
+	}
+	RenderSort::RadixSort(m_renderSortItems, m_renderSortScratch);
+	m_staticDraws.resize(draws.size());
+	for (size_t i = 0; i < m_renderSortItems.size(); i++)
+		m_staticDraws[i] = draws[m_renderSortItems[i].m_index];
+}
+
+bool RenderLayer::UpdateStaticRenderCache(
+	const std::shared_ptr<Scene>& scene, const std::vector<Entity>& staticOwners, const bool& sceneChanged)
+{
+	// Static entities that were added, removed, enabled or disabled change the list.
+	if (sceneChanged && staticOwners != m_staticRendererOwners)
+	{
+		m_staticRendererOwners = staticOwners;
+		RebuildStaticRenderCache(scene);
+		return true;
+	}
+	for (const auto& owner : m_pendingStaticOwners)
+	{
+		RenderCandidate candidate;
+		Bound bound;
+		if (GatherMeshRenderer(scene, owner, candidate, bound))
+		{
+			RebuildStaticRenderCache(scene);
+			return true;
+		}
+	}
+	// Entries only go stale through the scene, which bumps its static version, or through the assets they use.
+	std::vector<size_t> assetVersions;
+	assetVersions.reserve(m_staticAssetVersions.size());
+	CaptureStaticAssetVersions(assetVersions);
+	if (!sceneChanged && assetVersions == m_staticAssetVersions)
+	{
+		ProfilerLayer::SetCounter("Static renderers rebuilt", 0, m_staticCandidateCount);
+		return false;
+	}
+	// Every entry is compared with what it was built from on the Jobs workers, only the changed ones are gathered again.
+	constexpr size_t MinSliceSize = 4096;
+	const auto workerAmount = static_cast<size_t>(Jobs::Workers().Size());
+	const auto sliceAmount = static_cast<unsigned>(
+		workerAmount > 1 ? (glm::clamp)(m_staticCandidateCount / MinSliceSize, static_cast<size_t>(1), workerAmount) : 1);
+	const size_t sliceSize = (m_staticCandidateCount + sliceAmount - 1) / sliceAmount;
+	std::vector<std::vector<size_t>> changedIndices(sliceAmount);
+	const auto validateSlice = [&](unsigned sliceIndex) {
+		const size_t end = (glm::min)(m_staticCandidateCount, (sliceIndex + 1) * sliceSize);
+		for (size_t i = sliceIndex * sliceSize; i < end; i++)
+		{
+			const auto globalTransform = scene->GetDataComponent<GlobalTransform>(m_staticCandidateOwners[i]);
+			if (!IsStaticRenderStateValid(m_staticRenderStates[i], m_renderCandidates[i], globalTransform))
+				changedIndices[sliceIndex].push_back(i);
+		}
+	};
+	if (sliceAmount > 1)
+	{
+		std::vector<std::shared_future<void>> results;
+		Jobs::ParallelFor(sliceAmount, validateSlice, results);
+		for (const auto& i : results)
+			i.wait();
+	}
+	else
+	{
+		validateSlice(0);
+	}
+	size_t changedCount = 0;
+	for (const auto& indices : changedIndices)
+	{
+		for (const auto& i : indices)
+		{
+			const auto& owner = m_staticCandidateOwners[i];
+			RenderCandidate candidate;
+			Bound bound;
+			// A renderer that has nothing to draw anymore leaves a hole, the cache is built again without it.
+			if (!GatherMeshRenderer(scene, owner, candidate, bound))
+			{
+				RebuildStaticRenderCache(scene);
+				return true;
+			}
+			candidate.m_static = true;
+			PrepareRenderCandidate(candidate, bound, m_staticRenderResources);
+			m_staticRenderStates[i] = CaptureStaticRenderState(candidate);
+			const auto& lodChain = m_staticRenderStates[i].m_lodChainAsset;
+			if (lodChain &&
+				std::find(m_staticLodChains.begin(), m_staticLodChains.end(), lodChain) == m_staticLodChains.end())
+				m_staticLodChains.push_back(lodChain);
+			// The static world bound only grows until the next rebuild.
+			m_staticWorldBound.m_min = (glm::min)(m_staticWorldBound.m_min, bound.m_min);
+			m_staticWorldBound.m_max = (glm::max)(m_staticWorldBound.m_max, bound.m_max);
+			m_cullingBounds.Set(i, bound);
+			m_sceneBvh.Update(owner, bound);
+			m_renderCandidates[i] = std::move(candidate);
+			changedCount++;
 		}
 	}
+	ProfilerLayer::SetCounter("Static renderers rebuilt", changedCount, m_staticCandidateCount);
+	// Entries that were gathered again may have added assets to the static tables.
+	CaptureStaticAssetVersions(m_staticAssetVersions);
+	return changedCount != 0;
 }
+#pragma endregion
 
 inline float RenderLayer::Lerp(const float& a, const float& b, const float& f)
 {
@@ -909,18 +1765,15 @@ void RenderLayer::ShadowMapPrePass(
 	std::shared_ptr<OpenGLUtils::GLProgram>& instancedSkinnedMeshProgram,
 	std::shared_ptr<OpenGLUtils::GLProgram>& strandsProgram)
 {
-
-	for (auto& i : m_deferredRenderInstances)
-	{
-		DispatchRenderCommands(
-			i.second,
-			[&](const std::shared_ptr<Material>& material, const RenderCommand& renderCommand) {
-				if (!renderCommand.m_castShadow)
-				return;
+	// Every command of the frame is drawn once, casters outside of every camera frustum are in the list with an empty
+	// camera mask.
+	const auto drawShadow = [&](const RenderCommand& renderCommand) {
+		if (!renderCommand.m_castShadow || !IsLightCaster(renderCommand))
+			return;
 		switch (renderCommand.m_geometryType)
 		{
 		case RenderGeometryType::Mesh: {
-			auto mesh = std::dynamic_pointer_cast<Mesh>(renderCommand.m_renderGeometry);
+			auto mesh = GetGeometry<Mesh>(renderCommand);
 			auto& program = meshProgram;
 			program->Bind();
 			program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
@@ -929,17 +1782,17 @@ void RenderLayer::ShadowMapPrePass(
 			break;
 		}
 		case RenderGeometryType::SkinnedMesh: {
-			auto skinnedMesh = std::dynamic_pointer_cast<SkinnedMesh>(renderCommand.m_renderGeometry);
+			auto skinnedMesh = GetGeometry<SkinnedMesh>(renderCommand);
 			auto& program = skinnedMeshProgram;
 			program->Bind();
-			renderCommand.m_boneMatrices->UploadBones(skinnedMesh);
+			GetBoneMatrices(renderCommand)->UploadBones(skinnedMesh);
 			program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
 			program->SetInt("index", enabledSize);
 			skinnedMesh->Draw();
 			break;
 		}
 		case RenderGeometryType::Strands: {
-			auto strands = std::dynamic_pointer_cast<Strands>(renderCommand.m_renderGeometry);
+			auto strands = GetGeometry<Strands>(renderCommand);
 			auto& program = strandsProgram;
 			program->Bind();
 			program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
@@ -948,160 +1801,77 @@ void RenderLayer::ShadowMapPrePass(
 			break;
 		}
 		}
-			},
-			false);
-	}
-	for (auto& i : m_deferredInstancedRenderInstances)
-	{
-		DispatchRenderCommands(
-			i.second,
-			[&](const std::shared_ptr<Material>& material, const RenderCommand& renderCommand) {
-				if (!renderCommand.m_castShadow)
-				return;
+	};
+	const auto drawInstancedShadow = [&](const RenderCommand& renderCommand) {
+		if (!renderCommand.m_castShadow || !IsLightCaster(renderCommand))
+			return;
 		switch (renderCommand.m_geometryType)
 		{
 		case RenderGeometryType::Mesh: {
-			auto mesh = std::dynamic_pointer_cast<Mesh>(renderCommand.m_renderGeometry);
+			auto mesh = GetGeometry<Mesh>(renderCommand);
 			auto& program = meshInstancedProgram;
 			program->Bind();
 			program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
 			program->SetInt("index", enabledSize);
-			mesh->DrawInstanced(renderCommand.m_matrices);
-			break;
-		}
-		}
-			},
-			false);
-	}
-	for (auto& i : m_forwardRenderInstances)
-	{
-		DispatchRenderCommands(
-			i.second,
-			[&](const std::shared_ptr<Material>& material, const RenderCommand& renderCommand) {
-				if (!renderCommand.m_castShadow)
-				return;
-		switch (renderCommand.m_geometryType)
-		{
-		case RenderGeometryType::Mesh: {
-			auto mesh = std::dynamic_pointer_cast<Mesh>(renderCommand.m_renderGeometry);
-			auto& program = meshProgram;
-			program->Bind();
-			program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
-			program->SetInt("index", enabledSize);
-			mesh->Draw();
+			mesh->DrawInstanced(GetParticleMatrices(renderCommand));
 			break;
 		}
-		case RenderGeometryType::SkinnedMesh: {
-			auto skinnedMesh = std::dynamic_pointer_cast<SkinnedMesh>(renderCommand.m_renderGeometry);
-			auto& program = skinnedMeshProgram;
-			program->Bind();
-			renderCommand.m_boneMatrices->UploadBones(skinnedMesh);
-			program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
-			program->SetInt("index", enabledSize);
-			skinnedMesh->Draw();
-			break;
 		}
-		case RenderGeometryType::Strands: {
-			auto strands = std::dynamic_pointer_cast<Strands>(renderCommand.m_renderGeometry);
-			auto& program = strandsProgram;
-			program->Bind();
-			program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
-			program->SetInt("index", enabledSize);
-			strands->Draw();
-			break;
-		}
-		}
-
-			},
-			false);
-	}
-	for (auto& i : m_forwardInstancedRenderInstances)
+	};
+	// Point and spot lights filter the casters one by one, their batches are drawn command by command.
+	const bool useBatches = !m_filterLightCasters;
+	size_t batchIndex = 0;
+	for (size_t i = 0; i < m_renderCommands.size(); i++)
 	{
-		DispatchRenderCommands(
-			i.second,
-			[&](const std::shared_ptr<Material>& material, const RenderCommand& renderCommand) {
-				if (!renderCommand.m_castShadow)
-				return;
-		switch (renderCommand.m_geometryType)
+		if (useBatches && batchIndex < m_shadowInstanceBatches.size() && m_shadowInstanceBatches[batchIndex].m_begin == i)
 		{
-		case RenderGeometryType::Mesh: {
-			auto mesh = std::dynamic_pointer_cast<Mesh>(renderCommand.m_renderGeometry);
+			const auto& batch = m_shadowInstanceBatches[batchIndex++];
+			auto mesh = GetGeometry<Mesh>(m_renderCommands[i]);
 			auto& program = meshInstancedProgram;
 			program->Bind();
-			program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
+			program->SetFloat4x4("model", glm::mat4(1.0f));
 			program->SetInt("index", enabledSize);
-			mesh->DrawInstanced(renderCommand.m_matrices);
-			break;
-		}
+			mesh->DrawInstanced(*m_instanceBatchBuffer, batch.m_firstInstance, batch.m_instanceCount);
+			i = batch.m_end - 1;
+			continue;
 		}
-			},
-			false);
-	}
-
-	for (auto& i : m_transparentRenderInstances)
-	{
-		DispatchRenderCommands(
-			i.second,
-			[&](const std::shared_ptr<Material>& material, const RenderCommand& renderCommand) {
-				if (!renderCommand.m_castShadow)
-				return;
-		switch (renderCommand.m_geometryType)
+		const auto& renderCommand = m_renderCommands[i];
+		switch (renderCommand.GetPass())
 		{
-		case RenderGeometryType::Mesh: {
-			auto mesh = std::dynamic_pointer_cast<Mesh>(renderCommand.m_renderGeometry);
-			auto& program = meshProgram;
-			program->Bind();
-			program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
-			program->SetInt("index", enabledSize);
-			mesh->Draw();
+		case RenderCommandPass::DeferredInstanced:
+		case RenderCommandPass::ForwardInstanced:
+		case RenderCommandPass::InstancedTransparent:
+			drawInstancedShadow(renderCommand);
 			break;
-		}
-		case RenderGeometryType::SkinnedMesh: {
-			auto skinnedMesh = std::dynamic_pointer_cast<SkinnedMesh>(renderCommand.m_renderGeometry);
-			auto& program = skinnedMeshProgram;
-			program->Bind();
-			renderCommand.m_boneMatrices->UploadBones(skinnedMesh);
-			program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
-			program->SetInt("index", enabledSize);
-			skinnedMesh->Draw();
+		default:
+			drawShadow(renderCommand);
 			break;
 		}
-		case RenderGeometryType::Strands: {
-			auto strands = std::dynamic_pointer_cast<Strands>(renderCommand.m_renderGeometry);
-			auto& program = strandsProgram;
-			program->Bind();
-			program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
-			program->SetInt("index", enabledSize);
-			strands->Draw();
-			break;
-		}
-		}
-
-			},
-			false);
 	}
-	for (auto& i : m_instancedTransparentRenderInstances)
+}
+void RenderLayer::SetLightCasters(const std::vector<Entity>& casters)
+{
+	m_lightCasterStamp++;
+	for (const auto& entity : casters)
 	{
-		DispatchRenderCommands(
-			i.second,
-			[&](const std::shared_ptr<Material>& material, const RenderCommand& renderCommand) {
-				if (!renderCommand.m_castShadow)
-				return;
-		switch (renderCommand.m_geometryType)
-		{
-		case RenderGeometryType::Mesh: {
-			auto mesh = std::dynamic_pointer_cast<Mesh>(renderCommand.m_renderGeometry);
-			auto& program = meshInstancedProgram;
-			program->Bind();
-			program->SetFloat4x4("model", renderCommand.m_globalTransform.m_value);
-			program->SetInt("index", enabledSize);
-			mesh->DrawInstanced(renderCommand.m_matrices);
-			break;
-		}
-		}
-			},
-			false);
+		if (entity.GetIndex() >= m_lightCasterStamps.size())
+			m_lightCasterStamps.resize(entity.GetIndex() + 1, 0);
+		m_lightCasterStamps[entity.GetIndex()] = m_lightCasterStamp;
 	}
+	m_filterLightCasters = true;
+}
+bool RenderLayer::IsLightCaster(const RenderCommand& renderCommand) const
+{
+	// Commands from the Graphics API and renderers without a bound in the tree are never filtered.
+	if (!m_filterLightCasters || renderCommand.m_commandType != RenderCommandType::FromRenderer ||
+		!m_sceneBvh.Contains(renderCommand.m_owner))
+		return true;
+	const auto index = renderCommand.m_owner.GetIndex();
+	return index < m_lightCasterStamps.size() && m_lightCasterStamps[index] == m_lightCasterStamp;
+}
+const BoundingVolumeHierarchy& RenderLayer::GetSceneBvh() const
+{
+	return m_sceneBvh;
 }
 void RenderLayer::RenderShadows(
 	Bound& worldBound, const std::shared_ptr<Camera>& cameraComponent, const GlobalTransform& cameraModel)
@@ -1115,6 +1885,9 @@ void RenderLayer::RenderShadows(
 	OpenGLUtils::SetEnable(OpenGLCapability::CullFace, false);
 	OpenGLUtils::SetPolygonMode(OpenGLPolygonMode::Fill);
 	auto scene = GetScene();
+	// Directional lights draw every caster, point and spot lights only the ones m_sceneBvh finds in their range.
+	m_filterLightCasters = false;
+	std::vector<Entity> lightCasters;
 #pragma region Shadow
 	auto& minBound = worldBound.m_min;
 	auto& maxBound = worldBound.m_max;
@@ -1438,6 +2211,12 @@ void RenderLayer::RenderShadows(
 					m_pointLights[enabledSize].m_viewPort.y,
 					m_pointLights[enabledSize].m_viewPort.z,
 					m_pointLights[enabledSize].m_viewPort.w);
+				lightCasters.clear();
+				m_sceneBvh.QuerySphere(
+					m_pointLights[enabledSize].m_position,
+					m_pointLights[enabledSize].m_constantLinearQuadFarPlane.w,
+					lightCasters);
+				SetLightCasters(lightCasters);
 				ShadowMapPrePass(
 					enabledSize,
 					DefaultResources::m_pointLightProgram,
@@ -1543,6 +2322,9 @@ void RenderLayer::RenderShadows(
 					m_spotLights[enabledSize].m_viewPort.y,
 					m_spotLights[enabledSize].m_viewPort.z,
 					m_spotLights[enabledSize].m_viewPort.w);
+				lightCasters.clear();
+				m_sceneBvh.QueryFrustum(Frustum(m_spotLights[enabledSize].m_lightSpaceMatrix), lightCasters);
+				SetLightCasters(lightCasters);
 				ShadowMapPrePass(
 					enabledSize,
 					DefaultResources::m_spotLightProgram,
@@ -1559,6 +2341,7 @@ void RenderLayer::RenderShadows(
 	{
 		m_spotLightBlock->SubData(0, 4, &size);
 	}
+	m_filterLightCasters = false;
 #pragma endregion
 }
 #pragma endregion
@@ -1774,6 +2557,16 @@ void RenderLayer::DeferredPrepassInstancedInternal(
 	mesh->DrawInstanced(matrices);
 }
 
+void RenderLayer::DeferredPrepassInstancedInternal(const std::shared_ptr<Mesh>& mesh, const RenderInstanceBatch& batch)
+{
+	if (mesh == nullptr || batch.m_instanceCount == 0)
+		return;
+	m_drawCall++;
+	m_mergedDrawCall += batch.m_instanceCount - 1;
+	m_triangles += mesh->GetTriangleAmount() * batch.m_instanceCount;
+	mesh->DrawInstanced(*m_instanceBatchBuffer, batch.m_firstInstance, batch.m_instanceCount);
+}
+
 void RenderLayer::DeferredPrepassInternal(const std::shared_ptr<SkinnedMesh>& skinnedMesh)
 {
 	if (skinnedMesh == nullptr)
@@ -1916,6 +2709,11 @@ size_t RenderLayer::DrawCall()
 	return m_drawCall;
 }
 
+size_t RenderLayer::MergedDrawCall()
+{
+	return m_mergedDrawCall;
+}
+
 #pragma endregion
 void DrawSettings::ApplySettings() const
 {
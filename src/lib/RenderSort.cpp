@@ -0,0 +1,127 @@
+#include <Jobs.hpp>
+#include <RenderSort.hpp>
+using namespace UniEngine;
+
+namespace
+{
+constexpr unsigned DigitBits = 8;
+constexpr unsigned DigitAmount = 1u << DigitBits;
+constexpr unsigned RoundAmount = 64 / DigitBits;
+// Below this many items per slice the workers cost more than they save.
+constexpr size_t MinSliceSize = 8192;
+
+uint64_t Quantize(const float &value, const unsigned &bits)
+{
+    // NaN fails both comparisons, so test for the inside of the range and map NaN to 0.
+    const float clamped = value > 0.0f ? (value < 1.0f ? value : 1.0f) : 0.0f;
+    const uint64_t max = (uint64_t(1) << bits) - 1;
+    return static_cast<uint64_t>(clamped * static_cast<float>(max));
+}
+
+uint64_t Field(const unsigned &value, const unsigned &bits)
+{
+    return static_cast<uint64_t>(value) & ((uint64_t(1) << bits) - 1);
+}
+
+void ForEachSlice(const unsigned &sliceAmount, const std::function<void(unsigned)> &func)
+{
+    if (sliceAmount == 1)
+    {
+        func(0);
+        return;
+    }
+    std::vector<std::shared_future<void>> results;
+    Jobs::ParallelFor(sliceAmount, func, results);
+    for (const auto &i : results)
+        i.wait();
+}
+} // namespace
+
+uint64_t RenderSort::OpaqueKey(const unsigned &pass, const unsigned &material, const unsigned &geometry, const float &depth)
+{
+    return Field(pass, PassBits) << (64 - PassBits) |
+           Field(material, OpaqueMaterialBits) << (OpaqueGeometryBits + OpaqueDepthBits) |
+           Field(geometry, OpaqueGeometryBits) << OpaqueDepthBits | Quantize(depth, OpaqueDepthBits);
+}
+
+uint64_t RenderSort::TransparentKey(
+    const unsigned &pass, const unsigned &material, const unsigned &geometry, const float &depth)
+{
+    return Field(pass, PassBits) << (64 - PassBits) |
+           Quantize(1.0f - depth, TransparentDepthBits) << (TransparentMaterialBits + TransparentGeometryBits) |
+           Field(material, TransparentMaterialBits) << TransparentGeometryBits |
+           Field(geometry, TransparentGeometryBits);
+}
+
+unsigned RenderSort::GetPass(const uint64_t &key)
+{
+    return static_cast<unsigned>(key >> (64 - PassBits));
+}
+
+void RenderSort::RadixSort(std::vector<RenderSortItem> &items, std::vector<RenderSortItem> &scratch)
+{
+    const size_t size = items.size();
+    if (size < 2)
+        return;
+    scratch.resize(size);
+    const auto workerAmount = static_cast<size_t>(Jobs::Workers().Size());
+    const auto sliceAmount =
+        static_cast<unsigned>(workerAmount > 1 ? (std::max)(size_t(1), (std::min)(workerAmount, size / MinSliceSize)) : 1);
+    const size_t sliceSize = (size + sliceAmount - 1) / sliceAmount;
+    // Digits that differ between items, found from the bits that differ from the first key.
+    uint64_t differentBits = 0;
+    {
+        std::vector<uint64_t> sliceBits(sliceAmount, 0);
+        const uint64_t first = items[0].m_key;
+        ForEachSlice(sliceAmount, [&](unsigned sliceIndex) {
+            const size_t end = (std::min)(size, (sliceIndex + 1) * sliceSize);
+            uint64_t bits = 0;
+            for (size_t i = sliceIndex * sliceSize; i < end; i++)
+                bits |= items[i].m_key ^ first;
+            sliceBits[sliceIndex] = bits;
+        });
+        for (const auto &bits : sliceBits)
+            differentBits |= bits;
+    }
+    std::vector<size_t> offsets(static_cast<size_t>(sliceAmount) * DigitAmount);
+    auto *source = &items;
+    auto *target = &scratch;
+    for (unsigned round = 0; round < RoundAmount; round++)
+    {
+        const unsigned shift = round * DigitBits;
+        if (((differentBits >> shift) & (DigitAmount - 1)) == 0)
+            continue;
+        // Histogram of every slice, then the exclusive prefix sum in digit major order so equal digits keep the order
+        // of the slices.
+        ForEachSlice(sliceAmount, [&](unsigned sliceIndex) {
+            size_t *counts = &offsets[static_cast<size_t>(sliceIndex) * DigitAmount];
+            std::fill(counts, counts + DigitAmount, 0);
+            const size_t end = (std::min)(size, (sliceIndex + 1) * sliceSize);
+            for (size_t i = sliceIndex * sliceSize; i < end; i++)
+                counts[((*source)[i].m_key >> shift) & (DigitAmount - 1)]++;
+        });
+        size_t sum = 0;
+        for (unsigned digit = 0; digit < DigitAmount; digit++)
+        {
+            for (unsigned sliceIndex = 0; sliceIndex < sliceAmount; sliceIndex++)
+            {
+                auto &offset = offsets[static_cast<size_t>(sliceIndex) * DigitAmount + digit];
+                const size_t count = offset;
+                offset = sum;
+                sum += count;
+            }
+        }
+        ForEachSlice(sliceAmount, [&](unsigned sliceIndex) {
+            size_t *sliceOffsets = &offsets[static_cast<size_t>(sliceIndex) * DigitAmount];
+            const size_t end = (std::min)(size, (sliceIndex + 1) * sliceSize);
+            for (size_t i = sliceIndex * sliceSize; i < end; i++)
+            {
+                const auto &item = (*source)[i];
+                (*target)[sliceOffsets[(item.m_key >> shift) & (DigitAmount - 1)]++] = item;
+            }
+        });
+        std::swap(source, target);
+    }
+    if (source != &items)
+        items.swap(scratch);
+}
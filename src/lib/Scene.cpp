@@ -7,10 +7,12 @@
 #include "EntityMetadata.hpp"
 #include "EnvironmentalMap.hpp"
 #include "ClassRegistry.hpp"
+#include "MemoryStats.hpp"
 using namespace UniEngine;
 AssetRegistration<Scene> SceneReg("Scene", {".uescene"});
 void Scene::Purge()
 {
+    m_staticVersion++;
     m_sceneDataStorage.m_entityPrivateComponentStorage = PrivateComponentStorage();
     m_sceneDataStorage.m_entities.clear();
     m_sceneDataStorage.m_entityMetadataList.clear();
@@ -37,6 +39,16 @@ void Scene::SetBound(const Bound &value)
     m_worldBound = value;
 }
 
+size_t Scene::GetStaticVersion() const
+{
+    return m_staticVersion;
+}
+
+void Scene::MarkStaticChanged()
+{
+    m_staticVersion++;
+}
+
 Scene::~Scene()
 {
     Purge();
@@ -76,13 +88,13 @@ void Scene::Start()
     {
         if (i.second->Enabled())
         {
-            ProfilerLayer::StartEvent(i.second->GetTypeName());
+            ProfilerLayer::StartEvent(i.second->GetProfilerScope());
             if (!i.second->m_started)
             {
                 i.second->Start();
                 i.second->m_started = true;
             }
-            ProfilerLayer::EndEvent(i.second->GetTypeName());
+            ProfilerLayer::EndEvent(i.second->GetProfilerScope());
         }
     }
 }
@@ -112,9 +124,9 @@ void Scene::Update()
     {
         if (i.second->Enabled() && i.second->m_started)
         {
-            ProfilerLayer::StartEvent(i.second->GetTypeName());
+            ProfilerLayer::StartEvent(i.second->GetProfilerScope());
             i.second->Update();
-            ProfilerLayer::EndEvent(i.second->GetTypeName());
+            ProfilerLayer::EndEvent(i.second->GetProfilerScope());
         }
     }
 }
@@ -144,9 +156,9 @@ void Scene::LateUpdate()
     {
         if (i.second->Enabled() && i.second->m_started)
         {
-            ProfilerLayer::StartEvent(i.second->GetTypeName());
+            ProfilerLayer::StartEvent(i.second->GetProfilerScope());
             i.second->LateUpdate();
-            ProfilerLayer::EndEvent(i.second->GetTypeName());
+            ProfilerLayer::EndEvent(i.second->GetProfilerScope());
         }
     }
 }
@@ -175,9 +187,9 @@ void Scene::FixedUpdate()
     {
         if (i.second->Enabled() && i.second->m_started)
         {
-            ProfilerLayer::StartEvent(i.second->GetTypeName());
+            ProfilerLayer::StartEvent(i.second->GetProfilerScope());
             i.second->FixedUpdate();
-            ProfilerLayer::EndEvent(i.second->GetTypeName());
+            ProfilerLayer::EndEvent(i.second->GetProfilerScope());
         }
     }
 }
@@ -383,6 +395,7 @@ void Scene::Deserialize(const YAML::Node &in)
 {
     UNIENGINE_LOG("Loading scene...");
     auto scene = std::dynamic_pointer_cast<Scene>(m_self.lock());
+    m_staticVersion++;
     m_sceneDataStorage.m_entities.clear();
     m_sceneDataStorage.m_entityMetadataList.clear();
     m_sceneDataStorage.m_dataComponentStorages.clear();
@@ -675,7 +688,8 @@ bool Scene::LoadInternal(const std::filesystem::path &path)
     std::ifstream stream(path.string());
     std::stringstream stringStream;
     stringStream << stream.rdbuf();
-    YAML::Node in = YAML::Load(stringStream.str());
+    MemoryStats::ScopedAllocation yamlBuffer(MemoryTag::YamlBuffers, static_cast<size_t>(stringStream.tellp()));
+    YAML::Node in = YAML::Load(stringStream);
     Deserialize(in);
     Application::Attach(previousScene);
 
@@ -686,6 +700,7 @@ void Scene::Clone(const std::shared_ptr<Scene> &source, const std::shared_ptr<Sc
     newScene->m_environmentSettings = source->m_environmentSettings;
     newScene->m_saved = source->m_saved;
     newScene->m_worldBound = source->m_worldBound;
+    newScene->m_staticVersion++;
     std::unordered_map<Handle, Handle> entityMap;
 
     newScene->m_sceneDataStorage.Clone(entityMap, source->m_sceneDataStorage, newScene);
@@ -1193,6 +1208,7 @@ void Scene::DeleteEntity(const Entity &entity)
         return;
     }
     m_saved = false;
+    m_staticVersion++;
     const size_t entityIndex = entity.m_index;
     auto children = m_sceneDataStorage.m_entityMetadataList.at(entityIndex).m_children;
     for (const auto &child : children)
@@ -1240,6 +1256,7 @@ void Scene::SetEntityStatic(const Entity &entity, bool value)
     auto &entityInfo = m_sceneDataStorage.m_entityMetadataList.at(GetRoot(entity).m_index);
     entityInfo.m_static = value;
     m_saved = false;
+    m_staticVersion++;
 }
 void Scene::SetParent(const Entity &entity, const Entity &parent, const bool &recalculateTransform)
 {
@@ -1253,6 +1270,7 @@ void Scene::SetParent(const Entity &entity, const Entity &parent, const bool &re
             return;
     }
     m_saved = false;
+    m_staticVersion++;
     auto &childEntityInfo = m_sceneDataStorage.m_entityMetadataList.at(childIndex);
     if (childEntityInfo.m_parent.GetIndex() != 0)
     {
@@ -1326,6 +1344,7 @@ void Scene::RemoveChild(const Entity &entity, const Entity &parent)
         UNIENGINE_ERROR("No child by the parent!");
     }
     m_saved = false;
+    m_staticVersion++;
     childEntityMetadata.m_parent = Entity();
     childEntityMetadata.m_root = entity;
     const size_t childrenCount = parentEntityMetadata.m_children.size();
@@ -1426,6 +1445,13 @@ void Scene::SetDataComponent(const unsigned &entityIndex, size_t id, size_t size
     const auto chunkIndex = entityInfo.m_chunkArrayIndex / dataComponentStorage.m_chunkCapacity;
     const auto chunkPointer = entityInfo.m_chunkArrayIndex % dataComponentStorage.m_chunkCapacity;
     const auto chunk = dataComponentStorage.m_chunkArray.m_chunks[chunkIndex];
+    if (id == typeid(Transform).hash_code() || id == typeid(GlobalTransform).hash_code())
+    {
+        // The transform layer never moves static entities, so this is the only place their placement changes.
+        if (m_sceneDataStorage.m_entityMetadataList.at(GetRoot(m_sceneDataStorage.m_entities.at(entityIndex)).m_index)
+                .m_static)
+            m_staticVersion++;
+    }
     if (id == typeid(Transform).hash_code())
     {
         chunk.SetData(static_cast<size_t>(chunkPointer * sizeof(Transform)), sizeof(Transform), data);
@@ -1557,6 +1583,7 @@ void Scene::SetPrivateComponent(const Entity &entity, const std::shared_ptr<IPri
     m_sceneDataStorage.m_entityPrivateComponentStorage.SetPrivateComponent(entity, id);
     elements.emplace_back(id, ptr, entity, std::dynamic_pointer_cast<Scene>(m_self.lock()));
     m_saved = false;
+    m_staticVersion++;
 }
 
 void Scene::ForEachDescendantHelper(const Entity &target, const std::function<void(const Entity &entity)> &func)
@@ -1597,6 +1624,7 @@ void Scene::RemovePrivateComponent(const Entity &entity, size_t typeId)
                 entity, typeId, privateComponentElements[i].m_privateComponentData);
             privateComponentElements.erase(privateComponentElements.begin() + i);
             m_saved = false;
+            m_staticVersion++;
             break;
         }
     }
@@ -1626,6 +1654,7 @@ void Scene::SetEnable(const Entity &entity, const bool &value)
         SetEnable(i, value);
     }
     m_saved = false;
+    m_staticVersion++;
 }
 
 void Scene::SetEnableSingle(const Entity &entity, const bool &value)
@@ -1824,6 +1853,27 @@ std::vector<std::reference_wrapper<DataComponentStorage>> Scene::QueryDataCompon
     }
     return queriedStorage;
 }
+void Scene::GetGlobalTransforms(const std::vector<Entity> &entities, std::vector<GlobalTransform> &results)
+{
+    results.resize(entities.size());
+    for (size_t i = 0; i < entities.size(); i++)
+    {
+        const auto &entity = entities[i];
+        if (!IsEntityValid(entity))
+        {
+            results[i] = GlobalTransform();
+            continue;
+        }
+        const auto &entityInfo = m_sceneDataStorage.m_entityMetadataList[entity.m_index];
+        auto &dataComponentStorage =
+            m_sceneDataStorage.m_dataComponentStorages[entityInfo.m_dataComponentStorageIndex];
+        const size_t chunkIndex = entityInfo.m_chunkArrayIndex / dataComponentStorage.m_chunkCapacity;
+        const size_t chunkPointer = entityInfo.m_chunkArrayIndex % dataComponentStorage.m_chunkCapacity;
+        results[i] = dataComponentStorage.m_chunkArray.m_chunks[chunkIndex].GetData<GlobalTransform>(
+            sizeof(Transform) * dataComponentStorage.m_chunkCapacity + chunkPointer * sizeof(GlobalTransform));
+    }
+}
+
 bool Scene::IsEntityValid(const Entity &entity)
 {
     auto &storage = m_sceneDataStorage.m_entities;
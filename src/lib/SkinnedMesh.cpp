@@ -3,6 +3,7 @@
 #include <Mesh.hpp>
 #include <Particles.hpp>
 #include <SkinnedMesh.hpp>
+#include <MeshUtilities.hpp>
 #include "DefaultResources.hpp"
 using namespace UniEngine;
 
@@ -11,10 +12,16 @@ std::unique_ptr<OpenGLUtils::GLBuffer> SkinnedMesh::m_skinnedMeshBonesUniformBuf
 
 void SkinnedMesh::OnInspect()
 {
-    ImGui::Text(("Vertices size: " + std::to_string(m_skinnedVertices.size())).c_str());
+    ImGui::Text(("Vertices size: " + std::to_string(m_vertexStreams.Size())).c_str());
     ImGui::Text(("Triangle amount: " + std::to_string(m_triangles.size())).c_str());
-
-    if(!m_skinnedVertices.empty()){
+    ImGui::Text(
+        ("CPU memory: " + std::to_string(GetMemoryUsage() / 1024) + " KB (interleaved: " +
+         std::to_string(
+             (m_vertexStreams.Size() * sizeof(SkinnedVertex) + m_triangles.size() * sizeof(glm::uvec3)) / 1024) +
+         " KB)")
+            .c_str());
+
+    if(!m_vertexStreams.Empty()){
         FileUtils::SaveFile(
             "Export as OBJ",
             "Mesh",
@@ -37,32 +44,37 @@ bool SkinnedMesh::SaveInternal(const std::filesystem::path &path)
             of.flush();
             unsigned startIndex = 1;
             if (!m_triangles.empty()) {
+                const auto &positions = m_vertexStreams.m_positions;
+                const auto &normals = m_vertexStreams.m_normals;
+                const auto &colors = m_vertexStreams.m_colors;
+                const auto &texCoords = m_vertexStreams.m_texCoords;
                 std::string header =
-                    "#Vertices: " + std::to_string(m_skinnedVertices.size()) +
+                    "#Vertices: " + std::to_string(positions.size()) +
                     ", tris: " + std::to_string(m_triangles.size());
                 header += "\n";
                 of.write(header.c_str(), header.size());
                 of.flush();
                 std::string data;
 #pragma region Data collection
-                for (auto i = 0; i < m_skinnedVertices.size(); i++) {
-                    auto &vertexPosition = m_skinnedVertices.at(i).m_position;
-                    auto &color = m_skinnedVertices.at(i).m_color;
+                for (auto i = 0; i < positions.size(); i++) {
+                    auto &vertexPosition = positions.at(i);
+                    auto color = colors.empty() ? glm::vec4(1.0f) : colors.at(i);
                     data += "v " + std::to_string(vertexPosition.x) + " " +
                             std::to_string(vertexPosition.y) + " " +
                             std::to_string(vertexPosition.z) + " " +
                             std::to_string(color.x) + " " + std::to_string(color.y) + " " +
                             std::to_string(color.z) + "\n";
                 }
-                for (const auto &vertex : m_skinnedVertices) {
-                    data += "vn " + std::to_string(vertex.m_normal.x) + " " +
-                            std::to_string(vertex.m_normal.y) + " " +
-                            std::to_string(vertex.m_normal.z) + "\n";
+                for (const auto &normal : normals) {
+                    data += "vn " + std::to_string(normal.x) + " " +
+                            std::to_string(normal.y) + " " +
+                            std::to_string(normal.z) + "\n";
                 }
 
-                for (const auto &vertex : m_skinnedVertices) {
-                    data += "vt " + std::to_string(vertex.m_texCoord.x) + " " +
-                            std::to_string(vertex.m_texCoord.y) + "\n";
+                for (auto i = 0; i < positions.size(); i++) {
+                    auto texCoord = texCoords.empty() ? glm::vec2(0.0f) : texCoords.at(i);
+                    data += "vt " + std::to_string(texCoord.x) + " " +
+                            std::to_string(texCoord.y) + "\n";
                 }
                 // data += "s off\n";
                 data += "# List of indices for faces vertices, with (x, y, z).\n";
@@ -78,7 +90,7 @@ bool SkinnedMesh::SaveInternal(const std::filesystem::path &path)
                             std::to_string(f3) + "/" + std::to_string(f3) + "/" +
                             std::to_string(f3) + "\n";
                 }
-                startIndex += m_skinnedVertices.size();
+                startIndex += positions.size();
 #pragma endregion
                 of.write(data.c_str(), data.size());
                 of.flush();
@@ -131,7 +143,7 @@ void SkinnedMesh::OnCreate()
 }
 void SkinnedMesh::Upload()
 {
-    if (m_skinnedVertices.empty())
+    if (m_vertexStreams.Empty())
     {
         UNIENGINE_ERROR("Vertices empty!")
         return;
@@ -141,37 +153,39 @@ void SkinnedMesh::Upload()
         UNIENGINE_ERROR("Triangles empty!")
         return;
     }
-
-#pragma region Data
-    m_vao->SetData((GLsizei)(m_skinnedVertices.size() * sizeof(SkinnedVertex)), nullptr, GL_STATIC_DRAW);
-    m_vao->SubData(0, m_skinnedVertices.size() * sizeof(SkinnedVertex), m_skinnedVertices.data());
-#pragma endregion
+    const auto &boneIds = m_boneWeightStreams.m_boneIds;
+    const auto &weights = m_boneWeightStreams.m_weights;
+    const auto &boneIds2 = m_boneWeightStreams.m_boneIds2;
+    const auto &weights2 = m_boneWeightStreams.m_weights2;
+    const size_t boneBytes = boneIds.size() * sizeof(glm::ivec4) + weights.size() * sizeof(glm::vec4) +
+                             boneIds2.size() * sizeof(glm::ivec4) + weights2.size() * sizeof(glm::vec4);
+    size_t offset = Mesh::UploadVertexStreams(*m_vao, m_vertexStreams, boneBytes);
 #pragma region AttributePointer
-    m_vao->EnableAttributeArray(0);
-    m_vao->SetAttributePointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(SkinnedVertex), 0);
-    m_vao->EnableAttributeArray(1);
-    m_vao->SetAttributePointer(
-        1, 3, GL_FLOAT, GL_FALSE, sizeof(SkinnedVertex), (void *)(offsetof(SkinnedVertex, m_normal)));
-    m_vao->EnableAttributeArray(2);
-    m_vao->SetAttributePointer(
-        2, 3, GL_FLOAT, GL_FALSE, sizeof(SkinnedVertex), (void *)(offsetof(SkinnedVertex, m_tangent)));
-    m_vao->EnableAttributeArray(3);
-    m_vao->SetAttributePointer(
-        3, 3, GL_FLOAT, GL_FALSE, sizeof(SkinnedVertex), (void *)(offsetof(SkinnedVertex, m_color)));
-    m_vao->EnableAttributeArray(4);
-    m_vao->SetAttributePointer(
-        4, 2, GL_FLOAT, GL_FALSE, sizeof(SkinnedVertex), (void *)(offsetof(SkinnedVertex, m_texCoord)));
-
+    const size_t defaultsOffset = offset + boneBytes;
+    m_vao->SubData(offset, boneIds.size() * sizeof(glm::ivec4), boneIds.data());
     m_vao->EnableAttributeArray(5);
-    m_vao->SetAttributeIntPointer(5, 4, GL_INT, sizeof(SkinnedVertex), (void *)(offsetof(SkinnedVertex, m_bondId)));
+    m_vao->SetAttributeIntPointer(5, 4, GL_INT, sizeof(glm::ivec4), (void *)offset);
+    offset += boneIds.size() * sizeof(glm::ivec4);
+    m_vao->SubData(offset, weights.size() * sizeof(glm::vec4), weights.data());
     m_vao->EnableAttributeArray(6);
-    m_vao->SetAttributePointer(
-        6, 4, GL_FLOAT, GL_FALSE, sizeof(SkinnedVertex), (void *)(offsetof(SkinnedVertex, m_weight)));
-    m_vao->EnableAttributeArray(7);
-    m_vao->SetAttributeIntPointer(7, 4, GL_INT, sizeof(SkinnedVertex), (void *)(offsetof(SkinnedVertex, m_bondId2)));
-    m_vao->EnableAttributeArray(8);
-    m_vao->SetAttributePointer(
-        8, 4, GL_FLOAT, GL_FALSE, sizeof(SkinnedVertex), (void *)(offsetof(SkinnedVertex, m_weight2)));
+    m_vao->SetAttributePointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(glm::vec4), (void *)offset);
+    offset += weights.size() * sizeof(glm::vec4);
+    if (!weights2.empty())
+    {
+        m_vao->SubData(offset, boneIds2.size() * sizeof(glm::ivec4), boneIds2.data());
+        m_vao->EnableAttributeArray(7);
+        m_vao->SetAttributeIntPointer(7, 4, GL_INT, sizeof(glm::ivec4), (void *)offset);
+        offset += boneIds2.size() * sizeof(glm::ivec4);
+        m_vao->SubData(offset, weights2.size() * sizeof(glm::vec4), weights2.data());
+        m_vao->EnableAttributeArray(8);
+        m_vao->SetAttributePointer(8, 4, GL_FLOAT, GL_FALSE, sizeof(glm::vec4), (void *)offset);
+    }
+    else
+    {
+        // No vertex uses the second set of influences, zero weights make the shader ignore it.
+        m_vao->SetAttributeConstant(7, 4, GL_INT, defaultsOffset + offsetof(VertexAttributeDefaults, m_boneIds));
+        m_vao->SetAttributeConstant(8, 4, GL_FLOAT, defaultsOffset + offsetof(VertexAttributeDefaults, m_weights));
+    }
 #pragma endregion
     m_vao->Ebo().SetData((GLsizei)m_triangles.size() * sizeof(glm::uvec3), m_triangles.data(), GL_STATIC_DRAW);
     m_version++;
@@ -204,36 +218,66 @@ void SkinnedMesh::SetVertices(
         UNIENGINE_ERROR("No Position Data!");
         return;
     }
-    m_mask = mask;
-    m_skinnedVertices = skinnedVertices;
+    VertexStreams vertexStreams;
+    BoneWeightStreams boneWeightStreams;
+    vertexStreams.Import(mask, skinnedVertices);
+    boneWeightStreams.Import(skinnedVertices);
+    SetVertices(std::move(vertexStreams), std::move(boneWeightStreams), triangles);
+}
+
+void SkinnedMesh::SetVertices(
+    VertexStreams &&vertexStreams, BoneWeightStreams &&boneWeightStreams, const std::vector<glm::uvec3> &triangles)
+{
+    if (vertexStreams.Empty() || triangles.empty())
+    {
+        UNIENGINE_LOG("Vertices or triangles empty!");
+        return;
+    }
+    if (boneWeightStreams.m_boneIds.size() != vertexStreams.Size() ||
+        boneWeightStreams.m_weights.size() != vertexStreams.Size())
+    {
+        UNIENGINE_ERROR("Bone weights don't match vertices!");
+        return;
+    }
+    m_vertexStreams = std::move(vertexStreams);
+    m_vertexStreams.m_mask |= static_cast<unsigned>(VertexAttribute::Position);
+    m_boneWeightStreams = std::move(boneWeightStreams);
+    if (m_boneWeightStreams.m_boneIds2.size() != m_vertexStreams.Size() ||
+        m_boneWeightStreams.m_weights2.size() != m_vertexStreams.Size())
+    {
+        m_boneWeightStreams.m_boneIds2.clear();
+        m_boneWeightStreams.m_weights2.clear();
+    }
     m_triangles = triangles;
 #pragma region Bound
-    glm::vec3 minBound = m_skinnedVertices.at(0).m_position;
-    glm::vec3 maxBound = m_skinnedVertices.at(0).m_position;
-    for (size_t i = 0; i < m_skinnedVertices.size(); i++)
+    const auto &positions = m_vertexStreams.m_positions;
+    glm::vec3 minBound = positions.at(0);
+    glm::vec3 maxBound = positions.at(0);
+    for (size_t i = 0; i < positions.size(); i++)
     {
         minBound = glm::vec3(
-            (glm::min)(minBound.x, m_skinnedVertices[i].m_position.x),
-            (glm::min)(minBound.y, m_skinnedVertices[i].m_position.y),
-            (glm::min)(minBound.z, m_skinnedVertices[i].m_position.z));
+            (glm::min)(minBound.x, positions[i].x),
+            (glm::min)(minBound.y, positions[i].y),
+            (glm::min)(minBound.z, positions[i].z));
         maxBound = glm::vec3(
-            (glm::max)(maxBound.x, m_skinnedVertices[i].m_position.x),
-            (glm::max)(maxBound.y, m_skinnedVertices[i].m_position.y),
-            (glm::max)(maxBound.z, m_skinnedVertices[i].m_position.z));
+            (glm::max)(maxBound.x, positions[i].x),
+            (glm::max)(maxBound.y, positions[i].y),
+            (glm::max)(maxBound.z, positions[i].z));
     }
     m_bound.m_max = maxBound;
     m_bound.m_min = minBound;
 #pragma endregion
-    if (!(m_mask & (unsigned)VertexAttribute::Normal))
+    if (!m_vertexStreams.Has(VertexAttribute::Normal))
         RecalculateNormal();
-    if (!(m_mask & (unsigned)VertexAttribute::Tangent))
+    // Tangents are derived from texture coordinates, without them there is nothing to compute.
+    if (!m_vertexStreams.Has(VertexAttribute::Tangent) && m_vertexStreams.Has(VertexAttribute::TexCoord))
         RecalculateTangent();
     Upload();
 }
 
 size_t SkinnedMesh::GetSkinnedVerticesAmount() const
 {
-    return m_skinnedVertices.size();
+    return m_vertexStreams.Size();
 }
 
 size_t SkinnedMesh::GetTriangleAmount() const
@@ -241,78 +285,17 @@ size_t SkinnedMesh::GetTriangleAmount() const
     return m_triangles.size();
 }
 
-void SkinnedMesh::RecalculateNormal()
+void SkinnedMesh::RecalculateNormal(const NormalWeighting &weighting)
 {
-    std::vector<std::vector<glm::vec3>> normalLists = std::vector<std::vector<glm::vec3>>();
-    auto size = m_skinnedVertices.size();
-    for (auto i = 0; i < size; i++)
-    {
-        normalLists.push_back(std::vector<glm::vec3>());
-    }
-    for (size_t i = 0; i < m_triangles.size(); i++)
-    {
-        const auto i1 = m_triangles[i].x;
-        const auto i2 = m_triangles[i].y;
-        const auto i3 = m_triangles[i].z;
-        auto v1 = m_skinnedVertices[i1].m_position;
-        auto v2 = m_skinnedVertices[i2].m_position;
-        auto v3 = m_skinnedVertices[i3].m_position;
-        auto normal = glm::normalize(glm::cross(v1 - v2, v1 - v3));
-        normalLists[i1].push_back(normal);
-        normalLists[i2].push_back(normal);
-        normalLists[i3].push_back(normal);
-    }
-    for (auto i = 0; i < size; i++)
-    {
-        auto normal = glm::vec3(0.0f);
-        for (auto j : normalLists[i])
-        {
-            normal += j;
-        }
-        m_skinnedVertices[i].m_normal = glm::normalize(normal);
-    }
+    m_vertexStreams.SetAttribute(VertexAttribute::Normal, true);
+    MeshUtilities::RecalculateNormal(m_vertexStreams.m_positions, m_triangles, m_vertexStreams.m_normals, weighting);
 }
 
 void SkinnedMesh::RecalculateTangent()
 {
-    auto tangentLists = std::vector<std::vector<glm::vec3>>();
-    auto size = m_skinnedVertices.size();
-    for (auto i = 0; i < size; i++)
-    {
-        tangentLists.emplace_back();
-    }
-    for (size_t i = 0; i < m_triangles.size(); i++)
-    {
-        const auto i1 = m_triangles[i].x;
-        const auto i2 = m_triangles[i].y;
-        const auto i3 = m_triangles[i].z;
-        auto p1 = m_skinnedVertices[i1].m_position;
-        auto p2 = m_skinnedVertices[i2].m_position;
-        auto p3 = m_skinnedVertices[i3].m_position;
-        auto uv1 = m_skinnedVertices[i1].m_texCoord;
-        auto uv2 = m_skinnedVertices[i2].m_texCoord;
-        auto uv3 = m_skinnedVertices[i3].m_texCoord;
-
-        auto e21 = p2 - p1;
-        auto d21 = uv2 - uv1;
-        auto e31 = p3 - p1;
-        auto d31 = uv3 - uv1;
-        float f = 1.0f / (d21.x * d31.y - d31.x * d21.y);
-        auto tangent =
-            f * glm::vec3(d31.y * e21.x - d21.y * e31.x, d31.y * e21.y - d21.y * e31.y, d31.y * e21.z - d21.y * e31.z);
-        tangentLists[i1].push_back(tangent);
-        tangentLists[i2].push_back(tangent);
-        tangentLists[i3].push_back(tangent);
-    }
-    for (auto i = 0; i < size; i++)
-    {
-        auto tangent = glm::vec3(0.0f);
-        for (auto j : tangentLists[i])
-        {
-            tangent += j;
-        }
-        m_skinnedVertices[i].m_tangent = glm::normalize(tangent);
-    }
+    m_vertexStreams.SetAttribute(VertexAttribute::Tangent, true);
+    MeshUtilities::RecalculateTangent(
+        m_vertexStreams.m_positions, m_vertexStreams.m_texCoords, m_triangles, m_vertexStreams.m_tangents);
 }
 
 std::shared_ptr<OpenGLUtils::GLVAO> SkinnedMesh::Vao() const
@@ -334,9 +317,29 @@ std::vector<glm::uvec3> &SkinnedMesh::UnsafeGetTriangles()
 {
     return m_triangles;
 }
-std::vector<SkinnedVertex> &SkinnedMesh::UnsafeGetSkinnedVertices()
+std::vector<SkinnedVertex> SkinnedMesh::GetSkinnedVertices() const
 {
-    return m_skinnedVertices;
+    std::vector<SkinnedVertex> skinnedVertices;
+    m_vertexStreams.Export(skinnedVertices);
+    m_boneWeightStreams.Export(skinnedVertices);
+    return skinnedVertices;
+}
+unsigned SkinnedMesh::GetMask() const
+{
+    return m_vertexStreams.m_mask;
+}
+const VertexStreams &SkinnedMesh::PeekVertexStreams() const
+{
+    return m_vertexStreams;
+}
+const BoneWeightStreams &SkinnedMesh::PeekBoneWeightStreams() const
+{
+    return m_boneWeightStreams;
+}
+size_t SkinnedMesh::GetMemoryUsage() const
+{
+    return m_vertexStreams.GetMemoryUsage() + m_boneWeightStreams.GetMemoryUsage() +
+           m_triangles.capacity() * sizeof(glm::uvec3);
 }
 
 void SkinnedMesh::Draw() const
@@ -410,15 +413,14 @@ void SkinnedMesh::Serialize(YAML::Emitter &out)
                    (const unsigned char *)m_boneAnimatorIndices.data(),
                    m_boneAnimatorIndices.size() * sizeof(unsigned));
     }
-    out << YAML::Key << "m_mask" << YAML::Value << m_mask;
+    out << YAML::Key << "m_mask" << YAML::Value << m_vertexStreams.m_mask;
     out << YAML::Key << "m_offset" << YAML::Value << m_offset;
     out << YAML::Key << "m_version" << YAML::Value << m_version;
 
-    if (!m_skinnedVertices.empty() && !m_triangles.empty())
+    if (!m_vertexStreams.Empty() && !m_triangles.empty())
     {
-        out << YAML::Key << "m_skinnedVertices" << YAML::Value
-            << YAML::Binary(
-                   (const unsigned char *)m_skinnedVertices.data(), m_skinnedVertices.size() * sizeof(SkinnedVertex));
+        Mesh::SerializeVertexStreams(m_vertexStreams, out);
+        Mesh::SerializeBoneWeightStreams(m_boneWeightStreams, out);
         out << YAML::Key << "m_triangles" << YAML::Value
             << YAML::Binary((const unsigned char *)m_triangles.data(), m_triangles.size() * sizeof(glm::uvec3));
     }
@@ -431,22 +433,31 @@ void SkinnedMesh::Deserialize(const YAML::Node &in)
         m_boneAnimatorIndices.resize(boneIndices.size() / sizeof(unsigned));
         std::memcpy(m_boneAnimatorIndices.data(), boneIndices.data(), boneIndices.size());
     }
-    m_mask = in["m_mask"].as<unsigned>();
+    const auto mask = in["m_mask"].as<unsigned>();
     m_offset = in["m_offset"].as<size_t>();
     m_version = in["m_version"].as<size_t>();
 
-    if(in["m_skinnedVertices"] && in["m_triangles"])
+    if (!in["m_triangles"])
+        return;
+    YAML::Binary triangleData = in["m_triangles"].as<YAML::Binary>();
+    std::vector<glm::uvec3> triangles;
+    triangles.resize(triangleData.size() / sizeof(glm::uvec3));
+    std::memcpy(triangles.data(), triangleData.data(), triangleData.size());
+    if (in["m_positions"])
+    {
+        VertexStreams vertexStreams;
+        BoneWeightStreams boneWeightStreams;
+        Mesh::DeserializeVertexStreams(mask, vertexStreams, in);
+        Mesh::DeserializeBoneWeightStreams(boneWeightStreams, in);
+        SetVertices(std::move(vertexStreams), std::move(boneWeightStreams), triangles);
+    }
+    else if (in["m_skinnedVertices"])
     {
+        // Assets saved before vertex streams were introduced.
         YAML::Binary skinnedVertexData = in["m_skinnedVertices"].as<YAML::Binary>();
         std::vector<SkinnedVertex> skinnedVertices;
         skinnedVertices.resize(skinnedVertexData.size() / sizeof(SkinnedVertex));
         std::memcpy(skinnedVertices.data(), skinnedVertexData.data(), skinnedVertexData.size());
-
-        YAML::Binary triangleData = in["m_triangles"].as<YAML::Binary>();
-        std::vector<glm::uvec3> triangles;
-        triangles.resize(triangleData.size() / sizeof(glm::uvec3));
-        std::memcpy(triangles.data(), triangleData.data(), triangleData.size());
-
-        SetVertices(m_mask, skinnedVertices, triangles);
+        SetVertices(mask, skinnedVertices, triangles);
     }
 }
\ No newline at end of file
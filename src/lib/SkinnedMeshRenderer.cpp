@@ -2,6 +2,7 @@
 #include <DefaultResources.hpp>
 #include "Editor.hpp"
 #include "Engine/Rendering/Graphics.hpp"
+#include <BonePalette.hpp>
 #include <SkinnedMeshRenderer.hpp>
 using namespace UniEngine;
 void SkinnedMeshRenderer::RenderBound(glm::vec4& color)
@@ -36,20 +37,27 @@ void SkinnedMeshRenderer::GetBoneMatrices()
 	auto skinnedMesh = m_skinnedMesh.Get<SkinnedMesh>();
 	if (!skinnedMesh)
 		return;
+	m_finalResults->m_paletteVersion = 0;
 	if (m_ragDoll)
 	{
 		if (m_ragDollFreeze)
 			return;
 		
 		m_finalResults->m_value.resize(skinnedMesh->m_boneAnimatorIndices.size());
-		for (int i = 0; i < m_boundEntities.size(); i++)
+		const size_t amount = (std::min)(
+			{ m_boundEntities.size(), m_ragDollTransformChain.size(), animator->m_offsetMatrices.size() });
+		m_ragDollEntities.resize(amount);
+		for (size_t i = 0; i < amount; i++)
+			m_ragDollEntities[i] = m_boundEntities[i].Get();
+		// Unbound bones get the identity here and keep their last matrix below.
+		scene->GetGlobalTransforms(m_ragDollEntities, m_ragDollGlobalTransforms);
+		static_assert(sizeof(GlobalTransform) == sizeof(glm::mat4));
+		auto* products = reinterpret_cast<glm::mat4*>(m_ragDollGlobalTransforms.data());
+		BonePalette::MultiplyAffine(products, animator->m_offsetMatrices.data(), products, amount);
+		for (size_t i = 0; i < amount; i++)
 		{
-			auto entity = m_boundEntities[i].Get();
-			if (entity.GetIndex() != 0)
-			{
-				m_ragDollTransformChain[i] = scene->GetDataComponent<GlobalTransform>(entity).m_value;
-				m_ragDollTransformChain[i] *= animator->m_offsetMatrices[i];
-			}
+			if (m_ragDollEntities[i].GetIndex() != 0)
+				m_ragDollTransformChain[i] = products[i];
 		}
 		for (int i = 0; i < skinnedMesh->m_boneAnimatorIndices.size(); i++)
 		{
@@ -342,5 +350,7 @@ void BoneMatrices::Update()
 
 void BoneMatrices::UploadBones(const std::shared_ptr<SkinnedMesh>& skinnedMesh)
 {
+	if (BonePalette::Bind(*this))
+		return;
 	skinnedMesh->UploadBones(m_value);
 }
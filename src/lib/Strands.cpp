@@ -508,21 +508,38 @@ void CubicInterpolation(const glm::vec3& v0, const glm::vec3& v1, const glm::vec
 
 void Strands::RecalculateNormal()
 {
-	glm::vec3 tangent, temp;
-	for(const auto& indices : m_segmentIndices)
+	// Neighbouring segments share control points and each segment overwrites the normals of its points in order.
+	// Resolve the last segment touching every point up front so segments can be evaluated in parallel with
+	// the same result and without racing on shared points.
+	std::vector<unsigned> lastSegment(m_points.size(), 0);
+	for (unsigned i = 0; i < m_segmentIndices.size(); i++)
 	{
-		CubicInterpolation(m_points[indices[0]].m_position, m_points[indices[1]].m_position, m_points[indices[2]].m_position, m_points[indices[3]].m_position, temp, tangent, 0.0f);
-		m_points[indices[0]].m_normal = glm::vec3(tangent.y, tangent.z, tangent.x);
-
-		CubicInterpolation(m_points[indices[0]].m_position, m_points[indices[1]].m_position, m_points[indices[2]].m_position, m_points[indices[3]].m_position, temp, tangent, 0.25f);
-		m_points[indices[1]].m_normal = glm::cross(glm::cross(tangent, m_points[indices[0]].m_normal), tangent);
-
-		CubicInterpolation(m_points[indices[0]].m_position, m_points[indices[1]].m_position, m_points[indices[2]].m_position, m_points[indices[3]].m_position, temp, tangent, 0.75f);
-		m_points[indices[2]].m_normal = glm::cross(glm::cross(tangent, m_points[indices[1]].m_normal), tangent);
-
-		CubicInterpolation(m_points[indices[0]].m_position, m_points[indices[1]].m_position, m_points[indices[2]].m_position, m_points[indices[3]].m_position, temp, tangent, 1.0f);
-		m_points[indices[3]].m_normal = glm::cross(glm::cross(tangent, m_points[indices[2]].m_normal), tangent);
+		const auto& indices = m_segmentIndices[i];
+		for (int j = 0; j < 4; j++) lastSegment[indices[j]] = i;
 	}
+	std::vector<std::shared_future<void>> results;
+	Jobs::ParallelFor(m_segmentIndices.size(), [&](unsigned i)
+		{
+			const auto& indices = m_segmentIndices[i];
+			const auto& p0 = m_points[indices[0]].m_position;
+			const auto& p1 = m_points[indices[1]].m_position;
+			const auto& p2 = m_points[indices[2]].m_position;
+			const auto& p3 = m_points[indices[3]].m_position;
+			glm::vec3 tangent, temp, normals[4];
+			CubicInterpolation(p0, p1, p2, p3, temp, tangent, 0.0f);
+			normals[0] = glm::vec3(tangent.y, tangent.z, tangent.x);
+			CubicInterpolation(p0, p1, p2, p3, temp, tangent, 0.25f);
+			normals[1] = glm::cross(glm::cross(tangent, normals[0]), tangent);
+			CubicInterpolation(p0, p1, p2, p3, temp, tangent, 0.75f);
+			normals[2] = glm::cross(glm::cross(tangent, normals[1]), tangent);
+			CubicInterpolation(p0, p1, p2, p3, temp, tangent, 1.0f);
+			normals[3] = glm::cross(glm::cross(tangent, normals[2]), tangent);
+			for (int j = 0; j < 4; j++)
+			{
+				if (lastSegment[indices[j]] == i) m_points[indices[j]].m_normal = normals[j];
+			}
+		}, results);
+	for (auto& result : results) result.wait();
 }
 
 
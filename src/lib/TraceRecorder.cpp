@@ -0,0 +1,263 @@
+#include "TraceRecorder.hpp"
+using namespace UniEngine;
+
+namespace
+{
+constexpr uint32_t BufferMask = TraceRecorder::ThreadBufferCapacity - 1;
+
+uint64_t Now()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+void WriteString(std::ostream &out, const std::string &value)
+{
+    out << '"';
+    for (const auto &c : value)
+    {
+        if (c == '"' || c == '\\')
+            out << '\\';
+        out << c;
+    }
+    out << '"';
+}
+} // namespace
+
+// Written only by its own thread and read only by NewFrame, so the head and tail are the only synchronization.
+struct TraceRecorder::ThreadBuffer
+{
+    std::unique_ptr<TraceEvent[]> m_events = std::make_unique<TraceEvent[]>(ThreadBufferCapacity);
+    std::atomic<uint32_t> m_head{0};
+    std::atomic<uint32_t> m_tail{0};
+    std::atomic<size_t> m_droppedEvents{0};
+    // Scopes begun in the ring and not ended yet, a slot is kept free for the end of each.
+    uint32_t m_openScopes = 0;
+    // Depth within the outermost dropped scope, everything down to its end is dropped.
+    uint32_t m_droppedDepth = 0;
+    uint32_t m_recordingEpoch = 0;
+    uint16_t m_index = 0;
+    std::string m_name;
+};
+
+TraceRecorder::ThreadBuffer &TraceRecorder::GetThreadBuffer()
+{
+    // Buffers are owned by the recorder, so events of threads that exited can still be drained.
+    thread_local ThreadBuffer *buffer = nullptr;
+    if (!buffer)
+    {
+        auto &recorder = GetInstance();
+        std::lock_guard<std::mutex> lock(recorder.m_mutex);
+        const auto threadBuffer = std::make_shared<ThreadBuffer>();
+        threadBuffer->m_index = static_cast<uint16_t>(recorder.m_threadBuffers.size());
+        threadBuffer->m_name = "Thread " + std::to_string(threadBuffer->m_index);
+        recorder.m_threadBuffers.push_back(threadBuffer);
+        buffer = threadBuffer.get();
+    }
+    return *buffer;
+}
+
+void TraceRecorder::Record(const uint32_t &scope, const char &phase)
+{
+    auto &buffer = GetThreadBuffer();
+    const uint32_t epoch = GetInstance().m_recordingEpoch.load(std::memory_order_relaxed);
+    if (buffer.m_recordingEpoch != epoch)
+    {
+        buffer.m_recordingEpoch = epoch;
+        buffer.m_openScopes = 0;
+        buffer.m_droppedDepth = 0;
+    }
+    const uint32_t head = buffer.m_head.load(std::memory_order_relaxed);
+    const uint32_t used = head - buffer.m_tail.load(std::memory_order_acquire);
+    bool drop = false;
+    if (phase == 'B')
+    {
+        drop = buffer.m_droppedDepth != 0 || used + buffer.m_openScopes + 2 > ThreadBufferCapacity;
+        if (drop)
+            buffer.m_droppedDepth++;
+        else
+            buffer.m_openScopes++;
+    }
+    else if (buffer.m_droppedDepth != 0)
+    {
+        buffer.m_droppedDepth--;
+        drop = true;
+    }
+    else if (buffer.m_openScopes != 0)
+        buffer.m_openScopes--;
+    else
+        // End of a scope begun before recording started.
+        drop = used == ThreadBufferCapacity;
+    if (drop)
+    {
+        buffer.m_droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer.m_events[head & BufferMask] = {Now(), scope, buffer.m_index, phase};
+    buffer.m_head.store(head + 1, std::memory_order_release);
+}
+
+uint32_t TraceRecorder::RegisterScope(const std::string &name)
+{
+    auto &recorder = GetInstance();
+    std::lock_guard<std::mutex> lock(recorder.m_mutex);
+    const auto search = recorder.m_scopeIndices.find(name);
+    if (search != recorder.m_scopeIndices.end())
+        return search->second;
+    const auto scope = static_cast<uint32_t>(recorder.m_scopeNames.size());
+    recorder.m_scopeNames.push_back(name);
+    recorder.m_scopeIndices[name] = scope;
+    return scope;
+}
+
+const std::string &TraceRecorder::GetScopeName(const uint32_t &scope)
+{
+    auto &recorder = GetInstance();
+    std::lock_guard<std::mutex> lock(recorder.m_mutex);
+    return recorder.m_scopeNames.at(scope);
+}
+
+void TraceRecorder::SetThreadName(const std::string &name)
+{
+    auto &buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(GetInstance().m_mutex);
+    buffer.m_name = name;
+}
+
+void TraceRecorder::SetRecording(const bool &value)
+{
+    auto &recorder = GetInstance();
+    if (value && !recorder.m_recording)
+    {
+        std::lock_guard<std::mutex> lock(recorder.m_mutex);
+        recorder.m_currentFrame.m_start = Now();
+        recorder.m_recordingEpoch.fetch_add(1, std::memory_order_relaxed);
+    }
+    recorder.m_recording = value;
+}
+
+bool TraceRecorder::IsRecording()
+{
+    return GetInstance().m_recording.load(std::memory_order_relaxed);
+}
+
+void TraceRecorder::Begin(const uint32_t &scope)
+{
+    if (GetInstance().m_recording.load(std::memory_order_relaxed))
+        Record(scope, 'B');
+}
+
+void TraceRecorder::End(const uint32_t &scope)
+{
+    if (GetInstance().m_recording.load(std::memory_order_relaxed))
+        Record(scope, 'E');
+}
+
+void TraceRecorder::NewFrame()
+{
+    auto &recorder = GetInstance();
+    const uint64_t now = Now();
+    std::lock_guard<std::mutex> lock(recorder.m_mutex);
+    auto &frame = recorder.m_currentFrame;
+    for (const auto &buffer : recorder.m_threadBuffers)
+    {
+        const uint32_t tail = buffer->m_tail.load(std::memory_order_relaxed);
+        const uint32_t head = buffer->m_head.load(std::memory_order_acquire);
+        for (uint32_t i = tail; i != head; i++)
+            frame.m_events.push_back(buffer->m_events[i & BufferMask]);
+        buffer->m_tail.store(head, std::memory_order_release);
+        recorder.m_droppedEvents += buffer->m_droppedEvents.exchange(0, std::memory_order_relaxed);
+    }
+    // Events drained while not recording were left over from the previous recording and are discarded.
+    TraceFrame next;
+    if (frame.m_start != 0)
+    {
+        frame.m_end = now;
+        recorder.m_frames.push_back(std::move(frame));
+        if (recorder.m_frames.size() > recorder.m_maxFrames)
+        {
+            // Reuse the event storage of the discarded frame.
+            next = std::move(recorder.m_frames.front());
+            next.m_events.clear();
+            recorder.m_frames.pop_front();
+        }
+    }
+    frame = std::move(next);
+    frame.m_start = recorder.m_recording ? now : 0;
+    frame.m_end = 0;
+}
+
+void TraceRecorder::SetMaxFrames(const size_t &value)
+{
+    auto &recorder = GetInstance();
+    std::lock_guard<std::mutex> lock(recorder.m_mutex);
+    recorder.m_maxFrames = (std::max)(value, size_t(1));
+    while (recorder.m_frames.size() > recorder.m_maxFrames)
+        recorder.m_frames.pop_front();
+}
+
+void TraceRecorder::Clear()
+{
+    auto &recorder = GetInstance();
+    std::lock_guard<std::mutex> lock(recorder.m_mutex);
+    recorder.m_frames.clear();
+    recorder.m_currentFrame.m_events.clear();
+    recorder.m_droppedEvents = 0;
+}
+
+const std::deque<TraceFrame> &TraceRecorder::GetFrames()
+{
+    return GetInstance().m_frames;
+}
+
+size_t TraceRecorder::GetDroppedEventAmount()
+{
+    return GetInstance().m_droppedEvents;
+}
+
+bool TraceRecorder::ExportChromeTrace(const std::filesystem::path &path)
+{
+    std::ofstream out(path);
+    if (!out)
+        return false;
+    auto &recorder = GetInstance();
+    std::lock_guard<std::mutex> lock(recorder.m_mutex);
+    const uint64_t origin = recorder.m_frames.empty() ? 0 : recorder.m_frames.front().m_start;
+    const auto microseconds = [&](const uint64_t &time) {
+        return (static_cast<double>(time) - static_cast<double>(origin)) / 1000.0;
+    };
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    bool first = true;
+    const auto separator = [&]() {
+        out << (first ? "\n" : ",\n");
+        first = false;
+    };
+    for (const auto &buffer : recorder.m_threadBuffers)
+    {
+        separator();
+        out << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": " << buffer->m_index
+            << ", \"args\": {\"name\": ";
+        WriteString(out, buffer->m_name);
+        out << "}}";
+    }
+    size_t frameIndex = 0;
+    for (const auto &frame : recorder.m_frames)
+    {
+        // Frames go on a track of their own above the threads.
+        separator();
+        out << "{\"name\": \"Frame " << frameIndex++ << "\", \"ph\": \"X\", \"pid\": 0, \"tid\": -1, \"ts\": "
+            << microseconds(frame.m_start) << ", \"dur\": " << (frame.m_end - frame.m_start) / 1000.0 << "}";
+        for (const auto &event : frame.m_events)
+        {
+            separator();
+            out << "{\"name\": ";
+            WriteString(out, recorder.m_scopeNames[event.m_scope]);
+            out << ", \"ph\": \"" << event.m_phase << "\", \"pid\": 0, \"tid\": " << event.m_thread
+                << ", \"ts\": " << microseconds(event.m_time) << "}";
+        }
+    }
+    out << "\n]}\n";
+    return true;
+}
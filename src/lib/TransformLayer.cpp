@@ -56,8 +56,11 @@ void TransformLayer::CalculateTransformGraphs(const std::shared_ptr<Scene> &scen
 {
     if (!scene)
         return;
+    // Layers used outside of Application never receive OnCreate.
+    if (m_transformQuery.IsNull())
+        OnCreate();
     auto &entityInfos = scene->m_sceneDataStorage.m_entityMetadataList;
-    ProfilerLayer::StartEvent("TransformManager");
+    ProfilerLayer::StartEvent(UNIENGINE_PROFILE_EVENT("TransformManager"));
     scene->ForEach<Transform, GlobalTransform, GlobalTransformUpdateFlag>(
         Jobs::Workers(),
         m_transformQuery,
@@ -82,7 +85,7 @@ void TransformLayer::CalculateTransformGraphs(const std::shared_ptr<Scene> &scen
         },
         false);
     m_physicsSystemOverride = false;
-    ProfilerLayer::EndEvent("TransformManager");
+    ProfilerLayer::EndEvent(UNIENGINE_PROFILE_EVENT("TransformManager"));
 }
 void TransformLayer::CalculateTransformGraphForDescendents(const std::shared_ptr<Scene> &scene, const Entity &entity)
 {
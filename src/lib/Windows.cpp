@@ -40,20 +40,40 @@ void Windows::SetMonitorCallback(GLFWmonitor *monitor, int event)
 void Windows::LateUpdate()
 {
     auto& windowManager = GetInstance();
-    glfwSwapBuffers(windowManager.m_window);
+    if (!windowManager.m_headless)
+        glfwSwapBuffers(windowManager.m_window);
 }
 
-void Windows::Init(std::string name, bool fullScreen)
+void Windows::Init(std::string name, bool fullScreen, bool headless)
 {
-    glfwInit();
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, true);
+    GetInstance().m_headless = headless;
+    GetInstance().m_startTime = std::chrono::steady_clock::now();
+    if (headless)
+    {
+#ifdef GLFW_PLATFORM_NULL
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#endif
+        if (glfwInit() != GLFW_TRUE)
+        {
+            UNIENGINE_LOG("No display available, running headless without a window");
+            return;
+        }
+        glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    }
+    else
+    {
+        glfwInit();
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, true);
 
 #ifdef __APPLE__
-    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE); // uncomment this statement to fix compilation on OS X
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE); // uncomment this statement to fix compilation on OS X
 #endif
+    }
+    GetInstance().m_initialized = true;
     int size;
     auto monitors = glfwGetMonitors(&size);
     for (auto i = 0; i < size; i++)
@@ -79,7 +99,16 @@ void Windows::Init(std::string name, bool fullScreen)
     {
         UNIENGINE_ERROR("Failed to create GLFW window");
     }
-    glfwMakeContextCurrent(GetInstance().m_window);
+    if (!headless)
+        glfwMakeContextCurrent(GetInstance().m_window);
+}
+
+double Windows::GetTime()
+{
+    auto &windowManager = GetInstance();
+    if (windowManager.m_initialized)
+        return glfwGetTime();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - windowManager.m_startTime).count();
 }
 
 GLFWwindow *Windows::GetWindow()
@@ -94,10 +123,11 @@ GLFWmonitor *Windows::PrimaryMonitor()
 
 void Windows::PreUpdate()
 {
-    glfwPollEvents();
+    if (GetInstance().m_initialized)
+        glfwPollEvents();
     RenderTarget::BindDefault();
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
-    if (glfwWindowShouldClose(Windows::GetWindow()))
+    if (Windows::GetWindow() && glfwWindowShouldClose(Windows::GetWindow()))
     {
         Application::GetInstance().m_applicationStatus = ApplicationStatus::OnDestroy;
     }
@@ -132,5 +162,6 @@ void Windows::WindowFocusCallback(GLFWwindow* window, int focused)
 }
 void Windows::ResizeWindow(int x, int y)
 {
-    glfwSetWindowSize(GetWindow(), x, y);
+    if (GetWindow())
+        glfwSetWindowSize(GetWindow(), x, y);
 }